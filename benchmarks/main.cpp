@@ -0,0 +1,35 @@
+#include <benchmark/benchmark.h>
+
+#include <iostream>
+
+#include <shared/utils/logger.h>
+
+/**
+ * @brief Same as BENCHMARK_MAIN, but the logger is silenced first, otherwise we would mostly measure the logger.
+ *
+ * Results can be written as JSON with `--benchmark_out=<file> --benchmark_out_format=json`,
+ * see the run_benchmarks target.
+ */
+int main(int argc, char **argv)
+{
+    shared::Logger::initialize();
+
+    benchmark::Initialize(&argc, argv);
+    if ( benchmark::ReportUnrecognizedArguments(argc, argv) ) {
+        return 1;
+    }
+
+    // the engine logs every card played at INFO, only errors may get through while measuring
+    shared::Logger::setLevel(LogLevel::ERROR);
+
+    // an unoptimised engine is about 20 times slower, so the results are not comparable to a release build
+    benchmark::AddCustomContext("engine_build_type", ENGINE_BUILD_TYPE);
+#ifndef NDEBUG
+    std::cerr << "***WARNING*** The engine was built as " ENGINE_BUILD_TYPE
+                 " without optimisations, configure with -DCMAKE_BUILD_TYPE=Release for meaningful timings.\n";
+#endif
+
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
@@ -0,0 +1,40 @@
+#include <benchmark/benchmark.h>
+
+#include <server/game/behaviour_chain.h>
+#include <server/game/behaviour_registry.h>
+#include <server/game/game_state.h>
+
+/**
+ * @brief The behaviours of a card are looked up every time it is played.
+ */
+static void BM_BehaviourRegistryGetBehaviours(benchmark::State &state, shared::CardBase::handle_t card)
+{
+    server::BehaviourRegistry registry;
+
+    for ( auto _ : state ) {
+        benchmark::DoNotOptimize(registry.getBehaviours(card));
+    }
+}
+BENCHMARK_CAPTURE(BM_BehaviourRegistryGetBehaviours, Copper, shared::cardHandle("Copper"));
+BENCHMARK_CAPTURE(BM_BehaviourRegistryGetBehaviours, Village, shared::cardHandle("Village"));
+BENCHMARK_CAPTURE(BM_BehaviourRegistryGetBehaviours, Militia, shared::cardHandle("Militia"));
+BENCHMARK_CAPTURE(BM_BehaviourRegistryGetBehaviours, Remodel, shared::cardHandle("Remodel"));
+
+/**
+ * @brief Plays a card without interaction, like the treasures that are played at the start of the buy phase.
+ */
+static void BM_BehaviourChainPlayCard(benchmark::State &state, shared::CardBase::handle_t card)
+{
+    server::GameState game_state({"Village", "Smithy", "Festival", "Market", "Laboratory", "Council_Room", "Militia",
+                                  "Gardens", "Moat", "Cellar"},
+                                 {"player_0", "player_1"});
+    server::BehaviourChain chain;
+
+    for ( auto _ : state ) {
+        chain.loadBehaviours(card);
+        benchmark::DoNotOptimize(chain.startChain(game_state));
+    }
+}
+BENCHMARK_CAPTURE(BM_BehaviourChainPlayCard, Copper, shared::cardHandle("Copper"));
+BENCHMARK_CAPTURE(BM_BehaviourChainPlayCard, Festival, shared::cardHandle("Festival"));
+BENCHMARK_CAPTURE(BM_BehaviourChainPlayCard, Market, shared::cardHandle("Market"));
@@ -0,0 +1,66 @@
+#include <benchmark/benchmark.h>
+
+#include <server/game/game_state.h>
+#include <shared/utils/json.h>
+
+namespace
+{
+    // fixed kingdom, so the numbers do not depend on random card choices
+    const std::vector<shared::CardBase::id_t> KINGDOM = {"Village",      "Smithy",  "Festival", "Market", "Laboratory",
+                                                          "Council_Room", "Militia", "Gardens",  "Moat",   "Cellar"};
+
+    std::vector<server::Player::id_t> makePlayerIds(size_t n)
+    {
+        std::vector<server::Player::id_t> player_ids;
+        for ( size_t i = 0; i < n; ++i ) {
+            player_ids.push_back("player_" + std::to_string(i));
+        }
+        return player_ids;
+    }
+} // namespace
+
+/**
+ * @brief Builds the reduced game state of one player, this is done for every player after every decision.
+ */
+static void BM_GameStateGetReducedState(benchmark::State &state)
+{
+    const auto player_ids = makePlayerIds(state.range(0));
+    server::GameState game_state(KINGDOM, player_ids);
+
+    for ( auto _ : state ) {
+        benchmark::DoNotOptimize(game_state.getReducedState(player_ids.front()));
+    }
+}
+BENCHMARK(BM_GameStateGetReducedState)->DenseRange(2, 4);
+
+static void BM_ReducedGameStateToJson(benchmark::State &state)
+{
+    const auto player_ids = makePlayerIds(state.range(0));
+    server::GameState game_state(KINGDOM, player_ids);
+    const auto reduced_state = game_state.getReducedState(player_ids.front());
+
+    for ( auto _ : state ) {
+        benchmark::DoNotOptimize(reduced_state->toJson());
+    }
+}
+BENCHMARK(BM_ReducedGameStateToJson)->DenseRange(2, 4);
+
+/**
+ * @brief The state streamed into a string, which is what ends up on the wire.
+ */
+static void BM_ReducedGameStateToJsonString(benchmark::State &state)
+{
+    const auto player_ids = makePlayerIds(state.range(0));
+    server::GameState game_state(KINGDOM, player_ids);
+    const auto reduced_state = game_state.getReducedState(player_ids.front());
+
+    size_t bytes = 0;
+    for ( auto _ : state ) {
+        const auto json = shared::writeJson([&reduced_state](shared::JsonWriter &writer)
+                                            { reduced_state->writeJson(writer); });
+        benchmark::DoNotOptimize(json.data());
+        bytes = json.size();
+    }
+    state.counters["bytes"] = static_cast<double>(bytes);
+}
+BENCHMARK(BM_ReducedGameStateToJsonString)->DenseRange(2, 4);
@@ -0,0 +1,99 @@
+#include <benchmark/benchmark.h>
+
+#include <server/game/server_player.h>
+
+using shared::CardAccess;
+
+namespace
+{
+    server::Player::pile_t makePile(size_t size, shared::CardBase::handle_t card)
+    {
+        return server::Player::pile_t(size, card);
+    }
+} // namespace
+
+/**
+ * @brief endTurn discards the hand and draws 5 cards. With a deck of 5 cards every draw reshuffles, with 10 cards every
+ * second one does.
+ */
+static void BM_PlayerDrawWithReshuffle(benchmark::State &state)
+{
+    server::Player player("player");
+    player.add<CardAccess::DISCARD_PILE>(makePile(state.range(0), shared::cardHandle("Copper")));
+
+    for ( auto _ : state ) {
+        player.endTurn();
+        benchmark::DoNotOptimize(player.get<CardAccess::HAND>().data());
+    }
+    state.SetItemsProcessed(state.iterations() * 5);
+}
+BENCHMARK(BM_PlayerDrawWithReshuffle)->Arg(5)->Arg(10)->Arg(30);
+
+/**
+ * @brief Takes a card from the back of a hand of the given size by its id, like a decision from a client does, and
+ * puts it back.
+ */
+static void BM_PlayerTakeFromHandById(benchmark::State &state)
+{
+    server::Player player("player");
+    player.add<CardAccess::HAND>(makePile(state.range(0) - 1, shared::cardHandle("Copper")));
+    player.add<CardAccess::HAND>(shared::cardHandle("Village"));
+
+    const shared::CardBase::id_t card_id = "Village";
+    for ( auto _ : state ) {
+        const auto card = player.take<CardAccess::HAND>(shared::CardFactory::getHandle(card_id));
+        player.add<CardAccess::HAND>(card);
+    }
+}
+BENCHMARK(BM_PlayerTakeFromHandById)->Arg(5)->Arg(20)->Arg(100);
+
+/**
+ * @brief Puts a card on top of a draw pile of the given size and draws it again, like Artisan or Sentry do.
+ */
+static void BM_PlayerTopDeck(benchmark::State &state)
+{
+    server::Player player("player");
+    player.add<CardAccess::DRAW_PILE_TOP>(makePile(state.range(0), shared::cardHandle("Copper")));
+
+    for ( auto _ : state ) {
+        player.add<CardAccess::DRAW_PILE_TOP>(shared::cardHandle("Gold"));
+        player.draw(1);
+        player.move<CardAccess::HAND, CardAccess::DISCARD_PILE>(shared::cardHandle("Gold"));
+    }
+}
+BENCHMARK(BM_PlayerTopDeck)->Arg(10)->Arg(100)->Arg(1000);
+
+/**
+ * @brief Trashes four cards from a hand of the given size, like Chapel does, and puts them back.
+ */
+static void BM_PlayerTrashFromHand(benchmark::State &state)
+{
+    server::Player player("player");
+    player.add<CardAccess::HAND>(makePile(state.range(0) - 4, shared::cardHandle("Copper")));
+    const server::Player::pile_t trashed(4, shared::cardHandle("Estate"));
+    player.add<CardAccess::HAND>(trashed);
+
+    for ( auto _ : state ) {
+        player.move<CardAccess::HAND, CardAccess::TRASH>(trashed);
+        player.add<CardAccess::HAND>(trashed);
+    }
+}
+BENCHMARK(BM_PlayerTrashFromHand)->Arg(5)->Arg(20)->Arg(100);
+
+/**
+ * @brief Victory points of a deck of the given size with every kind of victory card in it. The deck is counted per
+ * card, so the time should not depend on the size of the deck.
+ */
+static void BM_PlayerGetVictoryPoints(benchmark::State &state)
+{
+    server::Player player("player");
+    player.add<CardAccess::DRAW_PILE_TOP>(makePile(state.range(0) - 6, shared::cardHandle("Copper")));
+    player.add<CardAccess::DISCARD_PILE>(server::Player::pile_t{
+            shared::cardHandle("Estate"), shared::cardHandle("Duchy"), shared::cardHandle("Province"),
+            shared::cardHandle("Gardens"), shared::cardHandle("Duke"), shared::cardHandle("Silk_Road")});
+
+    for ( auto _ : state ) {
+        benchmark::DoNotOptimize(player.getVictoryPoints());
+    }
+}
+BENCHMARK(BM_PlayerGetVictoryPoints)->Arg(20)->Arg(100)->Arg(500);
@@ -0,0 +1,63 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <vector>
+
+#include <shared/message_types.h>
+#include <shared/utils/json.h>
+
+namespace
+{
+    std::string makeJson(std::unique_ptr<shared::ActionDecision> decision)
+    {
+        return shared::ActionDecisionMessage("game_id", "player_id", std::move(decision), "in_response_to",
+                                             "message_id")
+                .toJson();
+    }
+
+    std::string deckChoiceJson()
+    {
+        return makeJson(std::make_unique<shared::DeckChoiceDecision>(
+                std::vector<shared::CardBase::id_t>{"Copper", "Copper", "Estate", "Estate"},
+                std::vector<shared::ChooseFromOrder::AllowedChoice>(4, shared::ChooseFromOrder::AllowedChoice::TRASH)));
+    }
+} // namespace
+
+/**
+ * @brief Parses a message as it arrives from a client.
+ */
+static void BM_ClientToServerMessageFromJson(benchmark::State &state, const std::string &json)
+{
+    for ( auto _ : state ) {
+        benchmark::DoNotOptimize(shared::ClientToServerMessage::fromJson(json));
+    }
+    state.SetBytesProcessed(state.iterations() * json.size());
+}
+BENCHMARK_CAPTURE(BM_ClientToServerMessageFromJson, PlayActionCard,
+                  makeJson(std::make_unique<shared::PlayActionCardDecision>("Village")));
+BENCHMARK_CAPTURE(BM_ClientToServerMessageFromJson, BuyCard, makeJson(std::make_unique<shared::BuyCardDecision>("Gold")));
+BENCHMARK_CAPTURE(BM_ClientToServerMessageFromJson, DeckChoice, deckChoiceJson());
+BENCHMARK_CAPTURE(BM_ClientToServerMessageFromJson, JoinLobby,
+                  shared::JoinLobbyRequestMessage("game_id", "player_id", "message_id").toJson());
+
+/**
+ * @brief Parses a message the way the server does, in place in the read buffer of the connection.
+ * The copy stands in for the socket read that refills the buffer.
+ */
+static void BM_ClientToServerMessageFromJsonInSitu(benchmark::State &state, const std::string &json)
+{
+    shared::InSituJsonParser parser;
+    std::vector<char> buffer(json.size() + 1, '\0');
+    for ( auto _ : state ) {
+        std::copy(json.begin(), json.end(), buffer.begin());
+        benchmark::DoNotOptimize(shared::ClientToServerMessage::fromJsonInSitu(buffer.data(), parser));
+    }
+    state.SetBytesProcessed(state.iterations() * json.size());
+}
+BENCHMARK_CAPTURE(BM_ClientToServerMessageFromJsonInSitu, PlayActionCard,
+                  makeJson(std::make_unique<shared::PlayActionCardDecision>("Village")));
+BENCHMARK_CAPTURE(BM_ClientToServerMessageFromJsonInSitu, BuyCard,
+                  makeJson(std::make_unique<shared::BuyCardDecision>("Gold")));
+BENCHMARK_CAPTURE(BM_ClientToServerMessageFromJsonInSitu, DeckChoice, deckChoiceJson());
+BENCHMARK_CAPTURE(BM_ClientToServerMessageFromJsonInSitu, JoinLobby,
+                  shared::JoinLobbyRequestMessage("game_id", "player_id", "message_id").toJson());
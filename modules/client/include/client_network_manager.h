@@ -2,6 +2,7 @@
 
 #include <cstdint>
 #include <string>
+#include <string_view>
 #include "client_listener.h"
 #include "shared/message_types.h"
 #include "sockpp/tcp_connector.h"
@@ -14,7 +15,7 @@ public:
 
     static void sendRequest(std::unique_ptr<shared::ClientToServerMessage> req);
 
-    static void receiveMessage(const std::string &message);
+    static void receiveMessage(std::string_view message);
 
     static void shutdown();
 
@@ -29,4 +30,7 @@ private:
 
     static bool _connection_success;
     static bool _failed_to_connect;
+
+    // format of our requests, the server answers in the same one
+    static shared::WireFormat _wire_format;
 };
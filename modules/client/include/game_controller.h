@@ -99,6 +99,7 @@ namespace client
         void receiveJoinLobbyBroadcastMessage(std::unique_ptr<shared::JoinLobbyBroadcastMessage> msg);
         void receiveResultResponseMessage(std::unique_ptr<shared::ResultResponseMessage> msg);
         void receiveGameStateMessage(std::unique_ptr<shared::GameStateMessage> msg);
+        void receiveGameStateDeltaMessage(std::unique_ptr<shared::GameStateDeltaMessage> msg);
         void receiveStartGameBroadcastMessage(std::unique_ptr<shared::StartGameBroadcastMessage> msg);
         void receiveEndGameBroadcastMessage(std::unique_ptr<shared::EndGameBroadcastMessage> msg);
 
@@ -111,6 +112,11 @@ namespace client
 
         bool isLobbyValid();
 
+        /**
+         * @brief Asks the server for the full game state, used when a delta does not fit our state.
+         */
+        void requestGameState();
+
         std::unique_ptr<GuiEventReceiver> _guiEventReceiver;
 
         ClientNetworkManager *_clientNetworkManager;
@@ -124,6 +130,11 @@ namespace client
         // this bool ensures correct behaviour for the militia card.
         // blocking game state updates until the player has chosen the cards to discard
         bool _isChoosingCards;
+
+        // the last full or delta updated game state, deltas are applied to it
+        std::unique_ptr<reduced::GameState> _gameState;
+        unsigned int _gameStateVersion;
+        bool _awaitingGameState;
     };
 
 } // namespace client
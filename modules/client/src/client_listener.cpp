@@ -2,6 +2,7 @@
 #include <cerrno>
 #include <cstddef>
 #include <dominion.h>
+#include <shared/utils/frame_decoder.h>
 #include <shared/utils/logger.h>
 #include <unistd.h>
 #include "client_network_manager.h"
@@ -19,48 +20,27 @@ void ClientListener::shutdown() { this->_isActive = false; }
 wxThread::ExitCode ClientListener::Entry()
 {
     try {
-        char buffer[512]; // 512 bytes
-        std::string leftover; // To store incomplete messages across reads
+        constexpr size_t READ_SIZE = 512;
+        // keeps incomplete messages across reads
+        shared::FrameDecoder decoder;
         sockpp::result<size_t> result;
 
         this->_connection->set_non_blocking();
 
         while ( this->isActive() ) {
             try {
-                result = this->_connection->read(buffer, sizeof(buffer));
+                result = this->_connection->read(decoder.prepare(READ_SIZE), READ_SIZE);
                 // if you get a message, read it
                 if ( result.is_ok() ) {
-                    // Append new data to leftover string
-                    leftover.append(buffer, result.value());
+                    decoder.commit(result.value());
 
-                    while ( !leftover.empty() ) {
-
-                        size_t colonPos = leftover.find(':');
-                        if ( colonPos == std::string::npos ) {
-                            // Wait for more data if ':' is not yet available
-                            break;
-                        }
-
-                        try {
-                            ssize_t messageLength = std::stoi(leftover.substr(0, colonPos));
-                            size_t totalMessageSize = colonPos + 1 + messageLength;
-
-                            // Check if the full message is available
-                            if ( leftover.size() < totalMessageSize ) {
-                                // Wait for more data
-                                break;
-                            }
-
-                            std::string message = leftover.substr(colonPos + 1, messageLength);
-                            leftover = leftover.substr(totalMessageSize);
-
-                            ClientNetworkManager::receiveMessage(message);
-
-                        } catch ( const std::exception &e ) {
-                            LOG(ERROR) << "Network error. Error while reading message: " << e.what();
-                            leftover.clear(); // Reset leftover to avoid infinite errors
-                            break;
+                    try {
+                        while ( auto message = decoder.next() ) {
+                            ClientNetworkManager::receiveMessage(*message);
                         }
+                    } catch ( const exception::MalformedFrame &e ) {
+                        LOG(ERROR) << "Network error. Error while reading message: " << e.what();
+                        decoder.reset(); // Drop the buffered data to avoid infinite errors
                     }
                 } else if ( result.error().value() != EWOULDBLOCK ) {
                     // Connection Error
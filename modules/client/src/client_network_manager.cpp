@@ -4,11 +4,13 @@
 #include <client_listener.h>
 #include <game_controller.h>
 
+#include <sstream>
+
 #include <shared/message_types.h>
 
+#include <shared/utils/frame_decoder.h>
 #include <shared/utils/logger.h>
 #include <sockpp/tcp_connector.h>
-#include <sstream>
 
 // initialize static members
 sockpp::tcp_connector *ClientNetworkManager::_connection = nullptr;
@@ -17,6 +19,9 @@ ClientListener *ClientNetworkManager::_listener = nullptr;
 bool ClientNetworkManager::_connection_success = false;
 bool ClientNetworkManager::_failed_to_connect = false;
 
+// the server answers in the format of our first request, JSON is only kept for older servers and debugging
+shared::WireFormat ClientNetworkManager::_wire_format = shared::WireFormat::BINARY;
+
 
 void ::ClientNetworkManager::init(const std::string &host, const uint16_t port)
 {
@@ -107,16 +112,12 @@ void ClientNetworkManager::sendRequest(std::unique_ptr<shared::ClientToServerMes
     if ( ClientNetworkManager::_connection_success && ClientNetworkManager::_connection->is_open() ) {
         LOG(INFO) << "Connected to server";
 
-        // convert message to json
-        std::string message = req->toJson();
-
-        // turn message into stream and prepend message length
-        std::stringstream messageStream;
-        messageStream << std::to_string(message.size()) << ':' << message;
-        std::string msg = messageStream.str();
+        // encode the message and prepend message length
+        const std::string payload = req->encode(ClientNetworkManager::_wire_format);
+        std::string msg = shared::encodeFrame(payload);
 
         // output message for debugging purposes
-        LOG(INFO) << "Sending request : " << msg;
+        LOG(INFO) << "Sending request : " << shared::loggable(payload);
         // send message to server
         sockpp::result<size_t> result = ClientNetworkManager::_connection->write(msg);
 
@@ -139,16 +140,18 @@ void ClientNetworkManager::sendRequest(std::unique_ptr<shared::ClientToServerMes
 }
 
 
-void ClientNetworkManager::receiveMessage(const std::string &message)
+void ClientNetworkManager::receiveMessage(std::string_view message)
 {
     try {
-        std::unique_ptr<shared::ServerToClientMessage> res = shared::ServerToClientMessage::fromJson(message);
-        LOG(INFO) << "Received Message: " << message;
+        std::unique_ptr<shared::ServerToClientMessage> res = shared::ServerToClientMessage::decode(message);
+        LOG(INFO) << "Received Message: " << shared::loggable(message);
         wxGetApp().getController().receiveMessage(std::move(res));
     } catch ( std::exception &e ) {
         LOG(ERROR) << "Exception in ClientNetworkManager::receive_message: " << e.what();
-        wxGetApp().getController().showError("JSON parsing error",
-                                             "Failed to parse message from server:\n" + message + "\n" +
+        std::ostringstream content;
+        content << shared::loggable(message);
+        wxGetApp().getController().showError("Parsing error",
+                                             "Failed to parse message from server:\n" + content.str() + "\n" +
                                                      (std::string)e.what());
     }
 }
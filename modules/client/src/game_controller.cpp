@@ -6,6 +6,7 @@
 #include <shared/game/cards/card_base.h>
 #include <shared/game/game_state/player_base.h>
 #include <shared/message_types.h>
+#include <shared/utils/exception.h>
 #include <shared/utils/logger.h>
 #include <vector>
 #include "shared/action_decision.h"
@@ -57,7 +58,8 @@ namespace client
     }
 
     GameController::GameController(GuiEventReceiver *event_receiver) :
-        _guiEventReceiver(event_receiver), _clientState(ClientState::LOGIN_SCREEN), _isChoosingCards(false)
+        _guiEventReceiver(event_receiver), _clientState(ClientState::LOGIN_SCREEN), _isChoosingCards(false),
+        _gameStateVersion(0), _awaitingGameState(false)
     {}
 
     void GameController::createLobby()
@@ -396,6 +398,10 @@ namespace client
 
     void GameController::receiveGameStateMessage(std::unique_ptr<shared::GameStateMessage> msg)
     {
+        _gameState = msg->game_state->clone();
+        _gameStateVersion = msg->version;
+        _awaitingGameState = false;
+
         // TODO(#125): Unfortunately, this is currently still used to update
         // the game state of the players that are not the active player.
         // In the future combining all ActionOrderMessages and this should be the goal
@@ -406,6 +412,43 @@ namespace client
         showGameScreen(std::move(msg->game_state));
     }
 
+    void GameController::receiveGameStateDeltaMessage(std::unique_ptr<shared::GameStateDeltaMessage> msg)
+    {
+        if ( _gameState == nullptr || msg->base_version != _gameStateVersion ) {
+            LOG(WARN) << "Received game state delta for version " << msg->base_version << ", but have version "
+                      << _gameStateVersion;
+            requestGameState();
+            return;
+        }
+
+        try {
+            msg->delta->applyTo(*_gameState);
+        } catch ( const exception::DeltaMismatch &e ) {
+            LOG(WARN) << "Failed to apply game state delta: " << e.what();
+            requestGameState();
+            return;
+        }
+        _gameStateVersion = msg->version;
+
+        // the state is kept up to date while choosing cards, only the screen is not
+        if ( _isChoosingCards ) {
+            LOG(INFO) << "Received GameStateDeltaMessage while choosing cards, not showing it";
+            return;
+        }
+        showGameScreen(_gameState->clone());
+    }
+
+    void GameController::requestGameState()
+    {
+        // the state is unusable until the full state arrives
+        _gameState.reset();
+        if ( _awaitingGameState ) {
+            return;
+        }
+        _awaitingGameState = true;
+        sendRequest(std::make_unique<shared::GameStateRequestMessage>(_gameName, _playerName));
+    }
+
     void GameController::receiveStartGameBroadcastMessage(std::unique_ptr<shared::StartGameBroadcastMessage> /*msg*/)
     {
         LOG(DEBUG) << "Game starting soon (StartGameBroadcastMessage)";
@@ -418,7 +461,7 @@ namespace client
             LOG(WARN) << "Received unexpected EndGameBroadcastMessage while not in game";
             return;
         }
-        LOG(DEBUG) << "Game ended (EndGameBroadcastMessage)";
+        LOG(DEBUG) << "Game ended (EndGameBroadcastMessage), seed " << msg->seed;
         showVictoryScreen(std::move(msg->results));
         _clientState = ClientState::VICTORY_SCREEN;
     }
@@ -427,21 +470,25 @@ namespace client
     {
 // NOLINTBEGIN(bugprone-macro-parentheses)
 #define HANDLE_MESSAGE(type)                                                                                           \
-    if ( typeid(msgRef) == typeid(type) ) {                                                                            \
-        LOG(INFO) << "Received message of type " << #type;                                                             \
-        std::unique_ptr<type> casted(static_cast<type *>(msg.release()));                                              \
-        receive##type(std::move(casted));                                                                              \
-        return;                                                                                                        \
-    }
+    case type::TAG:                                                                                                    \
+        {                                                                                                              \
+            LOG(INFO) << "Received message of type " << #type;                                                         \
+            receive##type(shared::tagCast<type>(msg));                                                                 \
+            return;                                                                                                    \
+        }
         // NOLINTEND(bugprone-macro-parentheses)
-        ServerToClientMessage &msgRef = *msg;
-        HANDLE_MESSAGE(ActionOrderMessage);
-        HANDLE_MESSAGE(CreateLobbyResponseMessage);
-        HANDLE_MESSAGE(JoinLobbyBroadcastMessage);
-        HANDLE_MESSAGE(ResultResponseMessage);
-        HANDLE_MESSAGE(GameStateMessage);
-        HANDLE_MESSAGE(StartGameBroadcastMessage);
-        HANDLE_MESSAGE(EndGameBroadcastMessage);
+        switch ( msg->getTag() ) {
+            HANDLE_MESSAGE(ActionOrderMessage);
+            HANDLE_MESSAGE(CreateLobbyResponseMessage);
+            HANDLE_MESSAGE(JoinLobbyBroadcastMessage);
+            HANDLE_MESSAGE(ResultResponseMessage);
+            HANDLE_MESSAGE(GameStateMessage);
+            HANDLE_MESSAGE(GameStateDeltaMessage);
+            HANDLE_MESSAGE(StartGameBroadcastMessage);
+            HANDLE_MESSAGE(EndGameBroadcastMessage);
+            default:
+                break;
+        }
 #undef HANDLE_MESSAGE
 
         LOG(ERROR) << "Unknown message type";
@@ -33,6 +33,10 @@ namespace client
                 if ( !wxGetApp().isDebugMode() && card.first == "God_Mode" ) {
                     continue;
                 }
+                // the server refuses cards we can not play yet
+                if ( !shared::CardFactory::isSelectable(card.first) ) {
+                    continue;
+                }
                 selectedCards[card.first] = false;
             }
         }
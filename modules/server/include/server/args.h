@@ -1,4 +1,7 @@
 
+#include <utility>
+#include <vector>
+
 #include <shared/utils/logger.h>
 
 namespace server
@@ -10,13 +13,22 @@ namespace server
         ~ServerArgs() = default;
         std::string getLogFile();
         LogLevel getLogLevel();
+        /**
+         * @brief Levels that override the log level for single modules, applied in order.
+         */
+        std::vector<std::pair<shared::LogModule, LogLevel>> getModuleLogLevels();
         uint16_t getPort();
+        size_t getIoThreads();
+        size_t getGameThreads();
         bool isDebug();
 
     private:
         std::string _logFile;
         LogLevel _logLevel;
+        std::vector<std::pair<shared::LogModule, LogLevel>> _module_log_levels;
         uint16_t _port;
+        size_t _io_threads;
+        size_t _game_threads;
         bool _debug;
     };
 } // namespace server
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+
+namespace server
+{
+    /**
+     * @brief Stack-like memory of a single game, the coroutine frames of its behaviours are placed here.
+     *
+     * Behaviours of a game never run concurrently and nested ones finish before the behaviour that started them, so
+     * memory is handed out and given back in LIFO order. Allocations that do not fit fall back to the heap.
+     */
+    class BehaviourArena
+    {
+    public:
+        static constexpr size_t CAPACITY = 4096;
+        static constexpr size_t ALIGNMENT = alignof(std::max_align_t);
+
+        BehaviourArena() = default;
+        BehaviourArena(const BehaviourArena &) = delete;
+        BehaviourArena &operator=(const BehaviourArena &) = delete;
+
+        void *allocate(size_t size);
+        void deallocate(void *ptr, size_t size) noexcept;
+
+        /**
+         * @brief Number of bytes currently handed out from the arena, heap fallbacks are not counted.
+         */
+        size_t used() const { return top; }
+
+    private:
+        // allocated on first use, most games never play a card that needs it
+        std::unique_ptr<std::byte[]> buffer;
+        size_t top = 0;
+        size_t live = 0;
+
+        bool owns(const void *ptr) const
+        {
+            return buffer != nullptr && ptr >= buffer.get() && ptr < buffer.get() + CAPACITY;
+        }
+    };
+} // namespace server
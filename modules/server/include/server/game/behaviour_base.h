@@ -8,6 +8,17 @@ namespace server
 {
     namespace base
     {
+        /**
+         * @brief Marks behaviours that take effect in a single step and never need a decision. They have no state,
+         * so they are plain functions shared by all games instead of objects:
+         * `static void apply(GameState &game_state, GameState::seat_t requestor)`
+         */
+        struct Effect
+        {};
+
+        /**
+         * @brief A behaviour that may need decisions of one or more players, it keeps its state between the steps.
+         */
         class Behaviour
         {
         protected:
@@ -21,10 +32,13 @@ namespace server
             using ret_t = OrderResponse;
             using action_decision_t = std::optional<std::unique_ptr<shared::ActionDecision>>;
 
+            // behaviours are constructed in place into a buffer of this size, see BehaviourChain
+            static constexpr size_t MAX_SIZE = 128;
+
             Behaviour() : finished_behaviour(false) {}
             virtual ~Behaviour() = default;
 
-            virtual ret_t apply(server::GameState &state, const shared::PlayerBase::id_t &player_id,
+            virtual ret_t apply(server::GameState &state, server::GameState::seat_t requestor,
                                 action_decision_t action_decision = std::nullopt) = 0;
 
             /**
@@ -1,7 +1,11 @@
 #pragma once
 
+#include <array>
+#include <cstddef>
+#include <optional>
+#include <span>
+
 #include <server/game/behaviour_registry.h>
-#include <vector>
 
 namespace server
 {
@@ -10,22 +14,32 @@ namespace server
      * class, which are then stored. Should a card contain multistep behaviours (cards that require interaction from one
      * or more users to continue) we can easily stop and continue where we left off. The class only does basic
      * error-handling, the more detailed handling will be done by the behaviours themselves.
+     *
+     * Effects are applied right away. Only one behaviour with state is alive at a time, it is constructed into the
+     * storage of the chain, so playing a card never allocates.
      */
     class BehaviourChain
     {
-        std::string current_card;
+        std::optional<shared::CardBase::handle_t> current_card;
         size_t behaviour_idx;
-        std::unique_ptr<BehaviourRegistry> behaviour_registry;
+        BehaviourRegistry behaviour_registry;
+
+        std::span<const BehaviourStep> behaviour_list;
 
-        std::vector<std::unique_ptr<base::Behaviour>> behaviour_list;
+        // the behaviour in progress lives in behaviour_storage
+        base::Behaviour *active_behaviour = nullptr;
+        alignas(std::max_align_t) std::array<std::byte, base::Behaviour::MAX_SIZE> behaviour_storage;
 
     public:
         using ret_t = server::base::Behaviour::ret_t;
 
         BehaviourChain();
-        ~BehaviourChain() = default;
+        ~BehaviourChain();
+
+        BehaviourChain(const BehaviourChain &) = delete;
+        BehaviourChain &operator=(const BehaviourChain &) = delete;
 
-        void loadBehaviours(const std::string &card_id);
+        void loadBehaviours(shared::CardBase::handle_t card);
 
         /**
          * @brief This is called the first time we execute a behaviour.
@@ -38,8 +52,10 @@ namespace server
          */
         ret_t continueChain(server::GameState &game_state, const shared::PlayerBase::id_t &player_id,
                             std::unique_ptr<shared::ActionDecision> &action_decision);
+        ret_t continueChain(server::GameState &game_state, server::GameState::seat_t requestor,
+                            std::unique_ptr<shared::ActionDecision> &action_decision);
 
-        inline bool empty() const { return (behaviour_idx == 0) && current_card.empty() && behaviour_list.empty(); }
+        inline bool empty() const { return (behaviour_idx == 0) && !current_card.has_value() && behaviour_list.empty(); }
 
     private:
         inline void resetBehaviours();
@@ -47,7 +63,22 @@ namespace server
         inline void advance() { ++behaviour_idx; }
         inline bool hasNext() const { return behaviour_idx < behaviour_list.size(); }
 
-        base::Behaviour &currentBehaviour() { return *behaviour_list[behaviour_idx]; }
+        /**
+         * @brief Constructs the behaviour at the current index.
+         */
+        base::Behaviour &startBehaviour();
+
+        /**
+         * @brief Destroys the behaviour in progress, if there is one.
+         */
+        void finishBehaviour();
+
+        /**
+         * @brief Applies the behaviour in progress. If it throws and can not be continued, the chain is emptied, so
+         * the turn can go on.
+         */
+        ret_t applyBehaviour(server::GameState &game_state, server::GameState::seat_t requestor,
+                             base::Behaviour::action_decision_t action_decision);
 
         /**
          * @warning Does not check (explicitly) if a behaviour is loaded, this happens in startChain and continueChain
@@ -1,24 +1,96 @@
 #pragma once
 
-#include <functional>
+#include <cstddef>
 #include <memory>
+#include <mutex>
+#include <new>
+#include <span>
 #include <stdexcept>
 #include <string>
-#include <typeindex>
-#include <unordered_map>
+#include <tuple>
+#include <type_traits>
 #include <vector>
 
 #include <server/game/behaviour_base.h>
 #include <server/game/victory_card_behaviours.h>
-#include <shared/game/cards/card_base.h>
+#include <shared/game/cards/card_factory.h>
 #include <shared/utils/utils.h>
 
 namespace server
 {
+    /**
+     * @brief One behaviour of a card, as stored in the registry. Exactly one of the members is set.
+     */
+    struct BehaviourStep
+    {
+        using effect_t = void (*)(GameState &game_state, GameState::seat_t requestor);
+        using construct_t = base::Behaviour *(*)(void *storage);
+
+        // applies a base::Effect
+        effect_t effect = nullptr;
+        // constructs a fresh base::Behaviour into storage of base::Behaviour::MAX_SIZE bytes
+        construct_t construct = nullptr;
+
+        template <typename BehaviourType>
+        static constexpr BehaviourStep make();
+    };
+
+    /**
+     * @brief Applies consecutive effects of a card in one call. The compiler inlines all of them into apply, so a card
+     * like Festival or Market is a single function without any indirect calls.
+     */
+    template <typename... Effects>
+    struct FusedEffect : base::Effect
+    {
+        static_assert((std::is_base_of_v<base::Effect, Effects> && ...));
+
+        static inline void apply(GameState &game_state, GameState::seat_t requestor)
+        {
+            (Effects::apply(game_state, requestor), ...);
+        }
+    };
+
+    namespace detail
+    {
+        /**
+         * @brief Walks the behaviours of a card at compile time. Pending collects the effects since the last
+         * interactive behaviour, they are emitted as one FusedEffect.
+         */
+        template <typename Pending, typename... Rest>
+        struct FuseBehaviours;
+
+        template <typename... Pending>
+        struct FuseBehaviours<std::tuple<Pending...>>
+        {
+            static void into(std::vector<BehaviourStep> &steps)
+            {
+                if constexpr ( sizeof...(Pending) > 0 ) {
+                    steps.push_back(BehaviourStep::make<FusedEffect<Pending...>>());
+                }
+            }
+        };
+
+        template <typename... Pending, typename Next, typename... Rest>
+        struct FuseBehaviours<std::tuple<Pending...>, Next, Rest...>
+        {
+            static void into(std::vector<BehaviourStep> &steps)
+            {
+                if constexpr ( std::is_base_of_v<base::Effect, Next> ) {
+                    FuseBehaviours<std::tuple<Pending..., Next>, Rest...>::into(steps);
+                } else {
+                    FuseBehaviours<std::tuple<Pending...>>::into(steps);
+                    steps.push_back(BehaviourStep::make<Next>());
+                    FuseBehaviours<std::tuple<>, Rest...>::into(steps);
+                }
+            }
+        };
+    } // namespace detail
+
     /**
      * @brief Behaviours are registered in this class. The Behaviour chain can request behaviours from the
-     * BehaviourRegistry. As some of the behaviours we have require to keep some state, we create a new behaviour list
-     * for each call. This way we can ensure that we always have fresh behaviours and it also helps with modularity.
+     * BehaviourRegistry. Effects have no state and are shared, consecutive effects of a card are fused into a single
+     * step. Behaviours that keep state between steps are created anew by the chain for every card played. Nothing is
+     * allocated when a card is played.
      */
     class BehaviourRegistry
     {
@@ -30,12 +102,11 @@ namespace server
         BehaviourRegistry();
 
         /**
-         * @brief Generates a list of behaviours that are registered for the card_id. The list will be generated anew
-         * for each call to getBehaviours.
+         * @brief Returns the behaviours that are registered for the card, in the order they are applied.
          */
-        std::vector<std::unique_ptr<base::Behaviour>> getBehaviours(const std::string &card_id);
+        std::span<const BehaviourStep> getBehaviours(shared::CardBase::handle_t card) const;
 
-        VictoryCardBehaviour &getVictoryBehaviour(const shared::CardBase::id_t &card_id) const;
+        VictoryCardBehaviour &getVictoryBehaviour(shared::CardBase::handle_t card) const;
 
     private:
         /**
@@ -62,19 +133,31 @@ namespace server
 
         // TODO(#229): I guess this is a memory leak.
         // In order to fix this, we could make the behaviour registry a singleton.
-        static std::unordered_map<shared::CardBase::id_t, std::unique_ptr<VictoryCardBehaviour>> _victory_map;
-        static std::unordered_map<shared::CardBase::id_t,
-                                  std::function<std::vector<std::unique_ptr<base::Behaviour>>()>>
-                _map;
-        static bool _is_initialised;
+        // Both tables are indexed by card handle, empty entries belong to cards without behaviours.
+        static std::vector<std::unique_ptr<VictoryCardBehaviour>> _victory_map;
+        static std::vector<std::vector<BehaviourStep>> _map;
+        // games on different worker threads can construct their first registry at the same time
+        static std::once_flag _initialised;
     };
 
     // static member initialisation
-    inline std::unordered_map<shared::CardBase::id_t, std::unique_ptr<VictoryCardBehaviour>>
-            BehaviourRegistry::_victory_map;
-    inline std::unordered_map<std::string, std::function<std::vector<std::unique_ptr<base::Behaviour>>()>>
-            BehaviourRegistry::_map;
-    inline bool BehaviourRegistry::_is_initialised;
+    inline std::vector<std::unique_ptr<VictoryCardBehaviour>> BehaviourRegistry::_victory_map;
+    inline std::vector<std::vector<BehaviourStep>> BehaviourRegistry::_map;
+    inline std::once_flag BehaviourRegistry::_initialised;
+
+    template <typename BehaviourType>
+    constexpr BehaviourStep BehaviourStep::make()
+    {
+        if constexpr ( std::is_base_of_v<base::Effect, BehaviourType> ) {
+            return {&BehaviourType::apply, nullptr};
+        } else {
+            static_assert(std::is_base_of_v<base::Behaviour, BehaviourType>);
+            static_assert(sizeof(BehaviourType) <= base::Behaviour::MAX_SIZE &&
+                                  alignof(BehaviourType) <= alignof(std::max_align_t),
+                          "behaviour does not fit into the storage of the BehaviourChain");
+            return {nullptr, [](void *storage) -> base::Behaviour * { return new (storage) BehaviourType(); }};
+        }
+    }
 
     template <typename... BehaviourType>
     inline void BehaviourRegistry::insert(const shared::CardBase::id_t &card_id)
@@ -85,16 +168,18 @@ namespace server
     template <typename VictoryCardBehaviour, typename... BehaviourType>
     inline void BehaviourRegistry::insertVictory(const shared::CardBase::id_t &card_id)
     {
+        if ( !shared::CardFactory::has(card_id) ) {
+            LOG(INFO) << "Card: " << card_id << " is not registered in the CardFactory, skipping its behaviours";
+            return;
+        }
+
         LOG(INFO) << "Registering card: " << card_id;
-        ((LOG(INFO) << "  Behaviour type: " << utils::demangle(typeid(BehaviourType).name())), ...);
+        ((LOG(INFO) << "  Behaviour type: " << utils::typeName<BehaviourType>()), ...);
 
-        _victory_map[card_id] = std::make_unique<VictoryCardBehaviour>();
+        const auto index = shared::toIndex(shared::CardFactory::getHandle(card_id));
+        _victory_map[index] = std::make_unique<VictoryCardBehaviour>();
 
-        _map[card_id] = []()
-        {
-            std::vector<std::unique_ptr<base::Behaviour>> behaviours;
-            (behaviours.emplace_back(std::make_unique<BehaviourType>()), ...);
-            return behaviours;
-        };
+        _map[index].clear();
+        detail::FuseBehaviours<std::tuple<>, BehaviourType...>::into(_map[index]);
     }
 } // namespace server
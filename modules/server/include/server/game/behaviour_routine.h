@@ -0,0 +1,249 @@
+#pragma once
+
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <server/game/behaviour_base.h>
+
+namespace server
+{
+    class BehaviourChain;
+
+    namespace base
+    {
+        /**
+         * @brief Something a Routine waits for with co_await, usually the decision of a player.
+         *
+         * Decisions are checked by the awaiter before the routine is resumed. An invalid decision throws and leaves the
+         * routine waiting, so the player can simply try again, just like with a hand-written Behaviour.
+         */
+        class Awaiter
+        {
+        public:
+            static constexpr shared::CardType ANY_TYPE = static_cast<shared::CardType>(
+                    shared::CardType::ACTION | shared::CardType::ATTACK | shared::CardType::CURSE |
+                    shared::CardType::KINGDOM | shared::CardType::REACTION | shared::CardType::TREASURE |
+                    shared::CardType::VICTORY);
+            static constexpr shared::CardType NO_TYPE = static_cast<shared::CardType>(0);
+
+            virtual ~Awaiter() = default;
+
+            /**
+             * @brief Hands a decision to the awaiter while the routine waits on it.
+             * @throws if the decision is not valid, the routine keeps waiting in that case.
+             * @return true if the routine can continue.
+             */
+            virtual bool accept(GameState &game_state, GameState::seat_t requestor,
+                                std::unique_ptr<shared::ActionDecision> &decision) = 0;
+
+            /**
+             * @brief The orders that are sent out while the routine waits on this awaiter.
+             */
+            OrderResponse takeOrders() { return std::move(orders); }
+
+            bool await_ready() const noexcept { return false; }
+
+            template <typename Promise>
+            void await_suspend(std::coroutine_handle<Promise> handle) noexcept
+            {
+                handle.promise().awaiting = this;
+            }
+
+        protected:
+            OrderResponse orders;
+        };
+
+        /**
+         * @brief Asks a player to choose cards from their hand, the routine continues with the chosen cards.
+         *
+         * Every type of a chosen card has to be in allowed_type, and every type in required_type has to be a type of
+         * the chosen card. E.g. required_type ACTION accepts Great_Hall, allowed_type ACTION does not.
+         */
+        class ChooseFromHand : public Awaiter
+        {
+        public:
+            ChooseFromHand(const GameState &game_state, GameState::seat_t seat, unsigned int min_cards,
+                           unsigned int max_cards, shared::ChooseFromOrder::AllowedChoice choices,
+                           shared::CardType allowed_type = ANY_TYPE, shared::CardType required_type = NO_TYPE);
+
+            bool accept(GameState &game_state, GameState::seat_t requestor,
+                        std::unique_ptr<shared::ActionDecision> &decision) override;
+
+            std::vector<shared::CardBase::handle_t> await_resume() { return std::move(chosen); }
+
+        private:
+            GameState::seat_t seat;
+            unsigned int min_cards;
+            unsigned int max_cards;
+            shared::CardType allowed_type;
+            shared::CardType required_type;
+            std::vector<shared::CardBase::handle_t> chosen;
+        };
+
+        /**
+         * @brief Asks a player to choose from cards that are not in their hand, e.g. revealed from the draw pile. The
+         * routine continues with the chosen cards and what the player chose to do with each of them.
+         */
+        class ChooseFromStaged : public Awaiter
+        {
+        public:
+            using choice_t = std::pair<shared::CardBase::handle_t, shared::ChooseFromOrder::AllowedChoice>;
+
+            ChooseFromStaged(const GameState &game_state, GameState::seat_t seat, unsigned int min_cards,
+                             unsigned int max_cards, shared::ChooseFromOrder::AllowedChoice choices,
+                             const std::vector<shared::CardBase::handle_t> &cards);
+
+            bool accept(GameState &game_state, GameState::seat_t requestor,
+                        std::unique_ptr<shared::ActionDecision> &decision) override;
+
+            std::vector<choice_t> await_resume() { return std::move(chosen); }
+
+        private:
+            GameState::seat_t seat;
+            unsigned int min_cards;
+            unsigned int max_cards;
+            shared::ChooseFromOrder::AllowedChoice allowed_choices;
+            std::vector<shared::CardBase::handle_t> cards;
+            std::vector<choice_t> chosen;
+        };
+
+        /**
+         * @brief Asks a player to choose a card from the board, the routine continues with the chosen card. The card is
+         * guaranteed to be available, but not yet taken from the board.
+         */
+        class GainFromBoard : public Awaiter
+        {
+        public:
+            GainFromBoard(const GameState &game_state, GameState::seat_t seat, unsigned int max_cost,
+                          shared::CardType allowed_type = ANY_TYPE);
+
+            bool accept(GameState &game_state, GameState::seat_t requestor,
+                        std::unique_ptr<shared::ActionDecision> &decision) override;
+
+            shared::CardBase::handle_t await_resume() const { return chosen; }
+
+        private:
+            GameState::seat_t seat;
+            unsigned int max_cost;
+            shared::CardType allowed_type;
+            shared::CardBase::handle_t chosen{};
+        };
+
+        /**
+         * @brief Applies all behaviours of a card, e.g. for Throne Room. Decisions are passed on to a BehaviourChain
+         * that lives in the BehaviourArena of the game, the routine continues once the card is done. If the card is
+         * aborted, the error is rethrown inside the routine.
+         */
+        class PlayCard : public Awaiter
+        {
+        public:
+            PlayCard(GameState &game_state, shared::CardBase::handle_t card) : game_state(game_state), card(card) {}
+            ~PlayCard() override;
+
+            PlayCard(const PlayCard &) = delete;
+            PlayCard &operator=(const PlayCard &) = delete;
+
+            bool accept(GameState &game_state, GameState::seat_t requestor,
+                        std::unique_ptr<shared::ActionDecision> &decision) override;
+
+            bool await_ready();
+            void await_resume() const
+            {
+                if ( error != nullptr ) {
+                    std::rethrow_exception(error);
+                }
+            }
+
+        private:
+            GameState &game_state;
+            shared::CardBase::handle_t card;
+            BehaviourChain *chain = nullptr;
+            std::exception_ptr error;
+        };
+
+        /**
+         * @brief Return type of behaviours that are written as coroutines, see RoutineBehaviour.
+         *
+         * The coroutine frame is allocated from the BehaviourArena of the game, so the coroutine has to take
+         * `(GameState &, GameState::seat_t)` like RoutineBehaviour::run.
+         */
+        class Routine
+        {
+        public:
+            struct promise_type
+            {
+                // what the suspended routine waits for
+                Awaiter *awaiting = nullptr;
+                std::exception_ptr exception;
+
+                Routine get_return_object()
+                {
+                    return Routine(std::coroutine_handle<promise_type>::from_promise(*this));
+                }
+                std::suspend_always initial_suspend() const noexcept { return {}; }
+                std::suspend_always final_suspend() const noexcept { return {}; }
+                void return_void() const noexcept {}
+                void unhandled_exception() noexcept { exception = std::current_exception(); }
+
+                static void *operator new(size_t size, GameState &game_state, GameState::seat_t);
+                static void operator delete(void *frame, size_t size) noexcept;
+            };
+
+            Routine() = default;
+            Routine(Routine &&other) noexcept : handle(std::exchange(other.handle, nullptr)) {}
+            Routine &operator=(Routine &&other) noexcept;
+            ~Routine();
+
+            bool started() const { return handle != nullptr; }
+            bool done() const { return handle != nullptr && handle.done(); }
+
+            /**
+             * @brief Runs the routine until it waits for the next decision or returns. The first call starts the
+             * routine, later calls hand the decision to the awaiter the routine waits on.
+             */
+            Behaviour::ret_t apply(GameState &game_state, GameState::seat_t requestor,
+                                   Behaviour::action_decision_t action_decision);
+
+        private:
+            explicit Routine(std::coroutine_handle<promise_type> handle) : handle(handle) {}
+
+            Behaviour::ret_t resume();
+
+            std::coroutine_handle<promise_type> handle;
+        };
+
+        /**
+         * @brief A behaviour written as straight-line code that co_awaits the decisions of the players, instead of a
+         * state machine that is re-entered for every decision. Self provides
+         * `static Routine run(GameState &game_state, GameState::seat_t requestor)`.
+         */
+        template <typename Self>
+        class RoutineBehaviour : public Behaviour
+        {
+            Routine routine;
+
+        public:
+            ret_t apply(GameState &game_state, GameState::seat_t requestor,
+                        action_decision_t action_decision = std::nullopt) override
+            {
+                if ( !routine.started() ) {
+                    routine = Self::run(game_state, game_state.getCurrentSeat());
+                }
+
+                try {
+                    auto response = routine.apply(game_state, requestor, std::move(action_decision));
+                    finished_behaviour = routine.done();
+                    return response;
+                } catch ( ... ) {
+                    // a rejected decision leaves the routine waiting, but if the body threw it can not be resumed
+                    finished_behaviour = routine.done();
+                    throw;
+                }
+            }
+        };
+    } // namespace base
+} // namespace server
@@ -1,5 +1,8 @@
+#include <array>
+
 #include <server/game/behaviour_base.h>
 #include <server/game/behaviour_helper.hpp>
+#include <server/game/behaviour_routine.h>
 #include <shared/utils/utils.h>
 
 namespace server
@@ -12,11 +15,12 @@ namespace server
     class name : public server::base::Behaviour                                                                        \
     {                                                                                                                  \
     public:                                                                                                            \
-        inline ret_t apply(server::GameState &state, const shared::PlayerBase::id_t &requestor_id,                     \
+        using self_t = name;                                                                                           \
+        inline ret_t apply(server::GameState &state, server::GameState::seat_t requestor,                              \
                            server::base::Behaviour::action_decision_t action_decision = std::nullopt);                 \
     };                                                                                                                 \
     inline server::base::Behaviour::ret_t name::apply(server::GameState &game_state,                                   \
-                                                      const shared::PlayerBase::id_t &requestor_id,                    \
+                                                      server::GameState::seat_t requestor,                             \
                                                       server::base::Behaviour::action_decision_t action_decision)
 // NOLINTEND(bugprone-macro-parentheses)
 
@@ -27,21 +31,58 @@ namespace server
     class name : public server::base::Behaviour                                                                        \
     {                                                                                                                  \
     public:                                                                                                            \
-        inline ret_t apply(server::GameState &state, const shared::PlayerBase::id_t &requestor_id,                     \
+        using self_t = name;                                                                                           \
+        inline ret_t apply(server::GameState &state, server::GameState::seat_t requestor,                              \
                            server::base::Behaviour::action_decision_t action_decision = std::nullopt);                 \
     };                                                                                                                 \
     template <template_type template_name>                                                                             \
     inline server::base::Behaviour::ret_t name<template_name>::apply(                                                  \
-            server::GameState &game_state, const shared::PlayerBase::id_t &requestor_id,                               \
+            server::GameState &game_state, server::GameState::seat_t requestor,                                        \
             server::base::Behaviour::action_decision_t action_decision)
 // NOLINTEND(bugprone-macro-parentheses)
 
+// False positive of clang-tidy
+// NOLINTBEGIN(bugprone-macro-parentheses)
+#define DEFINE_EFFECT(name)                                                                                            \
+    struct name : server::base::Effect                                                                                 \
+    {                                                                                                                  \
+        using self_t = name;                                                                                           \
+        static inline void apply(server::GameState &game_state, server::GameState::seat_t requestor);                  \
+    };                                                                                                                 \
+    inline void name::apply(server::GameState &game_state, server::GameState::seat_t requestor)
+// NOLINTEND(bugprone-macro-parentheses)
+
+// False positive of clang-tidy
+// NOLINTBEGIN(bugprone-macro-parentheses)
+#define DEFINE_TEMPLATED_EFFECT(name, template_type, template_name)                                                    \
+    template <template_type template_name>                                                                             \
+    struct name : server::base::Effect                                                                                 \
+    {                                                                                                                  \
+        using self_t = name;                                                                                           \
+        static inline void apply(server::GameState &game_state, server::GameState::seat_t requestor);                  \
+    };                                                                                                                 \
+    template <template_type template_name>                                                                             \
+    inline void name<template_name>::apply(server::GameState &game_state, server::GameState::seat_t requestor)
+// NOLINTEND(bugprone-macro-parentheses)
+
+// False positive of clang-tidy
+// NOLINTBEGIN(bugprone-macro-parentheses)
+#define DEFINE_ROUTINE(name)                                                                                           \
+    struct name : server::base::RoutineBehaviour<name>                                                                 \
+    {                                                                                                                  \
+        using self_t = name;                                                                                           \
+        static inline server::base::Routine run(server::GameState &game_state, server::GameState::seat_t requestor);   \
+    };                                                                                                                 \
+    inline server::base::Routine name::run(server::GameState &game_state, server::GameState::seat_t requestor)
+// NOLINTEND(bugprone-macro-parentheses)
+
 // ================================
 // HELPER MACROS
 // ================================
 
 // call this at the top of your behaviour to log the call.
-#define LOG_CALL LOG(INFO) << "Applying " << CLASS_NAME << " to player " << requestor_id
+#define LOG_CALL                                                                                                       \
+    LOG(INFO) << "Applying " << utils::typeName<self_t>() << " to player " << game_state.getPlayerId(requestor)
 
 // call this if the linter is beeing a lil bitch.
 #define SUPPRESS_UNUSED_VAR_WARNING(variable) (void)(variable)
@@ -67,9 +108,9 @@ namespace server
     [](server::base::Behaviour::action_decision_t &action_decision) -> decision_type *                                 \
     {                                                                                                                  \
         ASSERT_DECISION                                                                                                \
-        auto *casted_decision = dynamic_cast<(decision_type) *>(action_decision->get());                               \
+        auto *casted_decision = shared::tagCast<decision_type>(action_decision->get());                                \
         if ( !casted_decision ) {                                                                                      \
-            LOG(ERROR) << "Decision has wrong type! Expected: " << utils::demangle(typeid(decision_type).name())       \
+            LOG(ERROR) << "Decision has wrong type! Expected: " << utils::typeName<decision_type>()                    \
                        << ", but got: " << utils::demangle(typeid(*action_decision->get()).name());                    \
             throw std::runtime_error("Decision has wrong type");                                                       \
         }                                                                                                              \
@@ -84,120 +125,100 @@ namespace server
         // ================================
         // BEHAVIOUR IMPLEMENTATIONS
         // ================================
-        DEFINE_TEMPLATED_BEHAVIOUR(GainCoins, int, coins)
+        DEFINE_TEMPLATED_EFFECT(GainCoins, int, coins)
         {
             LOG_CALL;
-            ASSERT_NO_DECISION;
 
-            auto &affected_player = game_state.getPlayer(requestor_id);
+            auto &affected_player = game_state.getPlayer(requestor);
             affected_player.addTreasure(coins);
-
-            BEHAVIOUR_DONE;
         }
 
-        DEFINE_TEMPLATED_BEHAVIOUR(GainBuys, int, buys)
+        DEFINE_TEMPLATED_EFFECT(GainBuys, int, buys)
         {
             LOG_CALL;
-            ASSERT_NO_DECISION;
 
-            auto &affected_player = game_state.getPlayer(requestor_id);
+            auto &affected_player = game_state.getPlayer(requestor);
             affected_player.addBuys(buys);
-
-            BEHAVIOUR_DONE;
         }
 
-        DEFINE_TEMPLATED_BEHAVIOUR(GainActions, int, actions)
+        DEFINE_TEMPLATED_EFFECT(GainActions, int, actions)
         {
             LOG_CALL;
-            ASSERT_NO_DECISION;
 
-            auto &affected_player = game_state.getPlayer(requestor_id);
+            auto &affected_player = game_state.getPlayer(requestor);
             affected_player.addActions(actions);
-
-            BEHAVIOUR_DONE;
         }
 
-        DEFINE_TEMPLATED_BEHAVIOUR(DrawCards, int, n_cards)
+        DEFINE_TEMPLATED_EFFECT(DrawCards, int, n_cards)
         {
             LOG_CALL;
-            ASSERT_NO_DECISION;
 
-            auto &affected_player = game_state.getPlayer(requestor_id);
+            auto &affected_player = game_state.getPlayer(requestor);
             affected_player.draw(n_cards);
-
-            BEHAVIOUR_DONE;
         }
 
-        DEFINE_TEMPLATED_BEHAVIOUR(DrawCardsEnemies, int, n_cards)
+        DEFINE_TEMPLATED_EFFECT(DrawCardsEnemies, int, n_cards)
         {
             LOG_CALL;
-            ASSERT_NO_DECISION;
 
-            auto all_player_ids = game_state.getAllPlayerIDs();
-            for ( auto &player_id : all_player_ids ) {
-                if ( player_id == game_state.getCurrentPlayerId() ) {
-                    continue;
-                }
-                auto &affected_player = game_state.getPlayer(player_id);
+            for ( const auto enemy : game_state.getEnemySeats(requestor) ) {
+                auto &affected_player = game_state.getPlayer(enemy);
                 affected_player.draw(n_cards);
             }
-
-            BEHAVIOUR_DONE;
         }
 
-        DEFINE_BEHAVIOUR(SeaHag)
+        DEFINE_EFFECT(SeaHag)
         {
             LOG_CALL;
-            ASSERT_NO_DECISION;
+
+            constexpr auto curse = shared::cardHandle("Curse");
 
             // ensure play order
             helper::applyAttackToEnemies(game_state,
-                                         [&](GameState &game_state, const shared::PlayerBase::id_t &enemy_id)
+                                         [&](GameState &game_state, GameState::seat_t enemy)
                                          {
-                                             auto &affected_enemy = game_state.getPlayer(enemy_id);
+                                             auto &affected_enemy = game_state.getPlayer(enemy);
                                              affected_enemy.move<shared::DRAW_PILE_TOP, shared::DISCARD_PILE>(1);
-                                             if ( game_state.getBoard()->has("Curse") ) {
-                                                 game_state.getBoard()->tryTake("Curse");
-                                                 affected_enemy.add<shared::DRAW_PILE_TOP>("Curse");
+                                             if ( game_state.getBoard()->has(curse) ) {
+                                                 game_state.getBoard()->tryTake(curse);
+                                                 affected_enemy.add<shared::DRAW_PILE_TOP>(curse);
                                              }
                                          });
-
-            BEHAVIOUR_DONE;
         }
 
-        DEFINE_BEHAVIOUR(Moneylender)
+        DEFINE_EFFECT(Moneylender)
         {
             LOG_CALL;
-            ASSERT_NO_DECISION;
 
-            auto &affected_player = game_state.getPlayer(requestor_id);
-            if ( affected_player.hasCard<shared::HAND>("Copper") ) {
+            constexpr auto copper = shared::cardHandle("Copper");
+
+            auto &affected_player = game_state.getPlayer(requestor);
+            if ( affected_player.hasCard<shared::HAND>(copper) ) {
                 // Discard the copper
-                affected_player.move<shared::HAND, shared::TRASH>("Copper");
+                affected_player.move<shared::HAND, shared::TRASH>(copper);
                 affected_player.addTreasure(3);
             }
-
-            BEHAVIOUR_DONE;
         }
 
-        DEFINE_BEHAVIOUR(TreasureTrove)
+        DEFINE_EFFECT(TreasureTrove)
         {
             LOG_CALL;
-            ASSERT_NO_DECISION;
+
+            constexpr auto copper = shared::cardHandle("Copper");
+            constexpr auto gold = shared::cardHandle("Gold");
 
             auto &affected_player = game_state.getCurrentPlayer();
             auto &board = *game_state.getBoard();
-            if ( board.has("Copper") )
+            if ( board.has(copper) )
             {
-                board.tryTake("Copper");
-                affected_player.gain("Copper");
+                board.tryTake(copper);
+                affected_player.gain(copper);
             }
-            if ( board.has("Gold") )
+            if ( board.has(gold) )
             {
-                board.tryTake("Gold");
-                affected_player.gain("Gold");
+                board.tryTake(gold);
+                affected_player.gain(gold);
             }
-            BEHAVIOUR_DONE;
         }
 
         DEFINE_BEHAVIOUR(Poacher)
@@ -218,87 +239,84 @@ namespace server
             auto cards_to_discard = board->getEmptyPilesCount();
 
             if ( cards_to_discard != 0 ) {
-                auto decision =
-                        helper::validateResponse(game_state, requestor_id, action_decision.value(), cards_to_discard, cards_to_discard);
+                auto cards = helper::validateResponse(game_state, requestor, action_decision.value(), cards_to_discard,
+                                                      cards_to_discard);
 
-                if ( decision.cards.size() == 0 ) {
+                if ( cards.size() == 0 ) {
                     BEHAVIOUR_DONE;
                 }
 
                 auto &affected_player = game_state.getCurrentPlayer();
-                for ( const auto &card_id : decision.cards ) {
-                    affected_player.move<shared::HAND, shared::DISCARD_PILE>(card_id);
+                for ( const auto card : cards ) {
+                    affected_player.move<shared::HAND, shared::DISCARD_PILE>(card);
                 }
             }
             BEHAVIOUR_DONE;
         }
 
-        DEFINE_BEHAVIOUR(TreasureMap)
+        DEFINE_EFFECT(TreasureMap)
         {
             LOG_CALL;
-            ASSERT_NO_DECISION;
 
-            auto &affected_player = game_state.getPlayer(requestor_id);
+            constexpr auto treasure_map = shared::cardHandle("Treasure_Map");
+            constexpr auto gold = shared::cardHandle("Gold");
+
+            auto &affected_player = game_state.getPlayer(requestor);
             auto &board = *game_state.getBoard();
-            if ( affected_player.hasCard<shared::HAND>("Treasure_Map") ) {
-                affected_player.move<shared::HAND, shared::TRASH>("Treasure_Map");
+            if ( affected_player.hasCard<shared::HAND>(treasure_map) ) {
+                affected_player.move<shared::HAND, shared::TRASH>(treasure_map);
                 // Currently, ServerPlayer::move does not delete the card from
                 // the hand, so we have to do it manually
-                board.trashCard("Treasure_Map");
-                if ( !board.removeFromPlayedCards("Treasure_Map") ) {
+                board.trashCard(treasure_map);
+                if ( !board.removeFromPlayedCards(treasure_map) ) {
                     // We played a treasure map, so it should be in the played cards now
                     LOG(ERROR) << "Treasure_Map not found in played cards";
                     throw std::runtime_error("Treasure_Map not found in played cards");
                 }
-                board.trashCard("Treasure_Map");
+                board.trashCard(treasure_map);
                 for ( int i = 0; i < 4; i++ ) {
-                    if ( board.has("Gold") ) {
-                        board.tryTake("Gold");
-                        affected_player.add<shared::DRAW_PILE_TOP>("Gold");
+                    if ( board.has(gold) ) {
+                        board.tryTake(gold);
+                        affected_player.add<shared::DRAW_PILE_TOP>(gold);
                     }
                 }
             }
-
-            BEHAVIOUR_DONE;
         }
 
 
 #define TODO_IMPLEMENT_ME                                                                                              \
     SUPPRESS_UNUSED_VAR_WARNING(game_state);                                                                           \
-    SUPPRESS_UNUSED_VAR_WARNING(action_decision);                                                                      \
-    SUPPRESS_UNUSED_VAR_WARNING(requestor_id);                                                                         \
-    LOG(ERROR) << "BEHAVIOUR " << CLASS_NAME << " IS NOT IMPLEMENTED YET";                                             \
-    throw std::runtime_error("not implemented");                                                                       \
-    return OrderResponse()
+    SUPPRESS_UNUSED_VAR_WARNING(requestor);                                                                            \
+    LOG(ERROR) << "BEHAVIOUR " << utils::typeName<self_t>() << " IS NOT IMPLEMENTED YET";                              \
+    throw std::runtime_error("not implemented")
 
         // ================================
         // PLACEHOLDER BEHAVIOUR
         // ================================
-        DEFINE_BEHAVIOUR(NOT_IMPLEMENTED_YET) { TODO_IMPLEMENT_ME; }
+        DEFINE_EFFECT(NOT_IMPLEMENTED_YET) { TODO_IMPLEMENT_ME; }
 
         // ================================
         // Behaviours
         // ================================
 
-        DEFINE_BEHAVIOUR(CurseEnemy)
+        DEFINE_EFFECT(CurseEnemy)
         {
             /**
              * curses are applied clockwise, starting from the player to the right of the cur player
              */
 
             LOG_CALL;
-            ASSERT_NO_DECISION;
+
+            constexpr auto curse = shared::cardHandle("Curse");
 
             helper::applyAttackToEnemies(game_state,
-                                         [&](GameState &game_state, const shared::PlayerBase::id_t &enemy_id)
+                                         [&](GameState &game_state, GameState::seat_t enemy)
                                          {
-                                             if ( game_state.getBoard()->has("Curse") ) {
-                                                 game_state.getBoard()->tryTake("Curse");
-                                                 game_state.getPlayer(enemy_id).gain("Curse");
+                                             if ( game_state.getBoard()->has(curse) ) {
+                                                 game_state.getBoard()->tryTake(curse);
+                                                 game_state.getPlayer(enemy).gain(curse);
                                              }
                                          });
-
-            BEHAVIOUR_DONE;
         }
 
         DEFINE_TEMPLATED_BEHAVIOUR(GainCardMaxCostHand, int, max_cost)
@@ -309,10 +327,10 @@ namespace server
 
             if ( !has_action_decision ) {
                 // choose any card
-                return {requestor_id, std::make_unique<shared::GainFromBoardOrder>(max_cost)};
+                return {game_state.getPlayerId(requestor), std::make_unique<shared::GainFromBoardOrder>(max_cost)};
             }
 
-            auto *gain_decision = dynamic_cast<shared::GainFromBoardDecision *>(action_decision.value().get());
+            auto *gain_decision = shared::tagCast<shared::GainFromBoardDecision>(action_decision.value().get());
             if ( gain_decision == nullptr ) {
                 const auto *decision_ptr = action_decision.value().get();
                 if ( decision_ptr != nullptr ) {
@@ -325,8 +343,8 @@ namespace server
                 throw std::runtime_error("Decision type is not allowed!");
             }
 
-            const auto chosen_card_id = gain_decision->chosen_card;
-            game_state.tryGain<shared::HAND>(requestor_id, chosen_card_id);
+            const auto chosen_card = shared::CardFactory::getHandle(gain_decision->chosen_card);
+            game_state.tryGain<shared::HAND>(requestor, chosen_card);
 
             BEHAVIOUR_DONE;
         }
@@ -336,14 +354,13 @@ namespace server
             LOG_CALL;
 
             const bool has_action_decision = action_decision.has_value();
-            const auto cur_player_id = game_state.getCurrentPlayerId();
 
             if (!has_action_decision) {
                 // choose any card
-                return { cur_player_id, std::make_unique<shared::GainFromBoardOrder>(max_cost) };
+                return { game_state.getCurrentPlayerId(), std::make_unique<shared::GainFromBoardOrder>(max_cost) };
             }
 
-            auto* gain_decision = dynamic_cast<shared::GainFromBoardDecision*>(action_decision.value().get());
+            auto* gain_decision = shared::tagCast<shared::GainFromBoardDecision>(action_decision.value().get());
             if (gain_decision == nullptr) {
                 const auto* decision_ptr = action_decision.value().get();
                 if (decision_ptr != nullptr) {
@@ -357,8 +374,8 @@ namespace server
                 throw std::runtime_error("Decision type is not allowed!");
             }
 
-            const auto chosen_card_id = gain_decision->chosen_card;
-            game_state.tryGain<shared::DISCARD_PILE>(cur_player_id, chosen_card_id);
+            const auto chosen_card = shared::CardFactory::getHandle(gain_decision->chosen_card);
+            game_state.tryGain<shared::DISCARD_PILE>(game_state.getCurrentSeat(), chosen_card);
 
             BEHAVIOUR_DONE;
         }
@@ -374,90 +391,50 @@ namespace server
                                 1, 1, shared::ChooseFromOrder::AllowedChoice::DRAW_PILE)};
             }
 
-            auto deck_choice = helper::validateResponse(game_state, requestor_id, action_decision.value(), 1, 1);
+            auto cards = helper::validateResponse(game_state, requestor, action_decision.value(), 1, 1);
 
-            const auto move_card_id = deck_choice.cards.at(0);
+            const auto move_card = cards.at(0);
             game_state.getCurrentPlayer().move<shared::CardAccess::HAND, shared::CardAccess::DRAW_PILE_TOP>(
-                    move_card_id);
+                    move_card);
 
             BEHAVIOUR_DONE;
         }
 
-        DEFINE_BEHAVIOUR(Mine)
+        DEFINE_ROUTINE(Mine)
         {
             LOG_CALL;
 
-            const bool has_action_decision = action_decision.has_value();
-            const auto player_id = game_state.getCurrentPlayerId();
-            auto &affected_player = game_state.getPlayer(requestor_id);
-
-            if ( !has_action_decision ) {
-                if ( !affected_player.hasType<shared::CardAccess::HAND>(shared::CardType::TREASURE) ) {
-                    LOG(INFO) << "Player: "
-                              << " has no treasure in hand, returning";
-                    BEHAVIOUR_DONE;
-                }
-
-                return {requestor_id,
-                        std::make_unique<shared::ChooseFromHandOrder>(
-                                1, 1, shared::ChooseFromOrder::AllowedChoice::DISCARD, shared::CardType::TREASURE)};
+            auto &affected_player = game_state.getPlayer(requestor);
+            if ( !affected_player.hasType<shared::CardAccess::HAND>(shared::CardType::TREASURE) ) {
+                LOG(INFO) << "Player: " << affected_player.getId() << " has no treasure in hand, returning";
+                co_return;
             }
 
-            if ( dynamic_cast<shared::DeckChoiceDecision *>(action_decision.value().get()) != nullptr ) {
-                auto trash_decision = helper::validateResponse(game_state, requestor_id, action_decision.value(), 1, 1,
-                                                               shared::CardType::TREASURE);
-
-                const auto card_id = trash_decision.cards.at(0);
-                affected_player.move<shared::CardAccess::HAND, shared::CardAccess::TRASH>(card_id);
-                const auto max_cost = shared::CardFactory::getCost(card_id) + 3;
-                return {player_id, std::make_unique<shared::GainFromBoardOrder>(max_cost, shared::CardType::TREASURE)};
+            const auto trashed = (co_await base::ChooseFromHand(game_state, requestor, 1, 1,
+                                                               shared::ChooseFromOrder::AllowedChoice::DISCARD,
+                                                               shared::CardType::TREASURE))
+                                         .front();
+            affected_player.move<shared::CardAccess::HAND, shared::CardAccess::TRASH>(trashed);
+            game_state.getBoard()->trashCard(trashed);
 
-            } else if ( auto *card_choice =
-                                dynamic_cast<shared::GainFromBoardDecision *>(action_decision.value().get()) ) {
-                auto card_id = card_choice->chosen_card;
-
-                if ( !shared::CardFactory::isTreasure(card_id) ) {
-                    LOG(ERROR) << FUNC_NAME << "Player: " << requestor_id << " tried to select card: " << card_id
-                               << " which does not have type Treasure";
-                    throw std::runtime_error("CardType not allowed!");
-                }
-
-                game_state.tryGain<shared::HAND>(player_id, card_id);
-            }
-
-            BEHAVIOUR_DONE;
+            const auto gained = co_await base::GainFromBoard(
+                    game_state, requestor, shared::CardFactory::getCost(trashed) + 3, shared::CardType::TREASURE);
+            game_state.tryGain<shared::HAND>(requestor, gained);
         }
 
-        DEFINE_BEHAVIOUR(Remodel)
+        DEFINE_ROUTINE(Remodel)
         {
             LOG_CALL;
 
-            const bool has_action_decision = action_decision.has_value();
-            const auto player_id = game_state.getCurrentPlayerId();
-            auto &player = game_state.getCurrentPlayer();
+            const auto trashed = (co_await base::ChooseFromHand(game_state, requestor, 1, 1,
+                                                               shared::ChooseFromOrder::AllowedChoice::TRASH))
+                                         .front();
+            game_state.getPlayer(requestor).move<shared::CardAccess::HAND, shared::CardAccess::TRASH>(trashed);
+            game_state.getBoard()->trashCard(trashed);
 
-            if ( !has_action_decision ) {
-                return {player_id,
-                        std::make_unique<shared::ChooseFromHandOrder>(1, 1,
-                                                                      shared::ChooseFromOrder::AllowedChoice::TRASH)};
-            }
-
-            if ( dynamic_cast<shared::DeckChoiceDecision *>(action_decision.value().get()) != nullptr ) {
-                auto trash_decision = helper::validateResponse(game_state, requestor_id, action_decision.value(), 1, 1);
-
-                const auto card_id = trash_decision.cards.at(0);
-                player.move<shared::CardAccess::HAND, shared::CardAccess::TRASH>(card_id);
-                game_state.getBoard()->trashCard("card_id");
-                const auto max_cost = shared::CardFactory::getCost(card_id) + 2;
-                return {player_id, std::make_unique<shared::GainFromBoardOrder>(max_cost)};
-
-            } else if ( auto *card_choice =
-                                dynamic_cast<shared::GainFromBoardDecision *>(action_decision.value().get()) ) {
-                auto card_id = card_choice->chosen_card;
-                game_state.tryGain<shared::DISCARD_PILE>(player_id, card_id);
-            }
-
-            BEHAVIOUR_DONE;
+            const auto gained =
+                    co_await base::GainFromBoard(game_state, requestor, shared::CardFactory::getCost(trashed) + 2);
+            game_state.tryGain<shared::DISCARD_PILE>(requestor, gained);
         }
 
 
@@ -470,12 +447,11 @@ namespace server
                                                                       shared::ChooseFromOrder::AllowedChoice::TRASH)};
             }
 
-            auto trash_decision =
-                    helper::validateResponse(game_state, requestor_id, action_decision.value(), 0, num_cards);
+            auto cards = helper::validateResponse(game_state, requestor, action_decision.value(), 0, num_cards);
 
-            auto &affected_player = game_state.getPlayer(requestor_id);
-            for ( const auto &card_id : trash_decision.cards ) {
-                affected_player.move<shared::CardAccess::HAND, shared::CardAccess::TRASH>(card_id);
+            auto &affected_player = game_state.getPlayer(requestor);
+            for ( const auto card : cards ) {
+                affected_player.move<shared::CardAccess::HAND, shared::CardAccess::TRASH>(card);
             }
 
             BEHAVIOUR_DONE;
@@ -487,24 +463,24 @@ namespace server
 
             const auto max_discard_amount = game_state.getCurrentPlayer().get<shared::CardAccess::HAND>().size();
             if ( !action_decision.has_value() ) {
-                return {requestor_id,
+                return {game_state.getPlayerId(requestor),
                         std::make_unique<shared::ChooseFromHandOrder>(0, max_discard_amount,
                                                                       shared::ChooseFromOrder::AllowedChoice::TRASH)};
             }
 
-            auto discard_decision =
-                    helper::validateResponse(game_state, requestor_id, action_decision.value(), 0, max_discard_amount);
+            auto cards =
+                    helper::validateResponse(game_state, requestor, action_decision.value(), 0, max_discard_amount);
 
             // stop behaviour if no cards are selected
             // otherwise draw(0) would draw the entire draw pile
-            if ( discard_decision.cards.empty() ) {
+            if ( cards.empty() ) {
                 BEHAVIOUR_DONE;
             }
 
-            auto &affected_player = game_state.getPlayer(requestor_id);
-            affected_player.draw(discard_decision.cards.size());
-            for ( const auto &card_id : discard_decision.cards ) {
-                affected_player.move<shared::CardAccess::HAND, shared::CardAccess::DISCARD_PILE>(card_id);
+            auto &affected_player = game_state.getPlayer(requestor);
+            affected_player.draw(cards.size());
+            for ( const auto card : cards ) {
+                affected_player.move<shared::CardAccess::HAND, shared::CardAccess::DISCARD_PILE>(card);
             }
 
             BEHAVIOUR_DONE;
@@ -512,14 +488,16 @@ namespace server
 
         class MilitiaAttack : public server::base::Behaviour
         {
-            std::unordered_map<shared::PlayerBase::id_t, unsigned int> expect_response;
+            // cards each enemy still has to discard, indexed by seat
+            std::array<unsigned int, GameState::MAX_PLAYERS> expect_response{};
 
         public:
-            inline ret_t apply(server::GameState &state, const shared::PlayerBase::id_t &requestor_id,
+            using self_t = MilitiaAttack;
+            inline ret_t apply(server::GameState &state, server::GameState::seat_t requestor,
                                server::base::Behaviour::action_decision_t action_decision = std::nullopt) override;
         };
         inline server::base::Behaviour::ret_t
-        MilitiaAttack::apply(server::GameState &game_state, const shared::PlayerBase::id_t &requestor_id,
+        MilitiaAttack::apply(server::GameState &game_state, server::GameState::seat_t requestor,
                              server::base::Behaviour::action_decision_t action_decision)
         {
             LOG_CALL;
@@ -527,9 +505,9 @@ namespace server
             if ( !action_decision.has_value() ) {
                 auto order = helper::sendAttackToEnemies(
                         game_state,
-                        [this](GameState &game_state, const shared::PlayerBase::id_t &enemy_id)
+                        [this](GameState &game_state, GameState::seat_t enemy_seat)
                         {
-                            const auto &enemy = game_state.getPlayer(enemy_id);
+                            const auto &enemy = game_state.getPlayer(enemy_seat);
                             const auto hand_size = enemy.get<shared::HAND>().size();
 
 
@@ -540,7 +518,7 @@ namespace server
 
                             const unsigned int n_cards_to_discard = hand_size - 3;
 
-                            this->expect_response.emplace(enemy_id, n_cards_to_discard);
+                            this->expect_response[enemy_seat] = n_cards_to_discard;
 
                             return std::make_unique<shared::ChooseFromHandOrder>(
                                     n_cards_to_discard, n_cards_to_discard,
@@ -557,36 +535,190 @@ namespace server
                 }
             }
 
-            auto enemy_iter = this->expect_response.find(requestor_id);
-            if ( enemy_iter == this->expect_response.end() ) {
-                LOG(WARN) << "Not expecting a response from enemy: " << requestor_id;
+            const auto n_cards_to_discard = this->expect_response[requestor];
+            if ( n_cards_to_discard == 0 ) {
+                LOG(WARN) << "Not expecting a response from enemy: " << game_state.getPlayerId(requestor);
                 throw exception::NotYourTurn();
             }
 
-            const auto n_cards_to_discard = this->expect_response.at(requestor_id);
-            auto decision = helper::validateResponse(game_state, requestor_id, action_decision.value(),
-                                                     n_cards_to_discard, n_cards_to_discard);
+            auto cards = helper::validateResponse(game_state, requestor, action_decision.value(),
+                                                  n_cards_to_discard, n_cards_to_discard);
 
-            auto &affected_enemy = game_state.getPlayer(requestor_id);
-            for ( const auto &card_id : decision.cards ) {
-                affected_enemy.move<shared::HAND, shared::DISCARD_PILE>(card_id);
+            auto &affected_enemy = game_state.getPlayer(requestor);
+            for ( const auto card : cards ) {
+                affected_enemy.move<shared::HAND, shared::DISCARD_PILE>(card);
             }
 
-            this->expect_response.erase(enemy_iter);
+            this->expect_response[requestor] = 0;
 
-            if ( !this->expect_response.empty() ) {
+            if ( std::any_of(this->expect_response.begin(), this->expect_response.end(),
+                             [](unsigned int n_cards) { return n_cards != 0; }) ) {
                 return OrderResponse();
             }
 
             BEHAVIOUR_DONE;
         }
 
+        DEFINE_ROUTINE(ThroneRoom)
+        {
+            LOG_CALL;
+
+            // any action card, mixed ones like Great_Hall included
+            const auto chosen = co_await base::ChooseFromHand(game_state, requestor, 0, 1,
+                                                              shared::ChooseFromOrder::AllowedChoice::PLAY,
+                                                              base::Awaiter::ANY_TYPE, shared::CardType::ACTION);
+            if ( chosen.empty() ) {
+                co_return;
+            }
+
+            // the card is played without spending an action
+            const auto card = chosen.front();
+            game_state.getPlayer(requestor).move<shared::HAND, shared::STAGED_CARDS>(card);
+            game_state.tryPlay<shared::STAGED_CARDS>(game_state.getPlayerId(requestor), card);
+
+            co_await base::PlayCard(game_state, card);
+            co_await base::PlayCard(game_state, card);
+        }
+
+        DEFINE_ROUTINE(Library)
+        {
+            LOG_CALL;
+
+            constexpr size_t target_hand_size = 7;
+
+            // skipped action cards are set aside in the staged cards until the hand is full
+            auto &affected_player = game_state.getPlayer(requestor);
+            const auto &staged = affected_player.get<shared::STAGED_CARDS>();
+            const auto staged_before = staged.size();
+
+            while ( affected_player.get<shared::HAND>().size() < target_hand_size ) {
+                const auto staged_size = staged.size();
+                affected_player.move<shared::DRAW_PILE_TOP, shared::STAGED_CARDS>(1);
+                if ( staged.size() == staged_size ) {
+                    // draw and discard pile are both empty
+                    break;
+                }
+
+                const auto card = staged.back();
+                if ( shared::CardFactory::isAction(card) ) {
+                    const std::vector<shared::CardBase::handle_t> offered(1, card);
+                    const auto skipped = co_await base::ChooseFromStaged(
+                            game_state, requestor, 0, 1, shared::ChooseFromOrder::AllowedChoice::DISCARD, offered);
+                    if ( !skipped.empty() ) {
+                        continue;
+                    }
+                }
+                affected_player.move<shared::STAGED_CARDS, shared::HAND>(card);
+            }
+
+            if ( staged.size() > staged_before ) {
+                affected_player.move<shared::STAGED_CARDS, shared::DISCARD_PILE>(staged.size() - staged_before);
+            }
+        }
+
+        DEFINE_ROUTINE(Sentry)
+        {
+            LOG_CALL;
+
+            auto &affected_player = game_state.getPlayer(requestor);
+            const auto &staged = affected_player.get<shared::STAGED_CARDS>();
+            const auto staged_before = staged.size();
+
+            affected_player.move<shared::DRAW_PILE_TOP, shared::STAGED_CARDS>(2);
+            const std::vector<shared::CardBase::handle_t> revealed(staged.begin() + staged_before, staged.end());
+            if ( revealed.empty() ) {
+                co_return;
+            }
+
+            constexpr auto trash_or_discard = static_cast<shared::ChooseFromOrder::AllowedChoice>(
+                    shared::ChooseFromOrder::AllowedChoice::TRASH | shared::ChooseFromOrder::AllowedChoice::DISCARD);
+            const auto chosen =
+                    co_await base::ChooseFromStaged(game_state, requestor, 0, revealed.size(), trash_or_discard,
+                                                    revealed);
+
+            for ( const auto &[card, choice] : chosen ) {
+                if ( (choice & shared::ChooseFromOrder::AllowedChoice::TRASH) != 0 ) {
+                    affected_player.move<shared::STAGED_CARDS, shared::TRASH>(card);
+                    game_state.getBoard()->trashCard(card);
+                } else {
+                    affected_player.move<shared::STAGED_CARDS, shared::DISCARD_PILE>(card);
+                }
+            }
+
+            // the rest goes back on top in any order, so the player picks the card that ends up on top
+            const std::vector<shared::CardBase::handle_t> kept(staged.begin() + staged_before, staged.end());
+            if ( kept.size() == 2 && kept.front() != kept.back() ) {
+                const auto top = (co_await base::ChooseFromStaged(game_state, requestor, 1, 1,
+                                                                  shared::ChooseFromOrder::AllowedChoice::DRAW_PILE,
+                                                                  kept))
+                                         .front()
+                                         .first;
+                affected_player.move<shared::STAGED_CARDS, shared::DRAW_PILE_TOP>(
+                        top == kept.front() ? kept.back() : kept.front());
+                affected_player.move<shared::STAGED_CARDS, shared::DRAW_PILE_TOP>(top);
+            } else if ( !kept.empty() ) {
+                affected_player.move<shared::STAGED_CARDS, shared::DRAW_PILE_TOP>(kept.size());
+            }
+        }
+
+        DEFINE_ROUTINE(Bandit)
+        {
+            LOG_CALL;
+
+            constexpr auto gold = shared::cardHandle("Gold");
+            constexpr auto copper = shared::cardHandle("Copper");
+
+            auto &board = *game_state.getBoard();
+            if ( board.has(gold) ) {
+                board.tryTake(gold);
+                game_state.getPlayer(requestor).gain(gold);
+            }
+
+            // enemies are attacked one after the other, in playing order
+            for ( const auto enemy_seat : game_state.getEnemySeats(requestor) ) {
+                auto &enemy = game_state.getPlayer(enemy_seat);
+                if ( enemy.canBlock() ) {
+                    continue;
+                }
+
+                const auto &staged = enemy.get<shared::STAGED_CARDS>();
+                const auto staged_before = staged.size();
+                enemy.move<shared::DRAW_PILE_TOP, shared::STAGED_CARDS>(2);
+
+                std::vector<shared::CardBase::handle_t> treasures;
+                std::copy_if(staged.begin() + staged_before, staged.end(), std::back_inserter(treasures),
+                             [](shared::CardBase::handle_t card)
+                             { return shared::CardFactory::isTreasure(card) && card != copper; });
+
+                if ( !treasures.empty() ) {
+                    auto trashed = treasures.front();
+                    if ( treasures.size() > 1 && treasures.front() != treasures.back() ) {
+                        trashed = (co_await base::ChooseFromStaged(
+                                           game_state, enemy_seat, 1, 1, shared::ChooseFromOrder::AllowedChoice::TRASH,
+                                           treasures))
+                                          .front()
+                                          .first;
+                    }
+                    enemy.move<shared::STAGED_CARDS, shared::TRASH>(trashed);
+                    board.trashCard(trashed);
+                }
+
+                if ( staged.size() > staged_before ) {
+                    enemy.move<shared::STAGED_CARDS, shared::DISCARD_PILE>(staged.size() - staged_before);
+                }
+            }
+        }
+
 // ================================
 // UNDEF MACROS
 // ================================
 #undef DEFINE_BEHAVIOUR
 #undef BEHAVIOUR_DONE
 #undef DEFINE_TEMPLATED_BEHAVIOUR
+#undef DEFINE_EFFECT
+#undef DEFINE_TEMPLATED_EFFECT
+#undef DEFINE_ROUTINE
+#undef TODO_IMPLEMENT_ME
 #undef TRY_CAST_DECISION
 #undef LOG_CALL
 #undef SUPPRESS_UNUSED_VAR_WARNING
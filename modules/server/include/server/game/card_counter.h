@@ -0,0 +1,116 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+#include <shared/game/cards/card_factory.h>
+#include <shared/utils/exception.h>
+#include <shared/utils/logger.h>
+
+namespace server
+{
+    /**
+     * @brief Histogram of the cards in a pile, indexed by card handle.
+     *
+     * Queries only look at the distinct cards of the game, so they do not depend on the size of the pile.
+     */
+    class CardCounter
+    {
+    public:
+        using count_t = uint16_t;
+
+        inline void add(shared::CardBase::handle_t card)
+        {
+            ++counts[shared::toIndex(card)];
+            ++total;
+        }
+
+        template <typename Iterator>
+        inline void add(Iterator begin, Iterator end)
+        {
+            std::for_each(begin, end, [this](shared::CardBase::handle_t card) { add(card); });
+        }
+
+        /**
+         * @warning Throws if the card is not counted.
+         */
+        inline void remove(shared::CardBase::handle_t card)
+        {
+            auto &count = counts[shared::toIndex(card)];
+            if ( count == 0 ) {
+                LOG(ERROR) << "Tried to remove card \'" << card << "\' from a CardCounter that does not contain it";
+                throw exception::InvalidCardAccess();
+            }
+            --count;
+            --total;
+        }
+
+        template <typename Iterator>
+        inline void remove(Iterator begin, Iterator end)
+        {
+            std::for_each(begin, end, [this](shared::CardBase::handle_t card) { remove(card); });
+        }
+
+        inline count_t count(shared::CardBase::handle_t card) const { return counts[shared::toIndex(card)]; }
+        inline bool contains(shared::CardBase::handle_t card) const { return count(card) > 0; }
+        inline size_t size() const { return total; }
+        inline bool empty() const { return total == 0; }
+
+        /**
+         * @brief Calls func(card, count) for every card that is contained at least once.
+         */
+        template <typename Func>
+        inline void forEach(Func func) const
+        {
+            for ( size_t i = 0; i < counts.size(); ++i ) {
+                if ( counts[i] != 0 ) {
+                    func(static_cast<shared::CardBase::handle_t>(i), counts[i]);
+                }
+            }
+        }
+
+        /**
+         * @return The number of cards for which pred(card) is true.
+         */
+        template <typename Predicate>
+        inline size_t countIf(Predicate pred) const
+        {
+            size_t result = 0;
+            forEach(
+                    [&](shared::CardBase::handle_t card, count_t count)
+                    {
+                        if ( pred(card) ) {
+                            result += count;
+                        }
+                    });
+            return result;
+        }
+
+        /**
+         * @return true if there is a card that has all the bits of type set.
+         */
+        inline bool hasType(shared::CardType type) const
+        {
+            for ( size_t i = 0; i < counts.size(); ++i ) {
+                if ( counts[i] != 0 &&
+                     (shared::CardFactory::getType(static_cast<shared::CardBase::handle_t>(i)) & type) == type ) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        inline CardCounter &operator+=(const CardCounter &other)
+        {
+            for ( size_t i = 0; i < counts.size(); ++i ) {
+                counts[i] += other.counts[i];
+            }
+            total += other.total;
+            return *this;
+        }
+
+    private:
+        std::array<count_t, shared::CardFactory::size()> counts{};
+        size_t total = 0;
+    };
+} // namespace server
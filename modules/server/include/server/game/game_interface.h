@@ -20,8 +20,11 @@ namespace server
         GameInterface(GameInterface &&other) = default;
         ~GameInterface() = default;
 
+        /**
+         * @param seed determines all shuffles of the game, see GameState::getSeed
+         */
         static ptr_t make(const std::string &game_id, const std::vector<shared::CardBase::id_t> &play_cards,
-                          const std::vector<Player::id_t> &player_ids);
+                          const std::vector<Player::id_t> &player_ids, uint64_t seed = utils::randomSeed());
 
         /**
          * @brief Receives an ActionDecision from the Lobby and handles it accordingly.
@@ -43,6 +46,7 @@ namespace server
         response_t startGame() { return nextPhase(); }
 
         bool isGameOver() const { return game_state->isGameOver(); }
+        uint64_t getSeed() const { return game_state->getSeed(); }
 
         response_t terminate()
         {
@@ -52,8 +56,8 @@ namespace server
 
     private:
         GameInterface(const std::string &game_id, const std::vector<shared::CardBase::id_t> &play_cards,
-                      const std::vector<Player::id_t> &player_ids) :
-            game_state(std::make_shared<GameState>(play_cards, player_ids)),
+                      const std::vector<Player::id_t> &player_ids, uint64_t seed) :
+            game_state(std::make_shared<GameState>(play_cards, player_ids, seed)),
             behaviour_chain(std::make_unique<BehaviourChain>()), game_id(game_id)
         {}
 
@@ -73,6 +77,13 @@ namespace server
          */
         response_t finishedPlayingCard();
 
+        /**
+         * @brief Runs the behaviour chain with run. If a card fails and the chain gives up on it, the turn continues
+         * as if the card was done, otherwise errors are passed on to the player.
+         */
+        template <typename Run>
+        response_t runBehaviourChain(Run &&run);
+
 /**
  * @brief The handlers obviously handle the messages. The functions are specialised for certain decision types and
  * perform all required checks themselves. Each function will return an OrderResponse containing the necessary
@@ -1,9 +1,11 @@
 #pragma once
 
-#include <map>
 #include <memory>
+#include <ranges>
+#include <string_view>
 #include <vector>
 
+#include <server/game/behaviour_arena.h>
 #include <server/game/server_board.h>
 #include <server/game/server_player.h>
 
@@ -14,6 +16,7 @@
 #include <shared/game/game_state/game_phase.h>
 #include <shared/game/game_state/player_base.h>
 #include <shared/game/game_state/reduced_game_state.h>
+#include <shared/utils/random.h>
 
 namespace server
 {
@@ -25,16 +28,32 @@ namespace server
      */
     class GameState
     {
-        std::map<Player::id_t, Player::ptr_t> player_map;
-        std::vector<Player::id_t> player_order;
-        unsigned int current_player_idx;
+    public:
+        /**
+         * @brief Position of a player in the playing order, the player on seat 0 takes the first turn.
+         */
+        using seat_t = unsigned int;
+        static constexpr size_t MAX_PLAYERS = 4;
+
+    private:
+        // indexed by seat, the vector is never resized after initialisePlayers, so references stay valid
+        std::vector<Player> players;
+        // ids by seat, looking up a seat scans these, there are at most MAX_PLAYERS of them
+        std::vector<Player::id_t> player_ids;
+        seat_t current_seat;
         ServerBoard::ptr_t board;
         shared::GamePhase phase;
         bool is_actually_over = false;
+        // memory of the behaviours that are in progress
+        BehaviourArena behaviour_arena;
+        // every shuffle of the game derives from this seed, so a game can be replayed from it
+        uint64_t seed = 0;
+        utils::Xoshiro256 rng{seed};
 
     public:
         GameState();
-        GameState(const std::vector<shared::CardBase::id_t> &play_cards, const std::vector<Player::id_t> &player_ids);
+        GameState(const std::vector<shared::CardBase::id_t> &play_cards, const std::vector<Player::id_t> &player_ids,
+                  uint64_t seed = utils::randomSeed());
         ~GameState();
         GameState(GameState &&other);
 
@@ -61,25 +80,25 @@ namespace server
          * @brief Buys a card from the board and adds it to the players discard pile.
          * @throws exception::InvalidRequest, exception::OutOfPhase, exception::InsufficientFunds
          */
-        void tryBuy(const shared::PlayerBase::id_t &requestor_id, const shared::CardBase::id_t &card_id);
+        void tryBuy(const shared::PlayerBase::id_t &requestor_id, shared::CardBase::handle_t card);
 
         /**
          * @brief Tries to play all treasures from a players hand.
          * @return All treasure cards in a players hand
          */
-        std::vector<shared::CardBase::id_t> tryPlayAllTreasures(const shared::PlayerBase::id_t &requestor_id);
+        Player::pile_t tryPlayAllTreasures(const shared::PlayerBase::id_t &requestor_id);
 
         /**
          * @brief Tries to play the given card_id from the specified pile.
          */
         template <enum shared::CardAccess FROM>
-        inline void tryPlay(const shared::PlayerBase::id_t &requestor_id, const shared::CardBase::id_t &card_id);
+        inline void tryPlay(const shared::PlayerBase::id_t &requestor_id, shared::CardBase::handle_t card);
 
         /**
          * @brief Tries to gain the given card_id to the given pile.
          */
         template <enum shared::CardAccess TO>
-        inline void tryGain(const shared::PlayerBase::id_t &requestor_id, const shared::CardBase::id_t &card_id);
+        inline void tryGain(seat_t requestor, shared::CardBase::handle_t card);
 
 #pragma region GETTERS / SETTERS
 
@@ -88,27 +107,50 @@ namespace server
         shared::GamePhase getPhase() const { return phase; }
         ServerBoard::ptr_t getBoard() { return board; }
 
-        const Player::id_t &getCurrentPlayerId() const { return player_order[current_player_idx]; }
-        Player &getCurrentPlayer() { return *player_map[getCurrentPlayerId()]; }
+        seat_t getCurrentSeat() const { return current_seat; }
+        const Player::id_t &getCurrentPlayerId() const { return player_ids[current_seat]; }
+        Player &getCurrentPlayer() { return players[current_seat]; }
+
+        size_t getPlayerCount() const { return players.size(); }
 
-        Player &getPlayer(const Player::id_t &id) { return *player_map.at(id); }
-        const Player &getPlayer(const Player::id_t &id) const { return *player_map.at(id); }
+        /**
+         * @throws std::out_of_range if no player with this id takes part in the game
+         */
+        seat_t getSeat(const Player::id_t &id) const;
+        const Player::id_t &getPlayerId(seat_t seat) const { return player_ids[seat]; }
+
+        Player &getPlayer(seat_t seat) { return players[seat]; }
+        const Player &getPlayer(seat_t seat) const { return players[seat]; }
+        Player &getPlayer(const Player::id_t &id) { return players[getSeat(id)]; }
+        const Player &getPlayer(const Player::id_t &id) const { return players[getSeat(id)]; }
 
         inline void setPhase(shared::GamePhase new_phase) { phase = new_phase; }
 
+        BehaviourArena &getBehaviourArena() { return behaviour_arena; }
+
+        /**
+         * @return The seed the game was started with, passing it to a new GameState reproduces all shuffles.
+         */
+        uint64_t getSeed() const { return seed; }
+
         void endTurn();
 
         /**
-         * @return vector containing all player ids
+         * @return vector containing all player ids, indexed by seat
          */
-        const std::vector<Player::id_t> &getAllPlayerIDs() const { return player_order; }
+        const std::vector<Player::id_t> &getAllPlayerIDs() const { return player_ids; }
 
         /**
-         * @brief Returns a vector containing the enemies of the calling player_id. The enemies are provided in playing
-         * order.
-         * @return vector containing the enemies, where vector[0]=next player in sequence
+         * @brief The seats of the enemies of the given seat in playing order, starting with the next player. This is
+         * a lazy view, iterating it does not allocate.
          */
-        std::vector<Player::id_t> getEnemyIDs(const Player::id_t &player_id) const;
+        auto getEnemySeats(seat_t seat) const
+        {
+            const auto player_count = static_cast<seat_t>(players.size());
+            return std::views::iota(seat_t{1}, player_count) |
+                   std::views::transform([seat, player_count](seat_t offset)
+                                         { return (seat + offset) % player_count; });
+        }
 
         /**
          * @return true; if the game is over
@@ -143,25 +185,25 @@ namespace server
         void forceSwitchPhase();
 
         inline void resetPhase() { phase = shared::GamePhase::ACTION_PHASE; }
-        inline void switchPlayer() { current_player_idx = (current_player_idx + 1) % player_map.size(); }
+        inline void switchPlayer() { current_seat = (current_seat + 1) % getPlayerCount(); }
 
 #pragma region ASSERTION_HELPERS
-        void printSuccess(const shared::PlayerBase::id_t &requestor_id, const std::string &function_name);
-        void guaranteePhase(const shared::PlayerBase::id_t &requestor_id, const shared::CardBase::id_t &card_id,
-                            shared::GamePhase expected_phase, const std::string &error_msg,
-                            const std::string &function_name);
+        void printSuccess(const shared::PlayerBase::id_t &requestor_id, std::string_view function_name);
+        void guaranteePhase(const shared::PlayerBase::id_t &requestor_id, shared::CardBase::handle_t card,
+                            shared::GamePhase expected_phase, std::string_view error_msg,
+                            std::string_view function_name);
 
         void guaranteePhase(const shared::PlayerBase::id_t &requestor_id, shared::GamePhase expected_phase,
-                            const std::string &error_msg, const std::string &function_name);
+                            std::string_view error_msg, std::string_view function_name);
 
-        void guaranteeNotPhase(const shared::PlayerBase::id_t &requestor_id, const shared::CardBase::id_t &card_id,
-                               shared::GamePhase expected_phase, const std::string &error_msg,
-                               const std::string &function_name);
+        void guaranteeNotPhase(const shared::PlayerBase::id_t &requestor_id, shared::CardBase::handle_t card,
+                               shared::GamePhase expected_phase, std::string_view error_msg,
+                               std::string_view function_name);
 
         void guaranteeNotPhase(const shared::PlayerBase::id_t &requestor_id, shared::GamePhase expected_phase,
-                               const std::string &error_msg, const std::string &function_name);
+                               std::string_view error_msg, std::string_view function_name);
 
-        void guaranteeIsCurrentPlayer(const shared::PlayerBase::id_t &requestor_id, const std::string &function_name);
+        void guaranteeIsCurrentPlayer(const shared::PlayerBase::id_t &requestor_id, std::string_view function_name);
     };
 
 #include "game_state.hpp"
@@ -3,8 +3,7 @@
 #include "game_state.h"
 
 template <enum shared::CardAccess FROM>
-inline void server::GameState::tryPlay(const shared::PlayerBase::id_t &requestor_id,
-                                       const shared::CardBase::id_t &card_id)
+inline void server::GameState::tryPlay(const shared::PlayerBase::id_t &requestor_id, shared::CardBase::handle_t card)
 {
     if constexpr ( FROM != shared::CardAccess::HAND && FROM != shared::CardAccess::STAGED_CARDS ) {
         LOG(ERROR) << "Cards can only be played from " << toString(shared::CardAccess::HAND) << " or from "
@@ -17,37 +16,36 @@ inline void server::GameState::tryPlay(const shared::PlayerBase::id_t &requestor
     guaranteeIsCurrentPlayer(requestor_id, FUNC_NAME);
 
     if constexpr ( FROM == shared::CardAccess::HAND ) {
-        guaranteePhase(requestor_id, card_id, shared::GamePhase::ACTION_PHASE, "You can not play a card", FUNC_NAME);
+        guaranteePhase(requestor_id, card, shared::GamePhase::ACTION_PHASE, "You can not play a card", FUNC_NAME);
 
-        if ( getPlayer(requestor_id).getActions() == 0 ) {
-            LOG(WARN) << "Player \'" << requestor_id << "\' attempted to play card \'" << card_id
+        if ( getCurrentPlayer().getActions() == 0 ) {
+            LOG(WARN) << "Player \'" << requestor_id << "\' attempted to play card \'" << card
                       << "\' with no actions left.";
             throw exception::OutOfActions();
         }
     } else if constexpr ( FROM == shared::CardAccess::STAGED_CARDS ) {
-        guaranteePhase(requestor_id, card_id, shared::GamePhase::PLAYING_ACTION_CARD, "You can not play a card",
+        guaranteePhase(requestor_id, card, shared::GamePhase::PLAYING_ACTION_CARD, "You can not play a card",
                        FUNC_NAME);
     }
 
-    if ( !getPlayer(requestor_id).hasCard<FROM>(card_id) ) {
-        LOG(WARN) << "Player \'" << requestor_id << "\' attempted to play card \'" << card_id << "\' not in "
+    auto &player = getCurrentPlayer();
+    if ( !player.hasCard<FROM>(card) ) {
+        LOG(WARN) << "Player \'" << requestor_id << "\' attempted to play card \'" << card << "\' not in "
                   << toString(FROM);
         throw exception::CardNotAvailable();
     }
 
-    auto &player = getPlayer(requestor_id);
-    player.take<FROM>(card_id);
+    player.take<FROM>(card);
     if constexpr ( FROM == shared::CardAccess::HAND ) {
         player.decActions();
     }
-    board->addToPlayedCards(card_id);
+    board->addToPlayedCards(card);
 
     printSuccess(requestor_id, FUNC_NAME);
 }
 
 template <enum shared::CardAccess TO>
-inline void server::GameState::tryGain(const shared::PlayerBase::id_t &requestor_id,
-                                       const shared::CardBase::id_t &card_id)
+inline void server::GameState::tryGain(seat_t requestor, shared::CardBase::handle_t card)
 {
     if constexpr ( TO != shared::HAND && TO != shared::DISCARD_PILE ) {
         LOG(ERROR) << "Cards can only be gained to " << toString(shared::HAND) << " or to "
@@ -57,11 +55,11 @@ inline void server::GameState::tryGain(const shared::PlayerBase::id_t &requestor
                                                   // compile and the error can not go unnoticed
     }
 
-    guaranteePhase(requestor_id, card_id, shared::GamePhase::PLAYING_ACTION_CARD, "You can not gain a card", FUNC_NAME);
+    const auto &requestor_id = getPlayerId(requestor);
+    guaranteePhase(requestor_id, card, shared::GamePhase::PLAYING_ACTION_CARD, "You can not gain a card", FUNC_NAME);
 
-    board->tryTake(card_id);
-    auto &player = getPlayer(requestor_id);
-    player.add<TO>(card_id);
+    board->tryTake(card);
+    players[requestor].add<TO>(card);
 
     printSuccess(requestor_id, FUNC_NAME);
 }
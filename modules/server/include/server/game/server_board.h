@@ -2,6 +2,7 @@
 
 #include <vector>
 
+#include <shared/game/cards/card_factory.h>
 #include <shared/game/game_state/board_base.h>
 #include <shared/utils/assert.h>
 #include <shared/utils/logger.h>
@@ -22,6 +23,10 @@ namespace server
         using ptr_t = std::shared_ptr<ServerBoard>;
         using pile_container_t = shared::Board::pile_container_t;
 
+        // the supply index points into the pile containers, so the board must stay in place
+        ServerBoard(ServerBoard &&) = delete;
+        ServerBoard &operator=(ServerBoard &&) = delete;
+
         /**
          * @brief Constructs a ServerBoard for a given number of players and 10 kingdom cards.
          *
@@ -37,24 +42,26 @@ namespace server
         shared::Board::ptr_t getReduced();
 
         /**
-         * @brief Throws if the card_id one wants to buy is not available.
+         * @brief Throws if the card one wants to buy is not available.
          */
+        void tryTake(shared::CardBase::handle_t card);
         void tryTake(const shared::CardBase::id_t &card_id);
 
         /**
-         * @brief Checks if the card exists on the board.
+         * @brief Checks if the card exists on the board and its pile is not empty.
          */
+        bool has(shared::CardBase::handle_t card) const;
         bool has(const shared::CardBase::id_t &card_id) const;
 
         /**
          * @brief Adds the given card to the played_cards vector.
          */
-        void addToPlayedCards(const shared::CardBase::id_t &card_id);
+        void addToPlayedCards(shared::CardBase::handle_t card);
 
         /**
          * @brief Adds the given cards to the played_cards vector.
          */
-        void addToPlayedCards(const std::vector<shared::CardBase::id_t> &cards);
+        void addToPlayedCards(const std::vector<shared::CardBase::handle_t> &cards);
 
         /**
          * @brief Removes the given card from the played_cards vector
@@ -62,11 +69,12 @@ namespace server
          * @return true if the card was removed
          * @return false if the card was not found
          */
-        bool removeFromPlayedCards(const shared::CardBase::id_t &card_id);
+        bool removeFromPlayedCards(shared::CardBase::handle_t card);
 
         /**
-         * @brief Adds the card_id to the trash
+         * @brief Adds the card to the trash
          */
+        void trashCard(shared::CardBase::handle_t card);
         void trashCard(const shared::CardBase::id_t &card_id);
 
         /**
@@ -89,13 +97,26 @@ namespace server
         ServerBoard(const std::vector<shared::CardBase::id_t> &kingdom_cards, size_t player_count);
 
         /**
-         * @brief Tries to buy a card based on id.
-         *
-         * @param card
-         * @return true successfully bought the card
-         * @return false card_id can not be bought
+         * @brief Takes a card from its pile, the caller has to make sure the card is available.
+         */
+        void take(shared::CardBase::handle_t card);
+
+    private:
+        /**
+         * @brief Builds the supply index for all piles on the board.
          */
-        void take(const shared::CardBase::id_t &card_id);
+        void indexSupply();
+
+        /**
+         * @return The pile of the card, or nullptr if the card is not part of this game.
+         */
+        const shared::Pile *getPile(shared::CardBase::handle_t card) const
+        {
+            return shared::toIndex(card) < supply.size() ? supply[shared::toIndex(card)] : nullptr;
+        }
+
+        // supply piles indexed by card handle, nullptr if the card is not part of this game
+        std::vector<const shared::Pile *> supply;
     };
 
 } // namespace server
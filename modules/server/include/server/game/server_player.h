@@ -1,15 +1,17 @@
 #pragma once
 
 #include <deque>
-#include <random>
+#include <type_traits>
 #include <vector>
 
+#include <server/game/card_counter.h>
 #include <shared/game/cards/card_base.h>
 #include <shared/game/cards/card_factory.h>
 #include <shared/game/game_state/player_base.h>
 #include <shared/game/game_state/reduced_game_state.h>
 
 #include <shared/utils/logger.h>
+#include <shared/utils/random.h>
 
 namespace server
 {
@@ -18,20 +20,46 @@ namespace server
      */
     class Player : public shared::PlayerBase
     {
-        std::vector<shared::CardBase::id_t> draw_pile;
-        std::vector<shared::CardBase::id_t> hand_cards;
-
-        std::vector<shared::CardBase::id_t> staged_cards;
-
     public:
         using id_t = shared::PlayerBase::id_t;
         using ptr_t = std::unique_ptr<Player>;
         using card_id = shared::CardBase::id_t;
+        using card_handle_t = shared::CardBase::handle_t;
+        using pile_t = std::vector<card_handle_t>;
+        // cards are drawn from and put onto the top, reshuffled cards go to the bottom
+        using draw_pile_t = std::deque<card_handle_t>;
+
+        template <enum shared::CardAccess PILE>
+        using pile_type_t = std::conditional_t<PILE == shared::DRAW_PILE_TOP || PILE == shared::DRAW_PILE_BOTTOM,
+                                               draw_pile_t, pile_t>;
+
+    private:
+        // front() is the top of the draw pile
+        draw_pile_t draw_pile;
+        // the order of the hand is not kept when cards are taken out of it, clients get it sorted anyway
+        pile_t hand_cards;
+        // the discard_pile of shared::PlayerBase only holds the card ids for the reduced player/enemy
+        pile_t discard_cards;
 
-        explicit Player(shared::PlayerBase::id_t id) : shared::PlayerBase(id){};
+        pile_t staged_cards;
+
+        // histograms of the piles above, kept in sync by add and take
+        CardCounter draw_pile_counts;
+        CardCounter hand_counts;
+        CardCounter discard_counts;
+        CardCounter staged_counts;
+
+        // shuffles the discard pile, a player of a game gets its own stream of the game's engine
+        utils::Xoshiro256 rng;
+
+    public:
+        explicit Player(shared::PlayerBase::id_t id) : shared::PlayerBase(id), rng(utils::randomSeed()){};
 
         Player(const Player &other) :
-            shared::PlayerBase(other), draw_pile(other.draw_pile), hand_cards(other.hand_cards)
+            shared::PlayerBase(other), draw_pile(other.draw_pile), hand_cards(other.hand_cards),
+            discard_cards(other.discard_cards), staged_cards(other.staged_cards),
+            draw_pile_counts(other.draw_pile_counts), hand_counts(other.hand_counts),
+            discard_counts(other.discard_counts), staged_counts(other.staged_counts), rng(other.rng)
         {}
 
         reduced::Player::ptr_t getReducedPlayer();
@@ -40,13 +68,13 @@ namespace server
         void playAvailableTreasureCards();
 
         template <enum shared::CardAccess PILE>
-        inline bool hasCard(const shared::CardBase::id_t &card_id) const;
+        inline bool hasCard(card_handle_t card) const { return getCounts<PILE>().contains(card); }
 
         template <enum shared::CardAccess PILE>
-        inline bool hasType(shared::CardType type) const;
+        inline bool hasType(shared::CardType type) const { return getCounts<PILE>().hasType(type); }
 
         template <enum shared::CardAccess PILE>
-        inline std::vector<shared::CardBase::id_t> getType(shared::CardType type) const;
+        inline pile_t getType(shared::CardType type) const;
 
         inline bool canBuy(unsigned int cost) { return buys > 0 && treasure >= cost; }
         inline bool canBlock() const { return hasType<shared::CardAccess::HAND>(shared::CardType::REACTION); }
@@ -61,7 +89,12 @@ namespace server
         /**
          * @brief Adds a card to the discard_pile
          */
-        inline void gain(const shared::CardBase::id_t &card_id) { add<shared::DISCARD_PILE>(card_id); }
+        inline void gain(card_handle_t card) { add<shared::DISCARD_PILE>(card); }
+
+        /**
+         * @brief Replaces the engine used for shuffling, so that the shuffles of a game can be reproduced.
+         */
+        void setRandomEngine(const utils::Xoshiro256 &engine) { rng = engine; }
 
         void addActions(unsigned int n) { actions += n; }
         void addBuys(unsigned int n) { buys += n; }
@@ -85,37 +118,43 @@ namespace server
          * @warning Throws if we try to access the trash pile.
          */
         template <enum shared::CardAccess PILE>
-        inline const std::vector<shared::CardBase::id_t> &get() const;
+        inline const pile_type_t<PILE> &get() const;
+
+        /**
+         * @return A const reference to the card counts of the indicated pile.
+         */
+        template <enum shared::CardAccess PILE>
+        inline const CardCounter &getCounts() const;
 
         /**
          * @brief Adds a card to the specified pile.
          */
         template <enum shared::CardAccess TO>
-        inline void add(std::vector<shared::CardBase::id_t> &&cards);
+        inline void add(pile_t &&cards);
 
         /**
          * @brief Adds a card to the specified pile.
          */
         template <enum shared::CardAccess TO>
-        inline void add(const std::vector<shared::CardBase::id_t> &cards);
+        inline void add(const pile_t &cards);
 
         /**
          * @brief Adds a card to the specified pile.
          */
         template <enum shared::CardAccess TO>
-        inline void add(const shared::CardBase::id_t &card_id);
+        inline void add(card_handle_t card);
 
         /**
-         * @brief Moves the card ID from pile FROM to pile TO. Trashed cards are simply deleted.
+         * @brief Moves the card from pile FROM to pile TO. Trashed cards are simply deleted.
          */
         template <enum shared::CardAccess FROM, enum shared::CardAccess TO>
-        inline void move(const shared::CardBase::id_t &card_id);
+        inline void move(card_handle_t card);
 
         /**
-         * @brief Moves the card IDs from pile FROM to pile TO. Trashed cards are simply deleted.
+         * @brief Moves the cards from pile FROM to pile TO. Trashed cards are simply deleted.
          */
         template <enum shared::CardAccess FROM, enum shared::CardAccess TO>
-        inline void move(const std::vector<shared::CardBase::id_t> &cards);
+        inline void move(const pile_t &cards);
 
         /**
          * @brief Moves the first min(n, pile.size()) cards from pile FROM to pile TO.
@@ -124,29 +163,30 @@ namespace server
         inline void move(unsigned int n = 0);
 
         /**
-         * @brief Removes a card with ID 'card_id' from the indicated pile.
-         * @return The same ID we passed in.
+         * @brief Removes the card 'card' from the indicated pile. Taking a card from the hand moves the last card of
+         * the hand into its place.
+         * @return The same handle we passed in.
          * @warning Throws
          */
         template <enum shared::CardAccess FROM>
-        inline shared::CardBase::id_t take(const shared::CardBase::id_t &card_id);
+        inline card_handle_t take(card_handle_t card);
 
         /**
-         * @brief Removes the card_ids 'cards' with card_id from the indicated pile.
+         * @brief Removes the cards 'cards' from the indicated pile. Nothing is removed if one of them is missing.
          * @return The same vector we passed in.
          * @warning Throws
          */
         template <enum shared::CardAccess FROM>
-        inline std::vector<shared::CardBase::id_t> take(const std::vector<shared::CardBase::id_t> &cards);
+        inline pile_t take(const pile_t &cards);
 
     protected:
         /**
-         * @brief Get all cards in the deck of the player.
+         * @brief Get the card counts of the whole deck of the player.
          *
          * This includes the draw_pile, discard_pile and hand_cards.
          * This should only be called when staged_cards are empty.
          */
-        std::vector<shared::CardBase::id_t> getDeck() const;
+        CardCounter getDeckCounts() const;
 
         /**
          * @brief Resets the 'stats' to:
@@ -157,11 +197,10 @@ namespace server
         void resetValues();
 
         /**
-         * @return A mutable reference to the indicated pile.
-         * @warning Throws if one tries to access the trash pile.
+         * @brief Writes the draw pile size and the discard pile ids to shared::PlayerBase, which is what gets sent to
+         * the clients.
          */
-        template <enum shared::CardAccess PILE>
-        inline std::vector<shared::CardBase::id_t> &getMutable();
+        void syncPlayerBase();
 
         /**
          * @brief Shuffles the indicated pile PILE
@@ -169,6 +208,7 @@ namespace server
         template <enum shared::CardAccess PILE>
         inline void shuffle();
 
+
         /**
          * @brief Adds the given cards to the specified TO pile.
          * Will always perform a push_back, except for DRAW_PILE_BOTTOM
@@ -186,7 +226,32 @@ namespace server
          * @tparam FROM, a pile from which we want to take cards
          */
         template <enum shared::CardAccess FROM>
-        inline std::vector<shared::CardBase::id_t> take(unsigned int num_cards = 0);
+        inline pile_t take(unsigned int num_cards = 0);
+
+    private:
+        /**
+         * @return A mutable reference to the indicated pile.
+         * @warning The card counts have to be updated together with the pile, use add and take instead.
+         */
+        template <enum shared::CardAccess PILE>
+        inline pile_type_t<PILE> &getMutable();
+
+        /**
+         * @brief Reshuffles the discard pile into the draw pile if needed, see take.
+         * @return The number of cards that can actually be taken.
+         */
+        template <enum shared::CardAccess FROM>
+        inline unsigned int prepareTake(unsigned int n);
+
+        /**
+         * @brief Removes the given cards from the pile FROM without copying them.
+         * @warning Throws and removes nothing if one of the cards is missing.
+         */
+        template <enum shared::CardAccess FROM>
+        inline void remove(const pile_t &cards);
+
+        template <enum shared::CardAccess PILE>
+        inline CardCounter &getMutableCounts();
     };
 
 #include "server_player.hpp"
@@ -2,11 +2,11 @@
 
 #pragma region UTILS
 template <enum shared::CardAccess PILE>
-inline std::vector<shared::CardBase::id_t> &server::Player::getMutable()
+inline server::Player::pile_type_t<PILE> &server::Player::getMutable()
 {
     static_assert(PILE != shared::TRASH && "Player does not have access to the trash pile!");
     if constexpr ( PILE == shared::DISCARD_PILE ) {
-        return discard_pile;
+        return discard_cards;
     } else if constexpr ( PILE == shared::HAND ) {
         return hand_cards;
     } else if constexpr ( PILE == shared::STAGED_CARDS ) {
@@ -23,12 +23,12 @@ inline std::vector<shared::CardBase::id_t> &server::Player::getMutable()
 }
 
 template <enum shared::CardAccess PILE>
-inline const std::vector<shared::CardBase::id_t> &server::Player::get() const
+inline const server::Player::pile_type_t<PILE> &server::Player::get() const
 {
     static_assert(PILE != shared::TRASH && "Player does not have access to the trash pile!");
 
     if constexpr ( PILE == shared::DISCARD_PILE ) {
-        return discard_pile;
+        return discard_cards;
     } else if constexpr ( PILE == shared::HAND ) {
         return hand_cards;
     } else if constexpr ( PILE == shared::STAGED_CARDS ) {
@@ -45,37 +45,55 @@ inline const std::vector<shared::CardBase::id_t> &server::Player::get() const
 }
 
 template <enum shared::CardAccess PILE>
-inline void server::Player::shuffle()
+inline server::CardCounter &server::Player::getMutableCounts()
 {
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
-
-    auto &cards = getMutable<PILE>();
-    std::shuffle(cards.begin(), cards.end(), gen);
+    static_assert(PILE != shared::TRASH && "Player does not have access to the trash pile!");
+    if constexpr ( PILE == shared::DISCARD_PILE ) {
+        return discard_counts;
+    } else if constexpr ( PILE == shared::HAND ) {
+        return hand_counts;
+    } else if constexpr ( PILE == shared::STAGED_CARDS ) {
+        return staged_counts;
+    } else {
+        // DRAW_PILE_TOP and DRAW_PILE_BOTTOM
+        return draw_pile_counts;
+    }
 }
 
 template <enum shared::CardAccess PILE>
-inline bool server::Player::hasCard(const shared::CardBase::id_t &card_id) const
+inline const server::CardCounter &server::Player::getCounts() const
 {
-    const auto &cards = get<PILE>();
-    return std::find_if(cards.begin(), cards.end(), [card_id](const auto &id) { return id == card_id; }) != cards.end();
+    static_assert(PILE != shared::TRASH && "Player does not have access to the trash pile!");
+    if constexpr ( PILE == shared::DISCARD_PILE ) {
+        return discard_counts;
+    } else if constexpr ( PILE == shared::HAND ) {
+        return hand_counts;
+    } else if constexpr ( PILE == shared::STAGED_CARDS ) {
+        return staged_counts;
+    } else {
+        // DRAW_PILE_TOP and DRAW_PILE_BOTTOM
+        return draw_pile_counts;
+    }
 }
 
 template <enum shared::CardAccess PILE>
-inline bool server::Player::hasType(shared::CardType type) const
+inline void server::Player::shuffle()
 {
-    auto pile = get<PILE>();
-    return std::any_of(pile.begin(), pile.end(), [type](const auto &card_id)
-                       { return (shared::CardFactory::getCard(card_id).getType() & type) == type; });
+    auto &cards = getMutable<PILE>();
+    std::shuffle(cards.begin(), cards.end(), rng);
 }
 
 template <enum shared::CardAccess PILE>
-inline std::vector<shared::CardBase::id_t> server::Player::getType(shared::CardType type) const
+inline server::Player::pile_t server::Player::getType(shared::CardType type) const
 {
-    auto pile = get<PILE>();
-    std::vector<shared::CardBase::id_t> cards;
+    pile_t cards;
+    if ( getCounts<PILE>().empty() ) {
+        return cards;
+    }
+
+    const auto &pile = get<PILE>();
     std::copy_if(pile.begin(), pile.end(), std::back_inserter(cards),
-                 [type](const auto &card_id) { return (shared::CardFactory::getCard(card_id).getType() & type) != 0; });
+                 [type](card_handle_t card) { return (shared::CardFactory::getType(card) & type) != 0; });
     return cards;
 }
 
@@ -92,22 +110,23 @@ inline void server::Player::add(Iterator begin, Iterator end)
     } else {
         pile.insert(pile.end(), begin, end);
     }
+    getMutableCounts<TO>().add(begin, end);
 }
 
 template <enum shared::CardAccess TO>
-inline void server::Player::add(std::vector<shared::CardBase::id_t> &&cards)
+inline void server::Player::add(pile_t &&cards)
 {
-    add<TO>(std::make_move_iterator(cards.begin()), std::make_move_iterator(cards.end()));
+    add<TO>(cards.begin(), cards.end());
 }
 
 template <enum shared::CardAccess TO>
-inline void server::Player::add(const shared::CardBase::id_t &card_id)
+inline void server::Player::add(card_handle_t card)
 {
-    add<TO>(&card_id, &card_id + 1); // cursed lol
+    add<TO>(&card, &card + 1); // cursed lol
 }
 
 template <enum shared::CardAccess TO>
-inline void server::Player::add(const std::vector<shared::CardBase::id_t> &cards)
+inline void server::Player::add(const pile_t &cards)
 {
     add<TO>(cards.begin(), cards.end());
 }
@@ -115,68 +134,108 @@ inline void server::Player::add(const std::vector<shared::CardBase::id_t> &cards
 #pragma region MOVE
 
 template <enum shared::CardAccess FROM, enum shared::CardAccess TO>
-inline void server::Player::move(const shared::CardBase::id_t &card_id)
+inline void server::Player::move(card_handle_t card)
 {
     if constexpr ( TO == shared::TRASH ) {
-        take<FROM>(card_id);
+        take<FROM>(card);
     } else {
-        add<TO>(take<FROM>(card_id));
+        add<TO>(take<FROM>(card));
     }
 }
 
 template <enum shared::CardAccess FROM, enum shared::CardAccess TO>
-inline void server::Player::move(const std::vector<shared::CardBase::id_t> &cards)
+inline void server::Player::move(const pile_t &cards)
 {
     if ( cards.empty() ) {
         LOG(WARN) << "Tried to move an empty set of cards from " << toString(FROM) << " to " << toString(TO);
         return;
     }
 
-    std::for_each(cards.begin(), cards.end(), [this](const auto &card_id) { this->move<FROM, TO>(card_id); });
+    remove<FROM>(cards);
+    if constexpr ( TO != shared::TRASH ) {
+        add<TO>(cards.begin(), cards.end());
+    }
 }
 
 template <enum shared::CardAccess FROM, enum shared::CardAccess TO>
 inline void server::Player::move(unsigned int n)
 {
-    if constexpr ( TO == shared::TRASH ) {
-        take<FROM>(n);
-    } else {
+    constexpr auto is_draw_pile = [](shared::CardAccess pile)
+    { return pile == shared::DRAW_PILE_TOP || pile == shared::DRAW_PILE_BOTTOM; };
+
+    if constexpr ( is_draw_pile(FROM) && is_draw_pile(TO) ) {
+        // both ends of the same pile, the cards have to be copied out first
         add<TO>(take<FROM>(n));
+    } else {
+        // the cards go straight from one pile to the other
+        auto &pile = getMutable<FROM>();
+        n = prepareTake<FROM>(n);
+
+        const auto first = FROM == shared::DRAW_PILE_TOP ? pile.begin() : pile.end() - n;
+        const auto last = first + n;
+        getMutableCounts<FROM>().remove(first, last);
+        if constexpr ( TO != shared::TRASH ) {
+            add<TO>(first, last);
+        }
+        pile.erase(first, last);
     }
 }
 
 #pragma region TAKE
 
 template <enum shared::CardAccess FROM>
-inline shared::CardBase::id_t server::Player::take(const shared::CardBase::id_t &card_id)
+inline server::Player::card_handle_t server::Player::take(card_handle_t card)
 {
     static_assert(FROM != shared::TRASH && "Can not take cards from the trash pile!");
     static_assert((FROM != shared::DRAW_PILE_TOP && FROM != shared::DRAW_PILE_BOTTOM) &&
                   "Can not take card from the draw pile by ID!");
 
-    auto &pile = getMutable<FROM>();
-    auto it = std::find(pile.begin(), pile.end(), card_id);
-
-    if ( it == pile.end() ) {
-        LOG(ERROR) << "Card \'" << card_id << "\' does not exist in the pile " << toString(FROM);
+    if ( !getCounts<FROM>().contains(card) ) {
+        LOG(ERROR) << "Card \'" << card << "\' does not exist in the pile " << toString(FROM);
         throw exception::InvalidCardAccess();
     }
 
-    pile.erase(it);
-    return card_id;
+    // recently added cards are at the back, so that is where we start looking
+    auto &pile = getMutable<FROM>();
+    const auto it = std::prev(std::find(pile.rbegin(), pile.rend(), card).base());
+    if constexpr ( FROM == shared::HAND ) {
+        *it = pile.back();
+        pile.pop_back();
+    } else {
+        pile.erase(it);
+    }
+    getMutableCounts<FROM>().remove(card);
+    return card;
 }
 
 template <enum shared::CardAccess FROM>
-inline std::vector<shared::CardBase::id_t> server::Player::take(const std::vector<shared::CardBase::id_t> &cards)
+inline server::Player::pile_t server::Player::take(const pile_t &cards)
 {
-    std::vector<shared::CardBase::id_t> taken_cards;
-    std::for_each(cards.begin(), cards.end(),
-                  [&taken_cards, this](const auto &card_id) { taken_cards.push_back(this->take<FROM>(card_id)); });
-    return taken_cards;
+    remove<FROM>(cards);
+    return cards;
 }
 
 template <enum shared::CardAccess FROM>
-inline std::vector<shared::CardBase::id_t> server::Player::take(unsigned int n)
+inline void server::Player::remove(const pile_t &cards)
+{
+    static_assert(FROM != shared::TRASH && "Can not take cards from the trash pile!");
+    static_assert((FROM != shared::DRAW_PILE_TOP && FROM != shared::DRAW_PILE_BOTTOM) &&
+                  "Can not take card from the draw pile by ID!");
+
+    // check all cards up front, so that nothing is removed if one of them is missing
+    const auto &counts = getCounts<FROM>();
+    for ( const auto card : cards ) {
+        if ( counts.count(card) < std::count(cards.begin(), cards.end(), card) ) {
+            LOG(ERROR) << "Card \'" << card << "\' does not exist often enough in the pile " << toString(FROM);
+            throw exception::InvalidCardAccess();
+        }
+    }
+
+    std::for_each(cards.begin(), cards.end(), [this](card_handle_t card) { this->take<FROM>(card); });
+}
+
+template <enum shared::CardAccess FROM>
+inline unsigned int server::Player::prepareTake(unsigned int n)
 {
     auto &pile = getMutable<FROM>();
 
@@ -198,18 +257,27 @@ inline std::vector<shared::CardBase::id_t> server::Player::take(unsigned int n)
         }
     }
 
-    std::vector<shared::CardBase::id_t> taken_cards;
-    taken_cards.reserve(n);
+    return n;
+}
+
+template <enum shared::CardAccess FROM>
+inline server::Player::pile_t server::Player::take(unsigned int n)
+{
+    auto &pile = getMutable<FROM>();
+    n = prepareTake<FROM>(n);
+
+    pile_t taken_cards;
 
     if constexpr ( FROM == shared::DRAW_PILE_TOP ) {
         // take from top
-        taken_cards.assign(std::make_move_iterator(pile.begin()), std::make_move_iterator(pile.begin() + n));
+        taken_cards.assign(pile.begin(), pile.begin() + n);
         pile.erase(pile.begin(), pile.begin() + n);
     } else {
         // take from back
-        taken_cards.assign(std::make_move_iterator(pile.end() - n), std::make_move_iterator(pile.end()));
+        taken_cards.assign(pile.end() - n, pile.end());
         pile.erase(pile.end() - n, pile.end());
     }
+    getMutableCounts<FROM>().remove(taken_cards.begin(), taken_cards.end());
 
     return taken_cards;
 }
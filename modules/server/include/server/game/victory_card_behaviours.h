@@ -1,6 +1,8 @@
 
 #pragma once
 
+#include <server/game/card_counter.h>
+
 namespace server
 {
     /**
@@ -16,14 +18,14 @@ namespace server
         /**
          * @brief Get the victory points that this card is worth.
          *
-         * The function is provided with the complete deck of the player, so that
-         * the card can evaluate its victory points based on the other cards in the
-         * deck.
+         * The function is provided with the card counts of the complete deck of
+         * the player, so that the card can evaluate its victory points based on
+         * the other cards in the deck.
          *
-         * @param deck The complete deck of the player.
+         * @param deck The card counts of the complete deck of the player.
          * @return The number of victory points that this card is worth.
          */
-        virtual int getVictoryPoints(const std::vector<shared::CardBase::id_t> &deck) const = 0;
+        virtual int getVictoryPoints(const CardCounter &deck) const = 0;
     };
 
     /**
@@ -37,7 +39,7 @@ namespace server
     class ConstantVictoryPoints : public VictoryCardBehaviour
     {
     public:
-        int getVictoryPoints(const std::vector<shared::CardBase::id_t> & /*deck*/) const override { return N; }
+        int getVictoryPoints(const CardCounter & /*deck*/) const override { return N; }
     };
 
     /**
@@ -48,16 +50,16 @@ namespace server
      * @tparam points The number of victory points that each set of `perN` cards
      * is worth.
      * @tparam perN The number of cards that are required to get the victory points.
-     * @tparam Filter A callable object that takes a `shared::CardBase::id_t` and
+     * @tparam Filter A callable object that takes a `shared::CardBase::handle_t` and
      * returns `true` if the card is of the type that this card is looking for.
      */
     template <int points, int perN, auto Filter>
     class VictoryPointsPerNCards : public VictoryCardBehaviour
     {
     public:
-        int getVictoryPoints(const std::vector<shared::CardBase::id_t> &deck) const override
+        int getVictoryPoints(const CardCounter &deck) const override
         {
-            int count = std::count_if(deck.begin(), deck.end(), Filter);
+            const int count = static_cast<int>(deck.countIf(Filter));
             return points * (count / perN);
         }
     };
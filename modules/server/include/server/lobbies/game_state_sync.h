@@ -0,0 +1,56 @@
+#pragma once
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+#include <shared/game/game_state/reduced_game_state.h>
+#include <shared/message_types.h>
+
+namespace server
+{
+    /**
+     * @brief Decides for every player of a lobby whether a game state goes out as a full GameStateMessage or as a
+     * GameStateDeltaMessage.
+     *
+     * For every player the last state they received is kept. Following states are sent as deltas against it, a full
+     * state (keyframe) is sent first, every KEYFRAME_INTERVAL updates, and when the client asks for the state itself
+     * (which is how it recovers from a missed delta). Versions count per player.
+     *
+     * Like the lobby that owns it, this is not thread safe.
+     */
+    class GameStateSync
+    {
+    public:
+        static constexpr unsigned int KEYFRAME_INTERVAL = 32;
+
+        /**
+         * @brief Builds the message that brings the player from their last state to game_state.
+         *
+         * @param in_response_to set if the player requested the state, such a request always gets a full state.
+         */
+        std::unique_ptr<shared::ServerToClientMessage>
+        makeUpdate(const std::string &lobby_id, const shared::PlayerBase::id_t &player_id,
+                   std::unique_ptr<reduced::GameState> game_state,
+                   std::optional<std::string> in_response_to = std::nullopt);
+
+        /**
+         * @brief The next update of the player will be a full state.
+         */
+        void requestKeyframe(const shared::PlayerBase::id_t &player_id);
+
+        void removePlayer(const shared::PlayerBase::id_t &player_id);
+
+    private:
+        struct Entry
+        {
+            unsigned int version = 0;
+            unsigned int since_keyframe = 0;
+            // the state the player has, with version
+            std::unique_ptr<reduced::GameState> snapshot;
+        };
+
+        std::unordered_map<shared::PlayerBase::id_t, Entry> entries;
+    };
+} // namespace server
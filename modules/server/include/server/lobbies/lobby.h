@@ -5,7 +5,9 @@
 
 #include <server/game/game_interface.h>
 #include <server/game/game_state.h>
+#include <server/lobbies/game_state_sync.h>
 #include <server/network/message_interface.h>
+#include <server/utils/mailbox.h>
 
 #include <shared/message_types.h>
 #include "server/network/basic_network.h"
@@ -17,6 +19,8 @@ namespace server
      *
      * A lobby is created by a game master, who is the first player to join the lobby.
      * The game master can start the game when they want to.
+     *
+     * A lobby is not thread safe, everything that touches it has to be posted to its mailbox.
      */
     class Lobby
     {
@@ -26,9 +30,10 @@ namespace server
          * Game master is added to the players of the lobby.
          *
          * @param game_master The player who created the lobby.
+         * @param pool The pool the mailbox of the lobby runs on, nullptr runs it on the posting thread.
          */
-        Lobby(const Player::id_t &game_master,
-              const std::string &lobby_id); // TODO: add message_interface shared_ptr here
+        Lobby(const Player::id_t &game_master, const std::string &lobby_id,
+              WorkerPool *pool = nullptr); // TODO: add message_interface shared_ptr here
 
         /**
          * @brief The lobby receives a generic message. It handles what it is responsible for and the rest gets passed
@@ -59,6 +64,8 @@ namespace server
          */
         const Player::id_t &getGameMaster() const { return game_master; };
 
+        Mailbox &getMailbox() { return mailbox; }
+
         bool isGameOver() const { return (game_interface != nullptr) && (game_interface->isGameOver()); }
 
         /**
@@ -96,6 +103,10 @@ namespace server
         std::vector<Player::id_t> players;
         std::string lobby_id;
 
+        GameStateSync game_state_sync;
+
+        Mailbox mailbox;
+
 
         /**
          * @brief Adds a player to the lobby if the neccessary conditions are met.
@@ -142,25 +153,31 @@ namespace server
             return std::any_of(players.begin(), players.end(), [&](const auto &player) { return player == player_id; });
         }
 
+        /**
+         * @brief Sends the gamestate of a player, as a delta if possible.
+         */
+        inline void sendGameState(MessageInterface &message_interface, const Player::id_t &player_id)
+        {
+            LOG(INFO) << "Sending game state in Lobby ID: " << lobby_id << " to Player ID: " << player_id;
+            const auto update =
+                    game_state_sync.makeUpdate(lobby_id, player_id, game_interface->getGameState(player_id));
+            message_interface.sendMessage(*update, player_id);
+        }
+
         /**
          * @brief Broadcasts the gamestate to all players in the lobby.
          */
-        inline void broadcastGameState(MessageInterface &message_interface) const
+        inline void broadcastGameState(MessageInterface &message_interface)
         {
             std::for_each(players.begin(), players.end(),
-                          [&](const auto &player_id)
-                          {
-                              LOG(INFO) << "Sending GameStateMessage in Lobby ID: " << lobby_id
-                                        << " to Player ID: " << player_id;
-                              message_interface.send<shared::GameStateMessage>(player_id, lobby_id,
-                                                                               game_interface->getGameState(player_id));
-                          });
+                          [&](const auto &player_id) { sendGameState(message_interface, player_id); });
         }
 
         /**
          * @brief If a player received an order we send it, else we send the gamestate.
+         * Orders carry a full state, which does not replace the state deltas are based on.
          */
-        inline void broadcastOrders(MessageInterface &message_interface, OrderResponse &orders) const
+        inline void broadcastOrders(MessageInterface &message_interface, OrderResponse &orders)
         {
             if ( orders.empty() ) {
                 broadcastGameState(message_interface);
@@ -175,8 +192,7 @@ namespace server
                                           player_id, lobby_id, std::move(orders.getOrder(player_id)),
                                           game_interface->getGameState(player_id));
                               } else {
-                                  message_interface.send<shared::GameStateMessage>(
-                                          player_id, lobby_id, std::move(game_interface->getGameState(player_id)));
+                                  sendGameState(message_interface, player_id);
                               }
                           });
         }
@@ -1,12 +1,13 @@
-
 #pragma once
 
 #include <map>
 #include <memory>
+#include <shared_mutex>
 #include <string>
 
 #include <server/lobbies/lobby.h>
 #include <server/network/message_interface.h>
+#include <server/utils/worker_pool.h>
 
 #include <shared/game/game_state/reduced_game_state.h>
 #include <shared/message_types.h>
@@ -19,6 +20,9 @@ namespace server
      *
      * The lobby manager is responsible for creating, joining and starting games.
      * It also receives actions from players and passes them on to the correct game.
+     *
+     * Every lobby is an actor: the manager only looks the lobby up and posts the message to the lobby's mailbox, so
+     * messages for one game are handled one at a time while different games run in parallel on the worker pool.
      */
     class LobbyManager
     {
@@ -29,8 +33,15 @@ namespace server
          * @brief Create a new lobby manager.
          *
          * @param message_interface The message interface to send messages to the players.
+         * @param pool The pool the lobbies run on. Without a pool messages are handled on the calling thread.
+         */
+        LobbyManager(std::shared_ptr<MessageInterface> message_interface, std::unique_ptr<WorkerPool> pool = nullptr) :
+            message_interface(message_interface), pool(std::move(pool)){};
+
+        /**
+         * @brief Handles the messages that are still queued before the lobbies are destroyed.
          */
-        LobbyManager(std::shared_ptr<MessageInterface> message_interface) : message_interface(message_interface){};
+        ~LobbyManager() { pool.reset(); }
 
         /**
          * @brief The manager will now receive a message and only handle the lobby creation.
@@ -44,6 +55,7 @@ namespace server
          * @brief Get the games that are currently running.
          *
          * THIS IS ONLY FOR TESTING. WOULD BE NICE TO REMOVE THIS
+         * The map is not synchronised, only use it without a worker pool.
          *
          * @return A const reference to the map of lobby ids.
          */
@@ -52,11 +64,14 @@ namespace server
         /**
          * @brief Remove a player from his lobby and close the lobby if the game is in progress
          */
-        void removePlayer(std::string &lobby_id, player_id_t &player_id);
+        void removePlayer(const std::string &lobby_id, const player_id_t &player_id);
 
     private:
         std::map<std::string, std::shared_ptr<Lobby>> games;
+        // only guards the map, the lobbies themselves are protected by their mailbox
+        mutable std::shared_mutex games_mutex;
         std::shared_ptr<MessageInterface> message_interface;
+        std::unique_ptr<WorkerPool> pool;
 
         /**
          * @brief Create a new lobby.
@@ -67,12 +82,32 @@ namespace server
         void createLobby(std::unique_ptr<shared::CreateLobbyRequestMessage> &request);
 
         /**
-         * @brief Check if a lobby exists.
-         *
-         * @param lobby_id The id of the lobby to check.
+         * @brief Runs in the mailbox of the lobby.
+         */
+        void handleLobbyMessage(const std::shared_ptr<Lobby> &lobby,
+                                std::unique_ptr<shared::ClientToServerMessage> &message);
+
+        /**
+         * @brief Runs in the mailbox of the lobby.
+         */
+        void handleRemovePlayer(const std::string &lobby_id, const std::shared_ptr<Lobby> &lobby,
+                                player_id_t &player_id);
+
+        /**
+         * @return The lobby with the given id, nullptr if it does not exist.
+         */
+        std::shared_ptr<Lobby> getLobby(const std::string &lobby_id) const;
+
+        /**
+         * @brief A lobby can be closed while messages for it are still queued in its mailbox.
          *
-         * @return True if the lobby exists, false otherwise.
+         * @return True if the lobby is still the one registered under its id.
+         */
+        bool isOpen(const std::string &lobby_id, const std::shared_ptr<Lobby> &lobby) const;
+
+        /**
+         * @brief Removes the lobby from the running games.
          */
-        inline bool lobbyExists(std::string lobby_id) { return games.find(lobby_id) != games.end(); }
+        void closeLobby(const std::string &lobby_id, const std::shared_ptr<Lobby> &lobby);
     };
 } // namespace server
@@ -1,25 +1,29 @@
 #pragma once
 
-#include <shared_mutex>
-#include <sstream>
 #include <string>
-#include <unordered_map>
+#include <vector>
 
 #include <sockpp/tcp_socket.h>
 
+#include <server/network/connection.h>
+#include <server/utils/sharded_map.h>
+#include <shared/message_types.h>
+
 using addr_t = sockpp::tcp_socket::addr_t;
 using player_id_t = std::string;
 
 namespace server
 {
+    /**
+     * @brief Registry of all connections and the players registered over them.
+     *
+     * A connection knows its player and lobby, so the registry only needs two sharded maps: sends to different players
+     * lock different shards and never contend.
+     */
     class BasicNetwork
     {
-        inline static std::unordered_map<player_id_t, std::string> _player_id_to_address;
-        inline static std::unordered_map<player_id_t, std::string> _player_id_to_lobby_id;
-        inline static std::unordered_map<std::string, sockpp::tcp_socket> _address_to_socket;
-        inline static std::unordered_map<std::string, player_id_t> _address_to_player_id;
-
-        inline static std::shared_mutex _rw_lock;
+        inline static ShardedMap<std::string, Connection::ptr_t> _address_to_connection;
+        inline static ShardedMap<player_id_t, Connection::ptr_t> _player_id_to_connection;
 
     public:
         static void playerDisconnect(const std::string &address);
@@ -40,6 +44,23 @@ namespace server
          */
         static ssize_t sendToPlayer(const std::string &message, const player_id_t &player_id);
 
+        /**
+         * @brief Sends a message to the specified player_id, encoded in the wire format of its connection.
+         *
+         * @param message
+         * @param player_id
+         */
+        static ssize_t sendToPlayer(const shared::ServerToClientMessage &message, const player_id_t &player_id);
+
+        /**
+         * @brief Sends the same message to all given players.
+         *
+         * The message is encoded at most once per wire format, every connection queues a reference to the same frame.
+         *
+         * @return The number of players the message was queued for.
+         */
+        static size_t broadcast(const shared::ServerToClientMessage &message, const std::vector<player_id_t> &players);
+
         /**
          * @brief Maps a player ID to a network address.
          *
@@ -50,18 +71,16 @@ namespace server
                                        const std::string &address);
 
         /**
-         * @brief Maps a network address to a socket.
+         * @brief Makes a connection reachable under its address.
          *
-         * @param address
-         * @param socket
+         * @param connection
          */
-        static void addAddressToSocket(const std::string &address, sockpp::tcp_socket socket);
+        static void addConnection(const Connection::ptr_t &connection);
 
     private:
-        // DISCLAIMER: we assume the caller holds the neccessary locks here!
+        static ssize_t send(const std::string &message, const Connection::ptr_t &connection);
+        static ssize_t send(const shared::ServerToClientMessage &message, const Connection::ptr_t &connection);
 
-        static const std::string &getAddress(const player_id_t &player_id);
-        static sockpp::tcp_socket *getSocket(const std::string &address);
-        static bool isNewPlayer(const player_id_t &player_id);
+        static void rejectPlayer(const std::string &address, const std::string &reason);
     };
 } // namespace server
@@ -0,0 +1,157 @@
+#pragma once
+
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+
+#include <sockpp/tcp_socket.h>
+
+#include <shared/utils/binary.h>
+#include <shared/utils/frame_decoder.h>
+#include <shared/utils/json.h>
+
+namespace server
+{
+    /**
+     * @brief A non-blocking client connection, driven by the Reactor.
+     *
+     * Reads only ever happen on the I/O thread that owns the connection. Writes may come from any thread: they only
+     * append the frame to a bounded outbound queue and arm EPOLLOUT, the I/O thread then writes all queued frames with
+     * as few calls as possible. A client that does not keep up and lets the queue overflow is disconnected.
+     */
+    class Connection
+    {
+    public:
+        using ptr_t = std::shared_ptr<Connection>;
+        // the message is only valid during the call, it may be parsed in place and is followed by a '\0'
+        using message_handler_t = std::function<void(std::span<char> message)>;
+        // an encoded frame, immutable so a broadcast can queue the same buffer on every connection
+        using frame_t = std::shared_ptr<const std::string>;
+
+        // a few hundred game states, a client that is this far behind will not catch up anymore
+        static constexpr size_t MAX_QUEUED_BYTES = 8 << 20;
+
+        /**
+         * @param socket connected socket, it is switched to non-blocking mode
+         * @param epoll_fd the epoll instance of the I/O thread that will own this connection
+         */
+        Connection(sockpp::tcp_socket socket, int epoll_fd);
+        ~Connection();
+
+        Connection(const Connection &) = delete;
+        Connection &operator=(const Connection &) = delete;
+
+        const std::string &getAddress() const { return address; }
+        int getHandle() const { return socket.handle(); }
+        int getEpoll() const { return epoll_fd; }
+        bool isClosed() const { return closed; }
+
+        /**
+         * @brief The player that registered over this connection, empty until the first request of a player.
+         * Only touched by the owning I/O thread.
+         */
+        const std::string &getPlayerId() const { return player_id; }
+        const std::string &getLobbyId() const { return lobby_id; }
+        bool hasPlayer() const { return !player_id.empty(); }
+
+        void setPlayer(const std::string &player_id, const std::string &lobby_id)
+        {
+            this->player_id = player_id;
+            this->lobby_id = lobby_id;
+        }
+
+        /**
+         * @brief Parser for the JSON messages of this connection, reusing its memory for every message.
+         * Only touched by the owning I/O thread.
+         */
+        shared::InSituJsonParser &getJsonParser() { return json_parser; }
+
+        /**
+         * @brief The format the client chose with its first request, JSON until then.
+         */
+        shared::WireFormat getWireFormat() const { return wire_format; }
+
+        /**
+         * @brief Queues a frame for sending, never blocks and never touches the socket itself.
+         *
+         * @return The number of bytes queued, -1 if the connection is closed or the queue overflowed.
+         */
+        ssize_t send(std::string frame);
+
+        /**
+         * @brief Queues a frame that may be shared with other connections, it is only referenced, never copied.
+         */
+        ssize_t send(frame_t frame);
+
+        size_t getQueuedBytes() const;
+
+        /**
+         * @brief Reads what is available on the socket and passes every complete message to the handler.
+         *
+         * @return false if the connection was closed by the peer or is broken.
+         */
+        bool onReadable(const message_handler_t &handler);
+
+        /**
+         * @brief Writes queued frames.
+         *
+         * @return false if the connection is broken.
+         */
+        bool onWritable();
+
+        /**
+         * @brief Shuts the socket down, later sends fail. The connection has to be removed from epoll beforehand.
+         */
+        void close();
+
+    private:
+        /**
+         * @brief Writes as much of the queue as the socket accepts. Expects write_mutex to be held.
+         * @return false if the connection is broken.
+         */
+        bool flush();
+
+        /**
+         * @brief Disconnects a client whose queue overflowed. Expects write_mutex to be held.
+         */
+        void evict();
+
+        /**
+         * @brief Registers or unregisters interest in EPOLLOUT. Expects write_mutex to be held.
+         */
+        void setWriteInterest(bool enabled);
+
+        /**
+         * @brief Passes all complete frames of the decoder to the handler.
+         * @return false if the stream is malformed.
+         */
+        bool dispatchMessages(const message_handler_t &handler);
+
+        sockpp::tcp_socket socket;
+        const std::string address;
+        const int epoll_fd;
+
+        // only touched by the owning I/O thread
+        shared::FrameDecoder decoder;
+        shared::InSituJsonParser json_parser;
+        std::string player_id;
+        std::string lobby_id;
+        bool negotiated = false;
+
+        mutable std::mutex write_mutex;
+        std::deque<frame_t> write_queue;
+        // bytes of the front frame that were already written
+        size_t write_offset = 0;
+        size_t queued_bytes = 0;
+        bool write_interest = false;
+        bool evicted = false;
+
+        // written once by the I/O thread, read by whoever sends
+        std::atomic<shared::WireFormat> wire_format{shared::WireFormat::JSON};
+        std::atomic<bool> closed{false};
+    };
+} // namespace server
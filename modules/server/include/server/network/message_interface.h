@@ -1,5 +1,7 @@
 #pragma once
 
+#include <vector>
+
 #include <server/network/basic_network.h>
 #include <shared/message_types.h>
 
@@ -22,6 +24,18 @@ namespace server
         virtual void sendMessage(const shared::ServerToClientMessage &message,
                                  const shared::PlayerBase::id_t &player_id) = 0;
 
+        /**
+         * @brief Sends the same message to all given players. Sends it to each player by default, the network
+         * implementation serializes it only once.
+         */
+        virtual void broadcastMessage(const shared::ServerToClientMessage &message,
+                                      const std::vector<shared::PlayerBase::id_t> &players)
+        {
+            for ( const auto &player_id : players ) {
+                sendMessage(message, player_id);
+            }
+        }
+
         /**
          * @brief Sends a message of provided type to given player.
          *
@@ -49,9 +63,7 @@ namespace server
                           "T must derive from shared::ServerToClientMessage");
 
             const T message(std::forward<Args>(args)...);
-            for ( const auto &player_id : players ) {
-                sendMessage(message, player_id);
-            }
+            broadcastMessage(message, players);
         }
     };
 
@@ -62,6 +74,8 @@ namespace server
         ~ImplementedMessageInterface() override = default;
         void sendMessage(const shared::ServerToClientMessage &message,
                          const shared::PlayerBase::id_t &player_id) override;
+        void broadcastMessage(const shared::ServerToClientMessage &message,
+                              const std::vector<shared::PlayerBase::id_t> &players) override;
     };
 
 } // namespace server
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <ostream>
+
+#include <shared/message_types.h>
+
+namespace server
+{
+    /**
+     * @brief Process wide counters of the network path, cheap enough to be updated on every message.
+     */
+    struct NetworkMetrics
+    {
+        std::atomic<uint64_t> frames_queued{0};
+        std::atomic<uint64_t> frames_sent{0};
+        std::atomic<uint64_t> bytes_sent{0};
+        // a single call can write many frames, frames_sent / write_calls is the batching factor
+        std::atomic<uint64_t> write_calls{0};
+        // connections that were dropped because their outbound queue overflowed
+        std::atomic<uint64_t> slow_consumers{0};
+        std::atomic<uint64_t> dropped_frames{0};
+        // frames of a broadcast that reused the buffer encoded for an earlier recipient
+        std::atomic<uint64_t> shared_frames{0};
+        // high watermark of a single outbound queue
+        std::atomic<uint64_t> max_queued_bytes{0};
+        // inbound requests by their shared::MessageTag
+        std::array<std::atomic<uint64_t>, std::numeric_limits<std::underlying_type_t<shared::MessageTag>>::max() + 1>
+                requests{};
+
+        static NetworkMetrics &get();
+
+        void updateMaxQueuedBytes(uint64_t queued);
+
+        void countRequest(shared::MessageTag tag)
+        {
+            requests[static_cast<size_t>(tag)].fetch_add(1, std::memory_order_relaxed);
+        }
+    };
+
+    std::ostream &operator<<(std::ostream &os, const NetworkMetrics &metrics);
+} // namespace server
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <server/network/connection.h>
+
+namespace server
+{
+    /**
+     * @brief Event loop for all client connections, based on epoll.
+     *
+     * A fixed number of I/O threads each own an epoll instance, new connections are distributed round robin among them.
+     * An idle connection costs a socket and two empty buffers instead of a blocked thread.
+     */
+    class Reactor
+    {
+    public:
+        // the message is only valid during the call, see Connection::message_handler_t
+        using message_handler_t = std::function<void(std::span<char> message, Connection &connection)>;
+        using disconnect_handler_t = std::function<void(const std::string &address)>;
+
+        /**
+         * @param io_threads number of I/O threads, 0 uses one per core
+         * @param message_handler called on an I/O thread for every complete message
+         * @param disconnect_handler called on an I/O thread once a connection is closed
+         */
+        Reactor(size_t io_threads, message_handler_t message_handler, disconnect_handler_t disconnect_handler);
+
+        /**
+         * @brief Stops and joins the I/O threads and closes all remaining connections.
+         */
+        ~Reactor();
+
+        Reactor(const Reactor &) = delete;
+        Reactor &operator=(const Reactor &) = delete;
+
+        /**
+         * @brief Wraps the socket into a connection that belongs to one of the I/O threads.
+         * Nothing is read from it before start is called.
+         */
+        Connection::ptr_t makeConnection(sockpp::tcp_socket socket);
+
+        /**
+         * @brief Starts reading from the connection.
+         */
+        void start(const Connection::ptr_t &connection);
+
+        size_t getThreadCount() const { return loops.size(); }
+
+    private:
+        struct IoLoop
+        {
+            int epoll_fd = -1;
+            int wake_fd = -1;
+            std::thread thread;
+
+            std::mutex mutex;
+            std::unordered_map<int, Connection::ptr_t> connections;
+        };
+
+        void run(IoLoop &loop);
+        void remove(IoLoop &loop, const Connection::ptr_t &connection);
+        IoLoop &getLoop(const Connection::ptr_t &connection);
+
+        std::vector<std::unique_ptr<IoLoop>> loops;
+        std::atomic<size_t> next_loop{0};
+        std::atomic<bool> running{true};
+
+        message_handler_t message_handler;
+        disconnect_handler_t disconnect_handler;
+    };
+} // namespace server
@@ -14,10 +14,9 @@
 #include <server/lobbies/lobby_manager.h>
 #include <server/network/basic_network.h>
 #include <server/network/message_interface.h>
+#include <server/network/reactor.h>
 #include <shared/message_types.h>
 
-using handler = std::function<void(const std::string &, const sockpp::tcp_socket::addr_t &)>;
-
 namespace server
 {
     const std::string DEFAULT_SERVER_HOST = "127.0.0.1";
@@ -29,7 +28,14 @@ namespace server
         ServerNetworkManager();
         ~ServerNetworkManager();
 
-        void run(const std::string &host = DEFAULT_SERVER_HOST, uint16_t port = DEFAULT_PORT);
+        /**
+         * @brief Accepts clients until the acceptor fails.
+         *
+         * @param io_threads number of threads serving the connections, 0 uses one per core
+         * @param game_threads number of threads running the lobbies, 0 uses one per core
+         */
+        void run(const std::string &host = DEFAULT_SERVER_HOST, uint16_t port = DEFAULT_PORT, size_t io_threads = 0,
+                 size_t game_threads = 0);
 
         // function to send via the BasicNetwork class
         static ssize_t sendMessage(std::unique_ptr<shared::ServerToClientMessage> message,
@@ -42,28 +48,30 @@ namespace server
          *
          * @param player_id the id of the player to remove
          */
-        static void removePlayer(std::string &lobby_id, player_id_t &player_id);
+        static void removePlayer(const std::string &lobby_id, const player_id_t &player_id);
 
     private:
         // Lobby object to pass received messages to
-        static LobbyManager _lobby_manager;
+        inline static std::unique_ptr<LobbyManager> _lobby_manager;
 
         inline static ServerNetworkManager *_instance;
 
         inline static std::shared_mutex _rw_lock;
         inline static sockpp::tcp_acceptor _acc;
 
+        // serves all client connections, the listener loop only accepts them
+        inline static std::unique_ptr<Reactor> _reactor;
+
         // message interface gets passes to lobby manager etc. for the to send to clients later
         static std::shared_ptr<MessageInterface> _message_interface;
 
         // connect new clients
         void connect(const uint16_t port);
 
-        // function that listens to new clients
+        // function that listens to new clients and hands them to the reactor
         static void listenerLoop();
-        static void readLoop(sockpp::tcp_socket socket, const handler &message_handler);
 
-        // might get removed later
-        static void handleMessage(const std::string & /*msg*/, const sockpp::tcp_socket::addr_t & /*peer_address*/);
+        // called by the reactor for every complete message, JSON is parsed in place
+        static void handleMessage(std::span<char> msg, Connection &connection);
     };
 } // namespace server
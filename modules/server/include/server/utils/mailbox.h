@@ -0,0 +1,48 @@
+#pragma once
+
+#include <deque>
+#include <memory>
+#include <mutex>
+
+#include <server/utils/worker_pool.h>
+
+namespace server
+{
+    /**
+     * @brief Serialises the tasks posted to it, which turns its owner into an actor.
+     *
+     * Tasks run one after another in the order they were posted, never concurrently, so the state they touch needs no
+     * further locking. Different mailboxes run in parallel on the worker pool. Without a pool a task runs on the thread
+     * that posts it, unless another thread is already draining the mailbox, then that thread runs it.
+     */
+    class Mailbox
+    {
+    public:
+        /**
+         * @param pool where the mailbox is drained, nullptr drains it on the posting thread
+         */
+        explicit Mailbox(WorkerPool *pool = nullptr);
+
+        void post(Task task);
+
+        /**
+         * @brief Number of tasks that wait to be run, mostly useful for tests and diagnostics.
+         */
+        size_t size() const;
+
+    private:
+        struct State
+        {
+            WorkerPool *pool;
+            mutable std::mutex mutex;
+            std::deque<Task> tasks;
+            // set while a thread drains the mailbox or a drain is queued on the pool
+            bool scheduled = false;
+        };
+
+        // runs queued tasks, the state is shared with queued drains so it survives the mailbox
+        static void drain(const std::shared_ptr<State> &state);
+
+        std::shared_ptr<State> state;
+    };
+} // namespace server
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <array>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <unordered_map>
+#include <utility>
+
+namespace server
+{
+    /**
+     * @brief A hash map split into independently locked shards.
+     *
+     * Operations on keys in different shards never contend, readers of the same shard share its lock. Values are
+     * returned by copy, so they should be cheap to copy (ids, shared pointers).
+     *
+     * @tparam SHARDS number of shards, a power of two
+     */
+    template <typename Key, typename Value, size_t SHARDS = 64, typename Hash = std::hash<Key>>
+    class ShardedMap
+    {
+        static_assert(SHARDS > 0 && (SHARDS & (SHARDS - 1)) == 0, "SHARDS must be a power of two");
+
+    public:
+        std::optional<Value> find(const Key &key) const
+        {
+            const auto &shard = getShard(key);
+            std::shared_lock<std::shared_mutex> lock(shard.mutex);
+            const auto it = shard.map.find(key);
+            if ( it == shard.map.end() ) {
+                return std::nullopt;
+            }
+            return it->second;
+        }
+
+        /**
+         * @brief Inserts the value unless the key is already present.
+         *
+         * @return The value stored under the key afterwards and whether it was inserted.
+         */
+        std::pair<Value, bool> tryEmplace(const Key &key, Value value)
+        {
+            auto &shard = getShard(key);
+            std::unique_lock<std::shared_mutex> lock(shard.mutex);
+            const auto [it, inserted] = shard.map.try_emplace(key, std::move(value));
+            return {it->second, inserted};
+        }
+
+        /**
+         * @brief Removes the key.
+         *
+         * @return The value that was stored under it.
+         */
+        std::optional<Value> take(const Key &key)
+        {
+            auto &shard = getShard(key);
+            std::unique_lock<std::shared_mutex> lock(shard.mutex);
+            const auto it = shard.map.find(key);
+            if ( it == shard.map.end() ) {
+                return std::nullopt;
+            }
+            Value value = std::move(it->second);
+            shard.map.erase(it);
+            return value;
+        }
+
+        /**
+         * @brief Removes the key only if it still maps to the expected value.
+         */
+        bool eraseIf(const Key &key, const Value &expected)
+        {
+            auto &shard = getShard(key);
+            std::unique_lock<std::shared_mutex> lock(shard.mutex);
+            const auto it = shard.map.find(key);
+            if ( it == shard.map.end() || !(it->second == expected) ) {
+                return false;
+            }
+            shard.map.erase(it);
+            return true;
+        }
+
+        /**
+         * @brief Locks the shards one after another, the result is not a snapshot while others write.
+         */
+        size_t size() const
+        {
+            size_t size = 0;
+            for ( const auto &shard : shards ) {
+                std::shared_lock<std::shared_mutex> lock(shard.mutex);
+                size += shard.map.size();
+            }
+            return size;
+        }
+
+    private:
+        // one cache line per shard, so the locks of neighbouring shards do not share it
+        struct alignas(64) Shard
+        {
+            mutable std::shared_mutex mutex;
+            std::unordered_map<Key, Value, Hash> map;
+        };
+
+        Shard &getShard(const Key &key) { return shards[Hash{}(key) & (SHARDS - 1)]; }
+        const Shard &getShard(const Key &key) const { return shards[Hash{}(key) & (SHARDS - 1)]; }
+
+        std::array<Shard, SHARDS> shards;
+    };
+} // namespace server
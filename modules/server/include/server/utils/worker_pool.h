@@ -0,0 +1,100 @@
+#pragma once
+
+#include <atomic>
+#include <concepts>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace server
+{
+    /**
+     * @brief A callable that is run exactly once. Unlike std::function it can own move-only state, e.g. a message.
+     */
+    class Task
+    {
+    public:
+        Task() = default;
+
+        template <typename F>
+            requires(!std::same_as<std::decay_t<F>, Task> && std::invocable<F &>)
+        Task(F func) : impl(std::make_unique<Impl<F>>(std::move(func)))
+        {}
+
+        void operator()() { impl->run(); }
+        explicit operator bool() const { return impl != nullptr; }
+
+    private:
+        struct Base
+        {
+            virtual ~Base() = default;
+            virtual void run() = 0;
+        };
+
+        template <typename F>
+        struct Impl : Base
+        {
+            explicit Impl(F func) : func(std::move(func)) {}
+            void run() override { func(); }
+            F func;
+        };
+
+        std::unique_ptr<Base> impl;
+    };
+
+    /**
+     * @brief Fixed-size thread pool with work stealing.
+     *
+     * Every worker has its own queue. Tasks submitted from a worker stay on its queue (they are likely to touch the
+     * same data), tasks from other threads are distributed round robin. An idle worker steals from the others before it
+     * goes to sleep.
+     */
+    class WorkerPool
+    {
+    public:
+        /**
+         * @param threads number of workers, 0 uses one per core
+         */
+        explicit WorkerPool(size_t threads = 0);
+
+        /**
+         * @brief Runs the tasks that are still queued, then joins the workers.
+         */
+        ~WorkerPool();
+
+        WorkerPool(const WorkerPool &) = delete;
+        WorkerPool &operator=(const WorkerPool &) = delete;
+
+        void submit(Task task);
+
+        size_t getThreadCount() const { return workers.size(); }
+
+    private:
+        struct Worker
+        {
+            std::mutex mutex;
+            std::deque<Task> tasks;
+            std::thread thread;
+        };
+
+        void run(size_t index);
+
+        /**
+         * @brief Takes the oldest task of the own queue, or steals the newest one of another worker.
+         * The own queue is FIFO so a mailbox that reschedules itself can not starve the tasks queued before it.
+         */
+        bool pop(size_t index, Task &task);
+
+        std::vector<std::unique_ptr<Worker>> workers;
+        std::atomic<size_t> next_worker{0};
+
+        std::mutex idle_mutex;
+        std::condition_variable idle;
+        // submitted but not yet taken, only incremented while idle_mutex is held so no wakeup gets lost
+        std::atomic<size_t> pending{0};
+        bool stopping = false;
+    };
+} // namespace server
@@ -11,6 +11,9 @@ int main(int argc, char *argv[])
 
     shared::Logger::initialize();
     shared::Logger::setLevel(args.getLogLevel());
+    for ( const auto &[module, level] : args.getModuleLogLevels() ) {
+        shared::Logger::setLevel(module, level);
+    }
     shared::Logger::writeTo(args.getLogFile());
 
     LOG(DEBUG) << "Initialized logger, log level: " << shared::Logger::getLevel();
@@ -26,7 +29,7 @@ int main(int argc, char *argv[])
     while ( true ) {
         try {
             server::ServerNetworkManager server;
-            server.run(server::DEFAULT_SERVER_HOST, args.getPort());
+            server.run(server::DEFAULT_SERVER_HOST, args.getPort(), args.getIoThreads(), args.getGameThreads());
         } catch ( const std::exception &e ) {
             LOG(ERROR) << "Unhandled exception: " << e.what();
             LOG(DEBUG) << "Restarting server...";
@@ -1,4 +1,6 @@
 
+#include <sstream>
+
 #include <quick_arg_parser.hpp>
 #include <server/args.h>
 #include <server/network/server_network_manager.h>
@@ -10,7 +12,11 @@ namespace server
     {
         std::string logFile = option("log-file", 'f', "Log file") = "";
         std::string logLevel = option("log-level", 'l', "Log level") = "warn";
+        std::string logModules =
+                option("log-modules", 'm', "Log levels of single modules, e.g. network=info,game=debug") = "";
         uint16_t port = option("port", 'p', "Port") = DEFAULT_PORT;
+        int ioThreads = option("io-threads", 't', "Number of network I/O threads, 0 uses one per core") = 0;
+        int gameThreads = option("game-threads", 'g', "Number of threads running the lobbies, 0 uses one per core") = 0;
         bool debug = (option("debug", 'D', "Enable debug mode") = false);
     };
 
@@ -20,6 +26,28 @@ namespace server
         std::exit(1);
     }
 
+    /**
+     * @brief Parses a comma separated list of module=level pairs.
+     */
+    std::vector<std::pair<shared::LogModule, LogLevel>> parseModuleLogLevels(const std::string &modules)
+    {
+        std::vector<std::pair<shared::LogModule, LogLevel>> levels;
+        std::istringstream stream(modules);
+        for ( std::string entry; std::getline(stream, entry, ','); ) {
+            const auto separator = entry.find('=');
+            if ( separator == std::string::npos ) {
+                die("Invalid module log level: " + entry);
+            }
+            const auto module = shared::parseLogModule(entry.substr(0, separator));
+            const auto level = shared::parseLogLevel(entry.substr(separator + 1));
+            if ( !module.has_value() || !level.has_value() ) {
+                die("Invalid module log level: " + entry);
+            }
+            levels.emplace_back(module.value(), level.value());
+        }
+        return levels;
+    }
+
     ServerArgs::ServerArgs(int argc, char **argv)
     {
         try {
@@ -31,7 +59,16 @@ namespace server
             } else {
                 die("Invalid log level");
             }
+            _module_log_levels = parseModuleLogLevels(impl.logModules);
             _port = impl.port;
+            if ( impl.ioThreads < 0 ) {
+                die("Invalid number of I/O threads");
+            }
+            _io_threads = impl.ioThreads;
+            if ( impl.gameThreads < 0 ) {
+                die("Invalid number of game threads");
+            }
+            _game_threads = impl.gameThreads;
             _debug = impl.debug;
         } catch ( const QuickArgParserInternals::ArgumentError &e ) {
             die(e.what());
@@ -42,7 +79,13 @@ namespace server
 
     LogLevel ServerArgs::getLogLevel() { return _logLevel; }
 
+    std::vector<std::pair<shared::LogModule, LogLevel>> ServerArgs::getModuleLogLevels() { return _module_log_levels; }
+
     uint16_t ServerArgs::getPort() { return _port; }
 
+    size_t ServerArgs::getIoThreads() { return _io_threads; }
+
+    size_t ServerArgs::getGameThreads() { return _game_threads; }
+
     bool ServerArgs::isDebug() { return _debug; }
 } // namespace server
@@ -0,0 +1,50 @@
+#include <new>
+
+#include <server/game/behaviour_arena.h>
+#include <shared/utils/logger.h>
+
+namespace server
+{
+    namespace
+    {
+        constexpr size_t alignUp(size_t size)
+        {
+            return (size + BehaviourArena::ALIGNMENT - 1) & ~(BehaviourArena::ALIGNMENT - 1);
+        }
+    } // namespace
+
+    void *BehaviourArena::allocate(size_t size)
+    {
+        size = alignUp(size);
+        if ( buffer == nullptr ) {
+            buffer = std::make_unique_for_overwrite<std::byte[]>(CAPACITY);
+        }
+
+        if ( top + size > CAPACITY ) {
+            LOG(DEBUG) << "BehaviourArena is full, allocating " << size << " bytes on the heap";
+            return ::operator new(size);
+        }
+
+        void *ptr = buffer.get() + top;
+        top += size;
+        ++live;
+        return ptr;
+    }
+
+    void BehaviourArena::deallocate(void *ptr, size_t size) noexcept
+    {
+        if ( !owns(ptr) ) {
+            ::operator delete(ptr);
+            return;
+        }
+
+        size = alignUp(size);
+        // only the most recent allocation can be given back, the rest is reclaimed once everything is released
+        if ( static_cast<std::byte *>(ptr) + size == buffer.get() + top ) {
+            top -= size;
+        }
+        if ( --live == 0 ) {
+            top = 0;
+        }
+    }
+} // namespace server
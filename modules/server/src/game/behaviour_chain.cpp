@@ -1,23 +1,27 @@
+#include <memory>
+
 #include <server/game/behaviour_chain.h>
 #include <shared/utils/logger.h>
 
 server::BehaviourChain::BehaviourChain() :
-    current_card(""), behaviour_idx(0), behaviour_registry(std::make_unique<BehaviourRegistry>())
+    current_card(std::nullopt), behaviour_idx(0)
 {
     LOG(DEBUG) << "Created a new BehaviourChain";
 }
 
-void server::BehaviourChain::loadBehaviours(const std::string &card_id)
+server::BehaviourChain::~BehaviourChain() { finishBehaviour(); }
+
+void server::BehaviourChain::loadBehaviours(shared::CardBase::handle_t card)
 {
     if ( !empty() ) {
-        LOG(ERROR) << "BehaviourList is already in use for card: \'" << card_id << "\'.Error in " << FUNC_NAME;
+        LOG(ERROR) << "BehaviourList is already in use for card: \'" << card << "\'.Error in " << FUNC_NAME;
         throw exception::UnreachableCode();
     }
 
-    LOG(DEBUG) << "Loading Behaviours for card \'" << card_id << "\'";
+    LOG(DEBUG) << "Loading Behaviours for card \'" << card << "\'";
     behaviour_idx = 0;
-    current_card = card_id;
-    behaviour_list = behaviour_registry->getBehaviours(card_id);
+    current_card = card;
+    behaviour_list = behaviour_registry.getBehaviours(card);
 }
 
 void server::BehaviourChain::resetBehaviours()
@@ -27,11 +31,44 @@ void server::BehaviourChain::resetBehaviours()
         throw exception::UnreachableCode();
     }
 
-    LOG(DEBUG) << "Clearing behaviours for card \'" << current_card << "\'";
+    LOG(DEBUG) << "Clearing behaviours for card \'" << current_card.value() << "\'";
 
     behaviour_idx = 0;
-    current_card.clear();
-    behaviour_list.clear();
+    current_card.reset();
+    behaviour_list = {};
+}
+
+server::base::Behaviour &server::BehaviourChain::startBehaviour()
+{
+    finishBehaviour();
+    active_behaviour = behaviour_list[behaviour_idx].construct(behaviour_storage.data());
+    return *active_behaviour;
+}
+
+void server::BehaviourChain::finishBehaviour()
+{
+    if ( active_behaviour != nullptr ) {
+        std::destroy_at(active_behaviour);
+        active_behaviour = nullptr;
+    }
+}
+
+server::BehaviourChain::ret_t server::BehaviourChain::applyBehaviour(server::GameState &game_state,
+                                                                    server::GameState::seat_t requestor,
+                                                                    base::Behaviour::action_decision_t action_decision)
+{
+    try {
+        return active_behaviour->apply(game_state, requestor, std::move(action_decision));
+    } catch ( std::exception & ) {
+        if ( active_behaviour->isDone() ) {
+            // the behaviour failed and can not be continued, the rest of the card is dropped
+            LOG(WARN) << "Aborting the behaviours of card '" << current_card.value() << "'";
+            finishBehaviour();
+            behaviour_idx = behaviour_list.size();
+            resetBehaviours();
+        }
+        throw;
+    }
 }
 
 server::BehaviourChain::ret_t server::BehaviourChain::startChain(server::GameState &game_state)
@@ -46,11 +83,20 @@ server::BehaviourChain::ret_t server::BehaviourChain::startChain(server::GameSta
 
 server::BehaviourChain::ret_t server::BehaviourChain::runBehaviourChain(server::GameState &game_state)
 {
-    LOG(INFO) << "Called " << FUNC_NAME << "for card \'" << current_card << "\'";
+    LOG(INFO) << "Called " << FUNC_NAME << " for card \'" << current_card.value() << "\'";
     while ( hasNext() ) {
-        auto action_order = currentBehaviour().apply(game_state, game_state.getCurrentPlayerId(), std::nullopt);
+        const auto &step = behaviour_list[behaviour_idx];
+        if ( step.effect != nullptr ) {
+            step.effect(game_state, game_state.getCurrentSeat());
+            advance();
+            continue;
+        }
+
+        auto &behaviour = startBehaviour();
+        auto action_order = applyBehaviour(game_state, game_state.getCurrentSeat(), std::nullopt);
 
-        if ( currentBehaviour().isDone() ) {
+        if ( behaviour.isDone() ) {
+            finishBehaviour();
             advance();
         } else {
             // can be an empty OrderResponse as well
@@ -67,19 +113,27 @@ server::BehaviourChain::ret_t
 server::BehaviourChain::continueChain(server::GameState &game_state, const shared::PlayerBase::id_t &player_id,
                                       std::unique_ptr<shared::ActionDecision> &action_decision)
 {
-    LOG(INFO) << "Called " << FUNC_NAME << "for card \'" << current_card << "\'";
-    if ( empty() ) {
+    return continueChain(game_state, game_state.getSeat(player_id), action_decision);
+}
+
+server::BehaviourChain::ret_t
+server::BehaviourChain::continueChain(server::GameState &game_state, server::GameState::seat_t requestor,
+                                      std::unique_ptr<shared::ActionDecision> &action_decision)
+{
+    if ( empty() || active_behaviour == nullptr ) {
         LOG(ERROR) << "Tried to use an empty BehaviourChain. Client has a state mismatch.";
         throw exception::UnreachableCode();
     }
 
-    auto action_order = currentBehaviour().apply(game_state, player_id, std::move(action_decision));
+    LOG(INFO) << "Called " << FUNC_NAME << " for card \'" << current_card.value() << "\'";
+    auto action_order = applyBehaviour(game_state, requestor, std::move(action_decision));
 
-    if ( !currentBehaviour().isDone() ) {
+    if ( !active_behaviour->isDone() ) {
         // can be an empty OrderResponse as well
         return action_order;
     }
 
+    finishBehaviour();
     advance();
     return runBehaviourChain(game_state);
 }
\ No newline at end of file
@@ -4,40 +4,39 @@
 #include <server/game/victory_card_behaviours.h>
 #include <shared/game/cards/card_factory.h>
 
-std::vector<std::unique_ptr<server::base::Behaviour>>
-server::BehaviourRegistry::getBehaviours(const std::string &card_id)
+std::span<const server::BehaviourStep> server::BehaviourRegistry::getBehaviours(shared::CardBase::handle_t card) const
 {
-    auto it = _map.find(card_id);
-    if ( it == _map.end() ) {
-        LOG(ERROR) << "Requested card \'" << card_id << "\' not registered in the BehaviourRegistry!";
-        throw exception::CardNotAvailable("card not found: " + card_id);
+    const auto index = shared::toIndex(card);
+    // every registered card has a victory behaviour, cards without behaviours have an empty list
+    if ( index >= _map.size() || !_victory_map[index] ) {
+        LOG(ERROR) << "Requested card \'" << card << "\' not registered in the BehaviourRegistry!";
+        throw exception::CardNotAvailable("card not found: " + shared::CardFactory::getId(card));
     }
-    return it->second();
+    return _map[index];
 }
 
-server::VictoryCardBehaviour &
-server::BehaviourRegistry::getVictoryBehaviour(const shared::CardBase::id_t &card_id) const
+server::VictoryCardBehaviour &server::BehaviourRegistry::getVictoryBehaviour(shared::CardBase::handle_t card) const
 {
-    auto it = _victory_map.find(card_id);
-    if ( it == _victory_map.end() ) {
-        LOG(WARN) << "Requested victory card \'" << card_id << "\' not registered in the BehaviourRegistry!";
-        throw exception::CardNotAvailable("Requested card not found in the victory card registry: " + card_id);
+    const auto index = shared::toIndex(card);
+    if ( index >= _victory_map.size() || !_victory_map[index] ) {
+        LOG(WARN) << "Requested victory card \'" << card << "\' not registered in the BehaviourRegistry!";
+        throw exception::CardNotAvailable("Requested card not found in the victory card registry: " +
+                                          shared::CardFactory::getId(card));
     }
-    return *it->second;
+    return *_victory_map[index];
 }
 
 server::BehaviourRegistry::BehaviourRegistry()
 {
-    if ( _is_initialised ) {
-        LOG(INFO) << "BehaviourRegistry is already initialised, skipping card registration";
-        return;
-    }
-
-    LOG(INFO) << "Initialising BehaviourRegistry";
-
-    initialiseBehaviours();
-
-    _is_initialised = true;
+    std::call_once(_initialised,
+                   [this]()
+                   {
+                       LOG(INFO) << "Initialising BehaviourRegistry";
+
+                       _victory_map.resize(shared::CardFactory::size());
+                       _map.resize(shared::CardFactory::size());
+                       initialiseBehaviours();
+                   });
 }
 
 void server::BehaviourRegistry::initialiseBehaviours()
@@ -109,13 +108,17 @@ void server::BehaviourRegistry::initialiseBehaviours()
     // discard a card per empty supply pile
     insert<DrawCards<1>, GainActions<1>, GainCoins<1>, Poacher>("Poacher");
 
-    auto gardens_filter = [](const shared::CardBase::id_t & /*card*/) -> bool { return true; };
+    auto gardens_filter = [](shared::CardBase::handle_t /*card*/) -> bool { return true; };
     insertVictory<VictoryPointsPerNCards<1, 10, gardens_filter>>("Gardens");
 
-    auto duke_filter = [](const shared::CardBase::id_t &card) -> bool { return card == "Duchy"; };
+    auto duke_filter = [](shared::CardBase::handle_t card) -> bool
+    {
+        constexpr auto duchy = shared::cardHandle("Duchy");
+        return card == duchy;
+    };
     insertVictory<VictoryPointsPerNCards<1, 1, duke_filter>>("Duke");
 
-    auto silk_road_filter = [](const shared::CardBase::id_t &card) -> bool
+    auto silk_road_filter = [](shared::CardBase::handle_t card) -> bool
     { return shared::CardFactory::isVictory(card); };
     insertVictory<VictoryPointsPerNCards<1, 4, silk_road_filter>>("Silk_Road");
 
@@ -123,8 +126,8 @@ void server::BehaviourRegistry::initialiseBehaviours()
     /*
     UNSURE
      */
-    // next action card counts double
-    insert<NOT_IMPLEMENTED_YET>("Throne_Room"); // how 'sticky' card?
+    // play an action card from hand twice
+    insert<ThroneRoom>("Throne_Room");
     // gain +1 coin if you play silver for the first time
     insert<DrawCards<1>, GainActions<1>, NOT_IMPLEMENTED_YET>("Merchant"); // how conditional?
 
@@ -137,13 +140,13 @@ void server::BehaviourRegistry::initialiseBehaviours()
     // enemies discard down to three
     insert<GainCoins<2>, MilitiaAttack>("Militia");
     // peek top 2 from deck, trash (and/or) discard any. return rest to draw pile in any order
-    insert<DrawCards<1>, GainActions<1>, NOT_IMPLEMENTED_YET>("Sentry");
+    insert<DrawCards<1>, GainActions<1>, Sentry>("Sentry");
     // discard top of draw pile, if action you may play it
     insert<NOT_IMPLEMENTED_YET>("Vassal");
     // compilcated, google it
     insert<NOT_IMPLEMENTED_YET>("Bureaucrat");
     // draw until 7 hand cards, skip action cards or keep (if skip then discard pile, if keep hand)
-    insert<NOT_IMPLEMENTED_YET>("Library");
+    insert<Library>("Library");
     // gain a gold, enemies reveal top two card from deck trash any treasure except copper, discard rest
-    insert<NOT_IMPLEMENTED_YET>("Bandit");
+    insert<Bandit>("Bandit");
 }
@@ -0,0 +1,265 @@
+#include <algorithm>
+#include <new>
+
+#include <server/game/behaviour_chain.h>
+#include <server/game/behaviour_routine.h>
+#include <shared/utils/exception.h>
+#include <shared/utils/logger.h>
+
+namespace server
+{
+    namespace base
+    {
+        namespace
+        {
+            void guaranteeRequestor(const GameState &game_state, GameState::seat_t expected, GameState::seat_t actual)
+            {
+                if ( expected != actual ) {
+                    LOG(WARN) << "Expected a decision of player " << game_state.getPlayerId(expected)
+                              << ", but got one of " << game_state.getPlayerId(actual);
+                    throw exception::NotYourTurn();
+                }
+            }
+        } // namespace
+
+        ChooseFromHand::ChooseFromHand(const GameState &game_state, GameState::seat_t seat, unsigned int min_cards,
+                                       unsigned int max_cards, shared::ChooseFromOrder::AllowedChoice choices,
+                                       shared::CardType allowed_type, shared::CardType required_type) :
+            seat(seat),
+            min_cards(min_cards), max_cards(max_cards), allowed_type(allowed_type), required_type(required_type)
+        {
+            orders.addOrder(game_state.getPlayerId(seat),
+                            std::make_unique<shared::ChooseFromHandOrder>(min_cards, max_cards, choices, allowed_type,
+                                                                          required_type));
+        }
+
+        bool ChooseFromHand::accept(GameState &game_state, GameState::seat_t requestor,
+                                    std::unique_ptr<shared::ActionDecision> &decision)
+        {
+            guaranteeRequestor(game_state, seat, requestor);
+            auto cards = behaviour::helper::validateResponse(game_state, requestor, decision, min_cards, max_cards,
+                                                             allowed_type);
+            for ( const auto card : cards ) {
+                if ( (shared::CardFactory::getType(card) & required_type) != required_type ) {
+                    LOG(ERROR) << FUNC_NAME << " player " << game_state.getPlayerId(requestor) << " chose card "
+                               << card << ", which has the wrong type!";
+                    throw std::runtime_error("Card type not allowed!");
+                }
+            }
+            chosen = std::move(cards);
+            return true;
+        }
+
+        ChooseFromStaged::ChooseFromStaged(const GameState &game_state, GameState::seat_t seat, unsigned int min_cards,
+                                           unsigned int max_cards, shared::ChooseFromOrder::AllowedChoice choices,
+                                           const std::vector<shared::CardBase::handle_t> &cards) :
+            seat(seat),
+            min_cards(min_cards), max_cards(max_cards), allowed_choices(choices), cards(cards)
+        {
+            std::vector<shared::CardBase::id_t> card_ids;
+            card_ids.reserve(cards.size());
+            std::transform(cards.begin(), cards.end(), std::back_inserter(card_ids),
+                           [](shared::CardBase::handle_t card) { return shared::CardFactory::getId(card); });
+            orders.addOrder(game_state.getPlayerId(seat),
+                            std::make_unique<shared::ChooseFromStagedOrder>(min_cards, max_cards, choices,
+                                                                            std::move(card_ids)));
+        }
+
+        bool ChooseFromStaged::accept(GameState &game_state, GameState::seat_t requestor,
+                                      std::unique_ptr<shared::ActionDecision> &decision)
+        {
+            guaranteeRequestor(game_state, seat, requestor);
+            const auto &requestor_id = game_state.getPlayerId(requestor);
+
+            const auto *deck_choice = shared::tagCast<shared::DeckChoiceDecision>(decision.get());
+            if ( deck_choice == nullptr ) {
+                LOG(ERROR) << FUNC_NAME << " got a wrong decision type! Expected: shared::DeckChoiceDecision";
+                throw std::runtime_error("Decision type is not allowed!");
+            }
+
+            const auto choice_size = deck_choice->cards.size();
+            if ( choice_size < min_cards || choice_size > max_cards || deck_choice->choices.size() != choice_size ) {
+                LOG(ERROR) << FUNC_NAME << " expected between " << min_cards << " and " << max_cards
+                           << " cards, but player " << requestor_id << " chose " << choice_size << " cards!";
+                throw std::runtime_error("You have to choose between " + std::to_string(min_cards) + " and " +
+                                         std::to_string(max_cards) + " cards!");
+            }
+
+            // every offered card can only be chosen once
+            auto remaining = cards;
+            std::vector<choice_t> choices;
+            choices.reserve(choice_size);
+            for ( size_t i = 0; i < choice_size; ++i ) {
+                const auto &card_id = deck_choice->cards[i];
+                const auto card_it = std::find_if(remaining.begin(), remaining.end(),
+                                                  [&card_id](shared::CardBase::handle_t card)
+                                                  { return shared::CardFactory::getId(card) == card_id; });
+                if ( card_it == remaining.end() ) {
+                    LOG(ERROR) << FUNC_NAME << " player " << requestor_id << " chose card " << card_id
+                               << ", which was not offered!";
+                    throw std::runtime_error("Card was not offered!");
+                }
+
+                const auto choice = deck_choice->choices[i];
+                if ( (choice & allowed_choices) == 0 ) {
+                    LOG(ERROR) << FUNC_NAME << " player " << requestor_id << " chose a forbidden action for card "
+                               << card_id;
+                    throw std::runtime_error("Choice is not allowed!");
+                }
+
+                choices.emplace_back(*card_it, choice);
+                remaining.erase(card_it);
+            }
+
+            chosen = std::move(choices);
+            return true;
+        }
+
+        GainFromBoard::GainFromBoard(const GameState &game_state, GameState::seat_t seat, unsigned int max_cost,
+                                     shared::CardType allowed_type) :
+            seat(seat),
+            max_cost(max_cost), allowed_type(allowed_type)
+        {
+            orders.addOrder(game_state.getPlayerId(seat),
+                            std::make_unique<shared::GainFromBoardOrder>(max_cost, allowed_type));
+        }
+
+        bool GainFromBoard::accept(GameState &game_state, GameState::seat_t requestor,
+                                   std::unique_ptr<shared::ActionDecision> &decision)
+        {
+            guaranteeRequestor(game_state, seat, requestor);
+            const auto &requestor_id = game_state.getPlayerId(requestor);
+
+            const auto *gain_decision = shared::tagCast<shared::GainFromBoardDecision>(decision.get());
+            if ( gain_decision == nullptr ) {
+                LOG(ERROR) << FUNC_NAME << " got a wrong decision type! Expected: shared::GainFromBoardDecision";
+                throw std::runtime_error("Decision type is not allowed!");
+            }
+
+            if ( !shared::CardFactory::has(gain_decision->chosen_card) ) {
+                LOG(ERROR) << FUNC_NAME << " player " << requestor_id << " chose unknown card "
+                           << gain_decision->chosen_card;
+                throw exception::CardNotAvailable();
+            }
+
+            const auto card = shared::CardFactory::getHandle(gain_decision->chosen_card);
+            const auto card_type = shared::CardFactory::getType(card);
+            if ( shared::CardFactory::getCost(card) > max_cost || (card_type & allowed_type) != card_type ) {
+                LOG(ERROR) << FUNC_NAME << " player " << requestor_id << " chose card " << gain_decision->chosen_card
+                           << ", which is too expensive or has the wrong type!";
+                throw exception::InvalidCardType("This card can not be gained");
+            }
+
+            if ( !game_state.getBoard()->has(card) ) {
+                throw exception::CardNotAvailable();
+            }
+
+            chosen = card;
+            return true;
+        }
+
+        PlayCard::~PlayCard()
+        {
+            if ( chain != nullptr ) {
+                std::destroy_at(chain);
+                game_state.getBehaviourArena().deallocate(chain, sizeof(BehaviourChain));
+            }
+        }
+
+        bool PlayCard::await_ready()
+        {
+            chain = new (game_state.getBehaviourArena().allocate(sizeof(BehaviourChain))) BehaviourChain();
+            chain->loadBehaviours(card);
+            orders = chain->startChain(game_state);
+            return chain->empty();
+        }
+
+        bool PlayCard::accept(GameState &game_state, GameState::seat_t requestor,
+                              std::unique_ptr<shared::ActionDecision> &decision)
+        {
+            try {
+                orders = chain->continueChain(game_state, requestor, decision);
+            } catch ( std::exception & ) {
+                if ( !chain->empty() ) {
+                    // the card still waits for a valid decision
+                    throw;
+                }
+                error = std::current_exception();
+            }
+            return chain->empty();
+        }
+
+        void *Routine::promise_type::operator new(size_t size, GameState &game_state, GameState::seat_t)
+        {
+            auto &arena = game_state.getBehaviourArena();
+            // the arena is stored in front of the frame, operator delete only gets the pointer
+            auto *memory = static_cast<std::byte *>(arena.allocate(size + BehaviourArena::ALIGNMENT));
+            *reinterpret_cast<BehaviourArena **>(memory) = &arena;
+            return memory + BehaviourArena::ALIGNMENT;
+        }
+
+        void Routine::promise_type::operator delete(void *frame, size_t size) noexcept
+        {
+            auto *memory = static_cast<std::byte *>(frame) - BehaviourArena::ALIGNMENT;
+            (*reinterpret_cast<BehaviourArena **>(memory))->deallocate(memory, size + BehaviourArena::ALIGNMENT);
+        }
+
+        Routine &Routine::operator=(Routine &&other) noexcept
+        {
+            if ( this != &other ) {
+                if ( handle != nullptr ) {
+                    handle.destroy();
+                }
+                handle = std::exchange(other.handle, nullptr);
+            }
+            return *this;
+        }
+
+        Routine::~Routine()
+        {
+            if ( handle != nullptr ) {
+                handle.destroy();
+            }
+        }
+
+        Behaviour::ret_t Routine::apply(GameState &game_state, GameState::seat_t requestor,
+                                        Behaviour::action_decision_t action_decision)
+        {
+            if ( handle == nullptr || handle.done() ) {
+                LOG(ERROR) << "Tried to apply a routine that is not running. Error in " << FUNC_NAME;
+                throw exception::UnreachableCode();
+            }
+
+            auto *awaiting = handle.promise().awaiting;
+            if ( awaiting == nullptr ) {
+                // not started yet
+                return resume();
+            }
+
+            if ( !action_decision.has_value() || action_decision.value() == nullptr ) {
+                LOG(ERROR) << "Expected a decision, but didnt receive one";
+                throw std::runtime_error("Expected a decision, but didnt receive one");
+            }
+
+            if ( !awaiting->accept(game_state, requestor, action_decision.value()) ) {
+                return awaiting->takeOrders();
+            }
+            return resume();
+        }
+
+        Behaviour::ret_t Routine::resume()
+        {
+            auto &promise = handle.promise();
+            promise.awaiting = nullptr;
+            handle.resume();
+
+            if ( promise.exception != nullptr ) {
+                std::rethrow_exception(std::exchange(promise.exception, nullptr));
+            }
+            if ( handle.done() ) {
+                return OrderResponse();
+            }
+            return promise.awaiting->takeOrders();
+        }
+    } // namespace base
+} // namespace server
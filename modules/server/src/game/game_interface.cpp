@@ -4,45 +4,38 @@ namespace server
 {
     GameInterface::ptr_t GameInterface::make(const std::string &game_id,
                                              const std::vector<shared::CardBase::id_t> &play_cards,
-                                             const std::vector<Player::id_t> &player_ids)
+                                             const std::vector<Player::id_t> &player_ids, uint64_t seed)
     {
         LOG(DEBUG) << "Created a new GameInterface("
-                   << "game_id:" << game_id << ")";
-        return ptr_t(new GameInterface(game_id, play_cards, player_ids));
+                   << "game_id:" << game_id << ", seed:" << seed << ")";
+        return ptr_t(new GameInterface(game_id, play_cards, player_ids, seed));
     }
 
     GameInterface::response_t GameInterface::handleMessage(std::unique_ptr<shared::ClientToServerMessage> &message)
     {
-        auto casted_msg = std::unique_ptr<shared::ActionDecisionMessage>(
-                static_cast<shared::ActionDecisionMessage *>(message.release()));
+        auto casted_msg = shared::tagCast<shared::ActionDecisionMessage>(message);
 
-        if ( casted_msg == nullptr ) {
+        if ( casted_msg == nullptr || casted_msg->decision == nullptr ) {
             LOG(ERROR) << "Received a non shared::ActionDecisionMessage in " << FUNC_NAME;
             throw exception::UnreachableCode();
         }
 
-        if ( dynamic_cast<shared::PlayActionCardDecision *>(casted_msg->decision.get()) != nullptr ) {
-            return playActionCardDecisionHandler(
-                    std::unique_ptr<shared::PlayActionCardDecision>(
-                            static_cast<shared::PlayActionCardDecision *>(casted_msg->decision.release())),
-                    casted_msg->player_id);
-        } else if ( dynamic_cast<shared::BuyCardDecision *>(casted_msg->decision.get()) != nullptr ) {
-            return buyCardDecisionHandler(
-                    std::unique_ptr<shared::BuyCardDecision>(
-                            static_cast<shared::BuyCardDecision *>(casted_msg->decision.release())),
-                    casted_msg->player_id);
-        } else if ( dynamic_cast<shared::EndTurnDecision *>(casted_msg->decision.get()) != nullptr ) {
-            return endTurnDecisionHandler(
-                    std::unique_ptr<shared::EndTurnDecision>(
-                            static_cast<shared::EndTurnDecision *>(casted_msg->decision.release())),
-                    casted_msg->player_id);
-        } else if ( dynamic_cast<shared::EndActionPhaseDecision *>(casted_msg->decision.get()) != nullptr ) {
-            return endActionPhaseDecisionHandler(
-                    std::unique_ptr<shared::EndActionPhaseDecision>(
-                            static_cast<shared::EndActionPhaseDecision *>(casted_msg->decision.release())),
-                    casted_msg->player_id);
-        } else {
-            return passToBehaviour(casted_msg);
+        auto &decision = casted_msg->decision;
+        switch ( decision->getTag() ) {
+            case shared::PlayActionCardDecision::TAG:
+                return playActionCardDecisionHandler(shared::tagCast<shared::PlayActionCardDecision>(decision),
+                                                     casted_msg->player_id);
+            case shared::BuyCardDecision::TAG:
+                return buyCardDecisionHandler(shared::tagCast<shared::BuyCardDecision>(decision),
+                                              casted_msg->player_id);
+            case shared::EndTurnDecision::TAG:
+                return endTurnDecisionHandler(shared::tagCast<shared::EndTurnDecision>(decision),
+                                              casted_msg->player_id);
+            case shared::EndActionPhaseDecision::TAG:
+                return endActionPhaseDecisionHandler(shared::tagCast<shared::EndActionPhaseDecision>(decision),
+                                                     casted_msg->player_id);
+            default:
+                return passToBehaviour(casted_msg);
         }
     }
 
@@ -50,8 +43,10 @@ namespace server
     GameInterface::playActionCardDecisionHandler(std::unique_ptr<shared::PlayActionCardDecision> action_decision,
                                                  const Player::id_t &requestor_id)
     {
+        shared::CardBase::handle_t card;
         try {
-            game_state->tryPlay<shared::CardAccess::HAND>(requestor_id, action_decision->card_id);
+            card = shared::CardFactory::getHandle(action_decision->card_id);
+            game_state->tryPlay<shared::CardAccess::HAND>(requestor_id, card);
             // phase is only set if we successfully played a card
             game_state->setPhase(shared::GamePhase::PLAYING_ACTION_CARD);
         } catch ( exception::UnreachableCode &e ) {
@@ -62,14 +57,8 @@ namespace server
             throw e;
         }
 
-        behaviour_chain->loadBehaviours(action_decision->card_id);
-        auto response = behaviour_chain->startChain(*game_state);
-
-        if ( behaviour_chain->empty() ) {
-            return finishedPlayingCard();
-        }
-
-        return response;
+        behaviour_chain->loadBehaviours(card);
+        return runBehaviourChain([this] { return behaviour_chain->startChain(*game_state); });
     }
 
     GameInterface::response_t
@@ -77,7 +66,7 @@ namespace server
                                           const Player::id_t &requestor_id)
     {
         try {
-            game_state->tryBuy(requestor_id, action_decision->card);
+            game_state->tryBuy(requestor_id, shared::CardFactory::getHandle(action_decision->card));
         } catch ( exception::UnreachableCode &e ) {
             LOG(ERROR) << "Received unresolvable Error in " << FUNC_NAME << " aborting.";
             throw e;
@@ -127,13 +116,32 @@ namespace server
 
         auto decision = std::move(message->decision);
 
-        if ( (dynamic_cast<shared::DeckChoiceDecision *>(decision.get()) == nullptr) &&
-             (dynamic_cast<shared::GainFromBoardDecision *>(decision.get()) == nullptr) ) {
+        if ( decision == nullptr || (decision->getTag() != shared::DeckChoiceDecision::TAG &&
+                                     decision->getTag() != shared::GainFromBoardDecision::TAG) ) {
             LOG(ERROR) << "Unreachable code: received some unexpected decision type in: " << FUNC_NAME;
             throw exception::UnreachableCode();
         }
 
-        auto response = behaviour_chain->continueChain(*game_state, message->player_id, decision);
+        return runBehaviourChain([this, &message, &decision]
+                                 { return behaviour_chain->continueChain(*game_state, message->player_id, decision); });
+    }
+
+    template <typename Run>
+    GameInterface::response_t GameInterface::runBehaviourChain(Run &&run)
+    {
+        response_t response;
+        try {
+            response = run();
+        } catch ( exception::UnreachableCode &e ) {
+            throw e;
+        } catch ( std::exception &e ) {
+            if ( !behaviour_chain->empty() ) {
+                // the behaviour still waits for a valid decision
+                throw;
+            }
+            LOG(WARN) << "The card of player '" << game_state->getCurrentPlayerId()
+                      << "' was aborted, continuing the turn. Error: " << e.what();
+        }
 
         if ( behaviour_chain->empty() ) {
             return finishedPlayingCard();
@@ -183,8 +191,8 @@ namespace server
                 return {current_player_id, std::make_unique<shared::ActionPhaseOrder>()};
             case shared::GamePhase::BUY_PHASE:
                 {
-                    for ( const auto &card_id : game_state->tryPlayAllTreasures(current_player_id) ) {
-                        behaviour_chain->loadBehaviours(card_id);
+                    for ( const auto card : game_state->tryPlayAllTreasures(current_player_id) ) {
+                        behaviour_chain->loadBehaviours(card);
                         behaviour_chain->startChain(*game_state);
                     }
 
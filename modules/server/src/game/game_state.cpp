@@ -1,5 +1,6 @@
 #include <algorithm>
 #include <random>
+#include <stdexcept>
 
 #include <server/game/game_state.h>
 
@@ -13,16 +14,17 @@ using shared::GamePhase;
 namespace server
 {
     GameState::GameState(const std::vector<shared::CardBase::id_t> &play_cards,
-                         const std::vector<Player::id_t> &player_ids) :
-        current_player_idx(0),
-        phase(GamePhase::ACTION_PHASE)
+                         const std::vector<Player::id_t> &player_ids, uint64_t seed) :
+        current_seat(0),
+        phase(GamePhase::ACTION_PHASE), seed(seed), rng(seed)
     {
-        if ( player_ids.size() < 2 || player_ids.size() > 4 ) {
+        if ( player_ids.size() < 2 || player_ids.size() > MAX_PLAYERS ) {
             LOG(ERROR) << "Invalid number of players: expected 2-4, got " << player_ids.size() << " in " << FUNC_NAME
                        << ". This should have been checked implicitly by the lobby!";
             throw exception::UnreachableCode();
         }
 
+        LOG(INFO) << "Starting a game with seed " << seed;
         initialisePlayers(player_ids);
         initialiseBoard(play_cards);
     }
@@ -31,12 +33,9 @@ namespace server
     GameState::~GameState() = default;
 
     GameState::GameState(GameState &&other) :
-        player_order(other.player_order), current_player_idx(other.current_player_idx)
+        players(other.players), player_ids(other.player_ids), current_seat(other.current_seat), seed(other.seed),
+        rng(other.rng)
     {
-        for ( const auto &pair : other.player_map ) {
-            player_map[pair.first] = std::make_unique<Player>(*pair.second);
-        }
-
         if ( other.board ) {
             board = other.board;
         }
@@ -46,10 +45,9 @@ namespace server
     {
         std::vector<shared::PlayerResult> results;
         // Get results of each player
-        for ( const auto &pair : player_map ) {
-            const auto &player = pair.second;
-            int victory_points = player->getVictoryPoints();
-            shared::PlayerResult result(player->getId(), victory_points);
+        for ( const auto &player : players ) {
+            int victory_points = player.getVictoryPoints();
+            shared::PlayerResult result(player.getId(), victory_points);
             results.emplace_back(result);
         }
         // and sort them by score
@@ -60,24 +58,34 @@ namespace server
 
     void GameState::initialisePlayers(const std::vector<Player::id_t> &player_ids)
     {
-        player_order = player_ids;
+        constexpr auto estate = shared::cardHandle("Estate");
+        constexpr auto copper = shared::cardHandle("Copper");
+
+        this->player_ids.clear();
+        players.clear();
+        // players are referenced by the behaviours, so the storage must not move once the game runs
+        players.reserve(player_ids.size());
         for ( const auto &id : player_ids ) {
-            if ( player_map.count(id) != 0u ) {
+            if ( std::find(this->player_ids.begin(), this->player_ids.end(), id) != this->player_ids.end() ) {
                 LOG(ERROR) << "Duplicate player ID: " << id << " in " << FUNC_NAME
                            << ". This should have been checked implicitly by the lobby!";
                 throw exception::UnreachableCode();
             }
 
-            player_map[id] = std::make_unique<Player>(id);
+            this->player_ids.push_back(id);
+            auto &player = players.emplace_back(id);
+            // every player shuffles with its own part of the sequence of the game
+            player.setRandomEngine(rng);
+            rng.jump();
 
             for ( unsigned i = 0; i < 7; i++ ) {
                 if ( i < 3 ) {
-                    player_map[id]->gain("Estate");
+                    player.gain(estate);
                 }
-                player_map[id]->gain("Copper");
+                player.gain(copper);
             }
 
-            player_map[id]->draw(5);
+            player.draw(5);
         }
     }
 
@@ -87,21 +95,20 @@ namespace server
             LOG(ERROR) << "Invalid number of kingdom cards: expected 10, got " << selected_cards.size();
             throw exception::WrongCardCount("Incorrect number of kingdom cards!");
         }
-        board = server::ServerBoard::make(selected_cards, player_map.size());
+        board = server::ServerBoard::make(selected_cards, getPlayerCount());
     }
 
     std::unique_ptr<reduced::GameState> GameState::getReducedState(const Player::id_t &target_player)
     {
+        const auto target_seat = getSeat(target_player);
+
         std::vector<reduced::Enemy::ptr_t> reduced_enemies;
-        std::for_each(player_map.begin(), player_map.end(),
-                      [&](auto &entry)
-                      {
-                          if ( auto &[player_id, player_ptr] = entry; player_id != target_player ) {
-                              reduced_enemies.emplace_back(player_ptr->getReducedEnemy());
-                          }
-                      });
-
-        auto reduced_player = getPlayer(target_player).getReducedPlayer();
+        reduced_enemies.reserve(getPlayerCount() - 1);
+        for ( const auto enemy : getEnemySeats(target_seat) ) {
+            reduced_enemies.emplace_back(players[enemy].getReducedEnemy());
+        }
+
+        auto reduced_player = players[target_seat].getReducedPlayer();
         Player::id_t active_player_id = getCurrentPlayerId();
         shared::Board::ptr_t reduced_board = board->getReduced();
 
@@ -114,7 +121,7 @@ namespace server
         auto &current_player = getCurrentPlayer();
         const std::vector<shared::CardBase::id_t> &played_cards = board->getPlayedCards();
         for ( const auto &card_id : played_cards ) {
-            current_player.add<shared::CardAccess::DISCARD_PILE>(card_id);
+            current_player.add<shared::CardAccess::DISCARD_PILE>(shared::CardFactory::getHandle(card_id));
         }
         current_player.endTurn();
         switchPlayer();
@@ -128,21 +135,13 @@ namespace server
         maybeSwitchPhase(); // a player might not have any action cards at the beginning of the action phase
     }
 
-    std::vector<Player::id_t> GameState::getEnemyIDs(const Player::id_t &player_id) const
+    GameState::seat_t GameState::getSeat(const Player::id_t &id) const
     {
-        const size_t num_players = player_order.size();
-        const size_t num_enemies = num_players - 1;
-
-        const size_t attacker_index =
-                std::distance(player_order.begin(), std::find(player_order.begin(), player_order.end(), player_id));
-
-        std::vector<Player::id_t> enemies(num_enemies);
-        for ( size_t i = 1; i < num_players; ++i ) {
-            const size_t enemy_index = (i + attacker_index) % num_players;
-            enemies[i - 1] = player_order[enemy_index];
+        const auto it = std::find(player_ids.begin(), player_ids.end(), id);
+        if ( it == player_ids.end() ) {
+            throw std::out_of_range("No player with id " + id);
         }
-
-        return enemies;
+        return static_cast<seat_t>(std::distance(player_ids.begin(), it));
     }
 
     void GameState::forceSwitchPhase()
@@ -202,51 +201,51 @@ namespace server
 
 #pragma region ASSERTION_HELPERS
 
-    void GameState::guaranteePhase(const shared::PlayerBase::id_t &requestor_id, const shared::CardBase::id_t &card_id,
-                                   shared::GamePhase expected_phase, const std::string &error_msg,
-                                   const std::string &function_name)
+    void GameState::guaranteePhase(const shared::PlayerBase::id_t &requestor_id, shared::CardBase::handle_t card,
+                                   shared::GamePhase expected_phase, std::string_view error_msg,
+                                   std::string_view function_name)
     {
         if ( this->phase != expected_phase ) {
-            LOG(WARN) << "Player: \'" << requestor_id << "\' called " << function_name << " with card \'" << card_id
+            LOG(WARN) << "Player: \'" << requestor_id << "\' called " << function_name << " with card \'" << card
                       << "\'. Expected to be in \'" << toString(expected_phase) << "\', but current phase is \'"
                       << toString(this->phase);
-            throw exception::OutOfPhase(error_msg + std::string(" while in ") + toString(phase));
+            throw exception::OutOfPhase(std::string(error_msg) + " while in " + toString(phase));
         }
     }
 
     void GameState::guaranteePhase(const shared::PlayerBase::id_t &requestor_id, shared::GamePhase expected_phase,
-                                   const std::string &error_msg, const std::string &function_name)
+                                   std::string_view error_msg, std::string_view function_name)
     {
         if ( this->phase != expected_phase ) {
             LOG(WARN) << "Player: \'" << requestor_id << "\' called " << function_name << ". Expected to be in \'"
                       << toString(expected_phase) << "\', but current phase is \'" << toString(this->phase);
-            throw exception::OutOfPhase(error_msg + std::string(" while in ") + toString(phase));
+            throw exception::OutOfPhase(std::string(error_msg) + " while in " + toString(phase));
         }
     }
 
-    void GameState::guaranteeNotPhase(const shared::PlayerBase::id_t &requestor_id,
-                                      const shared::CardBase::id_t &card_id, shared::GamePhase expected_phase,
-                                      const std::string &error_msg, const std::string &function_name)
+    void GameState::guaranteeNotPhase(const shared::PlayerBase::id_t &requestor_id, shared::CardBase::handle_t card,
+                                      shared::GamePhase expected_phase, std::string_view error_msg,
+                                      std::string_view function_name)
     {
         if ( this->phase == expected_phase ) {
-            LOG(WARN) << "Player: \'" << requestor_id << "\' called " << function_name << " with card \'" << card_id
+            LOG(WARN) << "Player: \'" << requestor_id << "\' called " << function_name << " with card \'" << card
                       << "\'. Expected to not be in \'" << toString(expected_phase) << "\'";
-            throw exception::OutOfPhase(error_msg + std::string(" while in ") + toString(phase));
+            throw exception::OutOfPhase(std::string(error_msg) + " while in " + toString(phase));
         }
     }
 
     void GameState::guaranteeNotPhase(const shared::PlayerBase::id_t &requestor_id, shared::GamePhase expected_phase,
-                                      const std::string &error_msg, const std::string &function_name)
+                                      std::string_view error_msg, std::string_view function_name)
     {
         if ( this->phase == expected_phase ) {
             LOG(WARN) << "Player: \'" << requestor_id << "\' called " << function_name << ". Expected to not be in \'"
                       << toString(expected_phase) << "\'";
-            throw exception::OutOfPhase(error_msg + std::string(" while in ") + toString(phase));
+            throw exception::OutOfPhase(std::string(error_msg) + " while in " + toString(phase));
         }
     }
 
     void GameState::guaranteeIsCurrentPlayer(const shared::PlayerBase::id_t &requestor_id,
-                                             const std::string &function_name)
+                                             std::string_view function_name)
     {
         if ( requestor_id != getCurrentPlayerId() ) {
             LOG(WARN) << "Player: \'" << requestor_id << "\' attempted to call " << function_name << " out of turn.";
@@ -254,14 +253,14 @@ namespace server
         }
     }
 
-    void GameState::printSuccess(const shared::PlayerBase::id_t &requestor_id, const std::string &function_name)
+    void GameState::printSuccess(const shared::PlayerBase::id_t &requestor_id, std::string_view function_name)
     {
         LOG(DEBUG) << "Player: \'" << requestor_id << "\' successfully finished \'" << function_name;
     }
 
 #pragma region TRY_FUNCTIONS
 
-    std::vector<shared::CardBase::id_t> GameState::tryPlayAllTreasures(const shared::PlayerBase::id_t &requestor_id)
+    Player::pile_t GameState::tryPlayAllTreasures(const shared::PlayerBase::id_t &requestor_id)
     {
         guaranteeIsCurrentPlayer(requestor_id, FUNC_NAME);
         guaranteePhase(requestor_id, shared::GamePhase::BUY_PHASE, "You can not play all treasures", FUNC_NAME);
@@ -280,33 +279,32 @@ namespace server
     {
         guaranteeIsCurrentPlayer(requestor_id, FUNC_NAME);
 
-        guaranteePhase(requestor_id, shared::GamePhase::ACTION_PHASE,
-                       "You can not end " + toString(shared::GamePhase::ACTION_PHASE), FUNC_NAME);
+        guaranteePhase(requestor_id, shared::GamePhase::ACTION_PHASE, "You can not end action_phase", FUNC_NAME);
 
         forceSwitchPhase();
         printSuccess(requestor_id, FUNC_NAME);
     }
 
-    void GameState::tryBuy(const shared::PlayerBase::id_t &requestor_id, const shared::CardBase::id_t &card_id)
+    void GameState::tryBuy(const shared::PlayerBase::id_t &requestor_id, shared::CardBase::handle_t card)
     {
         guaranteeIsCurrentPlayer(requestor_id, FUNC_NAME);
-        guaranteePhase(requestor_id, card_id, shared::GamePhase::BUY_PHASE, "You can not buy a card", FUNC_NAME);
+        guaranteePhase(requestor_id, card, shared::GamePhase::BUY_PHASE, "You can not buy a card", FUNC_NAME);
 
-        const auto card_cost = shared::CardFactory::getCard(card_id).getCost();
+        const auto card_cost = shared::CardFactory::getCost(card);
 
         if ( !getPlayer(requestor_id).canBuy(card_cost) ) {
-            LOG(WARN) << "Player \'" << requestor_id << "\' cannot afford card \'" << card_id
+            LOG(WARN) << "Player \'" << requestor_id << "\' cannot afford card \'" << card
                       << "\' (cost: " << card_cost << ", treasure: " << getPlayer(requestor_id).getTreasure()
                       << ", buys: " << getPlayer(requestor_id).getBuys() << ").";
             throw exception::InsufficientFunds();
         }
 
-        board->tryTake(card_id);
+        board->tryTake(card);
 
         auto &player = getCurrentPlayer();
         player.decTreasure(card_cost);
         player.decBuys();
-        player.gain(card_id);
+        player.gain(card);
 
         printSuccess(requestor_id, FUNC_NAME);
     }
@@ -11,23 +11,42 @@ namespace server
 
     ServerBoard::ServerBoard(const std::vector<shared::CardBase::id_t> &kingdom_cards, size_t player_count) :
         shared::Board(kingdom_cards, player_count)
-    {}
+    {
+        indexSupply();
+    }
+
+    void ServerBoard::indexSupply()
+    {
+        supply.assign(shared::CardFactory::size(), nullptr);
+
+        auto index_pile = [this](const shared::Pile &pile)
+        { supply[shared::toIndex(shared::CardFactory::getHandle(pile.card_id))] = &pile; };
+
+        std::for_each(victory_cards.begin(), victory_cards.end(), index_pile);
+        std::for_each(treasure_cards.begin(), treasure_cards.end(), index_pile);
+        std::for_each(kingdom_cards.begin(), kingdom_cards.end(), index_pile);
+        index_pile(curse_card_pile);
+    }
 
     shared::Board::ptr_t ServerBoard::getReduced()
     {
         return std::static_pointer_cast<shared::Board>(shared_from_this());
     }
 
-    void ServerBoard::addToPlayedCards(const shared::CardBase::id_t &card_id) { played_cards.push_back(card_id); }
+    void ServerBoard::addToPlayedCards(shared::CardBase::handle_t card)
+    {
+        played_cards.push_back(shared::CardFactory::getId(card));
+    }
 
-    void ServerBoard::addToPlayedCards(const std::vector<shared::CardBase::id_t> &cards)
+    void ServerBoard::addToPlayedCards(const std::vector<shared::CardBase::handle_t> &cards)
     {
-        std::for_each(cards.begin(), cards.end(), [&](const auto &card_id) { played_cards.push_back(card_id); });
+        std::for_each(cards.begin(), cards.end(),
+                      [&](shared::CardBase::handle_t card) { played_cards.push_back(shared::CardFactory::getId(card)); });
     }
 
-    bool ServerBoard::removeFromPlayedCards(const shared::CardBase::id_t &card_id)
+    bool ServerBoard::removeFromPlayedCards(shared::CardBase::handle_t card)
     {
-        auto it = std::find(played_cards.begin(), played_cards.end(), card_id);
+        auto it = std::find(played_cards.begin(), played_cards.end(), shared::CardFactory::getId(card));
         if ( it != played_cards.end() ) {
             played_cards.erase(it);
             return true;
@@ -36,48 +55,42 @@ namespace server
         }
     }
 
+    void ServerBoard::tryTake(shared::CardBase::handle_t card)
+    {
+        if ( !has(card) ) {
+            LOG(WARN) << "tried to buy card: " << card << " but its not available";
+            throw exception::CardNotAvailable();
+        }
+
+        take(card);
+    }
+
     void ServerBoard::tryTake(const shared::CardBase::id_t &card_id)
     {
-        if ( !has(card_id) ) {
-            LOG(WARN) << "tried to buy card: " << card_id << " but its not available";
+        if ( !shared::CardFactory::has(card_id) ) {
+            LOG(WARN) << "tried to buy card: " << card_id << " but it does not exist";
             throw exception::CardNotAvailable();
         }
 
-        take(card_id);
+        tryTake(shared::CardFactory::getHandle(card_id));
     }
 
-    bool ServerBoard::has(const shared::CardBase::id_t &card_id) const
+    bool ServerBoard::has(shared::CardBase::handle_t card) const
     {
-        auto has_card = [card_id](const auto &pile)
-        {
-            if ( pile.find(card_id) != pile.end() ) {
-                return pile.find(card_id)->count > 0;
-            } else {
-                return false;
-            }
-        };
-
-        return (curse_card_pile.card_id == card_id && curse_card_pile.count > 0) || has_card(treasure_cards) ||
-                has_card(victory_cards) || has_card(kingdom_cards);
+        const auto *pile = getPile(card);
+        return pile != nullptr && pile->count > 0;
     }
 
-    void ServerBoard::take(const shared::CardBase::id_t &card_id)
+    bool ServerBoard::has(const shared::CardBase::id_t &card_id) const
     {
-        if ( card_id == curse_card_pile.card_id ) {
-            --curse_card_pile.count;
-        }
+        return shared::CardFactory::has(card_id) && has(shared::CardFactory::getHandle(card_id));
+    }
 
-        // helper to search the card in each pile
-        auto buy_if_found = [card_id](auto &card_piles)
-        {
-            if ( card_piles.find(card_id) != card_piles.end() ) {
-                --card_piles.find(card_id)->count;
-            }
-        };
-
-        buy_if_found(treasure_cards);
-        buy_if_found(victory_cards);
-        buy_if_found(kingdom_cards);
+    void ServerBoard::take(shared::CardBase::handle_t card) { --getPile(card)->count; }
+
+    void ServerBoard::trashCard(shared::CardBase::handle_t card)
+    {
+        this->trash.push_back(shared::CardFactory::getId(card));
     }
 
     void ServerBoard::trashCard(const shared::CardBase::id_t &card) { this->trash.push_back(card); }
@@ -11,10 +11,10 @@ namespace server
     reduced::Player::ptr_t Player::getReducedPlayer()
     {
         std::sort(this->hand_cards.begin(), this->hand_cards.end(),
-                  [](const auto &id_a, const auto &id_b)
+                  [](card_handle_t card_a, card_handle_t card_b)
                   {
-                      const auto type_a = shared::CardFactory::getType(id_a);
-                      const auto type_b = shared::CardFactory::getType(id_b);
+                      const auto type_a = shared::CardFactory::getType(card_a);
+                      const auto type_b = shared::CardFactory::getType(card_b);
 
                       // custom order
                       auto getCustomOrder = [](shared::CardType type)
@@ -37,39 +37,51 @@ namespace server
                           return order_a < order_b;
                       }
 
-                      const auto cost_a = shared::CardFactory::getCost(id_a);
-                      const auto cost_b = shared::CardFactory::getCost(id_b);
+                      const auto cost_a = shared::CardFactory::getCost(card_a);
+                      const auto cost_b = shared::CardFactory::getCost(card_b);
 
                       if ( cost_a != cost_b ) {
                           return cost_a < cost_b; // lowest cost first
                       }
 
                       // sort by name if same category and same cost
-                      return id_a < id_b;
+                      return shared::CardFactory::getId(card_a) < shared::CardFactory::getId(card_b);
                   });
 
-        this->draw_pile_size = draw_pile.size();
-        return reduced::Player::make(static_cast<shared::PlayerBase>(*this), hand_cards);
+        syncPlayerBase();
+        std::vector<shared::CardBase::id_t> hand_ids;
+        hand_ids.reserve(hand_cards.size());
+        std::transform(hand_cards.begin(), hand_cards.end(), std::back_inserter(hand_ids),
+                       [](card_handle_t card) { return shared::CardFactory::getId(card); });
+        return reduced::Player::make(static_cast<shared::PlayerBase>(*this), std::move(hand_ids));
     }
 
     reduced::Enemy::ptr_t Player::getReducedEnemy()
     {
-        this->draw_pile_size = draw_pile.size();
+        syncPlayerBase();
         return reduced::Enemy::make(static_cast<shared::PlayerBase>(*this), hand_cards.size());
     }
 
-    std::vector<shared::CardBase::id_t> Player::getDeck() const
+    void Player::syncPlayerBase()
+    {
+        this->draw_pile_size = draw_pile.size();
+
+        discard_pile.clear();
+        discard_pile.reserve(discard_cards.size());
+        std::transform(discard_cards.begin(), discard_cards.end(), std::back_inserter(discard_pile),
+                       [](card_handle_t card) { return shared::CardFactory::getId(card); });
+    }
+
+    CardCounter Player::getDeckCounts() const
     {
         if ( !staged_cards.empty() ) {
             LOG(ERROR) << "staged cards should be empty when getting deck";
             throw exception::OutOfPhase("You can not get your deck while you are playing a card!");
         }
 
-        std::vector<shared::CardBase::id_t> deck;
-        deck.reserve(draw_pile.size() + discard_pile.size() + hand_cards.size());
-        deck.insert(deck.end(), draw_pile.begin(), draw_pile.end());
-        deck.insert(deck.end(), discard_pile.begin(), discard_pile.end());
-        deck.insert(deck.end(), hand_cards.begin(), hand_cards.end());
+        CardCounter deck = draw_pile_counts;
+        deck += discard_counts;
+        deck += hand_counts;
 
         return deck;
     }
@@ -104,12 +116,15 @@ namespace server
 
     int Player::getVictoryPoints() const
     {
-        std::vector<shared::CardBase::id_t> deck = getDeck();
+        const CardCounter deck = getDeckCounts();
+        BehaviourRegistry registry;
         int victory_points = 0;
-        for ( const auto &card_id : deck ) {
-            VictoryCardBehaviour &behaviour = BehaviourRegistry().getVictoryBehaviour(card_id);
-            victory_points += behaviour.getVictoryPoints(deck);
-        }
+        deck.forEach(
+                [&](card_handle_t card, CardCounter::count_t count)
+                {
+                    VictoryCardBehaviour &behaviour = registry.getVictoryBehaviour(card);
+                    victory_points += count * behaviour.getVictoryPoints(deck);
+                });
         return victory_points;
     }
 
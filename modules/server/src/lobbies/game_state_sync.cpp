@@ -0,0 +1,42 @@
+#include <server/lobbies/game_state_sync.h>
+
+namespace server
+{
+    std::unique_ptr<shared::ServerToClientMessage>
+    GameStateSync::makeUpdate(const std::string &lobby_id, const shared::PlayerBase::id_t &player_id,
+                              std::unique_ptr<reduced::GameState> game_state,
+                              std::optional<std::string> in_response_to)
+    {
+        Entry &entry = entries[player_id];
+        ++entry.version;
+
+        std::unique_ptr<reduced::GameState::Delta> delta;
+        if ( entry.snapshot != nullptr && entry.since_keyframe < KEYFRAME_INTERVAL && !in_response_to.has_value() ) {
+            delta = reduced::GameState::Delta::make(*entry.snapshot, *game_state);
+        }
+
+        if ( delta == nullptr ) {
+            // the board of a reduced state is the live board of the game, the snapshot needs its own
+            entry.snapshot = game_state->clone();
+            entry.since_keyframe = 0;
+            auto message = std::make_unique<shared::GameStateMessage>(lobby_id, std::move(game_state), in_response_to);
+            message->version = entry.version;
+            return message;
+        }
+
+        delta->applyTo(*entry.snapshot);
+        ++entry.since_keyframe;
+        return std::make_unique<shared::GameStateDeltaMessage>(lobby_id, entry.version - 1, entry.version,
+                                                               std::move(delta));
+    }
+
+    void GameStateSync::requestKeyframe(const shared::PlayerBase::id_t &player_id)
+    {
+        auto it = entries.find(player_id);
+        if ( it != entries.end() ) {
+            it->second.snapshot.reset();
+        }
+    }
+
+    void GameStateSync::removePlayer(const shared::PlayerBase::id_t &player_id) { entries.erase(player_id); }
+} // namespace server
@@ -1,6 +1,7 @@
 
 #include <algorithm>
 #include <server/lobbies/lobby.h>
+#include <shared/game/cards/card_factory.h>
 #include <shared/game/game_state/board_base.h>
 #include <shared/utils/assert.h>
 #include <shared/utils/logger.h>
@@ -9,8 +10,8 @@
 
 namespace server
 {
-    Lobby::Lobby(const Player::id_t &game_master, const std::string &lobby_id) :
-        game_interface(nullptr), game_master(game_master), lobby_id(lobby_id)
+    Lobby::Lobby(const Player::id_t &game_master, const std::string &lobby_id, WorkerPool *pool) :
+        game_interface(nullptr), game_master(game_master), lobby_id(lobby_id), mailbox(pool)
     {
         LOG(INFO) << "Lobby constructor called with lobby_id: " << lobby_id;
         players.push_back(game_master);
@@ -22,7 +23,8 @@ namespace server
                 players, lobby_id, true, "The lobby closed. Please restart your game.", error_msg);
         if ( game_interface != nullptr ) {
             auto results = game_interface->terminate();
-            message_interface.broadcast<shared::EndGameBroadcastMessage>(players, lobby_id, results.getResults());
+            message_interface.broadcast<shared::EndGameBroadcastMessage>(players, lobby_id, results.getResults(),
+                                                                         game_interface->getSeed());
         }
     }
 
@@ -31,18 +33,24 @@ namespace server
     {
         // NOLINTBEGIN(bugprone-macro-parentheses)
 #define HANDLE(message_type, handler_func)                                                                             \
-    if ( dynamic_cast<shared::message_type *>(message.get()) ) {                                                       \
-        LOG(INFO) << "Trying to handle: " << #message_type;                                                            \
-        std::unique_ptr<shared::message_type> casted_message(static_cast<shared::message_type *>(message.release()));  \
-        handler_func(message_interface, casted_message);                                                               \
-        return;                                                                                                        \
-    }
+    case shared::message_type::TAG:                                                                                    \
+        {                                                                                                              \
+            LOG(INFO) << "Trying to handle: " << #message_type;                                                        \
+            auto casted_message = shared::tagCast<shared::message_type>(message);                                      \
+            handler_func(message_interface, casted_message);                                                           \
+            return;                                                                                                    \
+        }
         // NOLINTEND(bugprone-macro-parentheses)
 
         // handle messages the lobby is responsible for
-        HANDLE(JoinLobbyRequestMessage, addPlayer);
-        HANDLE(StartGameRequestMessage, startGame);
-        HANDLE(GameStateRequestMessage, getGameState);
+        switch ( message->getTag() ) {
+            HANDLE(JoinLobbyRequestMessage, addPlayer);
+            HANDLE(StartGameRequestMessage, startGame);
+            HANDLE(GameStateRequestMessage, getGameState);
+            default:
+                break;
+        }
+#undef HANDLE
 
         const auto requestor_id = message->player_id;
 
@@ -78,7 +86,8 @@ namespace server
         if ( order_response.isGameOver() ) {
             LOG(DEBUG) << "Game is over in Lobby ID: " << lobby_id;
             message_interface.broadcast<shared::EndGameBroadcastMessage>(players, lobby_id,
-                                                                         order_response.getResults());
+                                                                         order_response.getResults(),
+                                                                         game_interface->getSeed());
         } else {
             broadcastOrders(message_interface, order_response);
         }
@@ -95,8 +104,11 @@ namespace server
             return; // we do nothing in this case
         }
 
-        message_interface.send<shared::GameStateMessage>(
-                requestor_id, lobby_id, game_interface->getGameState(requestor_id), request->message_id);
+        // the client asks when it lost track of its state, so it always gets the full state
+        game_state_sync.requestKeyframe(requestor_id);
+        const auto update = game_state_sync.makeUpdate(lobby_id, requestor_id,
+                                                       game_interface->getGameState(requestor_id), request->message_id);
+        message_interface.sendMessage(*update, requestor_id);
     }
 
     void Lobby::addPlayer(MessageInterface &message_interface,
@@ -174,8 +186,24 @@ namespace server
             return;
         }
 
+        // the client cannot answer the orders of every card yet
+        const auto &selected_cards = request->selected_cards;
+        const auto unsupported = std::find_if(selected_cards.begin(), selected_cards.end(),
+                                              [](const shared::CardBase::id_t &card_id)
+                                              {
+                                                  return shared::CardFactory::has(card_id) &&
+                                                          !shared::CardFactory::isSelectable(card_id);
+                                              });
+        if ( unsupported != selected_cards.end() ) {
+            LOG(DEBUG) << "Lobby::start_game is called with the unsupported card " << *unsupported
+                       << ". Lobby ID: " << lobby_id;
+            message_interface.send<shared::ResultResponseMessage>(requestor_id, lobby_id, false, request->message_id,
+                                                                  *unsupported + " can not be played yet");
+            return;
+        }
+
         try {
-            game_interface = GameInterface::make(lobby_id, request->selected_cards, players);
+            game_interface = GameInterface::make(lobby_id, selected_cards, players);
         } catch ( std::exception &e ) {
             // any error while trying to create a game is unrecoverable
             LOG(ERROR) << "We somehow reached unreachable code while trying to create game \'" << lobby_id
@@ -197,6 +225,7 @@ namespace server
         if ( playerInLobby(player_id) ) {
             LOG(INFO) << "Removing player: " << player_id << " from lobby: " << lobby_id;
             players.erase(std::find(players.begin(), players.end(), player_id));
+            game_state_sync.removePlayer(player_id);
             if ( !gameRunning() ) {
                 message_interface.broadcast<shared::JoinLobbyBroadcastMessage>(players, lobby_id, players);
             }
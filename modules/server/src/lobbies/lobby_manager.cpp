@@ -1,5 +1,6 @@
 
 #include <server/lobbies/lobby_manager.h>
+#include <server/network/network_metrics.h>
 #include "server/network/basic_network.h"
 
 namespace server
@@ -11,19 +12,20 @@ namespace server
             throw std::runtime_error("unreachable code");
         }
 
+        // every request passes here exactly once
+        NetworkMetrics::get().countRequest(message->getTag());
+
         // handle create lobby
-        if ( dynamic_cast<shared::CreateLobbyRequestMessage *>(message.get()) != nullptr ) {
+        if ( auto request = shared::tagCast<shared::CreateLobbyRequestMessage>(message) ) {
             LOG(INFO) << "Trying to handle: CreateLobbyRequestMessage";
-            std::unique_ptr<shared::CreateLobbyRequestMessage> unique_CreateLobbyRequestMessage(
-                    static_cast<shared::CreateLobbyRequestMessage *>(message.release()));
-
-            createLobby(unique_CreateLobbyRequestMessage);
+            createLobby(request);
             return;
         }
 
         // other messages get forwarded to the lobby
         const std::string lobby_id = message->game_id;
-        if ( !lobbyExists(message->game_id) ) {
+        auto lobby = getLobby(lobby_id);
+        if ( lobby == nullptr ) {
             const auto &player_id = message->player_id;
             LOG(WARN) << "Tried to access a nonexistent LobbyID: " << lobby_id << ", by PlayerID: " << player_id;
 
@@ -32,7 +34,21 @@ namespace server
             return;
         }
 
-        auto &lobby = games.at(lobby_id);
+        lobby->getMailbox().post([this, lobby, message = std::move(message)]() mutable
+                                 { handleLobbyMessage(lobby, message); });
+    }
+
+    void LobbyManager::handleLobbyMessage(const std::shared_ptr<Lobby> &lobby,
+                                          std::unique_ptr<shared::ClientToServerMessage> &message)
+    {
+        const std::string lobby_id = message->game_id;
+        if ( !isOpen(lobby_id, lobby) ) {
+            LOG(WARN) << "Dropping message for closed LobbyID: " << lobby_id << ", by PlayerID: " << message->player_id;
+            message_interface->send<shared::ResultResponseMessage>(message->player_id, lobby_id, false,
+                                                                   message->message_id, "Lobby does not exist");
+            return;
+        }
+
         try {
             lobby->handleMessage(*message_interface, message);
         } catch ( std::exception &e ) {
@@ -43,13 +59,13 @@ namespace server
 
             std::string error_msg = "Fatal error while handling message";
             lobby->terminate(*message_interface, error_msg);
-            games.erase(games.find(lobby_id));
+            closeLobby(lobby_id, lobby);
             return;
         }
 
         if ( lobby->isGameOver() ) {
             LOG(DEBUG) << "Game finished in lobby: \'" << lobby_id << "\'. Deleting the lobby.";
-            games.erase(games.find(lobby_id));
+            closeLobby(lobby_id, lobby);
         }
     }
 
@@ -60,41 +76,58 @@ namespace server
         LOG(INFO) << "LobbyManager::create_lobby called with Lobby ID: " << lobby_id
                   << " and Player ID: " << game_master_id;
 
-        // Lobby already exists
-        if ( lobbyExists(lobby_id) ) {
-            LOG(DEBUG) << "Tried creating lobby that already exists. Game ID: " << lobby_id
-                       << " , Player ID: " << game_master_id;
+        {
+            std::unique_lock<std::shared_mutex> lock(games_mutex);
 
-            message_interface->send<shared::ResultResponseMessage>(game_master_id, lobby_id, false, request->message_id,
-                                                                   "Lobby already exists");
-            return;
-        }
+            // Lobby already exists
+            if ( games.find(lobby_id) != games.end() ) {
+                lock.unlock();
+                LOG(DEBUG) << "Tried creating lobby that already exists. Game ID: " << lobby_id
+                           << " , Player ID: " << game_master_id;
 
-        LOG(INFO) << "Creating lobby with ID: " << lobby_id;
+                message_interface->send<shared::ResultResponseMessage>(game_master_id, lobby_id, false,
+                                                                       request->message_id, "Lobby already exists");
+                return;
+            }
 
-        try {
-            games.emplace(lobby_id, std::make_shared<Lobby>(game_master_id, lobby_id));
-        } catch ( std::exception &e ) {
-            LOG(ERROR) << "Error while creating a new lobby. ID: \'" << lobby_id << "\', game_master: \'"
-                       << game_master_id << "\'";
-            message_interface->send<shared::ResultResponseMessage>(game_master_id, lobby_id, false, request->message_id,
-                                                                   "Failed to create lobby: \'" + lobby_id +
-                                                                           "\'. Please try again.");
-            return;
+            LOG(INFO) << "Creating lobby with ID: " << lobby_id;
+
+            try {
+                games.emplace(lobby_id, std::make_shared<Lobby>(game_master_id, lobby_id, pool.get()));
+            } catch ( std::exception &e ) {
+                lock.unlock();
+                LOG(ERROR) << "Error while creating a new lobby. ID: \'" << lobby_id << "\', game_master: \'"
+                           << game_master_id << "\'";
+                message_interface->send<shared::ResultResponseMessage>(game_master_id, lobby_id, false,
+                                                                       request->message_id,
+                                                                       "Failed to create lobby: \'" + lobby_id +
+                                                                               "\'. Please try again.");
+                return;
+            }
         }
 
         message_interface->send<shared::CreateLobbyResponseMessage>(game_master_id, lobby_id, request->message_id);
     };
 
-    void LobbyManager::removePlayer(std::string &lobby_id, player_id_t &player_id)
+    void LobbyManager::removePlayer(const std::string &lobby_id, const player_id_t &player_id)
     {
-        // other messages get forwarded to the lobby
-        if ( !lobbyExists(lobby_id) ) {
+        auto lobby = getLobby(lobby_id);
+        if ( lobby == nullptr ) {
             LOG(WARN) << "Tried removing player: " << player_id << " from inexistent lobby: " << lobby_id;
             return;
         }
-        // get the lobby that the player should be removed from
-        auto &lobby = games.at(lobby_id);
+
+        lobby->getMailbox().post([this, lobby, lobby_id, player_id = player_id_t(player_id)]() mutable
+                                 { handleRemovePlayer(lobby_id, lobby, player_id); });
+    }
+
+    void LobbyManager::handleRemovePlayer(const std::string &lobby_id, const std::shared_ptr<Lobby> &lobby,
+                                          player_id_t &player_id)
+    {
+        if ( !isOpen(lobby_id, lobby) ) {
+            LOG(DEBUG) << "Lobby: " << lobby_id << " was already closed when removing player: " << player_id;
+            return;
+        }
 
         if ( lobby->gameRunning() ) {
             // Remove the player from the lobby
@@ -104,7 +137,7 @@ namespace server
             // End the game for the remaining players and remove the game
             std::string error_msg = "Player " + player_id + " disconnected, closing the lobby";
             lobby->terminate(*message_interface, error_msg);
-            games.erase(games.find(lobby_id));
+            closeLobby(lobby_id, lobby);
         } else {
             // if lobby is in login screen, just remove the player
             lobby->removePlayer(player_id, *message_interface);
@@ -114,8 +147,31 @@ namespace server
                 LOG(INFO) << "Removing lobby: " << lobby_id;
                 std::string error_msg = "Game master quit, closing lobby, please restart your client";
                 lobby->terminate(*message_interface, error_msg);
-                games.erase(games.find(lobby_id));
+                closeLobby(lobby_id, lobby);
             }
         }
     }
+
+    std::shared_ptr<Lobby> LobbyManager::getLobby(const std::string &lobby_id) const
+    {
+        std::shared_lock<std::shared_mutex> lock(games_mutex);
+        const auto it = games.find(lobby_id);
+        return it == games.end() ? nullptr : it->second;
+    }
+
+    bool LobbyManager::isOpen(const std::string &lobby_id, const std::shared_ptr<Lobby> &lobby) const
+    {
+        std::shared_lock<std::shared_mutex> lock(games_mutex);
+        const auto it = games.find(lobby_id);
+        return it != games.end() && it->second == lobby;
+    }
+
+    void LobbyManager::closeLobby(const std::string &lobby_id, const std::shared_ptr<Lobby> &lobby)
+    {
+        std::unique_lock<std::shared_mutex> lock(games_mutex);
+        const auto it = games.find(lobby_id);
+        if ( it != games.end() && it->second == lobby ) {
+            games.erase(it);
+        }
+    }
 } // namespace server
@@ -1,6 +1,10 @@
+#include <array>
+#include <string>
+
 #include <server/network/basic_network.h>
+#include <server/network/network_metrics.h>
+#include <shared/utils/frame_decoder.h>
 #include <shared/utils/logger.h>
-#include <string>
 #include "server/network/server_network_manager.h"
 #include "shared/message_types.h"
 
@@ -10,154 +14,160 @@ namespace server
 
     ssize_t BasicNetwork::sendToAddress(const std::string &message, const std::string &address)
     {
-        LOG(INFO) << "Sending Message: " << message << " to Address: " << address;
-        try {
-            sockpp::tcp_socket *socket;
-
-            {
-                std::shared_lock<std::shared_mutex> lock(_rw_lock);
-                socket = getSocket(address);
-            }
+        LOG(INFO) << "Sending Message: " << shared::loggable(message) << " to Address: " << address;
 
-            if ( socket == nullptr ) {
-                LOG(ERROR) << "Failed to get socket for address: " << address;
-                return ssize_t(-1);
-            }
+        const auto connection = _address_to_connection.find(address);
+        if ( !connection.has_value() ) {
+            LOG(ERROR) << "Failed to get connection for address: " << address;
+            return ssize_t(-1);
+        }
+        return send(message, *connection);
+    }
 
-            std::stringstream ss_msg;
-            ss_msg << std::to_string(message.size()) << ':' << message; // prepend message length
-            sockpp::result<size_t> res = socket->write(ss_msg.str()); // TODO: make this thread safe (wrapper class)
-            if ( res.is_error() ) {
-                LOG(ERROR) << "Failed to send message to address: " << address
-                           << ". Socket error: " << res.error_message();
-            } else {
-                LOG(INFO) << "Successfully sent Message: " << message;
-            }
+    ssize_t BasicNetwork::sendToPlayer(const std::string &message, const player_id_t &player_id)
+    {
+        const auto connection = _player_id_to_connection.find(player_id);
+        if ( !connection.has_value() ) {
+            // lobbies handle a disconnect asynchronously, so they may still send to a player that just left
+            LOG(WARN) << "Player " << player_id << " is not connected, dropping message";
+            return ssize_t(-1);
+        }
+        return send(message, *connection);
+    }
 
-            return ssize_t(res.value());
-        } catch ( const std::runtime_error &e ) {
-            LOG(ERROR) << "Error in sendMessage: " << e.what();
-            return ssize_t(-1); // indicate failure
+    ssize_t BasicNetwork::sendToPlayer(const shared::ServerToClientMessage &message, const player_id_t &player_id)
+    {
+        const auto connection = _player_id_to_connection.find(player_id);
+        if ( !connection.has_value() ) {
+            LOG(WARN) << "Player " << player_id << " is not connected, dropping message";
+            return ssize_t(-1);
         }
+        return send(message, *connection);
     }
 
-    ssize_t BasicNetwork::sendToPlayer(const std::string &message, const player_id_t &player_id)
+    size_t BasicNetwork::broadcast(const shared::ServerToClientMessage &message,
+                                   const std::vector<player_id_t> &players)
     {
-        std::string address;
+        // indexed by shared::WireFormat, encoded when the first player that speaks the format comes up
+        std::array<Connection::frame_t, 2> frames;
+        size_t queued = 0;
+
+        for ( const auto &player_id : players ) {
+            const auto connection = _player_id_to_connection.find(player_id);
+            if ( !connection.has_value() ) {
+                LOG(WARN) << "Player " << player_id << " is not connected, dropping message";
+                continue;
+            }
 
-        {
-            std::shared_lock<std::shared_mutex> lock(_rw_lock);
-            address = getAddress(player_id);
+            auto &frame = frames[static_cast<size_t>((*connection)->getWireFormat())];
+            if ( frame == nullptr ) {
+                frame = std::make_shared<const std::string>(
+                        shared::encodeFrame(message.encode((*connection)->getWireFormat())));
+            } else {
+                ++NetworkMetrics::get().shared_frames;
+            }
+
+            if ( (*connection)->send(frame) < 0 ) {
+                LOG(ERROR) << "Failed to send message to address: " << (*connection)->getAddress();
+            } else {
+                ++queued;
+            }
         }
 
-        return sendToAddress(message, address);
+        LOG(INFO) << "Broadcast message " << message.message_id << " to " << queued << " of " << players.size()
+                  << " players";
+        return queued;
     }
 
     bool BasicNetwork::addPlayerToAddress(const player_id_t &player_id, const std::string &lobby_id,
                                           const std::string &address)
     {
-        // check with shared lock
-        {
-            std::shared_lock<std::shared_mutex> shared_lock(_rw_lock);
-            if ( !isNewPlayer(player_id) ) {
-                LOG(INFO) << "Player with ID " << player_id << " is already registered.";
-                if ( getAddress(player_id) != address ) {
-                    // There is already a player with this name
-                    shared::ResultResponseMessage msg = shared::ResultResponseMessage(
-                            "No lobby", false, "in_response_to deprecated", "This name is already taken!");
-                    sendToAddress(msg.toJson(), address);
-                    return false;
-                }
-                return true;
-            }
+        const auto connection = _address_to_connection.find(address);
+        if ( !connection.has_value() ) {
+            LOG(ERROR) << "Received a request over an unknown address: " << address;
+            return false;
         }
 
-        // acquire unique lock and re-check
-        {
-            std::unique_lock<std::shared_mutex> lock(_rw_lock);
-            if ( !isNewPlayer(player_id) ) {
-                LOG(WARN) << "Player with ID " << player_id << " is already registered (after lock).";
-                if ( getAddress(player_id) != address ) {
-                    // There is already a player with this name
-                    shared::ResultResponseMessage msg = shared::ResultResponseMessage(
-                            "No lobby", false, "in_response_to deprecated", "This name is already taken!");
-                    sendToAddress(msg.toJson(), address);
-                    return false;
-                }
-                return true;
+        const auto &owner = *connection;
+        if ( owner->hasPlayer() ) {
+            if ( owner->getPlayerId() != player_id ) {
+                LOG(WARN) << "Connection " << address << " already belongs to player " << owner->getPlayerId();
+                rejectPlayer(address, "This connection already belongs to another player!");
+                return false;
             }
-            LOG(INFO) << "Registering new client with ID: " << player_id;
-            _player_id_to_address.emplace(player_id, address);
-            _address_to_player_id.emplace(address, player_id);
-            _player_id_to_lobby_id.emplace(player_id, lobby_id);
+            return true;
         }
+
+        const auto [registered, inserted] = _player_id_to_connection.tryEmplace(player_id, owner);
+        if ( !inserted ) {
+            LOG(INFO) << "Player with ID " << player_id << " is already registered.";
+            // There is already a player with this name
+            rejectPlayer(address, "This name is already taken!");
+            return false;
+        }
+
+        LOG(INFO) << "Registering new client with ID: " << player_id;
+        owner->setPlayer(player_id, lobby_id);
         return true;
     }
 
-    void BasicNetwork::addAddressToSocket(const std::string &address, const sockpp::tcp_socket socket)
+    void BasicNetwork::addConnection(const Connection::ptr_t &connection)
     {
-        std::unique_lock<std::shared_mutex> lock(_rw_lock);
-
-        if ( _address_to_socket.count(address) != 0 ) {
+        const auto &address = connection->getAddress();
+        if ( !_address_to_connection.tryEmplace(address, connection).second ) {
             LOG(ERROR) << "Address is already connected: " << address;
         } else {
             LOG(DEBUG) << "Adding address: " << address;
-            _address_to_socket.emplace(address, socket.clone());
         }
     }
 
     void BasicNetwork::playerDisconnect(const std::string &address)
     {
         LOG(INFO) << "Disconnecting Address: " << address;
-        std::unique_lock<std::shared_mutex> lock(_rw_lock);
-
-        if ( _address_to_player_id.find(address) != _address_to_player_id.end() ) {
-            player_id_t player_id = _address_to_player_id.find(address)->second;
-            lock.unlock();
-            ServerNetworkManager::removePlayer(_player_id_to_lobby_id.find(player_id)->second, player_id);
-            lock.lock();
-            _player_id_to_lobby_id.erase(player_id);
-            _player_id_to_address.erase(player_id);
-            _address_to_player_id.erase(address);
-            _address_to_socket.erase(address);
+
+        const auto connection = _address_to_connection.take(address);
+        if ( !connection.has_value() ) {
+            LOG(WARN) << "Address " << address << " was not connected";
+            return;
+        }
+
+        const auto &owner = *connection;
+        if ( owner->hasPlayer() ) {
+            player_id_t player_id = owner->getPlayerId();
+            _player_id_to_connection.eraseIf(player_id, owner);
+            ServerNetworkManager::removePlayer(owner->getLobbyId(), player_id);
             LOG(INFO) << "Player with Address " << address << " disconnected and resources released.";
         } else {
-            LOG(WARN) << "Attempted to disconnect player with Address " << address << ", but it was not found.";
+            // the connection never registered a player
+            LOG(INFO) << "Address " << address << " disconnected without a registered player.";
         }
     }
 
-
-    // ================================================================
-    // LOCKS FOR FUNCTIONS BELOW MUST BE ACCUIRED BY CALLER
-    // ================================================================
-
-    bool BasicNetwork::isNewPlayer(const player_id_t &player_id)
+    ssize_t BasicNetwork::send(const std::string &message, const Connection::ptr_t &connection)
     {
-        // ASSUMING CALLER HOLDS THE LOCK!
-        return _player_id_to_address.find(player_id) == _player_id_to_address.end();
+        // only queues the frame, the I/O thread of the connection writes it
+        const ssize_t res = connection->send(shared::encodeFrame(message));
+        if ( res < 0 ) {
+            LOG(ERROR) << "Failed to send message to address: " << connection->getAddress();
+        } else {
+            LOG(INFO) << "Successfully queued Message: " << shared::loggable(message);
+        }
+        return res;
     }
 
-    sockpp::tcp_socket *BasicNetwork::getSocket(const std::string &address)
+    ssize_t BasicNetwork::send(const shared::ServerToClientMessage &message, const Connection::ptr_t &connection)
     {
-        // ASSUMING CALLER HOLDS THE LOCK!
-        auto it = _address_to_socket.find(address);
-        if ( it != _address_to_socket.end() ) {
-            return &(it->second);
-        } else {
-            LOG(ERROR) << "Cannot find socket for address: " << address;
-            return nullptr;
-        }
+        return send(message.encode(connection->getWireFormat()), connection);
     }
 
-    const std::string &BasicNetwork::getAddress(const player_id_t &player_id)
+    void BasicNetwork::rejectPlayer(const std::string &address, const std::string &reason)
     {
-        // ASSUMING CALLER HOLDS THE LOCK!
-        auto it = _player_id_to_address.find(player_id);
-        if ( it != _player_id_to_address.end() ) {
-            return it->second;
-        } else {
-            LOG(ERROR) << "Cannot find address for player ID: " << player_id;
-            throw std::runtime_error("Invalid player_id: " + player_id);
+        const auto connection = _address_to_connection.find(address);
+        if ( !connection.has_value() ) {
+            LOG(ERROR) << "Failed to get connection for address: " << address;
+            return;
         }
+        const ResultResponseMessage msg("No lobby", false, "in_response_to deprecated", reason);
+        send(msg, *connection);
     }
 } // namespace server
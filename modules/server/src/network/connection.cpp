@@ -0,0 +1,244 @@
+#include <array>
+#include <cstring>
+
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+
+#include <server/network/connection.h>
+#include <server/network/network_metrics.h>
+#include <shared/utils/logger.h>
+
+namespace server
+{
+    namespace
+    {
+        constexpr size_t READ_CHUNK_SIZE = 4096;
+        // a connection that floods us is read in several rounds, so the other connections of the thread get their turn
+        constexpr size_t MAX_READS_PER_EVENT = 16;
+        // frames gathered into a single sendmsg call
+        constexpr size_t MAX_FRAMES_PER_WRITE = 64;
+
+        bool wouldBlock(const std::error_code &error)
+        {
+            return error == std::errc::resource_unavailable_try_again || error == std::errc::operation_would_block;
+        }
+    } // namespace
+
+    Connection::Connection(sockpp::tcp_socket socket, int epoll_fd) :
+        socket(std::move(socket)), address(this->socket.peer_address().to_string()), epoll_fd(epoll_fd)
+    {
+        if ( auto res = this->socket.set_non_blocking(true); res.is_error() ) {
+            LOG(ERROR) << "Failed to make the socket of " << address << " non-blocking: " << res.error_message();
+            throw std::runtime_error("Failed to make socket non-blocking");
+        }
+    }
+
+    Connection::~Connection() { close(); }
+
+    ssize_t Connection::send(std::string frame) { return send(std::make_shared<const std::string>(std::move(frame))); }
+
+    ssize_t Connection::send(frame_t frame)
+    {
+        auto &metrics = NetworkMetrics::get();
+        const size_t size = frame->size();
+
+        std::lock_guard<std::mutex> lock(write_mutex);
+        if ( closed || evicted ) {
+            LOG(WARN) << "Tried to send to closed connection " << address;
+            ++metrics.dropped_frames;
+            return -1;
+        }
+        if ( queued_bytes + size > MAX_QUEUED_BYTES ) {
+            ++metrics.dropped_frames;
+            evict();
+            return -1;
+        }
+
+        write_queue.push_back(std::move(frame));
+        queued_bytes += size;
+        ++metrics.frames_queued;
+        metrics.updateMaxQueuedBytes(queued_bytes);
+
+        // the I/O thread does the writing as soon as the socket is writable, which it usually is right away
+        setWriteInterest(true);
+        return static_cast<ssize_t>(size);
+    }
+
+    size_t Connection::getQueuedBytes() const
+    {
+        std::lock_guard<std::mutex> lock(write_mutex);
+        return queued_bytes;
+    }
+
+    bool Connection::onReadable(const message_handler_t &handler)
+    {
+        bool open = true;
+
+        for ( size_t i = 0; i < MAX_READS_PER_EVENT; ++i ) {
+            // read straight into the decoder, the payloads are never copied on their way to the parser
+            const auto res = socket.read(decoder.prepare(READ_CHUNK_SIZE), READ_CHUNK_SIZE);
+            if ( res.is_error() ) {
+                if ( wouldBlock(res.error()) ) {
+                    break;
+                }
+                if ( res.error() == std::errc::interrupted ) {
+                    continue;
+                }
+                LOG(ERROR) << "Read error on " << address << ": " << res.error_message();
+                open = false;
+                break;
+            }
+            if ( res.value() == 0 ) {
+                // orderly shutdown by the peer, messages that arrived before are still handled
+                open = false;
+                break;
+            }
+
+            decoder.commit(res.value());
+            if ( res.value() < READ_CHUNK_SIZE ) {
+                // the socket is drained
+                break;
+            }
+        }
+
+        return dispatchMessages(handler) && open;
+    }
+
+    bool Connection::onWritable()
+    {
+        std::lock_guard<std::mutex> lock(write_mutex);
+        return !closed && flush();
+    }
+
+    void Connection::close()
+    {
+        std::lock_guard<std::mutex> lock(write_mutex);
+        if ( closed.exchange(true) ) {
+            return;
+        }
+        socket.shutdown();
+        socket.close();
+    }
+
+    bool Connection::flush()
+    {
+        auto &metrics = NetworkMetrics::get();
+
+        while ( !write_queue.empty() ) {
+            // gather as many frames as possible into one call
+            std::array<iovec, MAX_FRAMES_PER_WRITE> iov{};
+            size_t count = 0;
+            for ( auto it = write_queue.begin(); it != write_queue.end() && count < iov.size(); ++it, ++count ) {
+                const size_t offset = count == 0 ? write_offset : 0;
+                // sendmsg only reads the buffer, iovec just has no const variant
+                iov[count].iov_base = const_cast<char *>((*it)->data()) + offset;
+                iov[count].iov_len = (*it)->size() - offset;
+            }
+
+            msghdr message{};
+            message.msg_iov = iov.data();
+            message.msg_iovlen = count;
+            const ssize_t res = sendmsg(socket.handle(), &message, MSG_NOSIGNAL | MSG_DONTWAIT);
+            if ( res < 0 ) {
+                if ( errno == EAGAIN || errno == EWOULDBLOCK ) {
+                    break;
+                }
+                if ( errno == EINTR ) {
+                    continue;
+                }
+                LOG(ERROR) << "Write error on " << address << ": " << std::strerror(errno);
+                return false;
+            }
+
+            ++metrics.write_calls;
+            metrics.bytes_sent += res;
+            queued_bytes -= res;
+
+            // drop what was written completely
+            size_t written = res;
+            while ( written > 0 ) {
+                const size_t remaining = write_queue.front()->size() - write_offset;
+                if ( written < remaining ) {
+                    write_offset += written;
+                    break;
+                }
+                written -= remaining;
+                write_offset = 0;
+                write_queue.pop_front();
+                ++metrics.frames_sent;
+            }
+
+            if ( write_offset != 0 ) {
+                // short write, the socket buffer is full
+                break;
+            }
+        }
+
+        setWriteInterest(!write_queue.empty());
+        return true;
+    }
+
+    void Connection::evict()
+    {
+        if ( evicted ) {
+            return;
+        }
+        evicted = true;
+
+        auto &metrics = NetworkMetrics::get();
+        ++metrics.slow_consumers;
+        LOG(WARN) << "Disconnecting slow client " << address << " with " << queued_bytes
+                  << " bytes queued. Network metrics: " << metrics;
+
+        // the I/O thread sees the hang up and removes the connection the usual way
+        ::shutdown(socket.handle(), SHUT_RDWR);
+    }
+
+    void Connection::setWriteInterest(bool enabled)
+    {
+        if ( write_interest == enabled ) {
+            return;
+        }
+
+        epoll_event event{};
+        event.events = EPOLLIN | EPOLLRDHUP;
+        if ( enabled ) {
+            event.events |= EPOLLOUT;
+        }
+        event.data.fd = socket.handle();
+        if ( epoll_ctl(epoll_fd, EPOLL_CTL_MOD, socket.handle(), &event) != 0 ) {
+            LOG(ERROR) << "Failed to update the epoll registration of " << address;
+            return;
+        }
+        write_interest = enabled;
+    }
+
+    bool Connection::dispatchMessages(const message_handler_t &handler)
+    {
+        try {
+            while ( const auto message = decoder.nextWritable() ) {
+                const std::string_view view(message->data(), message->size());
+                // logged before the handler gets to parse it in place
+                LOG(INFO) << "Received Message: " << shared::loggable(view);
+                if ( !negotiated ) {
+                    // the first request picks the format of everything we send back
+                    wire_format = shared::detectWireFormat(view);
+                    negotiated = true;
+                    LOG(DEBUG) << address << " speaks "
+                               << (wire_format == shared::WireFormat::BINARY ? "binary" : "JSON");
+                }
+                try {
+                    handler(*message);
+                } catch ( const std::exception &e ) {
+                    LOG(ERROR) << "Error while handling message from " << address << ": " << e.what();
+                }
+            }
+        } catch ( const exception::MalformedFrame &e ) {
+            // we can not find the start of the next frame anymore
+            LOG(ERROR) << "Dropping connection to " << address << ": " << e.what();
+            return false;
+        }
+        return true;
+    }
+} // namespace server
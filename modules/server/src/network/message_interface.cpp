@@ -9,10 +9,14 @@ namespace server
     void ImplementedMessageInterface::sendMessage(const shared::ServerToClientMessage &message,
                                                   const shared::PlayerBase::id_t &player_id)
     {
-        std::string msg = message.toJson();
+        LOG(INFO) << "Message Interface sending to player: " << player_id;
+        BasicNetwork::sendToPlayer(message, player_id);
+    }
 
-        LOG(INFO) << "Message Interface sending: " << msg << " to player: " << player_id;
-        BasicNetwork::sendToPlayer(msg, player_id);
+    void ImplementedMessageInterface::broadcastMessage(const shared::ServerToClientMessage &message,
+                                                       const std::vector<shared::PlayerBase::id_t> &players)
+    {
+        BasicNetwork::broadcast(message, players);
     }
 
 } // namespace server
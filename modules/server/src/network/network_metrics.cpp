@@ -0,0 +1,35 @@
+#include <server/network/network_metrics.h>
+
+namespace server
+{
+    NetworkMetrics &NetworkMetrics::get()
+    {
+        static NetworkMetrics metrics;
+        return metrics;
+    }
+
+    void NetworkMetrics::updateMaxQueuedBytes(uint64_t queued)
+    {
+        uint64_t current = max_queued_bytes.load(std::memory_order_relaxed);
+        while ( queued > current && !max_queued_bytes.compare_exchange_weak(current, queued) ) {
+        }
+    }
+
+    std::ostream &operator<<(std::ostream &os, const NetworkMetrics &metrics)
+    {
+        os << "frames queued: " << metrics.frames_queued << ", frames sent: " << metrics.frames_sent
+           << ", bytes sent: " << metrics.bytes_sent << ", write calls: " << metrics.write_calls
+           << ", slow consumers: " << metrics.slow_consumers << ", dropped frames: " << metrics.dropped_frames
+           << ", shared frames: " << metrics.shared_frames << ", max queued bytes: " << metrics.max_queued_bytes
+           << ", requests by tag: {";
+
+        const char *separator = "";
+        for ( size_t tag = 0; tag < metrics.requests.size(); ++tag ) {
+            if ( const uint64_t count = metrics.requests[tag] ) {
+                os << separator << tag << ": " << count;
+                separator = ", ";
+            }
+        }
+        return os << "}";
+    }
+} // namespace server
@@ -0,0 +1,168 @@
+#include <array>
+#include <cstring>
+
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include <server/network/network_metrics.h>
+#include <server/network/reactor.h>
+#include <shared/utils/logger.h>
+
+namespace server
+{
+    namespace
+    {
+        constexpr int MAX_EVENTS = 64;
+    } // namespace
+
+    Reactor::Reactor(size_t io_threads, message_handler_t message_handler, disconnect_handler_t disconnect_handler) :
+        message_handler(std::move(message_handler)), disconnect_handler(std::move(disconnect_handler))
+    {
+        if ( io_threads == 0 ) {
+            io_threads = std::max(1u, std::thread::hardware_concurrency());
+        }
+
+        for ( size_t i = 0; i < io_threads; ++i ) {
+            auto loop = std::make_unique<IoLoop>();
+            loop->epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+            loop->wake_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+            if ( loop->epoll_fd < 0 || loop->wake_fd < 0 ) {
+                LOG(ERROR) << "Failed to create the epoll instance: " << std::strerror(errno);
+                throw std::runtime_error("Failed to create the epoll instance");
+            }
+
+            epoll_event event{};
+            event.events = EPOLLIN;
+            event.data.fd = loop->wake_fd;
+            epoll_ctl(loop->epoll_fd, EPOLL_CTL_ADD, loop->wake_fd, &event);
+
+            loops.push_back(std::move(loop));
+        }
+
+        for ( auto &loop : loops ) {
+            loop->thread = std::thread(&Reactor::run, this, std::ref(*loop));
+        }
+        LOG(INFO) << "Started reactor with " << loops.size() << " I/O threads";
+    }
+
+    Reactor::~Reactor()
+    {
+        running = false;
+        for ( auto &loop : loops ) {
+            const uint64_t wake = 1;
+            [[maybe_unused]] const auto res = write(loop->wake_fd, &wake, sizeof(wake));
+        }
+
+        for ( auto &loop : loops ) {
+            if ( loop->thread.joinable() ) {
+                loop->thread.join();
+            }
+            for ( auto &[fd, connection] : loop->connections ) {
+                connection->close();
+            }
+            ::close(loop->wake_fd);
+            ::close(loop->epoll_fd);
+        }
+        LOG(INFO) << "Stopped reactor. Network metrics: " << NetworkMetrics::get();
+    }
+
+    Connection::ptr_t Reactor::makeConnection(sockpp::tcp_socket socket)
+    {
+        auto &loop = *loops[next_loop++ % loops.size()];
+        return std::make_shared<Connection>(std::move(socket), loop.epoll_fd);
+    }
+
+    void Reactor::start(const Connection::ptr_t &connection)
+    {
+        auto &loop = getLoop(connection);
+        {
+            std::lock_guard<std::mutex> lock(loop.mutex);
+            loop.connections.emplace(connection->getHandle(), connection);
+        }
+
+        epoll_event event{};
+        event.events = EPOLLIN | EPOLLRDHUP;
+        event.data.fd = connection->getHandle();
+        if ( epoll_ctl(loop.epoll_fd, EPOLL_CTL_ADD, connection->getHandle(), &event) != 0 ) {
+            LOG(ERROR) << "Failed to register " << connection->getAddress() << " with epoll: " << std::strerror(errno);
+            remove(loop, connection);
+        }
+    }
+
+    void Reactor::run(IoLoop &loop)
+    {
+        std::array<epoll_event, MAX_EVENTS> events;
+
+        while ( running ) {
+            const int count = epoll_wait(loop.epoll_fd, events.data(), MAX_EVENTS, -1);
+            if ( count < 0 ) {
+                if ( errno == EINTR ) {
+                    continue;
+                }
+                LOG(ERROR) << "epoll_wait failed: " << std::strerror(errno);
+                return;
+            }
+
+            for ( int i = 0; i < count; ++i ) {
+                const int fd = events[i].data.fd;
+                if ( fd == loop.wake_fd ) {
+                    // only used to stop the loop
+                    continue;
+                }
+
+                Connection::ptr_t connection;
+                {
+                    std::lock_guard<std::mutex> lock(loop.mutex);
+                    const auto it = loop.connections.find(fd);
+                    if ( it == loop.connections.end() ) {
+                        continue;
+                    }
+                    connection = it->second;
+                }
+
+                const auto flags = events[i].events;
+                bool keep = (flags & EPOLLERR) == 0;
+                if ( keep && (flags & (EPOLLIN | EPOLLHUP | EPOLLRDHUP)) != 0 ) {
+                    keep = connection->onReadable([this, &connection](std::span<char> message)
+                                                  { message_handler(message, *connection); });
+                }
+                if ( keep && (flags & EPOLLOUT) != 0 ) {
+                    keep = connection->onWritable();
+                }
+
+                if ( !keep ) {
+                    remove(loop, connection);
+                }
+            }
+        }
+    }
+
+    void Reactor::remove(IoLoop &loop, const Connection::ptr_t &connection)
+    {
+        LOG(DEBUG) << "Closing connection to " << connection->getAddress();
+        epoll_ctl(loop.epoll_fd, EPOLL_CTL_DEL, connection->getHandle(), nullptr);
+        {
+            std::lock_guard<std::mutex> lock(loop.mutex);
+            loop.connections.erase(connection->getHandle());
+        }
+        connection->close();
+
+        try {
+            disconnect_handler(connection->getAddress());
+        } catch ( const std::exception &e ) {
+            LOG(ERROR) << "Error while disconnecting " << connection->getAddress() << ": " << e.what();
+        }
+    }
+
+    Reactor::IoLoop &Reactor::getLoop(const Connection::ptr_t &connection)
+    {
+        for ( auto &loop : loops ) {
+            if ( loop->epoll_fd == connection->getEpoll() ) {
+                return *loop;
+            }
+        }
+        LOG(ERROR) << "Connection " << connection->getAddress() << " does not belong to this reactor";
+        throw std::invalid_argument("Connection does not belong to this reactor");
+    }
+} // namespace server
@@ -1,17 +1,17 @@
 
+#include <csignal>
 #include <iostream>
 #include <sstream>
 
+#include <sys/resource.h>
+
 #include <server/network/server_network_manager.h>
 #include <shared/utils/logger.h>
 #include "server/network/basic_network.h"
 
-using handler = std::function<void(const std::string &, const sockpp::tcp_socket::addr_t &)>;
-
 namespace server
 {
     std::shared_ptr<MessageInterface> ServerNetworkManager::_message_interface;
-    LobbyManager ServerNetworkManager::_lobby_manager(ServerNetworkManager::_message_interface);
 
     ServerNetworkManager::ServerNetworkManager()
     {
@@ -20,13 +20,34 @@ namespace server
             _instance = this;
         }
         _message_interface = std::make_shared<ImplementedMessageInterface>();
-        _lobby_manager = LobbyManager(_message_interface);
     }
 
-    void ServerNetworkManager::run(const std::string &host, uint16_t port)
+    /**
+     * @brief Every connection needs a file descriptor, the default soft limit (often 1024) is far too low.
+     */
+    static void raiseFileLimit()
+    {
+        rlimit limit{};
+        if ( getrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur < limit.rlim_max ) {
+            limit.rlim_cur = limit.rlim_max;
+            if ( setrlimit(RLIMIT_NOFILE, &limit) != 0 ) {
+                LOG(WARN) << "Failed to raise the file descriptor limit";
+            }
+        }
+    }
+
+    void ServerNetworkManager::run(const std::string &host, uint16_t port, size_t io_threads, size_t game_threads)
     {
         LOG(INFO) << "Running the server on " << host << ":" << port;
         sockpp::socket_initializer::initialize(); // Required to initialise sockpp
+
+        // a client that disconnects while we write to it must not kill the server
+        std::signal(SIGPIPE, SIG_IGN);
+        raiseFileLimit();
+
+        _reactor.reset(); // stop the I/O threads of a previous run first
+        _lobby_manager = std::make_unique<LobbyManager>(_message_interface, std::make_unique<WorkerPool>(game_threads));
+        _reactor = std::make_unique<Reactor>(io_threads, handleMessage, BasicNetwork::playerDisconnect);
         this->connect(port);
     }
 
@@ -61,102 +82,39 @@ namespace server
                 return;
             }
 
-            auto sock = result.release();
-
-            const std::string address = sock.peer_address().to_string();
-            BasicNetwork::addAddressToSocket(address, sock.clone());
-
-            // Create a listener thread and transfer the new stream to it.
-            // Incoming messages will be passed to handle_message().
-            std::thread listener(readLoop, std::move(sock), handleMessage);
-            listener.detach();
-        }
-    }
-
-    // Runs in a thread and reads anything coming in on the 'socket'.
-    // Once a message is fully received, the string is passed on to the 'handle_message()' function
-    void ServerNetworkManager::readLoop(sockpp::tcp_socket socket, const handler &message_handler)
-    {
-        sockpp::socket_initializer::initialize(); // initializes socket framework
-
-        constexpr size_t BUFFER_SIZE = 512;
-        std::string buffer(BUFFER_SIZE, '\0');
-        sockpp::result<size_t> result;
-
-        while ( (result = socket.read(buffer.data(), buffer.size())).is_ok() && result.value() != 0 ) {
             try {
-                std::string_view read_data(buffer.data(), result.value());
-                size_t separator_pos = read_data.find(':');
-
-                if ( separator_pos == std::string_view::npos ) {
-                    LOG(ERROR) << "Malformed message: Missing length separator ':'";
-                    continue;
-                }
-
-                size_t msg_length = std::stoul(std::string(read_data.substr(0, separator_pos)));
-                LOG(INFO) << "Expecting message of length " << msg_length;
-
-                // accumulate the message payload
-                std::string message;
-                message.reserve(msg_length);
-                message.append(read_data.substr(separator_pos + 1));
-                size_t msg_bytes_read = message.size();
-
-                // read the remaining packages
-                while ( msg_bytes_read < msg_length ) {
-                    result = socket.read(buffer.data(), buffer.size());
-                    if ( result.is_error() || result.value() == 0 ) {
-                        break; // end of stream or error
-                    }
-
-                    size_t count = result.value();
-
-                    message.append(buffer.data(), count);
-                    msg_bytes_read += count;
-                }
-
-                if ( msg_bytes_read == msg_length ) {
-                    LOG(INFO) << "Received Message: " << message;
-                    message_handler(message, socket.peer_address());
-                } else {
-                    LOG(ERROR) << "Incomplete message. Expected " << msg_length << " bytes, but received "
-                               << msg_bytes_read;
-                }
+                // the connection has to be reachable by its address before the first message arrives
+                auto connection = _reactor->makeConnection(result.release());
+                BasicNetwork::addConnection(connection);
+                _reactor->start(connection);
             } catch ( const std::exception &e ) {
-                LOG(ERROR) << "Error while reading message from " << socket.peer_address() << ": " << e.what();
+                LOG(ERROR) << "Failed to set up connection to peer(" << peer << "): " << e.what();
             }
         }
-
-        if ( result.is_error() ) {
-            LOG(ERROR) << "Read error: " << result.error_message();
-        }
-
-        LOG(DEBUG) << "Closing connection to " << socket.peer_address();
-        BasicNetwork::playerDisconnect(socket.peer_address().to_string());
-        socket.shutdown();
     }
 
-    void ServerNetworkManager::handleMessage(const std::string &msg, const sockpp::tcp_socket::addr_t &peer_address)
+    void ServerNetworkManager::handleMessage(std::span<char> msg, Connection &connection)
     {
+        const std::string &address = connection.getAddress();
         try {
-            // try to parse a client_request from msg
-            std::unique_ptr<shared::ClientToServerMessage> req = shared::ClientToServerMessage::fromJson(msg);
+            // try to parse a client_request from msg, msg was logged on arrival and is unreadable after this
+            std::unique_ptr<shared::ClientToServerMessage> req =
+                    shared::ClientToServerMessage::decodeInSitu(msg, connection.getJsonParser());
 
             if ( req == nullptr ) {
                 // TODO: handle invalid message
-                LOG(ERROR) << "Failed to parse message";
+                LOG(ERROR) << "Failed to parse message from " << address;
                 return;
             }
 
             // check if this is a connection to a new player
-            if ( BasicNetwork::addPlayerToAddress(req->player_id, req->game_id, peer_address.to_string()) ) {
-                LOG(INFO) << "Handling request from player(" << req->player_id << "): " << msg;
+            if ( BasicNetwork::addPlayerToAddress(req->player_id, req->game_id, address) ) {
+                LOG(INFO) << "Handling request " << req->message_id << " from player(" << req->player_id << ")";
 
-                _lobby_manager.handleMessage(req);
+                _lobby_manager->handleMessage(req);
             }
         } catch ( const std::exception &e ) {
-            LOG(ERROR) << FUNC_NAME << ": Failed to execute client request. Content was :\n"
-                       << msg << std::endl
+            LOG(ERROR) << FUNC_NAME << ": Failed to execute client request from " << address << ".\n"
                        << "Error was " << e.what();
         }
     }
@@ -164,12 +122,12 @@ namespace server
     ssize_t ServerNetworkManager::sendMessage(std::unique_ptr<shared::ServerToClientMessage> message,
                                               const shared::PlayerBase::id_t &player_id)
     {
-        return BasicNetwork::sendToPlayer(message->toJson(), player_id);
+        return BasicNetwork::sendToPlayer(*message, player_id);
     }
 
-    void ServerNetworkManager::removePlayer(std::string &lobby_id, player_id_t &player_id)
+    void ServerNetworkManager::removePlayer(const std::string &lobby_id, const player_id_t &player_id)
     {
-        _lobby_manager.removePlayer(lobby_id, player_id);
+        _lobby_manager->removePlayer(lobby_id, player_id);
     }
 
 } // namespace server
@@ -0,0 +1,63 @@
+#include <server/utils/mailbox.h>
+#include <shared/utils/logger.h>
+
+namespace server
+{
+    namespace
+    {
+        // a busy mailbox gives its worker back after this many tasks, so other mailboxes get their turn
+        constexpr size_t MAX_TASKS_PER_DRAIN = 32;
+    } // namespace
+
+    Mailbox::Mailbox(WorkerPool *pool) : state(std::make_shared<State>()) { state->pool = pool; }
+
+    void Mailbox::post(Task task)
+    {
+        {
+            std::lock_guard<std::mutex> lock(state->mutex);
+            state->tasks.push_back(std::move(task));
+            if ( state->scheduled ) {
+                // whoever drains the mailbox will also run this task
+                return;
+            }
+            state->scheduled = true;
+        }
+
+        if ( state->pool == nullptr ) {
+            drain(state);
+        } else {
+            state->pool->submit([state = state] { drain(state); });
+        }
+    }
+
+    size_t Mailbox::size() const
+    {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        return state->tasks.size();
+    }
+
+    void Mailbox::drain(const std::shared_ptr<State> &state)
+    {
+        for ( size_t i = 0; state->pool == nullptr || i < MAX_TASKS_PER_DRAIN; ++i ) {
+            Task task;
+            {
+                std::lock_guard<std::mutex> lock(state->mutex);
+                if ( state->tasks.empty() ) {
+                    state->scheduled = false;
+                    return;
+                }
+                task = std::move(state->tasks.front());
+                state->tasks.pop_front();
+            }
+
+            try {
+                task();
+            } catch ( const std::exception &e ) {
+                LOG(ERROR) << "Uncaught exception in a mailbox task: " << e.what();
+            }
+        }
+
+        // still scheduled, continue at the back of the queue
+        state->pool->submit([state] { drain(state); });
+    }
+} // namespace server
@@ -0,0 +1,107 @@
+#include <server/utils/worker_pool.h>
+#include <shared/utils/logger.h>
+
+namespace server
+{
+    namespace
+    {
+        // lets submit find the queue of the worker it is called from
+        thread_local const WorkerPool *current_pool = nullptr;
+        thread_local size_t current_index = 0;
+    } // namespace
+
+    WorkerPool::WorkerPool(size_t threads)
+    {
+        if ( threads == 0 ) {
+            threads = std::max(1u, std::thread::hardware_concurrency());
+        }
+
+        for ( size_t i = 0; i < threads; ++i ) {
+            workers.push_back(std::make_unique<Worker>());
+        }
+        for ( size_t i = 0; i < threads; ++i ) {
+            workers[i]->thread = std::thread(&WorkerPool::run, this, i);
+        }
+        LOG(INFO) << "Started worker pool with " << workers.size() << " threads";
+    }
+
+    WorkerPool::~WorkerPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(idle_mutex);
+            stopping = true;
+        }
+        idle.notify_all();
+
+        for ( auto &worker : workers ) {
+            if ( worker->thread.joinable() ) {
+                worker->thread.join();
+            }
+        }
+    }
+
+    void WorkerPool::submit(Task task)
+    {
+        const size_t index =
+                current_pool == this ? current_index : next_worker.fetch_add(1, std::memory_order_relaxed) % workers.size();
+
+        {
+            std::lock_guard<std::mutex> lock(idle_mutex);
+            ++pending;
+        }
+        {
+            std::lock_guard<std::mutex> lock(workers[index]->mutex);
+            workers[index]->tasks.push_back(std::move(task));
+        }
+        idle.notify_one();
+    }
+
+    void WorkerPool::run(size_t index)
+    {
+        current_pool = this;
+        current_index = index;
+
+        while ( true ) {
+            Task task;
+            if ( pop(index, task) ) {
+                --pending;
+                try {
+                    task();
+                } catch ( const std::exception &e ) {
+                    LOG(ERROR) << "Uncaught exception in worker " << index << ": " << e.what();
+                }
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(idle_mutex);
+            idle.wait(lock, [this] { return stopping || pending > 0; });
+            if ( stopping && pending == 0 ) {
+                return;
+            }
+        }
+    }
+
+    bool WorkerPool::pop(size_t index, Task &task)
+    {
+        {
+            auto &own = *workers[index];
+            std::lock_guard<std::mutex> lock(own.mutex);
+            if ( !own.tasks.empty() ) {
+                task = std::move(own.tasks.front());
+                own.tasks.pop_front();
+                return true;
+            }
+        }
+
+        for ( size_t offset = 1; offset < workers.size(); ++offset ) {
+            auto &victim = *workers[(index + offset) % workers.size()];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if ( !victim.tasks.empty() ) {
+                task = std::move(victim.tasks.back());
+                victim.tasks.pop_back();
+                return true;
+            }
+        }
+        return false;
+    }
+} // namespace server
@@ -1,13 +1,31 @@
 
 #pragma once
 
+#include <cstdint>
+#include <type_traits>
 #include <vector>
 
 #include <shared/game/cards/card_base.h>
 #include <shared/game/game_state/player_base.h>
+#include <shared/utils/exception.h>
+#include <shared/utils/tag_cast.h>
 #include "shared/action_order.h"
 namespace shared
 {
+    /**
+     * @brief Identifies the concrete type of an ActionDecision, also in the binary format of an ActionDecisionMessage.
+     * The values are part of the protocol, only ever append new ones.
+     */
+    enum class DecisionTag : uint8_t
+    {
+        PLAY_ACTION_CARD,
+        BUY_CARD,
+        END_ACTION_PHASE,
+        END_TURN,
+        DECK_CHOICE,
+        BOARD_CHOICE
+    };
+
     class ActionDecision
     {
     public:
@@ -15,19 +33,29 @@ namespace shared
         bool operator==(const ActionDecision &other) const;
         bool operator!=(const ActionDecision &other) const;
 
+        /**
+         * @brief The concrete type of the decision, dispatch on it with visit or tagCast instead of dynamic_cast.
+         */
+        DecisionTag getTag() const { return tag; }
+
     protected:
+        explicit ActionDecision(DecisionTag tag) : tag(tag) {}
         virtual bool equals(const ActionDecision &other) const = 0;
+
+    private:
+        DecisionTag tag;
     };
 
     class PlayActionCardDecision : public ActionDecision
     {
     public:
+        static constexpr DecisionTag TAG = DecisionTag::PLAY_ACTION_CARD;
+
         bool operator==(const PlayActionCardDecision &other) const;
         bool operator!=(const PlayActionCardDecision &other) const;
         PlayActionCardDecision(shared::CardBase::id_t card_id,
                                shared::CardAccess from_pile = shared::CardAccess::HAND) :
-            card_id(card_id),
-            from(from_pile)
+            ActionDecision(TAG), card_id(card_id), from(from_pile)
         {}
 
         shared::CardBase::id_t card_id;
@@ -40,9 +68,11 @@ namespace shared
     class BuyCardDecision : public ActionDecision
     {
     public:
+        static constexpr DecisionTag TAG = DecisionTag::BUY_CARD;
+
         bool operator==(const BuyCardDecision &other) const;
         bool operator!=(const BuyCardDecision &other) const;
-        BuyCardDecision(CardBase::id_t card) : card(card) {}
+        BuyCardDecision(CardBase::id_t card) : ActionDecision(TAG), card(card) {}
         CardBase::id_t card;
 
     protected:
@@ -52,9 +82,11 @@ namespace shared
     class EndActionPhaseDecision : public ActionDecision
     {
     public:
+        static constexpr DecisionTag TAG = DecisionTag::END_ACTION_PHASE;
+
         bool operator==(const EndActionPhaseDecision &other) const;
         bool operator!=(const EndActionPhaseDecision &other) const;
-        EndActionPhaseDecision() = default;
+        EndActionPhaseDecision() : ActionDecision(TAG) {}
 
     protected:
         bool equals(const ActionDecision &other) const override;
@@ -63,9 +95,11 @@ namespace shared
     class EndTurnDecision : public ActionDecision
     {
     public:
+        static constexpr DecisionTag TAG = DecisionTag::END_TURN;
+
         bool operator==(const EndTurnDecision &other) const;
         bool operator!=(const EndTurnDecision &other) const;
-        EndTurnDecision() = default;
+        EndTurnDecision() : ActionDecision(TAG) {}
 
     protected:
         bool equals(const ActionDecision &other) const override;
@@ -74,13 +108,14 @@ namespace shared
     class DeckChoiceDecision : public ActionDecision
     {
     public:
+        static constexpr DecisionTag TAG = DecisionTag::DECK_CHOICE;
+
         std::vector<shared::CardBase::id_t> cards;
         std::vector<ChooseFromOrder::AllowedChoice> choices;
 
         DeckChoiceDecision(std::vector<shared::CardBase::id_t> cards,
                            std::vector<ChooseFromOrder::AllowedChoice> choices) :
-            cards(cards),
-            choices(choices)
+            ActionDecision(TAG), cards(cards), choices(choices)
         {}
 
         bool operator==(const DeckChoiceDecision &other) const;
@@ -93,12 +128,42 @@ namespace shared
     class GainFromBoardDecision : public ActionDecision
     {
     public:
+        static constexpr DecisionTag TAG = DecisionTag::BOARD_CHOICE;
+
         shared::CardBase::id_t chosen_card;
-        GainFromBoardDecision(shared::CardBase::id_t chosen_card) : chosen_card(chosen_card) {}
+        GainFromBoardDecision(shared::CardBase::id_t chosen_card) : ActionDecision(TAG), chosen_card(chosen_card) {}
         bool operator==(const GainFromBoardDecision &other) const;
         bool operator!=(const GainFromBoardDecision &other) const;
 
     protected:
         bool equals(const ActionDecision &other) const override;
     };
+
+    /**
+     * @brief Calls visitor with the decision as its concrete type. The switch over the tag compiles to a jump table,
+     * every branch of the visitor has to return the same type.
+     *
+     * @throw exception::UnreachableCode for a tag without a class, which can not be constructed.
+     */
+    template <typename Decision, typename Visitor>
+        requires std::is_same_v<std::remove_const_t<Decision>, ActionDecision>
+    decltype(auto) visit(Decision &decision, Visitor &&visitor)
+    {
+        switch ( decision.getTag() ) {
+            case DecisionTag::PLAY_ACTION_CARD:
+                return visitor(static_cast<like_const_t<PlayActionCardDecision, Decision> &>(decision));
+            case DecisionTag::BUY_CARD:
+                return visitor(static_cast<like_const_t<BuyCardDecision, Decision> &>(decision));
+            case DecisionTag::END_ACTION_PHASE:
+                return visitor(static_cast<like_const_t<EndActionPhaseDecision, Decision> &>(decision));
+            case DecisionTag::END_TURN:
+                return visitor(static_cast<like_const_t<EndTurnDecision, Decision> &>(decision));
+            case DecisionTag::DECK_CHOICE:
+                return visitor(static_cast<like_const_t<DeckChoiceDecision, Decision> &>(decision));
+            case DecisionTag::BOARD_CHOICE:
+                return visitor(static_cast<like_const_t<GainFromBoardDecision, Decision> &>(decision));
+        }
+        throw exception::UnreachableCode("Unknown decision tag " +
+                                         std::to_string(static_cast<unsigned int>(decision.getTag())));
+    }
 } // namespace shared
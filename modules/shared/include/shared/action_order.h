@@ -5,6 +5,8 @@
 #include <rapidjson/document.h>
 #include <shared/game/cards/card_base.h>
 #include <shared/game/game_state/player_base.h>
+#include <shared/utils/binary.h>
+#include <shared/utils/json_writer.h>
 
 namespace shared
 {
@@ -42,11 +44,25 @@ namespace shared
          * @brief Create an `ActionOrder` from a JSON object.
          */
         static std::unique_ptr<ActionOrder> fromJson(const rapidjson::Value &json);
+        /**
+         * @brief Stream this order as a JSON object into writer.
+         */
+        void writeJson(JsonWriter &writer) const;
         /**
          * @brief Convert this order to a JSON object.
          */
         rapidjson::Document toJson() const;
 
+        /**
+         * @brief Create an `ActionOrder` from the binary wire format.
+         * @throw exception::MalformedMessage
+         */
+        static std::unique_ptr<ActionOrder> fromBinary(BinaryReader &reader);
+        /**
+         * @brief Write this order in the binary wire format.
+         */
+        void toBinary(BinaryWriter &writer) const;
+
     protected:
         /**
          * @brief Virtual function to check if this order is equal to another order.
@@ -136,9 +152,11 @@ namespace shared
         };
 
         ChooseFromOrder(unsigned int min_cards, unsigned int max_cards, AllowedChoice allowed_choices,
-                        shared::CardType allowed_type = ChooseFromOrder::_any_type) :
+                        shared::CardType allowed_type = ChooseFromOrder::_any_type,
+                        shared::CardType required_type = static_cast<shared::CardType>(0)) :
             min_cards(min_cards),
-            max_cards(max_cards), allowed_choices(allowed_choices), allowed_type(allowed_type)
+            max_cards(max_cards), allowed_choices(allowed_choices), allowed_type(allowed_type),
+            required_type(required_type)
         {}
 
         ~ChooseFromOrder() override = default;
@@ -149,7 +167,9 @@ namespace shared
         unsigned int min_cards;
         unsigned int max_cards;
         AllowedChoice allowed_choices;
+        // every type of a chosen card is in allowed_type and every type in required_type is a type of the card
         shared::CardType allowed_type;
+        shared::CardType required_type;
 
     protected:
         bool equals(const ActionOrder &other) const override;
@@ -179,8 +199,9 @@ namespace shared
     {
     public:
         ChooseFromHandOrder(unsigned int min_cards, unsigned int max_cards, AllowedChoice choices,
-                            shared::CardType allowed_type) :
-            ChooseFromOrder(min_cards, max_cards, choices, allowed_type)
+                            shared::CardType allowed_type,
+                            shared::CardType required_type = static_cast<shared::CardType>(0)) :
+            ChooseFromOrder(min_cards, max_cards, choices, allowed_type, required_type)
         {}
 
         ChooseFromHandOrder(unsigned int min_cards, unsigned int max_cards, AllowedChoice choices) :
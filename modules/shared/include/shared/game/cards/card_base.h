@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <memory>
 #include <string>
 namespace shared
@@ -25,6 +26,16 @@ namespace shared
         using id_t = std::string;
         using ptr_t = std::unique_ptr<CardBase>;
 
+        /**
+         * @brief Compact handle of a registered card, assigned by the CardFactory in registration order.
+         *
+         * Handles index directly into the CardFactory tables. The server engine works exclusively on handles, id_t is
+         * only used at the JSON boundary (messages, reduced game states).
+         */
+        enum class handle_t : uint16_t
+        {
+        };
+
         CardBase(id_t id, CardType type, unsigned int cost) : id(id), type(type), cost(cost) {}
 
         unsigned int getCost() const { return cost; }
@@ -45,4 +56,9 @@ namespace shared
         const unsigned int cost;
     };
 
+    /**
+     * @return The index of the handle into tables that are indexed by card handles.
+     */
+    constexpr size_t toIndex(CardBase::handle_t handle) { return static_cast<size_t>(handle); }
+
 } // namespace shared
@@ -1,137 +1,137 @@
 #pragma once
 
 #include <algorithm>
+#include <optional>
+#include <ostream>
 #include <unordered_map>
 #include <vector>
 
 #include <shared/game/cards/card_base.h>
+#include <shared/game/cards/card_table.h>
 #include <shared/utils/logger.h>
 
 namespace shared
 {
+    /**
+     * @brief Thin view over the CARD_TABLE. Lookups by handle are array loads, lookups by card id first resolve the
+     * handle with a single hash lookup.
+     */
     class CardFactory
     {
     public:
         using map_t = std::unordered_map<CardBase::id_t, std::unique_ptr<CardBase>>;
+        using handle_map_t = std::unordered_map<CardBase::id_t, CardBase::handle_t>;
         using sorted_t = std::vector<CardBase::id_t>;
 
-        static void insert(const CardBase::id_t &card_id, CardType type, unsigned int cost);
-        static bool has(const CardBase::id_t &card_id) { return _map.count(card_id) > 0; }
+        static bool has(const CardBase::id_t &card_id) { return lookup().handles.count(card_id) > 0; }
 
-        static const map_t &getAll() { return _map; }
+        /**
+         * @return The number of registered cards, all handles are in the range [0, size()).
+         */
+        static constexpr size_t size() { return CARD_TABLE.size(); }
+
+        static const map_t &getAll() { return lookup().cards; }
         static sorted_t getKingdomSortedByCost();
         static const CardBase &getCard(const CardBase::id_t &card_id);
-        static unsigned int getCost(const CardBase::id_t &card_id);
-        static CardType getType(const CardBase::id_t &card_id);
-        static CardBase::id_t getId(const CardBase::id_t &card_id);
-
-        static bool isAction(const CardBase::id_t &card_id);
-        static bool isAttack(const CardBase::id_t &card_id);
-        static bool isReaction(const CardBase::id_t &card_id);
-        static bool isTreasure(const CardBase::id_t &card_id);
-        static bool isVictory(const CardBase::id_t &card_id);
-        static bool isCurse(const CardBase::id_t &card_id);
+        static unsigned int getCost(const CardBase::id_t &card_id) { return getCost(getHandle(card_id)); }
+        static CardType getType(const CardBase::id_t &card_id) { return getType(getHandle(card_id)); }
+        static CardBase::id_t getId(const CardBase::id_t &card_id) { return getId(getHandle(card_id)); }
+
+        static bool isAction(const CardBase::id_t &card_id) { return isAction(getHandle(card_id)); }
+        static bool isAttack(const CardBase::id_t &card_id) { return isAttack(getHandle(card_id)); }
+        static bool isReaction(const CardBase::id_t &card_id) { return isReaction(getHandle(card_id)); }
+        static bool isTreasure(const CardBase::id_t &card_id) { return isTreasure(getHandle(card_id)); }
+        static bool isVictory(const CardBase::id_t &card_id) { return isVictory(getHandle(card_id)); }
+        static bool isCurse(const CardBase::id_t &card_id) { return isCurse(getHandle(card_id)); }
+        static bool isSelectable(const CardBase::id_t &card_id) { return isSelectable(getHandle(card_id)); }
+
+        /**
+         * @brief Translates a card id into its handle, this should only be needed at the JSON boundary.
+         * @throw std::invalid_argument if the card does not exist
+         */
+        static CardBase::handle_t getHandle(const CardBase::id_t &card_id);
+        /**
+         * @brief Like getHandle, but returns std::nullopt for unknown card ids instead of throwing.
+         */
+        static std::optional<CardBase::handle_t> findHandle(const CardBase::id_t &card_id);
+
+        static const CardBase::id_t &getId(CardBase::handle_t handle) { return lookup().ids[toIndex(handle)]; }
+        static constexpr unsigned int getCost(CardBase::handle_t handle) { return CARD_TABLE.costs[toIndex(handle)]; }
+        static constexpr CardType getType(CardBase::handle_t handle) { return CARD_TABLE.types[toIndex(handle)]; }
+
+        static constexpr bool isAction(CardBase::handle_t handle) { return hasType(handle, ACTION); }
+        static constexpr bool isAttack(CardBase::handle_t handle) { return hasType(handle, ATTACK); }
+        static constexpr bool isReaction(CardBase::handle_t handle) { return hasType(handle, REACTION); }
+        static constexpr bool isTreasure(CardBase::handle_t handle) { return hasType(handle, TREASURE); }
+        static constexpr bool isVictory(CardBase::handle_t handle) { return hasType(handle, VICTORY); }
+        static constexpr bool isCurse(CardBase::handle_t handle) { return hasType(handle, CURSE); }
+
+        /**
+         * @brief Whether the card can be chosen for the kingdom of a lobby, see CLIENT_UNSUPPORTED_CARDS.
+         */
+        static constexpr bool isSelectable(CardBase::handle_t handle)
+        {
+            return std::find(std::begin(CLIENT_UNSUPPORTED_CARDS), std::end(CLIENT_UNSUPPORTED_CARDS),
+                             CARD_TABLE.ids[toIndex(handle)]) == std::end(CLIENT_UNSUPPORTED_CARDS);
+        }
 
     private:
-        static map_t _map;
+        static constexpr bool hasType(CardBase::handle_t handle, CardType type)
+        {
+            return (getType(handle) & type) == type;
+        }
+
+        /**
+         * @brief Runtime lookup tables for the card ids, built once from the CARD_TABLE on first use.
+         */
+        struct Lookup
+        {
+            map_t cards;
+            handle_map_t handles;
+            std::vector<CardBase::id_t> ids;
+        };
+
+        static const Lookup &lookup();
     };
 
+    /**
+     * @brief Prints the card id of the handle, so handles can be logged like card ids.
+     */
+    inline std::ostream &operator<<(std::ostream &os, CardBase::handle_t handle)
+    {
+        return os << CardFactory::getId(handle);
+    }
+
 } // namespace shared
 
 // function implementations
 namespace shared
 {
-    inline void shared::CardFactory::insert(const shared::CardBase::id_t &card_id, shared::CardType type,
-                                            unsigned int cost)
-    {
-        _map.emplace(card_id, std::make_unique<CardBase>(card_id, type, cost));
-    }
-
-    inline const shared::CardBase &shared::CardFactory::getCard(const shared::CardBase::id_t &card_id)
+    inline shared::CardBase::handle_t shared::CardFactory::getHandle(const shared::CardBase::id_t &card_id)
     {
-        return *_map.at(card_id).get();
-    }
-
-    inline unsigned int shared::CardFactory::getCost(const shared::CardBase::id_t &card_id)
-    {
-        if ( !has(card_id) ) {
+        const auto &handles = lookup().handles;
+        const auto it = handles.find(card_id);
+        if ( it == handles.end() ) {
             LOG(ERROR) << "Tried to access card: " << card_id << ", but this card does not exist";
             throw std::invalid_argument("card_id: " + card_id + " does not exist");
         }
-
-        return CardFactory::getCard(card_id).getCost();
-    }
-
-    inline shared::CardType shared::CardFactory::getType(const shared::CardBase::id_t &card_id)
-    {
-        if ( !has(card_id) ) {
-            LOG(ERROR) << "Tried to access card type for: " << card_id << ", but this card does not exist";
-            throw std::invalid_argument("card_id: " + card_id + " does not exist");
-        }
-        return getCard(card_id).getType();
-    }
-
-    inline shared::CardBase::id_t shared::CardFactory::getId(const shared::CardBase::id_t &card_id)
-    {
-        if ( !has(card_id) ) {
-            LOG(ERROR) << "Tried to access card ID for: " << card_id << ", but this card does not exist";
-            throw std::invalid_argument("card_id: " + card_id + " does not exist");
-        }
-        return getCard(card_id).getId();
+        return it->second;
     }
 
-    inline bool shared::CardFactory::isAction(const shared::CardBase::id_t &card_id)
+    inline std::optional<shared::CardBase::handle_t>
+    shared::CardFactory::findHandle(const shared::CardBase::id_t &card_id)
     {
-        if ( !has(card_id) ) {
-            LOG(ERROR) << "Tried to check if card is action: " << card_id << ", but this card does not exist";
-            throw std::invalid_argument("card_id: " + card_id + " does not exist");
-        }
-        return getCard(card_id).isAction();
-    }
-
-    inline bool shared::CardFactory::isAttack(const shared::CardBase::id_t &card_id)
-    {
-        if ( !has(card_id) ) {
-            LOG(ERROR) << "Tried to check if card is attack: " << card_id << ", but this card does not exist";
-            throw std::invalid_argument("card_id: " + card_id + " does not exist");
+        const auto &handles = lookup().handles;
+        const auto it = handles.find(card_id);
+        if ( it == handles.end() ) {
+            return std::nullopt;
         }
-        return getCard(card_id).isAttack();
+        return it->second;
     }
 
-    inline bool shared::CardFactory::isReaction(const shared::CardBase::id_t &card_id)
-    {
-        if ( !has(card_id) ) {
-            LOG(ERROR) << "Tried to check if card is reaction: " << card_id << ", but this card does not exist";
-            throw std::invalid_argument("card_id: " + card_id + " does not exist");
-        }
-        return getCard(card_id).isReaction();
-    }
-
-    inline bool shared::CardFactory::isTreasure(const shared::CardBase::id_t &card_id)
-    {
-        if ( !has(card_id) ) {
-            LOG(ERROR) << "Tried to check if card is treasure: " << card_id << ", but this card does not exist";
-            throw std::invalid_argument("card_id: " + card_id + " does not exist");
-        }
-        return getCard(card_id).isTreasure();
-    }
-
-    inline bool shared::CardFactory::isVictory(const shared::CardBase::id_t &card_id)
-    {
-        if ( !has(card_id) ) {
-            LOG(ERROR) << "Tried to check if card is victory: " << card_id << ", but this card does not exist";
-            throw std::invalid_argument("card_id: " + card_id + " does not exist");
-        }
-        return getCard(card_id).isVictory();
-    }
-
-    inline bool shared::CardFactory::isCurse(const shared::CardBase::id_t &card_id)
+    inline const shared::CardBase &shared::CardFactory::getCard(const shared::CardBase::id_t &card_id)
     {
-        if ( !has(card_id) ) {
-            LOG(ERROR) << "Tried to check if card is curse: " << card_id << ", but this card does not exist";
-            throw std::invalid_argument("card_id: " + card_id + " does not exist");
-        }
-        return getCard(card_id).isCurse();
+        return *getAll().at(card_id).get();
     }
 
     inline shared::CardFactory::sorted_t shared::CardFactory::getKingdomSortedByCost()
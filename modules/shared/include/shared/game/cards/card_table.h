@@ -0,0 +1,170 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
+#include <string_view>
+
+#include <shared/game/cards/card_base.h>
+
+namespace shared
+{
+    /**
+     * @brief A single entry of the card list, this is only used to build the CardTable.
+     */
+    struct CardEntry
+    {
+        std::string_view id;
+        uint16_t type;
+        uint8_t cost;
+    };
+
+    // clang-format off
+    /**
+     * @brief All cards of the game. The position of a card in this list is its handle.
+     *
+     * New cards have to be added here, the CardFactory and the card handles are derived from this list at compile time.
+     */
+    inline constexpr CardEntry CARD_LIST[] = {
+        /*
+        SUPPLY CARDS
+         */
+
+        // treasure
+        {"Copper", CardType::TREASURE, 0},
+        {"Silver", CardType::TREASURE, 3},
+        {"Gold", CardType::TREASURE, 6},
+
+        // victory
+        {"Estate", CardType::VICTORY, 2},
+        {"Duchy", CardType::VICTORY, 5},
+        {"Province", CardType::VICTORY, 8},
+
+        // curse
+        {"Curse", CardType::CURSE, 0},
+
+        /*
+        KINGDOM CARDS
+        */
+
+        // {"Merchant", CardType::ACTION, 3}, // conditional effect, how?
+
+        // God Mode (for testing only)
+        {"God_Mode", CardType::ACTION, 0},
+
+        // non-interactive
+        {"Village", CardType::ACTION, 3},
+        {"Smithy", CardType::ACTION, 4},
+        {"Festival", CardType::ACTION, 5},
+        {"Market", CardType::ACTION, 5},
+        {"Laboratory", CardType::ACTION, 5},
+        {"Council_Room", CardType::ACTION, 5},
+        {"Witch", CardType::ACTION | CardType::ATTACK, 5},
+        {"Workers_Village", CardType::ACTION, 4},
+        {"Great_Hall", CardType::ACTION | CardType::VICTORY, 3},
+        {"Treasure_Map", CardType::ACTION, 4},
+        {"Sea_Hag", CardType::ACTION | CardType::ATTACK, 4},
+
+        // victory cards
+        {"Gardens", CardType::KINGDOM | CardType::VICTORY, 4},
+        {"Duke", CardType::KINGDOM | CardType::VICTORY, 5},
+        {"Silk_Road", CardType::KINGDOM | CardType::VICTORY, 4},
+
+        // treasure cards
+        {"Treasure_Trove", CardType::KINGDOM | CardType::TREASURE, 5},
+
+        // reaction cards
+        {"Moat", CardType::ACTION | CardType::REACTION, 2},
+
+        // interactive
+        {"Remodel", CardType::ACTION, 4},
+        {"Poacher", CardType::ACTION, 4},
+        {"Moneylender", CardType::ACTION, 4},
+        {"Mine", CardType::ACTION, 5},
+        {"Artisan", CardType::ACTION, 6},
+        {"Cellar", CardType::ACTION, 2},
+        {"Chapel", CardType::ACTION, 2},
+        {"Workshop", CardType::ACTION, 3},
+        // {"Vassal", CardType::ACTION, 3},
+        // {"Harbinger", CardType::ACTION, 3},
+        {"Militia", CardType::ACTION | CardType::ATTACK, 4},
+        // {"Bureaucrat", CardType::ACTION | CardType::ATTACK, 4},
+        {"Throne_Room", CardType::ACTION, 4},
+        {"Sentry", CardType::ACTION, 5},
+        {"Library", CardType::ACTION, 5},
+        {"Bandit", CardType::ACTION | CardType::ATTACK, 5},
+    };
+
+    /**
+     * @brief Cards the server can play, but whose ChooseFromStagedOrder the client cannot answer yet (#195). Lobbies
+     * neither offer nor accept them, only the simulator deals them.
+     */
+    inline constexpr std::string_view CLIENT_UNSUPPORTED_CARDS[] = {"Sentry", "Library", "Bandit"};
+    // clang-format on
+
+    /**
+     * @brief Struct-of-arrays view of the card list, indexed by card handle.
+     *
+     * Type and cost checks on the hot path are plain array loads, no hashing or pointer chasing involved.
+     */
+    template <size_t N>
+    struct CardTable
+    {
+        std::array<std::string_view, N> ids;
+        std::array<CardType, N> types;
+        std::array<uint8_t, N> costs;
+
+        static constexpr size_t size() { return N; }
+
+        /**
+         * @brief Linear search for the handle of a card, meant for compile time lookups.
+         * At runtime use CardFactory::getHandle instead.
+         */
+        constexpr std::optional<CardBase::handle_t> find(std::string_view card_id) const
+        {
+            for ( size_t i = 0; i < N; ++i ) {
+                if ( ids[i] == card_id ) {
+                    return static_cast<CardBase::handle_t>(i);
+                }
+            }
+            return std::nullopt;
+        }
+    };
+
+    template <size_t N>
+    constexpr CardTable<N> makeCardTable(const CardEntry (&entries)[N])
+    {
+        static_assert(N <= UINT16_MAX, "Too many cards for a 16 bit handle");
+
+        CardTable<N> table{};
+        for ( size_t i = 0; i < N; ++i ) {
+            for ( size_t j = 0; j < i; ++j ) {
+                if ( entries[i].id == entries[j].id ) {
+                    throw std::logic_error("Card registered twice");
+                }
+            }
+            table.ids[i] = entries[i].id;
+            table.types[i] = static_cast<CardType>(entries[i].type);
+            table.costs[i] = entries[i].cost;
+        }
+        return table;
+    }
+
+    inline constexpr auto CARD_TABLE = makeCardTable(CARD_LIST);
+
+    /**
+     * @brief Compile time handle of a card, fails to compile if the card does not exist.
+     *
+     * Example: `constexpr auto copper = shared::cardHandle("Copper");`
+     */
+    consteval CardBase::handle_t cardHandle(std::string_view card_id)
+    {
+        const auto handle = CARD_TABLE.find(card_id);
+        if ( !handle.has_value() ) {
+            throw std::invalid_argument("Card does not exist");
+        }
+        return *handle;
+    }
+
+} // namespace shared
@@ -1,12 +1,17 @@
 
 #pragma once
 
+#include <optional>
 #include <set>
 #include <vector>
 
 #include <shared/game/cards/card_base.h>
 #include <shared/game/cards/card_factory.h>
+#include <shared/game/game_state/card_list_delta.h>
 #include <shared/utils/assert.h>
+#include <shared/utils/binary.h>
+#include <shared/utils/json_writer.h>
+#include <shared/utils/json_writer.h>
 
 #include <rapidjson/document.h>
 
@@ -59,9 +64,13 @@ namespace shared
         bool operator==(const Pile &other) const;
         bool operator!=(const Pile &other) const;
 
+        void writeJson(JsonWriter &writer) const;
         rapidjson::Document toJson() const;
         static std::unique_ptr<Pile> fromJson(const rapidjson::Value &json);
 
+        void toBinary(BinaryWriter &writer) const;
+        static Pile fromBinary(BinaryReader &reader);
+
         /**
          * @brief Creates a new kingdom card pile with size 10; defined by board_config::KINGDOM_CARD_COUNT
          *
@@ -107,6 +116,34 @@ namespace shared
         using ptr_t = std::shared_ptr<Board>;
         using pile_container_t = std::set<Pile, Pile::PileComparator>;
 
+        /**
+         * @brief Changes of the board between two versions of a game state.
+         */
+        struct Delta
+        {
+            // only the piles whose count changed, with their new count
+            std::vector<Pile> piles;
+            std::optional<CardListDelta> trash;
+            std::optional<CardListDelta> played_cards;
+
+            /**
+             * @return std::nullopt if the board did not change.
+             */
+            static std::optional<Delta> make(const Board &from, const Board &to);
+            /**
+             * @throw exception::DeltaMismatch if a pile is not on the board.
+             */
+            void applyTo(Board &board) const;
+
+            bool operator==(const Delta &other) const = default;
+
+            void writeJson(JsonWriter &writer) const;
+            rapidjson::Document toJson() const;
+            static std::unique_ptr<Delta> fromJson(const rapidjson::Value &json);
+            void toBinary(BinaryWriter &writer) const;
+            static Delta fromBinary(BinaryReader &reader);
+        };
+
         /**
          * @brief Constructs a shared_ptr on a ServerBoard for a given number of players and 10 kingdom cards.
          *
@@ -118,9 +155,25 @@ namespace shared
         bool operator==(const Board &other) const;
         bool operator!=(const Board &other) const;
 
+        /**
+         * @brief Stream the board as a JSON object into writer, toJson is built on top of it.
+         */
+        void writeJson(JsonWriter &writer) const;
         rapidjson::Document toJson() const;
         static ptr_t fromJson(const rapidjson::Value &json);
 
+        void toBinary(BinaryWriter &writer) const;
+        /**
+         * @throw exception::MalformedMessage
+         */
+        static ptr_t fromBinary(BinaryReader &reader);
+
+        /**
+         * @brief Deep copy of the board. Reduced game states share the live board of the server, a copy is needed to
+         * remember what a client has seen.
+         */
+        ptr_t clone() const;
+
         virtual ~Board() = default;
 
         // enable move semantics
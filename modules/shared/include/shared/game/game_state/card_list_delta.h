@@ -0,0 +1,59 @@
+#pragma once
+
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include <rapidjson/document.h>
+
+#include <shared/game/cards/card_base.h>
+#include <shared/utils/binary.h>
+#include <shared/utils/json_writer.h>
+
+namespace shared
+{
+    /**
+     * @brief Change of a card list between two versions of a game state.
+     *
+     * Discard pile, played cards and trash mostly grow at the end and are cleared at once, so the delta keeps a prefix
+     * of the old list and appends the new cards. Removing a card from the middle (e.g. playing a card from the hand)
+     * still works, only the cards after it are resent.
+     */
+    struct CardListDelta
+    {
+        size_t keep = 0;
+        std::vector<CardBase::id_t> append;
+
+        /**
+         * @return std::nullopt if the lists are equal.
+         */
+        static std::optional<CardListDelta> make(const std::vector<CardBase::id_t> &from,
+                                                 const std::vector<CardBase::id_t> &to);
+
+        /**
+         * @throw exception::DeltaMismatch if the list is shorter than the kept prefix.
+         */
+        void applyTo(std::vector<CardBase::id_t> &cards) const;
+
+        bool operator==(const CardListDelta &other) const = default;
+
+        void writeJson(JsonWriter &writer) const;
+        rapidjson::Document toJson() const;
+        static std::unique_ptr<CardListDelta> fromJson(const rapidjson::Value &json);
+        /**
+         * @brief Reads an optional delta, a missing member means the list did not change.
+         * @return false if the member is present but invalid.
+         */
+        static bool optionalFromJson(const rapidjson::Value &json, const char *member,
+                                     std::optional<CardListDelta> &delta);
+
+        void toBinary(BinaryWriter &writer) const;
+        static CardListDelta fromBinary(BinaryReader &reader);
+
+        /**
+         * @brief Writes an optional delta, the common case of an unchanged list costs a single byte.
+         */
+        static void toBinary(BinaryWriter &writer, const std::optional<CardListDelta> &delta);
+        static std::optional<CardListDelta> optionalFromBinary(BinaryReader &reader);
+    };
+} // namespace shared
@@ -6,9 +6,13 @@
 #include <iomanip> // for operator<<
 #include <iostream> // for operator<<
 #include <memory>
+#include <optional>
 
 #include <rapidjson/document.h>
 #include <shared/game/cards/card_base.h>
+#include <shared/game/game_state/card_list_delta.h>
+#include <shared/utils/binary.h>
+#include <shared/utils/json_writer.h>
 
 namespace shared
 {
@@ -30,6 +34,39 @@ namespace shared
     public:
         using id_t = std::string;
 
+        /**
+         * @brief Changes of a player between two versions of a game state. The counters are always sent, they only
+         * take a few bytes.
+         */
+        struct Delta
+        {
+            id_t player_id;
+            unsigned int actions = 0;
+            unsigned int buys = 0;
+            unsigned int treasure = 0;
+            CardBase::id_t current_card;
+            std::optional<CardListDelta> discard_pile;
+            unsigned int draw_pile_size = 0;
+
+            static Delta make(const PlayerBase &from, const PlayerBase &to);
+            /**
+             * @throw exception::DeltaMismatch if the delta belongs to another player.
+             */
+            void applyTo(PlayerBase &player) const;
+
+            bool operator==(const Delta &other) const = default;
+
+            void writeJson(JsonWriter &writer) const;
+            /**
+             * @brief Writes the members without opening an object, for the deltas that extend this one.
+             */
+            void writeJsonMembers(JsonWriter &writer) const;
+            rapidjson::Document toJson() const;
+            static std::unique_ptr<Delta> fromJson(const rapidjson::Value &json);
+            void toBinary(BinaryWriter &writer) const;
+            static Delta fromBinary(BinaryReader &reader);
+        };
+
         PlayerBase(id_t player_id);
         PlayerBase(const PlayerBase &other);
 
@@ -79,6 +116,14 @@ namespace shared
         std::vector<CardBase::id_t> discard_pile;
         unsigned int draw_pile_size;
 
+        /**
+         * @brief Stream the player as a JSON object into writer.
+         */
+        void writeJson(JsonWriter &writer) const;
+        /**
+         * @brief Stream the members of the player without opening an object, for derived players to extend.
+         */
+        void writeJsonMembers(JsonWriter &writer) const;
         /**
          * @brief Convert the player to a `rapidjson::Document` JSON object.
          */
@@ -87,6 +132,12 @@ namespace shared
          * @brief Initialize a player from a `rapidjson::Value` JSON object.
          */
         static std::unique_ptr<PlayerBase> fromJson(const rapidjson::Value &json);
+
+        void toBinary(BinaryWriter &writer) const;
+        /**
+         * @throw exception::MalformedMessage
+         */
+        static std::unique_ptr<PlayerBase> fromBinary(BinaryReader &reader);
     };
 
 } // namespace shared
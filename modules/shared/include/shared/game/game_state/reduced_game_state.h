@@ -1,5 +1,6 @@
 #pragma once
 
+#include <optional>
 #include <vector>
 
 #include <shared/game/game_state/board_base.h>
@@ -11,6 +12,40 @@ namespace reduced
     class GameState
     {
     public:
+        /**
+         * @brief Changes between two game states of the same player. Only what changed is set.
+         */
+        struct Delta
+        {
+            std::optional<shared::Board::Delta> board;
+            std::optional<reduced::Player::Delta> reduced_player;
+            // only the enemies that changed, matched by their id
+            std::vector<reduced::Enemy::Delta> reduced_enemies;
+            std::optional<shared::PlayerBase::id_t> active_player;
+            std::optional<shared::GamePhase> game_phase;
+
+            /**
+             * @return nullptr if the states belong to different players or games, a full state has to be sent then.
+             */
+            static std::unique_ptr<Delta> make(const GameState &from, const GameState &to);
+            /**
+             * @throw exception::DeltaMismatch if the delta was not made for this state.
+             */
+            void applyTo(GameState &game_state) const;
+
+            bool empty() const;
+            bool operator==(const Delta &other) const = default;
+
+            void writeJson(shared::JsonWriter &writer) const;
+            rapidjson::Document toJson() const;
+            static std::unique_ptr<Delta> fromJson(const rapidjson::Value &json);
+            void toBinary(shared::BinaryWriter &writer) const;
+            /**
+             * @throw exception::MalformedMessage
+             */
+            static std::unique_ptr<Delta> fromBinary(shared::BinaryReader &reader);
+        };
+
         // Constructor to use on the server side
         GameState(shared::Board::ptr_t board, reduced::Player::ptr_t reduced_player,
                   std::vector<reduced::Enemy::ptr_t> &&reduced_enemies, const shared::PlayerBase::id_t &active_player,
@@ -22,14 +57,24 @@ namespace reduced
 
         GameState(GameState &&other) :
             board(std::move(other.board)), reduced_player(std::move(other.reduced_player)),
-            reduced_enemies(std::move(other.reduced_enemies)), active_player(other.active_player)
+            reduced_enemies(std::move(other.reduced_enemies)), active_player(other.active_player),
+            game_phase(other.game_phase)
         {}
 
+        /**
+         * @brief Deep copy of the state, the board of a state built on the server is shared with the live game.
+         */
+        std::unique_ptr<GameState> clone() const;
+
         bool operator==(const GameState &other) const;
         bool operator!=(const GameState &other) const;
 
         bool isPlayerActive() const;
 
+        /**
+         * @brief Stream the GameState as a JSON object into writer, without building a document.
+         */
+        void writeJson(shared::JsonWriter &writer) const;
         /**
          * @brief Serialize the GameState to a JSON object.
          */
@@ -39,6 +84,16 @@ namespace reduced
          */
         static std::unique_ptr<GameState> fromJson(const rapidjson::Value &json);
 
+        /**
+         * @brief Serialize the GameState in the binary wire format.
+         */
+        void toBinary(shared::BinaryWriter &writer) const;
+        /**
+         * @brief Deserialize a GameState from the binary wire format.
+         * @throw exception::MalformedMessage
+         */
+        static std::unique_ptr<GameState> fromBinary(shared::BinaryReader &reader);
+
         shared::Board::ptr_t board;
         reduced::Player::ptr_t reduced_player;
         std::vector<reduced::Enemy::ptr_t> reduced_enemies;
@@ -9,13 +9,36 @@ namespace reduced
     public:
         using ptr_t = std::unique_ptr<Enemy>;
 
+        struct Delta : shared::PlayerBase::Delta
+        {
+            unsigned int hand_size = 0;
+
+            /**
+             * @return std::nullopt if the enemy did not change.
+             */
+            static std::optional<Delta> make(const Enemy &from, const Enemy &to);
+            void applyTo(Enemy &enemy) const;
+
+            bool operator==(const Delta &other) const = default;
+
+            void writeJson(shared::JsonWriter &writer) const;
+            rapidjson::Document toJson() const;
+            static std::unique_ptr<Delta> fromJson(const rapidjson::Value &json);
+            void toBinary(shared::BinaryWriter &writer) const;
+            static Delta fromBinary(shared::BinaryReader &reader);
+        };
+
         static ptr_t make(const PlayerBase &player, unsigned int hand_size);
 
         Enemy(Enemy &&other) noexcept : PlayerBase(std::move(other)), hand_size(other.hand_size) {}
 
+        void writeJson(shared::JsonWriter &writer) const;
         rapidjson::Document toJson() const;
         static std::unique_ptr<Enemy> fromJson(const rapidjson::Value &json);
 
+        void toBinary(shared::BinaryWriter &writer) const;
+        static std::unique_ptr<Enemy> fromBinary(shared::BinaryReader &reader);
+
         unsigned int getHandSize() const;
 
     protected:
@@ -28,18 +51,41 @@ namespace reduced
     public:
         using ptr_t = std::unique_ptr<Player>;
 
+        struct Delta : shared::PlayerBase::Delta
+        {
+            std::optional<shared::CardListDelta> hand_cards;
+
+            /**
+             * @return std::nullopt if the player did not change.
+             */
+            static std::optional<Delta> make(const Player &from, const Player &to);
+            void applyTo(Player &player) const;
+
+            bool operator==(const Delta &other) const = default;
+
+            void writeJson(shared::JsonWriter &writer) const;
+            rapidjson::Document toJson() const;
+            static std::unique_ptr<Delta> fromJson(const rapidjson::Value &json);
+            void toBinary(shared::BinaryWriter &writer) const;
+            static Delta fromBinary(shared::BinaryReader &reader);
+        };
+
         static ptr_t make(const shared::PlayerBase &player, std::vector<shared::CardBase::id_t> hand_cards);
 
         Player(Player &&other) noexcept : shared::PlayerBase(std::move(other)), hand_cards(std::move(other.hand_cards))
         {}
 
+        void writeJson(shared::JsonWriter &writer) const;
         rapidjson::Document toJson() const;
         static std::unique_ptr<Player> fromJson(const rapidjson::Value &json);
 
+        void toBinary(shared::BinaryWriter &writer) const;
+        static std::unique_ptr<Player> fromBinary(shared::BinaryReader &reader);
+
         const std::vector<shared::CardBase::id_t> &getHandCards() const;
 
     protected:
         Player(const shared::PlayerBase &player, const std::vector<shared::CardBase::id_t> &hand_cards);
-        const std::vector<shared::CardBase::id_t> hand_cards;
+        std::vector<shared::CardBase::id_t> hand_cards;
     };
 }; // namespace reduced
\ No newline at end of file
@@ -1,8 +1,11 @@
 #pragma once
 
+#include <cstdint>
 #include <memory>
 #include <optional>
+#include <span>
 #include <string>
+#include <type_traits>
 #include <vector>
 
 #include <shared/action_decision.h>
@@ -10,25 +13,67 @@
 #include <shared/game/game_state/player_base.h>
 #include <shared/game/game_state/reduced_game_state.h>
 #include <shared/player_result.h>
+#include <shared/utils/binary.h>
+#include <shared/utils/exception.h>
+#include <shared/utils/tag_cast.h>
 #include <shared/utils/uuid_generator.h>
 
 namespace shared
 {
+    class InSituJsonParser;
+
+    /**
+     * @brief Identifies the message type, in memory as well as in the binary format where it is the counterpart of the
+     * "type" member in JSON. The values are part of the protocol, only ever append new ones.
+     */
+    enum class MessageTag : uint8_t
+    {
+        // client -> server
+        GAME_STATE_REQUEST = 1,
+        CREATE_LOBBY_REQUEST,
+        JOIN_LOBBY_REQUEST,
+        START_GAME_REQUEST,
+        ACTION_DECISION,
+
+        // server -> client
+        GAME_STATE = 64,
+        CREATE_LOBBY_RESPONSE,
+        JOIN_LOBBY_BROADCAST,
+        START_GAME_BROADCAST,
+        END_GAME_BROADCAST,
+        RESULT_RESPONSE,
+        ACTION_ORDER,
+        GAME_STATE_DELTA
+    };
 
     class Message
     {
     public:
         virtual ~Message() = default;
         virtual std::string toJson() const = 0;
+        /**
+         * @brief Compact encoding of the message: BINARY_MAGIC, the MessageTag, then the fields in declaration order.
+         */
+        virtual std::string toBinary() const = 0;
+
+        std::string encode(WireFormat format) const { return format == WireFormat::BINARY ? toBinary() : toJson(); }
+
+        /**
+         * @brief The concrete type of the message, dispatch on it with visit or tagCast instead of dynamic_cast.
+         */
+        MessageTag getTag() const { return tag; }
 
         std::string game_id;
         std::string message_id;
 
     protected:
-        Message(std::string game_id, std::string message_id = UuidGenerator::generateUuidV4()) :
-            game_id(game_id), message_id(message_id)
+        Message(MessageTag tag, std::string game_id, std::string message_id = UuidGenerator::generateUuidV4()) :
+            game_id(game_id), message_id(message_id), tag(tag)
         {}
         bool operator==(const Message &other) const;
+
+    private:
+        MessageTag tag;
     };
 
     /* ======= client -> server ======= */
@@ -38,14 +83,34 @@ namespace shared
     public:
         ~ClientToServerMessage() override = default;
         std::string toJson() const override = 0;
-        static std::unique_ptr<ClientToServerMessage> fromJson(const std::string &json);
+        std::string toBinary() const override = 0;
+        static std::unique_ptr<ClientToServerMessage> fromJson(std::string_view json);
+        /**
+         * Returns nullptr if the payload is malformed.
+         */
+        static std::unique_ptr<ClientToServerMessage> fromBinary(std::string_view binary);
+        /**
+         * @brief Parses a payload in either wire format, see detectWireFormat.
+         */
+        static std::unique_ptr<ClientToServerMessage> decode(std::string_view payload);
+
+        /**
+         * @brief Parses JSON in place with a parser that is reused across messages, see InSituJsonParser.
+         * json has to be zero terminated and is garbage afterwards. Returns nullptr if it is malformed.
+         */
+        static std::unique_ptr<ClientToServerMessage> fromJsonInSitu(char *json, InSituJsonParser &parser);
+        /**
+         * @brief decode for a payload that may be modified, JSON is parsed in place.
+         * The byte after the payload has to be '\0', like FrameDecoder::nextWritable leaves it.
+         */
+        static std::unique_ptr<ClientToServerMessage> decodeInSitu(std::span<char> payload, InSituJsonParser &parser);
 
         PlayerBase::id_t player_id;
 
     protected:
-        ClientToServerMessage(std::string game_id, PlayerBase::id_t player_id,
+        ClientToServerMessage(MessageTag tag, std::string game_id, PlayerBase::id_t player_id,
                               std::string message_id = UuidGenerator::generateUuidV4()) :
-            Message(game_id, message_id),
+            Message(tag, game_id, message_id),
             player_id(player_id)
         {}
         bool operator==(const ClientToServerMessage &other) const;
@@ -54,42 +119,53 @@ namespace shared
     class GameStateRequestMessage final : public ClientToServerMessage
     {
     public:
+        static constexpr MessageTag TAG = MessageTag::GAME_STATE_REQUEST;
+
         GameStateRequestMessage(std::string game_id, PlayerBase::id_t player_id,
                                 std::string message_id = UuidGenerator::generateUuidV4()) :
-            ClientToServerMessage(game_id, player_id, message_id)
+            ClientToServerMessage(TAG, game_id, player_id, message_id)
         {}
         ~GameStateRequestMessage() override = default;
         std::string toJson() const override;
+        std::string toBinary() const override;
         bool operator==(const GameStateRequestMessage &other) const;
     };
 
     class CreateLobbyRequestMessage final : public ClientToServerMessage
     {
     public:
+        static constexpr MessageTag TAG = MessageTag::CREATE_LOBBY_REQUEST;
+
         CreateLobbyRequestMessage(std::string game_id, PlayerBase::id_t player_id,
                                   std::string message_id = UuidGenerator::generateUuidV4()) :
-            ClientToServerMessage(game_id, player_id, message_id)
+            ClientToServerMessage(TAG, game_id, player_id, message_id)
         {}
         ~CreateLobbyRequestMessage() override = default;
         std::string toJson() const override;
+        std::string toBinary() const override;
         bool operator==(const CreateLobbyRequestMessage &other) const;
     };
 
     class JoinLobbyRequestMessage final : public ClientToServerMessage
     {
     public:
+        static constexpr MessageTag TAG = MessageTag::JOIN_LOBBY_REQUEST;
+
         ~JoinLobbyRequestMessage() override = default;
         JoinLobbyRequestMessage(std::string game_id, PlayerBase::id_t player_id,
                                 std::string message_id = UuidGenerator::generateUuidV4()) :
-            ClientToServerMessage(game_id, player_id, message_id)
+            ClientToServerMessage(TAG, game_id, player_id, message_id)
         {}
         std::string toJson() const override;
+        std::string toBinary() const override;
         bool operator==(const JoinLobbyRequestMessage &other) const;
     };
 
     class StartGameRequestMessage final : public ClientToServerMessage
     {
     public:
+        static constexpr MessageTag TAG = MessageTag::START_GAME_REQUEST;
+
         ~StartGameRequestMessage() override = default;
         /**
          * @param selected_cards The 10 cards selected by the game master to play with.
@@ -99,6 +175,7 @@ namespace shared
                                 std::vector<CardBase::id_t> selected_cards,
                                 std::string message_id = UuidGenerator::generateUuidV4());
         std::string toJson() const override;
+        std::string toBinary() const override;
         bool operator==(const StartGameRequestMessage &other) const;
 
         std::vector<CardBase::id_t> selected_cards;
@@ -107,14 +184,17 @@ namespace shared
     class ActionDecisionMessage final : public ClientToServerMessage
     {
     public:
+        static constexpr MessageTag TAG = MessageTag::ACTION_DECISION;
+
         ~ActionDecisionMessage() override = default;
         ActionDecisionMessage(std::string game_id, PlayerBase::id_t player_id, std::unique_ptr<ActionDecision> decision,
                               std::optional<std::string> in_response_to = std::nullopt,
                               std::string message_id = UuidGenerator::generateUuidV4()) :
-            ClientToServerMessage(game_id, player_id, message_id),
+            ClientToServerMessage(TAG, game_id, player_id, message_id),
             decision(std::move(decision)), in_response_to(in_response_to)
         {}
         std::string toJson() const override;
+        std::string toBinary() const override;
         bool operator==(const ActionDecisionMessage &other) const;
 
         std::unique_ptr<ActionDecision> decision;
@@ -133,11 +213,21 @@ namespace shared
          * Returns nullptr if the JSON is invalid.
          */
         std::string toJson() const override = 0;
-        static std::unique_ptr<ServerToClientMessage> fromJson(const std::string &json);
+        std::string toBinary() const override = 0;
+        static std::unique_ptr<ServerToClientMessage> fromJson(std::string_view json);
+        /**
+         * Returns nullptr if the payload is malformed.
+         */
+        static std::unique_ptr<ServerToClientMessage> fromBinary(std::string_view binary);
+        /**
+         * @brief Parses a payload in either wire format, see detectWireFormat.
+         */
+        static std::unique_ptr<ServerToClientMessage> decode(std::string_view payload);
 
     protected:
-        ServerToClientMessage(std::string game_id, std::string message_id = UuidGenerator::generateUuidV4()) :
-            Message(game_id, message_id)
+        ServerToClientMessage(MessageTag tag, std::string game_id,
+                              std::string message_id = UuidGenerator::generateUuidV4()) :
+            Message(tag, game_id, message_id)
         {}
         bool operator==(const ServerToClientMessage &other) const;
     };
@@ -145,31 +235,69 @@ namespace shared
     class GameStateMessage final : public ServerToClientMessage
     {
     public:
+        static constexpr MessageTag TAG = MessageTag::GAME_STATE;
+
         ~GameStateMessage() override = default;
         GameStateMessage(std::string game_id, std::unique_ptr<reduced::GameState> game_state,
                          std::optional<std::string> in_response_to = std::nullopt,
                          std::string message_id = UuidGenerator::generateUuidV4()) :
 
-            ServerToClientMessage(game_id, message_id),
+            ServerToClientMessage(TAG, game_id, message_id),
             game_state(std::move(game_state)), in_response_to(in_response_to)
         {}
         std::string toJson() const override;
+        std::string toBinary() const override;
         bool operator==(const GameStateMessage &other) const;
 
         std::unique_ptr<reduced::GameState> game_state;
         std::optional<std::string> in_response_to;
+        /**
+         * @brief Version of the state for this player, following GameStateDeltaMessages build on it.
+         * 0 if the sender does not track versions.
+         */
+        unsigned int version = 0;
+    };
+
+    /**
+     * @brief Changes to the game state of a player since the state with version base_version.
+     *
+     * The client applies the delta to its copy of that state, which then has the given version. If the client does
+     * not have the base version it requests the full state with a GameStateRequestMessage.
+     */
+    class GameStateDeltaMessage final : public ServerToClientMessage
+    {
+    public:
+        static constexpr MessageTag TAG = MessageTag::GAME_STATE_DELTA;
+
+        ~GameStateDeltaMessage() override = default;
+        GameStateDeltaMessage(std::string game_id, unsigned int base_version, unsigned int version,
+                              std::unique_ptr<reduced::GameState::Delta> delta,
+                              std::string message_id = UuidGenerator::generateUuidV4()) :
+            ServerToClientMessage(TAG, std::move(game_id), std::move(message_id)),
+            base_version(base_version), version(version), delta(std::move(delta))
+        {}
+        std::string toJson() const override;
+        std::string toBinary() const override;
+        bool operator==(const GameStateDeltaMessage &other) const;
+
+        unsigned int base_version;
+        unsigned int version;
+        std::unique_ptr<reduced::GameState::Delta> delta;
     };
 
     class CreateLobbyResponseMessage final : public ServerToClientMessage
     {
     public:
+        static constexpr MessageTag TAG = MessageTag::CREATE_LOBBY_RESPONSE;
+
         ~CreateLobbyResponseMessage() override = default;
         CreateLobbyResponseMessage(std::string game_id, std::optional<std::string> in_response_to = std::nullopt,
                                    std::string message_id = UuidGenerator::generateUuidV4()) :
-            ServerToClientMessage(game_id, message_id),
+            ServerToClientMessage(TAG, game_id, message_id),
             in_response_to(in_response_to)
         {}
         std::string toJson() const override;
+        std::string toBinary() const override;
         bool operator==(const CreateLobbyResponseMessage &other) const;
 
         std::vector<CardBase::id_t> available_cards;
@@ -179,13 +307,16 @@ namespace shared
     class JoinLobbyBroadcastMessage final : public ServerToClientMessage
     {
     public:
+        static constexpr MessageTag TAG = MessageTag::JOIN_LOBBY_BROADCAST;
+
         ~JoinLobbyBroadcastMessage() override = default;
         JoinLobbyBroadcastMessage(std::string game_id, std::vector<shared::PlayerBase::id_t> players,
                                   std::string message_id = UuidGenerator::generateUuidV4()) :
-            ServerToClientMessage(game_id, message_id),
+            ServerToClientMessage(TAG, game_id, message_id),
             players(players)
         {}
         std::string toJson() const override;
+        std::string toBinary() const override;
         bool operator==(const JoinLobbyBroadcastMessage &other) const;
         std::vector<shared::PlayerBase::id_t> players;
     };
@@ -193,44 +324,58 @@ namespace shared
     class StartGameBroadcastMessage final : public ServerToClientMessage
     {
     public:
+        static constexpr MessageTag TAG = MessageTag::START_GAME_BROADCAST;
+
         ~StartGameBroadcastMessage() override = default;
         StartGameBroadcastMessage(std::string game_id, std::string message_id = UuidGenerator::generateUuidV4()) :
-            ServerToClientMessage(game_id, message_id)
+            ServerToClientMessage(TAG, game_id, message_id)
         {}
         std::string toJson() const override;
+        std::string toBinary() const override;
         bool operator==(const StartGameBroadcastMessage &other) const;
     };
 
     class EndGameBroadcastMessage final : public ServerToClientMessage
     {
     public:
+        static constexpr MessageTag TAG = MessageTag::END_GAME_BROADCAST;
+
         ~EndGameBroadcastMessage() override = default;
-        EndGameBroadcastMessage(std::string game_id, std::vector<PlayerResult> results,
+        EndGameBroadcastMessage(std::string game_id, std::vector<PlayerResult> results, uint64_t seed,
                                 std::string message_id = UuidGenerator::generateUuidV4()) :
-            ServerToClientMessage(game_id, message_id),
-            results(results)
+            ServerToClientMessage(TAG, game_id, message_id),
+            results(results), seed(seed)
         {}
         std::string toJson() const override;
+        std::string toBinary() const override;
         bool operator==(const EndGameBroadcastMessage &other) const;
 
         /**
          * @brief A list of players and their results ordered by their final score.
          */
         std::vector<PlayerResult> results;
+
+        /**
+         * @brief The seed the game was played with, a game started with the same seed is shuffled the same way.
+         */
+        uint64_t seed;
     };
 
     class ResultResponseMessage final : public ServerToClientMessage
     {
     public:
+        static constexpr MessageTag TAG = MessageTag::RESULT_RESPONSE;
+
         ~ResultResponseMessage() override = default;
         ResultResponseMessage(std::string game_id, bool success,
                               std::optional<std::string> in_response_to = std::nullopt,
                               std::optional<std::string> additional_information = std::nullopt,
                               std::string message_id = UuidGenerator::generateUuidV4()) :
-            ServerToClientMessage(game_id, message_id),
+            ServerToClientMessage(TAG, game_id, message_id),
             success(success), in_response_to(in_response_to), additional_information(additional_information)
         {}
         std::string toJson() const override;
+        std::string toBinary() const override;
         bool operator==(const ResultResponseMessage &other) const;
 
         bool success;
@@ -241,12 +386,14 @@ namespace shared
     class ActionOrderMessage final : public ServerToClientMessage
     {
     public:
+        static constexpr MessageTag TAG = MessageTag::ACTION_ORDER;
+
         ~ActionOrderMessage() override = default;
         ActionOrderMessage(std::string game_id, std::unique_ptr<ActionOrder> order,
                            std::unique_ptr<reduced::GameState> game_state,
                            std::optional<std::string> description = std::nullopt,
                            std::string message_id = UuidGenerator::generateUuidV4()) :
-            ServerToClientMessage(std::move(game_id), std::move(message_id)),
+            ServerToClientMessage(TAG, std::move(game_id), std::move(message_id)),
             order(std::move(order)), game_state(std::move(game_state)), description(std::move(description))
         {}
 
@@ -259,10 +406,38 @@ namespace shared
         {}
 
         std::string toJson() const override;
+        std::string toBinary() const override;
         bool operator==(const ActionOrderMessage &other) const;
 
         std::unique_ptr<ActionOrder> order;
         std::unique_ptr<reduced::GameState> game_state;
         std::optional<std::string> description;
     };
+
+    /**
+     * @brief Calls visitor with the message as its concrete type, see the visit for ActionDecision.
+     *
+     * @throw exception::UnreachableCode for a tag of the other direction, which can not be constructed.
+     */
+    template <typename Msg, typename Visitor>
+        requires std::is_same_v<std::remove_const_t<Msg>, ClientToServerMessage>
+    decltype(auto) visit(Msg &message, Visitor &&visitor)
+    {
+        switch ( message.getTag() ) {
+            case MessageTag::GAME_STATE_REQUEST:
+                return visitor(static_cast<like_const_t<GameStateRequestMessage, Msg> &>(message));
+            case MessageTag::CREATE_LOBBY_REQUEST:
+                return visitor(static_cast<like_const_t<CreateLobbyRequestMessage, Msg> &>(message));
+            case MessageTag::JOIN_LOBBY_REQUEST:
+                return visitor(static_cast<like_const_t<JoinLobbyRequestMessage, Msg> &>(message));
+            case MessageTag::START_GAME_REQUEST:
+                return visitor(static_cast<like_const_t<StartGameRequestMessage, Msg> &>(message));
+            case MessageTag::ACTION_DECISION:
+                return visitor(static_cast<like_const_t<ActionDecisionMessage, Msg> &>(message));
+            default:
+                break;
+        }
+        throw exception::UnreachableCode("Unknown client message tag " +
+                                         std::to_string(static_cast<unsigned int>(message.getTag())));
+    }
 } // namespace shared
@@ -0,0 +1,143 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include <shared/game/cards/card_base.h>
+#include <shared/utils/exception.h>
+
+namespace shared
+{
+    /**
+     * @brief Encoding of the message payloads, chosen per connection.
+     *
+     * A client picks the format with its first request, the server answers in the same format for the rest of the
+     * connection. JSON stays the default, so clients that do not know about the binary format keep working.
+     */
+    enum class WireFormat : uint8_t
+    {
+        JSON,
+        BINARY
+    };
+
+    /**
+     * @brief First byte of every binary payload. JSON payloads always start with '{', so the two can not be confused.
+     */
+    constexpr uint8_t BINARY_MAGIC = 0xB1;
+
+    WireFormat detectWireFormat(std::string_view payload);
+
+    /**
+     * @brief Makes a payload printable for the log, binary payloads are replaced by their size.
+     */
+    struct LoggablePayload
+    {
+        std::string_view payload;
+    };
+    inline LoggablePayload loggable(std::string_view payload) { return {payload}; }
+    std::ostream &operator<<(std::ostream &os, const LoggablePayload &loggable);
+
+    /**
+     * @brief Appends values in our binary format to a string.
+     *
+     * Integers are LEB128 varints (signed ones zigzag encoded first), strings and arrays are prefixed with their
+     * length. Cards are sent as their interned handle, which fits into a single byte for every card we have; ids that
+     * are not registered (e.g. the empty current card) fall back to the string.
+     */
+    class BinaryWriter
+    {
+    public:
+        explicit BinaryWriter(size_t reserve = 256) { buffer.reserve(reserve); }
+
+        void writeByte(uint8_t value) { buffer.push_back(static_cast<char>(value)); }
+        void writeBool(bool value) { writeByte(value ? 1 : 0); }
+        void writeUint(uint64_t value);
+        void writeInt(int64_t value);
+        void writeString(std::string_view value);
+        void writeOptionalString(const std::optional<std::string> &value);
+        void writeStrings(const std::vector<std::string> &values);
+        void writeCard(const CardBase::id_t &card_id);
+        void writeCards(const std::vector<CardBase::id_t> &card_ids);
+
+        template <typename Enum>
+            requires std::is_enum_v<Enum>
+        void writeEnum(Enum value)
+        {
+            writeUint(static_cast<uint64_t>(value));
+        }
+
+        template <typename Enum>
+            requires std::is_enum_v<Enum>
+        void writeEnums(const std::vector<Enum> &values)
+        {
+            writeUint(values.size());
+            for ( const auto value : values ) {
+                writeEnum(value);
+            }
+        }
+
+        size_t size() const { return buffer.size(); }
+        std::string release() { return std::move(buffer); }
+
+    private:
+        std::string buffer;
+    };
+
+    /**
+     * @brief Reads values written by the BinaryWriter from a view.
+     *
+     * Every read checks the remaining input, a truncated or otherwise malformed payload throws
+     * exception::MalformedMessage instead of reading out of bounds.
+     */
+    class BinaryReader
+    {
+    public:
+        explicit BinaryReader(std::string_view input) : input(input) {}
+
+        uint8_t readByte();
+        bool readBool();
+        uint64_t readUint();
+        int64_t readInt();
+        unsigned int readUint32();
+        std::string readString();
+        std::optional<std::string> readOptionalString();
+        std::vector<std::string> readStrings();
+        CardBase::id_t readCard();
+        std::vector<CardBase::id_t> readCards();
+
+        /**
+         * @brief Reads the length of an array, rejecting lengths that can not possibly fit into the rest of the input.
+         */
+        size_t readLength();
+
+        template <typename Enum>
+            requires std::is_enum_v<Enum>
+        Enum readEnum()
+        {
+            return static_cast<Enum>(readUint());
+        }
+
+        template <typename Enum>
+            requires std::is_enum_v<Enum>
+        std::vector<Enum> readEnums()
+        {
+            std::vector<Enum> values(readLength());
+            for ( auto &value : values ) {
+                value = readEnum<Enum>();
+            }
+            return values;
+        }
+
+        bool atEnd() const { return position == input.size(); }
+        size_t remaining() const { return input.size() - position; }
+
+    private:
+        std::string_view input;
+        size_t position = 0;
+    };
+} // namespace shared
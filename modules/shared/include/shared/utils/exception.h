@@ -94,6 +94,11 @@ NEW_INHERITED_EXCEPTION(OutOfPhase, GameState, "");
 NEW_INHERITED_EXCEPTION(InvalidCardAccess, GameState, "");
 NEW_INHERITED_EXCEPTION(InvalidCardType, GameState, "");
 NEW_INHERITED_EXCEPTION(InvalidRequest, GameState, "");
+NEW_INHERITED_EXCEPTION(DeltaMismatch, GameState, "The delta does not match the game state.");
+
+// for the network
+NEW_BASE_EXCEPTION(MalformedFrame, "Received a malformed frame");
+NEW_BASE_EXCEPTION(MalformedMessage, "Received a malformed binary message");
 
 NEW_BASE_EXCEPTION(SevereError, "Severe Error!");
 NEW_INHERITED_EXCEPTION(UnreachableCode, SevereError, "This should NEVER happen!");
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <shared/utils/exception.h>
+
+namespace shared
+{
+    /**
+     * @brief Prepends the length prefix of our protocol: `<length>:<payload>`.
+     */
+    std::string encodeFrame(std::string_view payload);
+
+    /**
+     * @brief Incremental decoder for `<length>:<payload>` frames, independent of how the stream is chunked.
+     *
+     * Data is read straight into the decoder (prepare/commit) and frames are handed out as views into its buffer, so a
+     * payload is not copied between the socket and the JSON parser. Consumed bytes are dropped lazily, only when room
+     * is needed, which keeps the cost of moving bytes around amortised constant per byte.
+     *
+     * The buffer always keeps a byte of room after the buffered data, so nextWritable can terminate any payload
+     * without copying it, for parsers that work in place.
+     *
+     * Example:
+     * ```
+     * char *dst = decoder.prepare(4096);
+     * decoder.commit(read(fd, dst, 4096));
+     * while ( auto frame = decoder.next() ) {
+     *     handle(*frame);
+     * }
+     * ```
+     */
+    class FrameDecoder
+    {
+    public:
+        static constexpr size_t DEFAULT_MAX_FRAME_SIZE = 1 << 20;
+
+        explicit FrameDecoder(size_t max_frame_size = DEFAULT_MAX_FRAME_SIZE) : max_frame_size(max_frame_size) {}
+
+        /**
+         * @return A buffer with room for at least size bytes. Invalidates all views returned by next.
+         */
+        char *prepare(size_t size);
+
+        /**
+         * @brief Marks size bytes of the buffer returned by prepare as filled.
+         */
+        void commit(size_t size);
+
+        /**
+         * @brief Copies data into the decoder, for callers that can not read into prepare directly.
+         * Invalidates all views returned by next.
+         */
+        void feed(std::string_view data);
+
+        /**
+         * @brief Cuts the next complete frame off the buffered data.
+         *
+         * @return The payload of the frame, it stays valid until the next call to prepare, feed or reset.
+         * std::nullopt if no complete frame is buffered yet.
+         * @throw exception::MalformedFrame if the length prefix is invalid or exceeds the maximum frame size.
+         * The stream can not be recovered after this, the decoder has to be reset.
+         */
+        std::optional<std::string_view> next();
+
+        /**
+         * @brief Like next, but the payload may be modified and is followed by a '\0' that is not part of the span.
+         *
+         * The terminator borrows the first byte of the following frame, which is put back by the next call to any
+         * other member. The payload stays valid as long as the one returned by next.
+         */
+        std::optional<std::span<char>> nextWritable();
+
+        /**
+         * @brief Drops all buffered data.
+         */
+        void reset()
+        {
+            restoreBorrowed();
+            begin = end = 0;
+        }
+
+        size_t buffered() const { return end - begin; }
+        size_t getMaxFrameSize() const { return max_frame_size; }
+
+    private:
+        static constexpr size_t NOTHING_BORROWED = static_cast<size_t>(-1);
+
+        /**
+         * @brief Puts back the byte that nextWritable overwrote with the terminator.
+         */
+        void restoreBorrowed();
+
+        std::vector<char> buffer;
+        // buffer[begin, end) holds the data that was not consumed yet
+        size_t begin = 0;
+        size_t end = 0;
+        const size_t max_frame_size;
+        // position and original value of the byte nextWritable terminated the last payload with
+        size_t borrowed = NOTHING_BORROWED;
+        char borrowed_byte = 0;
+    };
+} // namespace shared
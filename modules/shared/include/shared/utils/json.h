@@ -1,7 +1,14 @@
 
 #pragma once
 
+#include <cstddef>
+#include <string>
+#include <string_view>
+
 #include <rapidjson/document.h>
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+#include <shared/utils/json_writer.h>
 #include <shared/utils/logger.h>
 
 
@@ -13,7 +20,7 @@
         LOG(WARN) << "Missing or invalid member: " << (member);                                                        \
         return nullptr;                                                                                                \
     }                                                                                                                  \
-    (var) = (document)[member].GetString();
+    (var) = shared::jsonStringView((document)[member]);
 
 #define GET_UINT_MEMBER(var, document, member)                                                                         \
     if ( !(document).HasMember(member) || !(document)[member].IsUint() ) {                                             \
@@ -49,12 +56,13 @@
         LOG(WARN) << "Missing or invalid member: " << (member);                                                        \
         return nullptr;                                                                                                \
     }                                                                                                                  \
+    (var).reserve((document)[member].Size());                                                                          \
     for ( const auto &elem : (document)[member].GetArray() ) {                                                         \
         if ( !elem.IsString() ) {                                                                                      \
             LOG(WARN) << "Missing or invalid member: " << (member);                                                    \
             return nullptr;                                                                                            \
         }                                                                                                              \
-        (var).push_back(elem.GetString());                                                                             \
+        (var).emplace_back(shared::jsonStringView(elem));                                                              \
     }
 
 #define GET_UINT_ARRAY_MEMBER(var, document, member)                                                                   \
@@ -91,7 +99,7 @@
             LOG(WARN) << "Invalid member: " << (member);                                                               \
             return nullptr;                                                                                            \
         }                                                                                                              \
-        (var) = (document)[member].GetString();                                                                        \
+        (var) = shared::jsonStringView((document)[member]);                                                            \
     } else {                                                                                                           \
         (var) = std::nullopt;                                                                                          \
     }
@@ -155,4 +163,160 @@
     doc.AddMember(#key, key##_array, doc.GetAllocator());
 
 
+// ======= WRITER MACROS ======= //
+// These stream straight into a `writer` (shared::JsonWriter) in scope, see shared::writeJson.
+
+
+#define WRITE_KEY(key) writer.Key(#key, sizeof(#key) - 1);
+
+#define WRITE_STRING_MEMBER(var, key)                                                                                  \
+    WRITE_KEY(key)                                                                                                     \
+    shared::writeJsonString(writer, var);
+
+#define WRITE_UINT_MEMBER(var, key)                                                                                    \
+    WRITE_KEY(key)                                                                                                     \
+    writer.Uint(var);
+
+#define WRITE_INT_MEMBER(var, key)                                                                                     \
+    WRITE_KEY(key)                                                                                                     \
+    writer.Int(var);
+
+#define WRITE_ENUM_MEMBER(var, key)                                                                                    \
+    WRITE_KEY(key)                                                                                                     \
+    writer.Uint(static_cast<unsigned int>(var));
+
+#define WRITE_BOOL_MEMBER(var, key)                                                                                    \
+    WRITE_KEY(key)                                                                                                     \
+    writer.Bool(var);
+
+#define WRITE_OPTIONAL_STRING_MEMBER(var, key)                                                                         \
+    if ( var ) {                                                                                                       \
+        WRITE_STRING_MEMBER((var).value(), key)                                                                        \
+    }
+
+// var has to have a `void writeJson(shared::JsonWriter &) const`
+#define WRITE_OBJECT_MEMBER(var, key)                                                                                  \
+    WRITE_KEY(key)                                                                                                     \
+    (var).writeJson(writer);
+
+#define WRITE_OPTIONAL_OBJECT_MEMBER(var, key)                                                                         \
+    if ( var ) {                                                                                                       \
+        WRITE_OBJECT_MEMBER((var).value(), key)                                                                        \
+    }
+
+#define WRITE_ARRAY_OF_STRINGS_MEMBER(var, key)                                                                        \
+    WRITE_KEY(key)                                                                                                     \
+    writer.StartArray();                                                                                               \
+    for ( const auto &item : (var) ) {                                                                                 \
+        shared::writeJsonString(writer, item);                                                                         \
+    }                                                                                                                  \
+    writer.EndArray();
+
+#define WRITE_ARRAY_OF_ENUMS_MEMBER(var, key)                                                                          \
+    WRITE_KEY(key)                                                                                                     \
+    writer.StartArray();                                                                                               \
+    for ( const auto &item : (var) ) {                                                                                 \
+        writer.Uint(static_cast<unsigned int>(item));                                                                  \
+    }                                                                                                                  \
+    writer.EndArray();
+
+#define WRITE_ARRAY_OF_OBJECTS_MEMBER(var, key)                                                                        \
+    WRITE_KEY(key)                                                                                                     \
+    writer.StartArray();                                                                                               \
+    for ( const auto &item : (var) ) {                                                                                 \
+        item.writeJson(writer);                                                                                        \
+    }                                                                                                                  \
+    writer.EndArray();
+
+
 std::string documentToString(const rapidjson::Document &doc);
+
+namespace shared
+{
+    /**
+     * @brief The string of a value without copying it, the length is stored so no need to search the terminator.
+     */
+    inline std::string_view jsonStringView(const rapidjson::Value &value)
+    {
+        return {value.GetString(), value.GetStringLength()};
+    }
+
+    /**
+     * @brief Parses JSON in place, meant to be kept per connection and reused for every message.
+     *
+     * rapidjson's in-situ mode decodes the strings inside the input instead of copying them, and all nodes of the
+     * document as well as the parse stack come from a pool that starts in an inline chunk and is reset per message.
+     * Parsing a usual message therefore does not touch the heap at all.
+     */
+    class InSituJsonParser
+    {
+    public:
+        using Allocator = rapidjson::MemoryPoolAllocator<>;
+        using Document = rapidjson::GenericDocument<rapidjson::UTF8<>, Allocator, Allocator>;
+
+        // a client message takes about a KiB including the parse stack, bigger ones spill over to the heap
+        static constexpr size_t INLINE_POOL_SIZE = 4096;
+
+        InSituJsonParser();
+
+        InSituJsonParser(const InSituJsonParser &) = delete;
+        InSituJsonParser &operator=(const InSituJsonParser &) = delete;
+
+        /**
+         * @brief Parses a zero terminated string, which is modified in the process.
+         *
+         * @return The document, its strings point into json. It is only valid until the next call and as long as
+         * json is. nullptr if json is not valid JSON.
+         */
+        const Document *parse(char *json);
+
+    private:
+        alignas(std::max_align_t) char chunk[INLINE_POOL_SIZE];
+        Allocator pool;
+        Document document;
+    };
+
+    inline void writeJsonString(JsonWriter &writer, std::string_view str)
+    {
+        writer.String(str.data(), static_cast<rapidjson::SizeType>(str.size()));
+    }
+
+    /**
+     * @brief Buffer of the calling thread that writeJson reuses, so serialising does not allocate once it has grown
+     * to the size of the usual message.
+     */
+    rapidjson::StringBuffer &threadJsonBuffer();
+
+    /**
+     * @brief Gives the buffer back after a write, drops its memory if a single large message grew it too much.
+     */
+    void releaseThreadJsonBuffer(rapidjson::StringBuffer &buffer);
+
+    /**
+     * @brief Streams the JSON that write produces into the thread's buffer and returns it, without building a DOM.
+     * write must not call writeJson itself, nested objects are written to the same writer.
+     */
+    template <typename Write>
+    std::string writeJson(Write &&write)
+    {
+        rapidjson::StringBuffer &buffer = threadJsonBuffer();
+        buffer.Clear();
+        JsonWriter writer(buffer);
+        write(writer);
+        std::string json(buffer.GetString(), buffer.GetSize());
+        releaseThreadJsonBuffer(buffer);
+        return json;
+    }
+
+    /**
+     * @brief Parses what write produces into a document, for the callers that still want a DOM.
+     */
+    template <typename Write>
+    rapidjson::Document writeJsonDocument(Write &&write)
+    {
+        const std::string json = writeJson(std::forward<Write>(write));
+        rapidjson::Document doc;
+        doc.Parse(json.data(), json.size());
+        return doc;
+    }
+} // namespace shared
@@ -0,0 +1,12 @@
+#pragma once
+
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+
+namespace shared
+{
+    /**
+     * @brief The writer all writeJson methods stream into, see shared::writeJson in json.h.
+     */
+    using JsonWriter = rapidjson::Writer<rapidjson::StringBuffer>;
+} // namespace shared
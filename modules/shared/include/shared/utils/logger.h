@@ -1,11 +1,17 @@
 #pragma once
 
-#include <fstream>
+#include <array>
+#include <atomic>
+#include <cstdint>
 #include <memory>
 #include <mutex>
 #include <optional>
 #include <sstream>
 #include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <vector>
 
 #include <shared/utils/exception.h>
 #include <shared/utils/utils.h>
@@ -15,20 +21,31 @@
 #define PROJECT_ROOT "/default/path/for/linter"
 #endif
 
+// statements below this level are compiled out, e.g. -DLOG_MIN_LEVEL=WARN (the default for release builds)
+#ifndef LOG_MIN_LEVEL
+#define LOG_MIN_LEVEL INFO
+#endif
+
 /**
  * @brief This macro returns a stream with the desired level.
+ *
+ * The level of the module is checked first, a disabled statement neither formats its prefix nor evaluates its
+ * arguments. The module is derived from the path of the file at compile time, see shared::logModuleOf.
  */
-#define LOG(level) shared::Logger::getInstance().log(level, __FILE__, __LINE__).stream()
+#define LOG(level)                                                                                                     \
+    !shared::Logger::isEnabled(level, shared::logModuleOf(__FILE__))                                                   \
+            ? (void)0                                                                                                  \
+            : shared::log_helpers::Voidify() & shared::Logger::getInstance().log(level, __FILE__, __LINE__).stream()
 
 /**
- * @brief Returns a string with the cleaned up class name
+ * @brief Returns a std::string_view with the name of the enclosing class, resolved at compile time
  */
-#define CLASS_NAME (std::string("{class:") + utils::demangle(typeid(*this).name()) + std::string("}"))
+#define CLASS_NAME (utils::typeName<std::remove_cvref_t<decltype(*this)>>())
 
 /**
- * @brief Returns a string with the cleaned up function name
+ * @brief Returns a std::string_view with the name of the enclosing function, resolved at compile time
  */
-#define FUNC_NAME (std::string("{func:") + utils::demangle(__func__) + std::string("}"))
+#define FUNC_NAME (std::string_view(__func__))
 
 #define LOG_FUNCTION_ENTRY LOG(INFO) << "ENTERED: " << FUNC_NAME
 #define LOG_FUNCTION_EXIT LOG(INFO) << "EXITED: " << FUNC_NAME
@@ -46,8 +63,50 @@ std::ostream &operator<<(std::ostream &os, const LogLevel &level);
 
 namespace shared
 {
+    /**
+     * @brief Parts of the code whose log level can be set separately.
+     */
+    enum class LogModule
+    {
+        GENERAL,
+        NETWORK,
+        LOBBY,
+        GAME,
+        BEHAVIOUR,
+        COUNT
+    };
+
+    /**
+     * @brief Maps a source file to its module by its directory, behaviours are recognized by their file name.
+     */
+    consteval LogModule logModuleOf(std::string_view file)
+    {
+        if ( file.find("behaviour") != std::string_view::npos ) {
+            return LogModule::BEHAVIOUR;
+        }
+        if ( file.find("/network/") != std::string_view::npos ) {
+            return LogModule::NETWORK;
+        }
+        if ( file.find("/lobbies/") != std::string_view::npos ) {
+            return LogModule::LOBBY;
+        }
+        if ( file.find("/game/") != std::string_view::npos ) {
+            return LogModule::GAME;
+        }
+        return LogModule::GENERAL;
+    }
+
     namespace log_helpers
     {
+        /**
+         * @brief Turns the stream expression of LOG into void, so both branches of its conditional have the same type.
+         * Binds weaker than <<, so it applies to the whole statement.
+         */
+        struct Voidify
+        {
+            void operator&(std::ostream &) {}
+        };
+
         std::string toString(LogLevel level);
         std::string formatLevel(LogLevel level, bool toggle_colors);
 
@@ -72,6 +131,21 @@ namespace shared
      */
     std::optional<LogLevel> parseLogLevel(const std::string &level);
 
+    /**
+     * @brief Parses the name of a module, e.g. "network".
+     */
+    std::optional<LogModule> parseLogModule(const std::string &module);
+
+    /**
+     * @brief Asynchronous logger.
+     *
+     * A log statement formats its line on the calling thread and pushes it into a lock-free ring buffer owned by that
+     * thread, the only lock is taken once per thread to register its buffer. A background thread drains all buffers
+     * and writes them with one call per batch. If a thread logs faster than the writer keeps up, its buffer fills up
+     * and further lines are dropped and counted instead of blocking the caller.
+     *
+     * Lines of one thread keep their order, lines of different threads are only ordered by their timestamps.
+     */
     class Logger
     {
         class LogStream
@@ -84,10 +158,44 @@ namespace shared
 
         private:
             Logger &logger_;
-            LogLevel level_;
             std::ostringstream ss_;
         };
 
+        /**
+         * @brief Single producer, single consumer ring of log lines. The producer is the thread owning the buffer, the
+         * consumer is the writer thread.
+         */
+        class ThreadBuffer
+        {
+        public:
+            // lines a thread can be ahead of the writer, must be a power of two
+            static constexpr size_t CAPACITY = 1024;
+
+            /**
+             * @return false if the buffer is full, the line is left untouched.
+             */
+            bool tryPush(std::string &&line);
+
+            /**
+             * @brief Appends all buffered lines to batch.
+             * @return The number of lines appended.
+             */
+            size_t drainInto(std::string &batch);
+
+            bool empty() const
+            {
+                return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire);
+            }
+
+            // set when the owning thread exits, the writer forgets the buffer once it is drained
+            std::atomic<bool> retired{false};
+
+        private:
+            std::array<std::string, CAPACITY> slots_;
+            alignas(64) std::atomic<size_t> head_{0};
+            alignas(64) std::atomic<size_t> tail_{0};
+        };
+
     public:
         /**
          * @brief Initializes the logger. If not called, logging will default to std::cerr.
@@ -101,15 +209,39 @@ namespace shared
         static void writeTo(const std::string &file_path = "");
 
         /**
-         * @brief Sets the minimum log level. Messages below this level will not be logged.
+         * @brief Sets the minimum log level of all modules. Messages below this level will not be logged.
          * @param level The minimum LogLevel to log.
          */
         static void setLevel(LogLevel level);
 
+        /**
+         * @brief Sets the minimum log level of a single module.
+         */
+        static void setLevel(LogModule module, LogLevel level);
+
         /**
          * @brief Returns the current minimum log level.
          */
-        static LogLevel getLevel();
+        static LogLevel getLevel(LogModule module = LogModule::GENERAL);
+
+        /**
+         * @brief Checked by LOG before anything is formatted, so it has to be cheap: no lock and no instance.
+         */
+        static bool isEnabled(LogLevel level, LogModule module)
+        {
+            return level >= LOG_MIN_LEVEL &&
+                    level >= _module_levels[static_cast<size_t>(module)].load(std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Blocks until every line logged before the call is written.
+         */
+        static void flush();
+
+        /**
+         * @brief Returns the number of lines dropped because the buffer of their thread was full.
+         */
+        static uint64_t getDroppedCount();
 
         /**
          * @brief Returns an instance to the logger.
@@ -118,6 +250,9 @@ namespace shared
          */
         static Logger &getInstance();
 
+        /**
+         * @brief Writes everything that is still buffered and stops the writer thread.
+         */
         ~Logger();
 
         LogStream log(LogLevel level, const char *file, int line) { return LogStream(*this, level, file, line); }
@@ -125,18 +260,46 @@ namespace shared
     private:
         inline static std::mutex _init_mutex;
         inline static std::unique_ptr<Logger> _instance;
+        inline static std::array<std::atomic<LogLevel>, static_cast<size_t>(LogModule::COUNT)> _module_levels = {
+                WARN, WARN, WARN, WARN, WARN};
+
+        std::atomic<bool> log_to_file_;
+
+        // only shared between the writer thread and writeTo
+        std::mutex output_mutex_;
+        int output_fd_;
 
-        LogLevel min_log_level_;
+        // only locked to register a new thread and by the writer
+        std::mutex buffers_mutex_;
+        std::vector<std::shared_ptr<ThreadBuffer>> buffers_;
 
-        std::mutex mutex_;
-        std::ofstream log_file_;
-        bool log_to_file_;
+        // bumped for every line, the idle writer waits for it to change
+        std::atomic<uint32_t> wakeups_{0};
+        std::atomic<bool> writer_idle_{false};
+        std::atomic<bool> stopping_{false};
+        std::atomic<uint64_t> enqueued_{0};
+        std::atomic<uint64_t> written_{0};
+        std::atomic<uint64_t> dropped_{0};
+        std::thread writer_;
 
         Logger();
 
         Logger(const Logger &) = delete;
         Logger &operator=(const Logger &) = delete;
 
-        void writeLog(LogLevel level, const std::string &message);
+        void writeLog(std::string &&message);
+
+        /**
+         * @brief The buffer of the calling thread, registered on its first log statement.
+         */
+        ThreadBuffer &threadBuffer();
+
+        void wakeWriter();
+        void writerLoop();
+
+        /**
+         * @brief Writes the batch to the current output. Only called by the writer thread.
+         */
+        void writeOut(const std::string &batch);
     };
 } // namespace shared
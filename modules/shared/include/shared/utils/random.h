@@ -0,0 +1,103 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <random>
+
+namespace utils
+{
+    /**
+     * @brief The number at position index of the splitmix64 sequence that starts at seed. Neighbouring seeds and
+     * indices give unrelated numbers, so this derives independent seeds from a single one.
+     */
+    constexpr uint64_t splitmix64(uint64_t seed, uint64_t index)
+    {
+        uint64_t z = seed + (index + 1) * 0x9e3779b97f4a7c15;
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+        return z ^ (z >> 31);
+    }
+
+    /**
+     * @brief xoshiro256** by Blackman and Vigna, see https://prng.di.unimi.it.
+     *
+     * It only has 32 bytes of state and needs a handful of shifts per number, std::mt19937 has 2.5 KB. It satisfies
+     * UniformRandomBitGenerator, so it works with std::shuffle and the std distributions. Each engine belongs to a
+     * single game or thread, nothing here is synchronised.
+     */
+    class Xoshiro256
+    {
+    public:
+        using result_type = uint64_t;
+
+        explicit Xoshiro256(uint64_t seed) { this->seed(seed); }
+
+        /**
+         * @brief Expands the seed into the full state with splitmix64, as recommended by the authors.
+         */
+        void seed(uint64_t seed)
+        {
+            for ( size_t i = 0; i < state.size(); ++i ) {
+                state[i] = splitmix64(seed, i);
+            }
+        }
+
+        static constexpr result_type min() { return std::numeric_limits<result_type>::min(); }
+        static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+        result_type operator()()
+        {
+            const uint64_t result = rotl(state[1] * 5, 7) * 9;
+            const uint64_t t = state[1] << 17;
+
+            state[2] ^= state[0];
+            state[3] ^= state[1];
+            state[1] ^= state[2];
+            state[0] ^= state[3];
+            state[2] ^= t;
+            state[3] = rotl(state[3], 45);
+
+            return result;
+        }
+
+        /**
+         * @brief Advances the engine by 2^128 numbers. Copies taken between jumps produce sequences that do not
+         * overlap, which is how one seed is split into several independent streams.
+         */
+        void jump()
+        {
+            constexpr std::array<uint64_t, 4> JUMP = {0x180ec6d33cfd0aba, 0xd5a61266f0c9392c, 0xa9582618e03fc9aa,
+                                                      0x39abdc4529b1661c};
+
+            std::array<uint64_t, 4> jumped{};
+            for ( const auto word : JUMP ) {
+                for ( int bit = 0; bit < 64; ++bit ) {
+                    if ( (word & (uint64_t{1} << bit)) != 0 ) {
+                        for ( size_t i = 0; i < state.size(); ++i ) {
+                            jumped[i] ^= state[i];
+                        }
+                    }
+                    (*this)();
+                }
+            }
+            state = jumped;
+        }
+
+        bool operator==(const Xoshiro256 &other) const = default;
+
+    private:
+        static constexpr uint64_t rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+
+        std::array<uint64_t, 4> state{};
+    };
+
+    /**
+     * @brief A seed from the operating system, for when nothing needs to be reproduced.
+     */
+    inline uint64_t randomSeed()
+    {
+        std::random_device device;
+        return (static_cast<uint64_t>(device()) << 32) ^ device();
+    }
+} // namespace utils
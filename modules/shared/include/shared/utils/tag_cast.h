@@ -0,0 +1,61 @@
+#pragma once
+
+#include <memory>
+#include <type_traits>
+
+namespace shared
+{
+    /**
+     * @brief Checked downcast for hierarchies whose classes carry their type as a tag: the base has a `getTag()` and
+     * every concrete class a `static constexpr TAG`. Comparing the tag is a single load, unlike the RTTI walk of
+     * dynamic_cast.
+     *
+     * Only works for concrete classes, which are the only ones with a TAG.
+     *
+     * @return nullptr if base is nullptr or not a Derived.
+     */
+    template <typename Derived, typename Base>
+    Derived *tagCast(Base *base)
+    {
+        static_assert(std::is_base_of_v<Base, Derived>);
+        return base != nullptr && base->getTag() == Derived::TAG ? static_cast<Derived *>(base) : nullptr;
+    }
+
+    template <typename Derived, typename Base>
+    const Derived *tagCast(const Base *base)
+    {
+        static_assert(std::is_base_of_v<Base, Derived>);
+        return base != nullptr && base->getTag() == Derived::TAG ? static_cast<const Derived *>(base) : nullptr;
+    }
+
+    /**
+     * @brief Moves ownership to the returned pointer if base is a Derived, otherwise base is left untouched.
+     */
+    template <typename Derived, typename Base>
+    std::unique_ptr<Derived> tagCast(std::unique_ptr<Base> &base)
+    {
+        if ( tagCast<Derived>(base.get()) == nullptr ) {
+            return nullptr;
+        }
+        return std::unique_ptr<Derived>(static_cast<Derived *>(base.release()));
+    }
+
+    /**
+     * @brief Derived with the constness of Base, for visitors that work on const and mutable objects alike.
+     */
+    template <typename Derived, typename Base>
+    using like_const_t = std::conditional_t<std::is_const_v<Base>, const Derived, Derived>;
+
+    /**
+     * @brief Combines lambdas into a single visitor, e.g. `visit(decision, Overloaded{[](const BuyCardDecision &) {},
+     * [](const auto &) {}})`.
+     */
+    template <typename... Visitors>
+    struct Overloaded : Visitors...
+    {
+        using Visitors::operator()...;
+    };
+
+    template <typename... Visitors>
+    Overloaded(Visitors...) -> Overloaded<Visitors...>;
+} // namespace shared
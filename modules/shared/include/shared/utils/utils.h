@@ -2,7 +2,9 @@
 
 #include <cxxabi.h> // to demangle typeids
 #include <memory>
+#include <source_location>
 #include <string>
+#include <string_view>
 
 namespace utils
 {
@@ -14,4 +16,19 @@ namespace utils
         return (status == 0) ? demangled_name.get() : mangled_name;
     }
 
+    /**
+     * @brief Name of a type, determined at compile time. Unlike demangle it needs no allocation, but it only knows
+     * the static type, use demangle(typeid(...).name()) for the dynamic type of an object.
+     */
+    template <typename T>
+    constexpr std::string_view typeName()
+    {
+        // gcc: "... typeName() [with T = <type>; std::string_view = ...]", clang: "... typeName() [T = <type>]"
+        // not a constexpr variable, gcc leaves out the template arguments in its initializer
+        const std::string_view function = std::source_location::current().function_name();
+        const size_t start = function.find("T = ") + 4;
+        const size_t end = function.find(';', start);
+        return function.substr(start, (end != std::string_view::npos ? end : function.rfind(']')) - start);
+    }
+
 } // namespace utils
\ No newline at end of file
@@ -5,8 +5,10 @@
 #pragma once
 
 #include <array>
-#include <random>
-#include <sstream>
+#include <cstdint>
+#include <string>
+
+#include <shared/utils/random.h>
 
 class UuidGenerator
 {
@@ -15,35 +17,32 @@ private:
 public:
     static std::string generateUuidV4()
     {
-        // made those static to not seed a new engine for every call
-        static std::random_device rd;
-        static std::mt19937 gen(rd());
-        static std::uniform_int_distribution<int> hexDist(0, 15);
-        static std::uniform_int_distribution<int> variantDist(8, 11);
+        // one engine per thread, messages are created on several threads at once
+        thread_local utils::Xoshiro256 gen(utils::randomSeed());
 
-        // stuff below is by chatgpt
+        // 16 hex digits, one per 4 bits of a single random number
+        uint64_t bits = gen();
         std::array<int, 16> uuidData;
-
-        // Generate random data for UUID
-        for ( auto &byte : uuidData ) {
-            byte = hexDist(gen);
+        for ( auto &digit : uuidData ) {
+            digit = static_cast<int>(bits & 0xf);
+            bits >>= 4;
         }
 
         uuidData[6] = 0x4; // Version field (4 for UUID v4)
-        uuidData[8] = variantDist(gen); // Variant field (8-B for RFC4122 compliance)
+        uuidData[8] = 0x8 | (uuidData[8] & 0x3); // Variant field (8-B for RFC4122 compliance)
 
         // Format as string
-        std::ostringstream ss;
-        ss << std::hex;
-
+        constexpr char hex_digits[] = "0123456789abcdef";
+        std::string uuid;
+        uuid.reserve(uuidData.size() + 4);
         for ( size_t i = 0; i < uuidData.size(); ++i ) {
-            ss << uuidData[i];
+            uuid += hex_digits[uuidData[i]];
             // Add hyphens at specific positions
             if ( i == 3 || i == 5 || i == 7 || i == 9 ) {
-                ss << "-";
+                uuid += '-';
             }
         }
 
-        return ss.str();
+        return uuid;
     }
 };
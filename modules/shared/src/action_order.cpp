@@ -1,11 +1,26 @@
 
 #include <shared/action_order.h>
+#include <shared/utils/assert.h>
 #include <shared/utils/json.h>
 #include <string>
 #include <typeinfo>
 
 namespace shared
 {
+    namespace
+    {
+        // identifies the order in the binary format, the counterpart of the "type" member in JSON
+        enum class OrderTag : uint8_t
+        {
+            ACTION_PHASE,
+            BUY_PHASE,
+            END_TURN,
+            GAIN_FROM_BOARD,
+            CHOOSE_FROM_HAND,
+            CHOOSE_FROM_STAGED
+        };
+    } // namespace
+
     bool ActionOrder::operator==(const ActionOrder &other) const
     {
         return typeid(*this) == typeid(other) && equals(other);
@@ -32,14 +47,17 @@ namespace shared
             unsigned int max_cards;
             shared::ChooseFromOrder::AllowedChoice allowed_choices;
             shared::CardType allowed_type;
+            shared::CardType required_type;
 
             GET_UINT_MEMBER(min_cards, json, "min_cards");
             GET_UINT_MEMBER(max_cards, json, "max_cards");
             GET_ENUM_MEMBER(allowed_choices, json, "allowed_choices", shared::ChooseFromOrder::AllowedChoice);
             GET_ENUM_MEMBER(allowed_type, json, "allowed_type", shared::CardType);
+            GET_ENUM_MEMBER(required_type, json, "required_type", shared::CardType);
 
             if ( type == "choose_from_hand" ) {
-                return std::make_unique<ChooseFromHandOrder>(min_cards, max_cards, allowed_choices, allowed_type);
+                return std::make_unique<ChooseFromHandOrder>(min_cards, max_cards, allowed_choices, allowed_type,
+                                                             required_type);
             } else if ( type == "choose_from_staged" ) {
                 std::vector<shared::CardBase::id_t> cards;
                 GET_STRING_ARRAY_MEMBER(cards, json, "cards");
@@ -52,33 +70,112 @@ namespace shared
         }
     }
 
+    void ActionOrder::writeJson(JsonWriter &writer) const
+    {
+        writer.StartObject();
+        if ( typeid(*this) == typeid(ActionPhaseOrder) ) {
+            WRITE_STRING_MEMBER("action_phase", type);
+        } else if ( typeid(*this) == typeid(BuyPhaseOrder) ) {
+            WRITE_STRING_MEMBER("buy_phase", type);
+        } else if ( typeid(*this) == typeid(GainFromBoardOrder) ) {
+            const auto &order = static_cast<const GainFromBoardOrder &>(*this);
+            WRITE_STRING_MEMBER("gain_card", type);
+            WRITE_UINT_MEMBER(order.max_cost, max_cost);
+            WRITE_ENUM_MEMBER(order.allowed_type, allowed_type);
+        } else if ( typeid(*this) == typeid(ChooseFromHandOrder) ) {
+            const auto &order = static_cast<const ChooseFromHandOrder &>(*this);
+            WRITE_STRING_MEMBER("choose_from_hand", type);
+            WRITE_UINT_MEMBER(order.min_cards, min_cards);
+            WRITE_UINT_MEMBER(order.max_cards, max_cards);
+            WRITE_ENUM_MEMBER(order.allowed_choices, allowed_choices);
+            WRITE_ENUM_MEMBER(order.allowed_type, allowed_type);
+            WRITE_ENUM_MEMBER(order.required_type, required_type);
+        } else if ( typeid(*this) == typeid(ChooseFromStagedOrder) ) {
+            const auto &order = static_cast<const ChooseFromStagedOrder &>(*this);
+            WRITE_STRING_MEMBER("choose_from_staged", type);
+            WRITE_UINT_MEMBER(order.min_cards, min_cards);
+            WRITE_UINT_MEMBER(order.max_cards, max_cards);
+            WRITE_ENUM_MEMBER(order.allowed_choices, allowed_choices);
+            WRITE_ARRAY_OF_STRINGS_MEMBER(order.cards, cards);
+            WRITE_ENUM_MEMBER(order.allowed_type, allowed_type);
+            WRITE_ENUM_MEMBER(order.required_type, required_type);
+        }
+        writer.EndObject();
+    }
+
     rapidjson::Document ActionOrder::toJson() const
     {
-        rapidjson::Document doc;
-        doc.SetObject();
+        return writeJsonDocument([this](JsonWriter &writer) { writeJson(writer); });
+    }
+
+    std::unique_ptr<ActionOrder> ActionOrder::fromBinary(BinaryReader &reader)
+    {
+        const auto tag = reader.readEnum<OrderTag>();
+        switch ( tag ) {
+            case OrderTag::ACTION_PHASE:
+                return std::make_unique<ActionPhaseOrder>();
+            case OrderTag::BUY_PHASE:
+                return std::make_unique<BuyPhaseOrder>();
+            case OrderTag::END_TURN:
+                return std::make_unique<EndTurnOrder>();
+            case OrderTag::GAIN_FROM_BOARD:
+                {
+                    const unsigned int max_cost = reader.readUint32();
+                    const auto allowed_type = reader.readEnum<shared::CardType>();
+                    return std::make_unique<GainFromBoardOrder>(max_cost, allowed_type);
+                }
+            case OrderTag::CHOOSE_FROM_HAND:
+            case OrderTag::CHOOSE_FROM_STAGED:
+                {
+                    const unsigned int min_cards = reader.readUint32();
+                    const unsigned int max_cards = reader.readUint32();
+                    const auto allowed_choices = reader.readEnum<shared::ChooseFromOrder::AllowedChoice>();
+                    const auto allowed_type = reader.readEnum<shared::CardType>();
+                    const auto required_type = reader.readEnum<shared::CardType>();
+                    if ( tag == OrderTag::CHOOSE_FROM_HAND ) {
+                        return std::make_unique<ChooseFromHandOrder>(min_cards, max_cards, allowed_choices,
+                                                                     allowed_type, required_type);
+                    }
+                    return std::make_unique<ChooseFromStagedOrder>(min_cards, max_cards, allowed_choices,
+                                                                   reader.readCards());
+                }
+        }
+        throw exception::MalformedMessage("Unknown order tag " + std::to_string(static_cast<unsigned int>(tag)));
+    }
+
+    void ActionOrder::toBinary(BinaryWriter &writer) const
+    {
+        const auto write_choose_from = [&writer](OrderTag tag, const ChooseFromOrder &order)
+        {
+            writer.writeEnum(tag);
+            writer.writeUint(order.min_cards);
+            writer.writeUint(order.max_cards);
+            writer.writeEnum(order.allowed_choices);
+            writer.writeEnum(order.allowed_type);
+            writer.writeEnum(order.required_type);
+        };
+
         if ( typeid(*this) == typeid(ActionPhaseOrder) ) {
-            doc.AddMember("type", "action_phase", doc.GetAllocator());
+            writer.writeEnum(OrderTag::ACTION_PHASE);
         } else if ( typeid(*this) == typeid(BuyPhaseOrder) ) {
-            doc.AddMember("type", "buy_phase", doc.GetAllocator());
+            writer.writeEnum(OrderTag::BUY_PHASE);
+        } else if ( typeid(*this) == typeid(EndTurnOrder) ) {
+            writer.writeEnum(OrderTag::END_TURN);
         } else if ( typeid(*this) == typeid(GainFromBoardOrder) ) {
-            doc.AddMember("type", "gain_card", doc.GetAllocator());
-            ADD_UINT_MEMBER(dynamic_cast<const GainFromBoardOrder *>(this)->max_cost, max_cost);
-            ADD_ENUM_MEMBER(dynamic_cast<const GainFromBoardOrder *>(this)->allowed_type, allowed_type);
+            const auto &order = static_cast<const GainFromBoardOrder &>(*this);
+            writer.writeEnum(OrderTag::GAIN_FROM_BOARD);
+            writer.writeUint(order.max_cost);
+            writer.writeEnum(order.allowed_type);
         } else if ( typeid(*this) == typeid(ChooseFromHandOrder) ) {
-            doc.AddMember("type", "choose_from_hand", doc.GetAllocator());
-            ADD_UINT_MEMBER(dynamic_cast<const ChooseFromHandOrder *>(this)->min_cards, min_cards);
-            ADD_UINT_MEMBER(dynamic_cast<const ChooseFromHandOrder *>(this)->max_cards, max_cards);
-            ADD_ENUM_MEMBER(dynamic_cast<const ChooseFromHandOrder *>(this)->allowed_choices, allowed_choices);
-            ADD_ENUM_MEMBER(dynamic_cast<const ChooseFromHandOrder *>(this)->allowed_type, allowed_type);
+            write_choose_from(OrderTag::CHOOSE_FROM_HAND, static_cast<const ChooseFromHandOrder &>(*this));
         } else if ( typeid(*this) == typeid(ChooseFromStagedOrder) ) {
-            doc.AddMember("type", "choose_from_staged", doc.GetAllocator());
-            ADD_UINT_MEMBER(dynamic_cast<const ChooseFromStagedOrder *>(this)->min_cards, min_cards);
-            ADD_UINT_MEMBER(dynamic_cast<const ChooseFromStagedOrder *>(this)->max_cards, max_cards);
-            ADD_ENUM_MEMBER(dynamic_cast<const ChooseFromStagedOrder *>(this)->allowed_choices, allowed_choices);
-            ADD_ARRAY_OF_STRINGS_MEMBER(dynamic_cast<const ChooseFromStagedOrder *>(this)->cards, cards);
-            ADD_ENUM_MEMBER(dynamic_cast<const ChooseFromStagedOrder *>(this)->allowed_type, allowed_type);
+            const auto &order = static_cast<const ChooseFromStagedOrder &>(*this);
+            write_choose_from(OrderTag::CHOOSE_FROM_STAGED, order);
+            writer.writeCards(order.cards);
+        } else {
+            // This code should be unreachable
+            _ASSERT_TRUE(false, "Unknown order type");
         }
-        return doc;
     }
 
     bool ActionPhaseOrder::operator==(const ActionPhaseOrder & /* other */) const { return true; }
@@ -102,7 +199,7 @@ namespace shared
         return *this == dynamic_cast<const BuyPhaseOrder &>(other);
     }
 
-    bool EndTurnOrder::operator==(const EndTurnOrder &other) const { return this->equals(other); }
+    bool EndTurnOrder::operator==(const EndTurnOrder & /* other */) const { return true; }
 
     bool EndTurnOrder::operator!=(const EndTurnOrder &other) const { return !EndTurnOrder::operator==(other); }
 
@@ -123,7 +220,8 @@ namespace shared
 
     bool ChooseFromOrder::operator==(const ChooseFromOrder &other) const
     {
-        return min_cards == other.min_cards && max_cards == other.max_cards && allowed_choices == other.allowed_choices;
+        return min_cards == other.min_cards && max_cards == other.max_cards &&
+                allowed_choices == other.allowed_choices && required_type == other.required_type;
     }
 
     bool ChooseFromOrder::operator!=(const ChooseFromOrder &other) const { return !ChooseFromOrder::operator==(other); }
@@ -153,7 +251,7 @@ namespace shared
 
     bool ChooseFromHandOrder::operator==(const ChooseFromHandOrder &other) const
     {
-        return !ChooseFromOrder::operator==(other);
+        return ChooseFromOrder::operator==(other);
     }
 
     bool ChooseFromHandOrder::operator!=(const ChooseFromHandOrder &other) const
@@ -4,6 +4,7 @@
 
 #include <rapidjson/document.h>
 #include <shared/game/game_state/board_base.h>
+#include <shared/utils/exception.h>
 #include <shared/utils/json.h>
 #include <shared/utils/logger.h>
 
@@ -27,13 +28,30 @@ namespace shared
         return std::make_unique<Pile>(card_id, count);
     }
 
+    void Pile::writeJson(JsonWriter &writer) const
+    {
+        writer.StartObject();
+        WRITE_STRING_MEMBER(this->card_id, card_id);
+        WRITE_UINT_MEMBER(this->count, count);
+        writer.EndObject();
+    }
+
     rapidjson::Document Pile::toJson() const
     {
-        rapidjson::Document doc;
-        doc.SetObject();
-        ADD_STRING_MEMBER(this->card_id.c_str(), card_id);
-        ADD_UINT_MEMBER(this->count, count);
-        return doc;
+        return writeJsonDocument([this](JsonWriter &writer) { writeJson(writer); });
+    }
+
+    void Pile::toBinary(BinaryWriter &writer) const
+    {
+        writer.writeCard(card_id);
+        writer.writeUint(count);
+    }
+
+    Pile Pile::fromBinary(BinaryReader &reader)
+    {
+        CardBase::id_t card_id = reader.readCard();
+        const size_t count = reader.readUint();
+        return Pile(card_id, count);
     }
 
     Board::Board(const std::vector<shared::CardBase::id_t> &kingdom_cards, size_t player_count) :
@@ -133,36 +151,180 @@ namespace shared
                 new Board(victory_cards, treasure_cards, kingdom_cards, curse_pile, trash, played_cards));
     }
 
+    void Board::writeJson(JsonWriter &writer) const
+    {
+        writer.StartObject();
+        WRITE_OBJECT_MEMBER(curse_card_pile, curse_pile);
+        WRITE_ARRAY_OF_OBJECTS_MEMBER(victory_cards, victory_cards);
+        WRITE_ARRAY_OF_OBJECTS_MEMBER(treasure_cards, treasure_cards);
+        WRITE_ARRAY_OF_OBJECTS_MEMBER(kingdom_cards, kingdom_cards);
+        WRITE_ARRAY_OF_STRINGS_MEMBER(trash, trash);
+        WRITE_ARRAY_OF_STRINGS_MEMBER(played_cards, played_cards);
+        writer.EndObject();
+    }
+
     rapidjson::Document Board::toJson() const
     {
-        rapidjson::Document doc;
-        doc.SetObject();
+        return writeJsonDocument([this](JsonWriter &writer) { writeJson(writer); });
+    }
+
+    void Board::toBinary(BinaryWriter &writer) const
+    {
+        curse_card_pile.toBinary(writer);
+        for ( const auto *pile_container : {&victory_cards, &treasure_cards, &kingdom_cards} ) {
+            writer.writeUint(pile_container->size());
+            for ( const auto &pile : *pile_container ) {
+                pile.toBinary(writer);
+            }
+        }
+        writer.writeCards(trash);
+        writer.writeCards(played_cards);
+    }
+
+    Board::ptr_t Board::fromBinary(BinaryReader &reader)
+    {
+        const Pile curse_pile = Pile::fromBinary(reader);
+
+        const auto read_pile_container = [&reader]()
+        {
+            pile_container_t pile_container;
+            const size_t size = reader.readLength();
+            for ( size_t i = 0; i < size; ++i ) {
+                pile_container.insert(Pile::fromBinary(reader));
+            }
+            return pile_container;
+        };
+        pile_container_t victory_cards = read_pile_container();
+        pile_container_t treasure_cards = read_pile_container();
+        pile_container_t kingdom_cards = read_pile_container();
+
+        std::vector<shared::CardBase::id_t> trash = reader.readCards();
+        std::vector<shared::CardBase::id_t> played_cards = reader.readCards();
+
+        return std::unique_ptr<Board>(
+                new Board(victory_cards, treasure_cards, kingdom_cards, curse_pile, trash, played_cards));
+    }
+
+    Board::ptr_t Board::clone() const
+    {
+        return std::unique_ptr<Board>(
+                new Board(victory_cards, treasure_cards, kingdom_cards, curse_card_pile, trash, played_cards));
+    }
+
+    std::optional<Board::Delta> Board::Delta::make(const Board &from, const Board &to)
+    {
+        Delta delta;
+        const auto add_changed_piles = [&delta](const pile_container_t &from_piles, const pile_container_t &to_piles)
+        {
+            for ( const auto &pile : to_piles ) {
+                const auto it = from_piles.find(pile.card_id);
+                if ( it == from_piles.end() || it->count != pile.count ) {
+                    delta.piles.push_back(pile);
+                }
+            }
+        };
+        add_changed_piles(from.victory_cards, to.victory_cards);
+        add_changed_piles(from.treasure_cards, to.treasure_cards);
+        add_changed_piles(from.kingdom_cards, to.kingdom_cards);
+        if ( from.curse_card_pile != to.curse_card_pile ) {
+            delta.piles.push_back(to.curse_card_pile);
+        }
+        delta.trash = CardListDelta::make(from.trash, to.trash);
+        delta.played_cards = CardListDelta::make(from.played_cards, to.played_cards);
+
+        if ( delta.piles.empty() && !delta.trash.has_value() && !delta.played_cards.has_value() ) {
+            return std::nullopt;
+        }
+        return delta;
+    }
+
+    void Board::Delta::applyTo(Board &board) const
+    {
+        for ( const auto &pile : piles ) {
+            if ( pile.card_id == board.curse_card_pile.card_id ) {
+                board.curse_card_pile.count = pile.count;
+                continue;
+            }
 
-        rapidjson::Document curse_pile_doc = curse_card_pile.toJson();
-        rapidjson::Value curse_pile_value;
-        curse_pile_value.CopyFrom(curse_pile_doc, doc.GetAllocator());
-        doc.AddMember("curse_pile", curse_pile_value, doc.GetAllocator());
+            bool found = false;
+            for ( const auto *pile_container : {&board.victory_cards, &board.treasure_cards, &board.kingdom_cards} ) {
+                if ( const auto it = pile_container->find(pile.card_id); it != pile_container->end() ) {
+                    // the count is not part of the ordering, so it can be changed in place
+                    it->count = pile.count;
+                    found = true;
+                    break;
+                }
+            }
+            if ( !found ) {
+                throw exception::DeltaMismatch("Pile " + pile.card_id + " is not on the board");
+            }
+        }
+        if ( trash.has_value() ) {
+            trash->applyTo(board.trash);
+        }
+        if ( played_cards.has_value() ) {
+            played_cards->applyTo(board.played_cards);
+        }
+    }
+
+    void Board::Delta::writeJson(JsonWriter &writer) const
+    {
+        writer.StartObject();
+        WRITE_ARRAY_OF_OBJECTS_MEMBER(this->piles, piles);
+        WRITE_OPTIONAL_OBJECT_MEMBER(this->trash, trash);
+        WRITE_OPTIONAL_OBJECT_MEMBER(this->played_cards, played_cards);
+        writer.EndObject();
+    }
 
-#define ADD_PILE_CONTAINER(pile_container, member_name)                                                                \
-    rapidjson::Value member_name##_json(rapidjson::kArrayType);                                                        \
-    for ( const auto &pile : (pile_container) ) {                                                                      \
-        rapidjson::Document pile_doc = pile.toJson();                                                                  \
-        rapidjson::Value pile_value;                                                                                   \
-        pile_value.CopyFrom(pile_doc, doc.GetAllocator());                                                             \
-        member_name##_json.PushBack(pile_value, doc.GetAllocator());                                                   \
-    }                                                                                                                  \
-    doc.AddMember(#member_name, member_name##_json, doc.GetAllocator());
+    rapidjson::Document Board::Delta::toJson() const
+    {
+        return writeJsonDocument([this](JsonWriter &writer) { writeJson(writer); });
+    }
 
-        ADD_PILE_CONTAINER(victory_cards, victory_cards);
-        ADD_PILE_CONTAINER(treasure_cards, treasure_cards);
-        ADD_PILE_CONTAINER(kingdom_cards, kingdom_cards);
+    std::unique_ptr<Board::Delta> Board::Delta::fromJson(const rapidjson::Value &json)
+    {
+        if ( !json.HasMember("piles") || !json["piles"].IsArray() ) {
+            LOG(WARN) << "piles not found in JSON";
+            return nullptr;
+        }
+        auto delta = std::make_unique<Delta>();
+        for ( const auto &pile_json : json["piles"].GetArray() ) {
+            const std::unique_ptr<Pile> pile = Pile::fromJson(pile_json);
+            if ( pile == nullptr ) {
+                LOG(WARN) << "Failed to parse pile from JSON";
+                return nullptr;
+            }
+            delta->piles.push_back(*pile);
+        }
 
-#undef ADD_PILE_CONTAINER
+        if ( !CardListDelta::optionalFromJson(json, "trash", delta->trash) ||
+             !CardListDelta::optionalFromJson(json, "played_cards", delta->played_cards) ) {
+            return nullptr;
+        }
+        return delta;
+    }
 
-        ADD_ARRAY_OF_STRINGS_MEMBER(trash, trash);
-        ADD_ARRAY_OF_STRINGS_MEMBER(played_cards, played_cards);
+    void Board::Delta::toBinary(BinaryWriter &writer) const
+    {
+        writer.writeUint(piles.size());
+        for ( const auto &pile : piles ) {
+            pile.toBinary(writer);
+        }
+        CardListDelta::toBinary(writer, trash);
+        CardListDelta::toBinary(writer, played_cards);
+    }
 
-        return doc;
+    Board::Delta Board::Delta::fromBinary(BinaryReader &reader)
+    {
+        Delta delta;
+        const size_t pile_count = reader.readLength();
+        delta.piles.reserve(pile_count);
+        for ( size_t i = 0; i < pile_count; ++i ) {
+            delta.piles.push_back(Pile::fromBinary(reader));
+        }
+        delta.trash = CardListDelta::optionalFromBinary(reader);
+        delta.played_cards = CardListDelta::optionalFromBinary(reader);
+        return delta;
     }
 
     size_t Board::getEmptyPilesCount() const
@@ -0,0 +1,95 @@
+#include <algorithm>
+
+#include <shared/game/game_state/card_list_delta.h>
+#include <shared/utils/exception.h>
+#include <shared/utils/json.h>
+
+namespace shared
+{
+    std::optional<CardListDelta> CardListDelta::make(const std::vector<CardBase::id_t> &from,
+                                                     const std::vector<CardBase::id_t> &to)
+    {
+        if ( from == to ) {
+            return std::nullopt;
+        }
+        const auto [from_end, to_end] = std::mismatch(from.begin(), from.end(), to.begin(), to.end());
+        return CardListDelta{static_cast<size_t>(from_end - from.begin()), {to_end, to.end()}};
+    }
+
+    void CardListDelta::applyTo(std::vector<CardBase::id_t> &cards) const
+    {
+        if ( keep > cards.size() ) {
+            throw exception::DeltaMismatch("Can not keep " + std::to_string(keep) + " of " +
+                                           std::to_string(cards.size()) + " cards");
+        }
+        cards.resize(keep);
+        cards.insert(cards.end(), append.begin(), append.end());
+    }
+
+    void CardListDelta::writeJson(JsonWriter &writer) const
+    {
+        writer.StartObject();
+        WRITE_UINT_MEMBER(static_cast<unsigned int>(this->keep), keep);
+        WRITE_ARRAY_OF_STRINGS_MEMBER(this->append, append);
+        writer.EndObject();
+    }
+
+    rapidjson::Document CardListDelta::toJson() const
+    {
+        return writeJsonDocument([this](JsonWriter &writer) { writeJson(writer); });
+    }
+
+    std::unique_ptr<CardListDelta> CardListDelta::fromJson(const rapidjson::Value &json)
+    {
+        auto delta = std::make_unique<CardListDelta>();
+        GET_UINT_MEMBER(delta->keep, json, "keep");
+        GET_STRING_ARRAY_MEMBER(delta->append, json, "append");
+        return delta;
+    }
+
+    bool CardListDelta::optionalFromJson(const rapidjson::Value &json, const char *member,
+                                         std::optional<CardListDelta> &delta)
+    {
+        delta.reset();
+        if ( !json.HasMember(member) ) {
+            return true;
+        }
+        const auto parsed = fromJson(json[member]);
+        if ( parsed == nullptr ) {
+            LOG(WARN) << "Failed to parse " << member << " from JSON";
+            return false;
+        }
+        delta = *parsed;
+        return true;
+    }
+
+    void CardListDelta::toBinary(BinaryWriter &writer) const
+    {
+        writer.writeUint(keep);
+        writer.writeCards(append);
+    }
+
+    CardListDelta CardListDelta::fromBinary(BinaryReader &reader)
+    {
+        CardListDelta delta;
+        delta.keep = reader.readUint();
+        delta.append = reader.readCards();
+        return delta;
+    }
+
+    void CardListDelta::toBinary(BinaryWriter &writer, const std::optional<CardListDelta> &delta)
+    {
+        writer.writeBool(delta.has_value());
+        if ( delta.has_value() ) {
+            delta->toBinary(writer);
+        }
+    }
+
+    std::optional<CardListDelta> CardListDelta::optionalFromBinary(BinaryReader &reader)
+    {
+        if ( !reader.readBool() ) {
+            return std::nullopt;
+        }
+        return fromBinary(reader);
+    }
+} // namespace shared
@@ -1,5 +1,6 @@
 
 #include <shared/game/game_state/player_base.h>
+#include <shared/utils/exception.h>
 #include <shared/utils/json.h>
 
 namespace shared
@@ -99,20 +100,27 @@ namespace shared
                 (discard_pile == other.discard_pile) && (draw_pile_size == other.draw_pile_size);
     }
 
-    rapidjson::Document PlayerBase::toJson() const
+    void PlayerBase::writeJson(JsonWriter &writer) const
     {
-        rapidjson::Document doc;
-        doc.SetObject();
+        writer.StartObject();
+        writeJsonMembers(writer);
+        writer.EndObject();
+    }
 
-        ADD_STRING_MEMBER(this->player_id.c_str(), player_id);
-        ADD_UINT_MEMBER(this->actions, actions);
-        ADD_UINT_MEMBER(this->buys, buys);
-        ADD_UINT_MEMBER(this->treasure, treasure);
-        ADD_STRING_MEMBER(this->current_card.c_str(), current_card);
-        ADD_ARRAY_OF_STRINGS_MEMBER(this->discard_pile, discard_pile);
-        ADD_UINT_MEMBER(this->draw_pile_size, draw_pile_size);
+    void PlayerBase::writeJsonMembers(JsonWriter &writer) const
+    {
+        WRITE_STRING_MEMBER(this->player_id, player_id);
+        WRITE_UINT_MEMBER(this->actions, actions);
+        WRITE_UINT_MEMBER(this->buys, buys);
+        WRITE_UINT_MEMBER(this->treasure, treasure);
+        WRITE_STRING_MEMBER(this->current_card, current_card);
+        WRITE_ARRAY_OF_STRINGS_MEMBER(this->discard_pile, discard_pile);
+        WRITE_UINT_MEMBER(this->draw_pile_size, draw_pile_size);
+    }
 
-        return doc;
+    rapidjson::Document PlayerBase::toJson() const
+    {
+        return writeJsonDocument([this](JsonWriter &writer) { writeJson(writer); });
     }
 
     std::unique_ptr<PlayerBase> PlayerBase::fromJson(const rapidjson::Value &json)
@@ -129,4 +137,117 @@ namespace shared
         return player;
     }
 
+    void PlayerBase::toBinary(BinaryWriter &writer) const
+    {
+        writer.writeString(this->player_id);
+        writer.writeUint(this->actions);
+        writer.writeUint(this->buys);
+        writer.writeUint(this->treasure);
+        writer.writeCard(this->current_card);
+        writer.writeCards(this->discard_pile);
+        writer.writeUint(this->draw_pile_size);
+    }
+
+    std::unique_ptr<PlayerBase> PlayerBase::fromBinary(BinaryReader &reader)
+    {
+        std::unique_ptr<PlayerBase> player(new PlayerBase(reader.readString()));
+        player->actions = reader.readUint32();
+        player->buys = reader.readUint32();
+        player->treasure = reader.readUint32();
+        player->current_card = reader.readCard();
+        player->discard_pile = reader.readCards();
+        player->draw_pile_size = reader.readUint32();
+        return player;
+    }
+
+    PlayerBase::Delta PlayerBase::Delta::make(const PlayerBase &from, const PlayerBase &to)
+    {
+        Delta delta;
+        delta.player_id = to.player_id;
+        delta.actions = to.actions;
+        delta.buys = to.buys;
+        delta.treasure = to.treasure;
+        delta.current_card = to.current_card;
+        delta.discard_pile = CardListDelta::make(from.discard_pile, to.discard_pile);
+        delta.draw_pile_size = to.draw_pile_size;
+        return delta;
+    }
+
+    void PlayerBase::Delta::applyTo(PlayerBase &player) const
+    {
+        if ( player.player_id != player_id ) {
+            throw exception::DeltaMismatch("Delta of player " + player_id + " applied to " + player.player_id);
+        }
+        player.actions = actions;
+        player.buys = buys;
+        player.treasure = treasure;
+        player.current_card = current_card;
+        if ( discard_pile.has_value() ) {
+            discard_pile->applyTo(player.discard_pile);
+        }
+        player.draw_pile_size = draw_pile_size;
+    }
+
+    void PlayerBase::Delta::writeJson(JsonWriter &writer) const
+    {
+        writer.StartObject();
+        writeJsonMembers(writer);
+        writer.EndObject();
+    }
+
+    void PlayerBase::Delta::writeJsonMembers(JsonWriter &writer) const
+    {
+        WRITE_STRING_MEMBER(this->player_id, player_id);
+        WRITE_UINT_MEMBER(this->actions, actions);
+        WRITE_UINT_MEMBER(this->buys, buys);
+        WRITE_UINT_MEMBER(this->treasure, treasure);
+        WRITE_STRING_MEMBER(this->current_card, current_card);
+        WRITE_OPTIONAL_OBJECT_MEMBER(this->discard_pile, discard_pile);
+        WRITE_UINT_MEMBER(this->draw_pile_size, draw_pile_size);
+    }
+
+    rapidjson::Document PlayerBase::Delta::toJson() const
+    {
+        return writeJsonDocument([this](JsonWriter &writer) { writeJson(writer); });
+    }
+
+    std::unique_ptr<PlayerBase::Delta> PlayerBase::Delta::fromJson(const rapidjson::Value &json)
+    {
+        auto delta = std::make_unique<Delta>();
+        GET_STRING_MEMBER(delta->player_id, json, "player_id");
+        GET_UINT_MEMBER(delta->actions, json, "actions");
+        GET_UINT_MEMBER(delta->buys, json, "buys");
+        GET_UINT_MEMBER(delta->treasure, json, "treasure");
+        GET_STRING_MEMBER(delta->current_card, json, "current_card");
+        if ( !CardListDelta::optionalFromJson(json, "discard_pile", delta->discard_pile) ) {
+            return nullptr;
+        }
+        GET_UINT_MEMBER(delta->draw_pile_size, json, "draw_pile_size");
+        return delta;
+    }
+
+    void PlayerBase::Delta::toBinary(BinaryWriter &writer) const
+    {
+        writer.writeString(this->player_id);
+        writer.writeUint(this->actions);
+        writer.writeUint(this->buys);
+        writer.writeUint(this->treasure);
+        writer.writeCard(this->current_card);
+        CardListDelta::toBinary(writer, this->discard_pile);
+        writer.writeUint(this->draw_pile_size);
+    }
+
+    PlayerBase::Delta PlayerBase::Delta::fromBinary(BinaryReader &reader)
+    {
+        Delta delta;
+        delta.player_id = reader.readString();
+        delta.actions = reader.readUint32();
+        delta.buys = reader.readUint32();
+        delta.treasure = reader.readUint32();
+        delta.current_card = reader.readCard();
+        delta.discard_pile = CardListDelta::optionalFromBinary(reader);
+        delta.draw_pile_size = reader.readUint32();
+        return delta;
+    }
+
 } // namespace shared
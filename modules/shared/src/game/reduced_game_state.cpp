@@ -2,6 +2,7 @@
 #include <algorithm>
 
 #include <shared/game/game_state/reduced_game_state.h>
+#include <shared/utils/exception.h>
 #include <shared/utils/json.h>
 #include <shared/utils/logger.h>
 
@@ -18,36 +19,37 @@ namespace reduced
 
     bool GameState::operator!=(const GameState &other) const { return !(*this == other); }
 
-    rapidjson::Document GameState::toJson() const
+    void GameState::writeJson(shared::JsonWriter &writer) const
     {
-        rapidjson::Document doc;
-        doc.SetObject();
-
-        rapidjson::Document board_doc = board->toJson();
-        rapidjson::Value board_value;
-        board_value.CopyFrom(board_doc, doc.GetAllocator());
-        doc.AddMember("board", board_value, doc.GetAllocator());
-
-        rapidjson::Document reduced_player_doc = reduced_player->toJson();
-        rapidjson::Value reduced_player_value;
-        reduced_player_value.CopyFrom(reduced_player_doc, doc.GetAllocator());
-        doc.AddMember("reduced_player", reduced_player_value, doc.GetAllocator());
-
-        rapidjson::Value reduced_enemies_value(rapidjson::kArrayType);
+        writer.StartObject();
+        WRITE_OBJECT_MEMBER(*board, board);
+        WRITE_OBJECT_MEMBER(*reduced_player, reduced_player);
+        WRITE_KEY(reduced_enemies);
+        writer.StartArray();
         for ( const auto &reduced_enemy : reduced_enemies ) {
-            rapidjson::Document reduced_enemy_doc = reduced_enemy->toJson();
-            rapidjson::Value reduced_enemy_value;
-            reduced_enemy_value.CopyFrom(reduced_enemy_doc, doc.GetAllocator());
-            reduced_enemies_value.PushBack(reduced_enemy_value, doc.GetAllocator());
+            reduced_enemy->writeJson(writer);
         }
-        doc.AddMember("reduced_enemies", reduced_enemies_value, doc.GetAllocator());
-
-        std::string game_phase = shared::toString(this->game_phase);
-        ADD_STRING_MEMBER(game_phase.c_str(), game_phase);
+        writer.EndArray();
+        WRITE_STRING_MEMBER(shared::toString(this->game_phase), game_phase);
+        WRITE_STRING_MEMBER(this->active_player, active_player);
+        writer.EndObject();
+    }
 
-        ADD_STRING_MEMBER(this->active_player.c_str(), active_player);
+    rapidjson::Document GameState::toJson() const
+    {
+        return shared::writeJsonDocument([this](shared::JsonWriter &writer) { writeJson(writer); });
+    }
 
-        return doc;
+    std::unique_ptr<GameState> GameState::clone() const
+    {
+        std::vector<reduced::Enemy::ptr_t> enemies;
+        enemies.reserve(reduced_enemies.size());
+        for ( const auto &enemy : reduced_enemies ) {
+            enemies.push_back(reduced::Enemy::make(*enemy, enemy->getHandSize()));
+        }
+        return std::make_unique<GameState>(board->clone(),
+                                           reduced::Player::make(*reduced_player, reduced_player->getHandCards()),
+                                           std::move(enemies), active_player, game_phase);
     }
 
     bool GameState::isPlayerActive() const { return active_player == reduced_player->getId(); }
@@ -114,4 +116,203 @@ namespace reduced
         return std::make_unique<GameState>(std::move(board), std::move(reduced_player), std::move(reduced_enemies),
                                            active_player, game_phase);
     }
+
+    void GameState::toBinary(shared::BinaryWriter &writer) const
+    {
+        board->toBinary(writer);
+        reduced_player->toBinary(writer);
+        writer.writeUint(reduced_enemies.size());
+        for ( const auto &reduced_enemy : reduced_enemies ) {
+            reduced_enemy->toBinary(writer);
+        }
+        writer.writeEnum(game_phase);
+        writer.writeString(active_player);
+    }
+
+    std::unique_ptr<GameState> GameState::fromBinary(shared::BinaryReader &reader)
+    {
+        shared::Board::ptr_t board = shared::Board::fromBinary(reader);
+        reduced::Player::ptr_t reduced_player = reduced::Player::fromBinary(reader);
+
+        std::vector<reduced::Enemy::ptr_t> reduced_enemies(reader.readLength());
+        for ( auto &reduced_enemy : reduced_enemies ) {
+            reduced_enemy = reduced::Enemy::fromBinary(reader);
+        }
+
+        const auto game_phase = reader.readEnum<shared::GamePhase>();
+        shared::PlayerBase::id_t active_player = reader.readString();
+
+        return std::make_unique<GameState>(std::move(board), std::move(reduced_player), std::move(reduced_enemies),
+                                           active_player, game_phase);
+    }
+
+    std::unique_ptr<GameState::Delta> GameState::Delta::make(const GameState &from, const GameState &to)
+    {
+        if ( from.reduced_player->getId() != to.reduced_player->getId() ||
+             !std::equal(from.reduced_enemies.begin(), from.reduced_enemies.end(), to.reduced_enemies.begin(),
+                         to.reduced_enemies.end(), [](const reduced::Enemy::ptr_t &a, const reduced::Enemy::ptr_t &b)
+                         { return a->getId() == b->getId(); }) ) {
+            return nullptr;
+        }
+
+        auto delta = std::make_unique<Delta>();
+        delta->board = shared::Board::Delta::make(*from.board, *to.board);
+        delta->reduced_player = reduced::Player::Delta::make(*from.reduced_player, *to.reduced_player);
+        for ( size_t i = 0; i < to.reduced_enemies.size(); ++i ) {
+            auto enemy_delta = reduced::Enemy::Delta::make(*from.reduced_enemies[i], *to.reduced_enemies[i]);
+            if ( enemy_delta.has_value() ) {
+                delta->reduced_enemies.push_back(std::move(*enemy_delta));
+            }
+        }
+        if ( from.active_player != to.active_player ) {
+            delta->active_player = to.active_player;
+        }
+        if ( from.game_phase != to.game_phase ) {
+            delta->game_phase = to.game_phase;
+        }
+        return delta;
+    }
+
+    void GameState::Delta::applyTo(GameState &game_state) const
+    {
+        if ( board.has_value() ) {
+            board->applyTo(*game_state.board);
+        }
+        if ( reduced_player.has_value() ) {
+            reduced_player->applyTo(*game_state.reduced_player);
+        }
+        for ( const auto &enemy_delta : reduced_enemies ) {
+            const auto enemy = std::find_if(game_state.reduced_enemies.begin(), game_state.reduced_enemies.end(),
+                                            [&enemy_delta](const reduced::Enemy::ptr_t &enemy)
+                                            { return enemy->getId() == enemy_delta.player_id; });
+            if ( enemy == game_state.reduced_enemies.end() ) {
+                throw exception::DeltaMismatch("Enemy " + enemy_delta.player_id + " is not in the game state");
+            }
+            enemy_delta.applyTo(**enemy);
+        }
+        if ( active_player.has_value() ) {
+            game_state.active_player = *active_player;
+        }
+        if ( game_phase.has_value() ) {
+            game_state.game_phase = *game_phase;
+        }
+    }
+
+    bool GameState::Delta::empty() const
+    {
+        return !board.has_value() && !reduced_player.has_value() && reduced_enemies.empty() &&
+                !active_player.has_value() && !game_phase.has_value();
+    }
+
+    void GameState::Delta::writeJson(shared::JsonWriter &writer) const
+    {
+        writer.StartObject();
+        WRITE_OPTIONAL_OBJECT_MEMBER(this->board, board);
+        WRITE_OPTIONAL_OBJECT_MEMBER(this->reduced_player, reduced_player);
+        WRITE_ARRAY_OF_OBJECTS_MEMBER(this->reduced_enemies, reduced_enemies);
+        WRITE_OPTIONAL_STRING_MEMBER(this->active_player, active_player);
+        if ( this->game_phase.has_value() ) {
+            WRITE_STRING_MEMBER(shared::toString(*this->game_phase), game_phase);
+        }
+        writer.EndObject();
+    }
+
+    rapidjson::Document GameState::Delta::toJson() const
+    {
+        return shared::writeJsonDocument([this](shared::JsonWriter &writer) { writeJson(writer); });
+    }
+
+    std::unique_ptr<GameState::Delta> GameState::Delta::fromJson(const rapidjson::Value &json)
+    {
+        if ( !json.IsObject() ) {
+            LOG(WARN) << "GameState::Delta::fromJson: JSON is not an object";
+            return nullptr;
+        }
+        auto delta = std::make_unique<Delta>();
+
+        if ( json.HasMember("board") ) {
+            auto board = shared::Board::Delta::fromJson(json["board"]);
+            if ( board == nullptr ) {
+                LOG(WARN) << "GameState::Delta::fromJson: Failed to parse board";
+                return nullptr;
+            }
+            delta->board = std::move(*board);
+        }
+        if ( json.HasMember("reduced_player") ) {
+            auto reduced_player = reduced::Player::Delta::fromJson(json["reduced_player"]);
+            if ( reduced_player == nullptr ) {
+                LOG(WARN) << "GameState::Delta::fromJson: Failed to parse reduced_player";
+                return nullptr;
+            }
+            delta->reduced_player = std::move(*reduced_player);
+        }
+
+        if ( !json.HasMember("reduced_enemies") || !json["reduced_enemies"].IsArray() ) {
+            LOG(WARN) << "GameState::Delta::fromJson: 'reduced_enemies' is missing or not an array";
+            return nullptr;
+        }
+        for ( const auto &reduced_enemy_json : json["reduced_enemies"].GetArray() ) {
+            auto reduced_enemy = reduced::Enemy::Delta::fromJson(reduced_enemy_json);
+            if ( reduced_enemy == nullptr ) {
+                LOG(WARN) << "GameState::Delta::fromJson: Failed to parse reduced_enemy";
+                return nullptr;
+            }
+            delta->reduced_enemies.push_back(std::move(*reduced_enemy));
+        }
+
+        if ( json.HasMember("active_player") ) {
+            shared::PlayerBase::id_t active_player;
+            GET_STRING_MEMBER(active_player, json, "active_player");
+            delta->active_player = active_player;
+        }
+        if ( json.HasMember("game_phase") ) {
+            std::string game_phase;
+            GET_STRING_MEMBER(game_phase, json, "game_phase");
+            delta->game_phase = shared::gamePhaseFromString(game_phase);
+        }
+
+        return delta;
+    }
+
+    void GameState::Delta::toBinary(shared::BinaryWriter &writer) const
+    {
+        writer.writeBool(board.has_value());
+        if ( board.has_value() ) {
+            board->toBinary(writer);
+        }
+        writer.writeBool(reduced_player.has_value());
+        if ( reduced_player.has_value() ) {
+            reduced_player->toBinary(writer);
+        }
+        writer.writeUint(reduced_enemies.size());
+        for ( const auto &reduced_enemy : reduced_enemies ) {
+            reduced_enemy.toBinary(writer);
+        }
+        writer.writeOptionalString(active_player);
+        writer.writeBool(game_phase.has_value());
+        if ( game_phase.has_value() ) {
+            writer.writeEnum(*game_phase);
+        }
+    }
+
+    std::unique_ptr<GameState::Delta> GameState::Delta::fromBinary(shared::BinaryReader &reader)
+    {
+        auto delta = std::make_unique<Delta>();
+        if ( reader.readBool() ) {
+            delta->board = shared::Board::Delta::fromBinary(reader);
+        }
+        if ( reader.readBool() ) {
+            delta->reduced_player = reduced::Player::Delta::fromBinary(reader);
+        }
+        const size_t enemy_count = reader.readLength();
+        delta->reduced_enemies.reserve(enemy_count);
+        for ( size_t i = 0; i < enemy_count; ++i ) {
+            delta->reduced_enemies.push_back(reduced::Enemy::Delta::fromBinary(reader));
+        }
+        delta->active_player = reader.readOptionalString();
+        if ( reader.readBool() ) {
+            delta->game_phase = reader.readEnum<shared::GamePhase>();
+        }
+        return delta;
+    }
 } // namespace reduced
@@ -12,11 +12,17 @@ namespace reduced
         return ptr_t(new Player(player, hand_cards));
     }
 
+    void Player::writeJson(shared::JsonWriter &writer) const
+    {
+        writer.StartObject();
+        PlayerBase::writeJsonMembers(writer);
+        WRITE_ARRAY_OF_STRINGS_MEMBER(this->hand_cards, hand_cards);
+        writer.EndObject();
+    }
+
     rapidjson::Document Player::toJson() const
     {
-        rapidjson::Document doc = PlayerBase::toJson();
-        ADD_ARRAY_OF_STRINGS_MEMBER(this->hand_cards, hand_cards);
-        return doc;
+        return shared::writeJsonDocument([this](shared::JsonWriter &writer) { writeJson(writer); });
     }
 
     std::unique_ptr<Player> Player::fromJson(const rapidjson::Value &json)
@@ -27,8 +33,80 @@ namespace reduced
         return std::unique_ptr<Player>(new Player(*player_base, hand_cards));
     }
 
+    void Player::toBinary(shared::BinaryWriter &writer) const
+    {
+        PlayerBase::toBinary(writer);
+        writer.writeCards(this->hand_cards);
+    }
+
+    std::unique_ptr<Player> Player::fromBinary(shared::BinaryReader &reader)
+    {
+        std::unique_ptr<shared::PlayerBase> player_base = PlayerBase::fromBinary(reader);
+        return std::unique_ptr<Player>(new Player(*player_base, reader.readCards()));
+    }
+
     const std::vector<shared::CardBase::id_t> &Player::getHandCards() const { return hand_cards; }
 
+    std::optional<Player::Delta> Player::Delta::make(const Player &from, const Player &to)
+    {
+        if ( static_cast<const shared::PlayerBase &>(from) == to && from.hand_cards == to.hand_cards ) {
+            return std::nullopt;
+        }
+        Delta delta;
+        static_cast<shared::PlayerBase::Delta &>(delta) = shared::PlayerBase::Delta::make(from, to);
+        delta.hand_cards = shared::CardListDelta::make(from.hand_cards, to.hand_cards);
+        return delta;
+    }
+
+    void Player::Delta::applyTo(Player &player) const
+    {
+        shared::PlayerBase::Delta::applyTo(player);
+        if ( hand_cards.has_value() ) {
+            hand_cards->applyTo(player.hand_cards);
+        }
+    }
+
+    void Player::Delta::writeJson(shared::JsonWriter &writer) const
+    {
+        writer.StartObject();
+        shared::PlayerBase::Delta::writeJsonMembers(writer);
+        WRITE_OPTIONAL_OBJECT_MEMBER(this->hand_cards, hand_cards);
+        writer.EndObject();
+    }
+
+    rapidjson::Document Player::Delta::toJson() const
+    {
+        return shared::writeJsonDocument([this](shared::JsonWriter &writer) { writeJson(writer); });
+    }
+
+    std::unique_ptr<Player::Delta> Player::Delta::fromJson(const rapidjson::Value &json)
+    {
+        std::unique_ptr<shared::PlayerBase::Delta> base = shared::PlayerBase::Delta::fromJson(json);
+        if ( base == nullptr ) {
+            return nullptr;
+        }
+        auto delta = std::make_unique<Delta>();
+        static_cast<shared::PlayerBase::Delta &>(*delta) = std::move(*base);
+        if ( !shared::CardListDelta::optionalFromJson(json, "hand_cards", delta->hand_cards) ) {
+            return nullptr;
+        }
+        return delta;
+    }
+
+    void Player::Delta::toBinary(shared::BinaryWriter &writer) const
+    {
+        shared::PlayerBase::Delta::toBinary(writer);
+        shared::CardListDelta::toBinary(writer, this->hand_cards);
+    }
+
+    Player::Delta Player::Delta::fromBinary(shared::BinaryReader &reader)
+    {
+        Delta delta;
+        static_cast<shared::PlayerBase::Delta &>(delta) = shared::PlayerBase::Delta::fromBinary(reader);
+        delta.hand_cards = shared::CardListDelta::optionalFromBinary(reader);
+        return delta;
+    }
+
     Enemy::Enemy(const shared::PlayerBase &player, unsigned int hand) : shared::PlayerBase(player), hand_size(hand) {}
 
     Enemy::ptr_t Enemy::make(const shared::PlayerBase &player, unsigned int hand_size)
@@ -36,11 +114,17 @@ namespace reduced
         return ptr_t(new Enemy(player, hand_size));
     }
 
+    void Enemy::writeJson(shared::JsonWriter &writer) const
+    {
+        writer.StartObject();
+        shared::PlayerBase::writeJsonMembers(writer);
+        WRITE_UINT_MEMBER(this->hand_size, hand_size);
+        writer.EndObject();
+    }
+
     rapidjson::Document Enemy::toJson() const
     {
-        rapidjson::Document doc = shared::PlayerBase::toJson();
-        ADD_UINT_MEMBER(this->hand_size, hand_size);
-        return doc;
+        return shared::writeJsonDocument([this](shared::JsonWriter &writer) { writeJson(writer); });
     }
 
     std::unique_ptr<Enemy> Enemy::fromJson(const rapidjson::Value &json)
@@ -51,5 +135,73 @@ namespace reduced
         return std::unique_ptr<Enemy>(new Enemy(*player_base, hand_size));
     }
 
+    void Enemy::toBinary(shared::BinaryWriter &writer) const
+    {
+        shared::PlayerBase::toBinary(writer);
+        writer.writeUint(this->hand_size);
+    }
+
+    std::unique_ptr<Enemy> Enemy::fromBinary(shared::BinaryReader &reader)
+    {
+        std::unique_ptr<shared::PlayerBase> player_base = PlayerBase::fromBinary(reader);
+        return std::unique_ptr<Enemy>(new Enemy(*player_base, reader.readUint32()));
+    }
+
     unsigned int Enemy::getHandSize() const { return hand_size; }
+
+    std::optional<Enemy::Delta> Enemy::Delta::make(const Enemy &from, const Enemy &to)
+    {
+        if ( static_cast<const shared::PlayerBase &>(from) == to && from.hand_size == to.hand_size ) {
+            return std::nullopt;
+        }
+        Delta delta;
+        static_cast<shared::PlayerBase::Delta &>(delta) = shared::PlayerBase::Delta::make(from, to);
+        delta.hand_size = to.hand_size;
+        return delta;
+    }
+
+    void Enemy::Delta::applyTo(Enemy &enemy) const
+    {
+        shared::PlayerBase::Delta::applyTo(enemy);
+        enemy.hand_size = hand_size;
+    }
+
+    void Enemy::Delta::writeJson(shared::JsonWriter &writer) const
+    {
+        writer.StartObject();
+        shared::PlayerBase::Delta::writeJsonMembers(writer);
+        WRITE_UINT_MEMBER(this->hand_size, hand_size);
+        writer.EndObject();
+    }
+
+    rapidjson::Document Enemy::Delta::toJson() const
+    {
+        return shared::writeJsonDocument([this](shared::JsonWriter &writer) { writeJson(writer); });
+    }
+
+    std::unique_ptr<Enemy::Delta> Enemy::Delta::fromJson(const rapidjson::Value &json)
+    {
+        std::unique_ptr<shared::PlayerBase::Delta> base = shared::PlayerBase::Delta::fromJson(json);
+        if ( base == nullptr ) {
+            return nullptr;
+        }
+        auto delta = std::make_unique<Delta>();
+        static_cast<shared::PlayerBase::Delta &>(*delta) = std::move(*base);
+        GET_UINT_MEMBER(delta->hand_size, json, "hand_size");
+        return delta;
+    }
+
+    void Enemy::Delta::toBinary(shared::BinaryWriter &writer) const
+    {
+        shared::PlayerBase::Delta::toBinary(writer);
+        writer.writeUint(this->hand_size);
+    }
+
+    Enemy::Delta Enemy::Delta::fromBinary(shared::BinaryReader &reader)
+    {
+        Delta delta;
+        static_cast<shared::PlayerBase::Delta &>(delta) = shared::PlayerBase::Delta::fromBinary(reader);
+        delta.hand_size = reader.readUint32();
+        return delta;
+    }
 } // namespace reduced
\ No newline at end of file
@@ -0,0 +1,247 @@
+#include <memory>
+
+#include <shared/message_types.h>
+#include <shared/utils/binary.h>
+#include <shared/utils/logger.h>
+
+using namespace shared;
+
+/* ======= SERVER TO CLIENT MESSAGES ======= */
+
+static std::unique_ptr<GameStateMessage> parseGameStateMessage(BinaryReader &reader, const std::string &game_id,
+                                                               const std::string &message_id)
+{
+    std::unique_ptr<reduced::GameState> game_state = reduced::GameState::fromBinary(reader);
+    std::optional<std::string> in_response_to = reader.readOptionalString();
+    auto message = std::make_unique<GameStateMessage>(game_id, std::move(game_state), in_response_to, message_id);
+    message->version = reader.readUint32();
+    return message;
+}
+
+static std::unique_ptr<GameStateDeltaMessage> parseGameStateDelta(BinaryReader &reader, const std::string &game_id,
+                                                                  const std::string &message_id)
+{
+    const unsigned int base_version = reader.readUint32();
+    const unsigned int version = reader.readUint32();
+    std::unique_ptr<reduced::GameState::Delta> delta = reduced::GameState::Delta::fromBinary(reader);
+    return std::make_unique<GameStateDeltaMessage>(game_id, base_version, version, std::move(delta), message_id);
+}
+
+static std::unique_ptr<CreateLobbyResponseMessage>
+parseCreateLobbyResponse(BinaryReader &reader, const std::string &game_id, const std::string &message_id)
+{
+    std::optional<std::string> in_response_to = reader.readOptionalString();
+    auto message = std::make_unique<CreateLobbyResponseMessage>(game_id, in_response_to, message_id);
+    message->available_cards = reader.readCards();
+    return message;
+}
+
+static std::unique_ptr<JoinLobbyBroadcastMessage>
+parseJoinGameBroadcast(BinaryReader &reader, const std::string &game_id, const std::string &message_id)
+{
+    return std::make_unique<JoinLobbyBroadcastMessage>(game_id, reader.readStrings(), message_id);
+}
+
+static std::unique_ptr<EndGameBroadcastMessage> parseEndGameBroadcast(BinaryReader &reader,
+                                                                      const std::string &game_id,
+                                                                      const std::string &message_id)
+{
+    std::vector<PlayerResult> results;
+    const size_t count = reader.readLength();
+    results.reserve(count);
+    for ( size_t i = 0; i < count; ++i ) {
+        shared::PlayerBase::id_t player_id = reader.readString();
+        const auto score = static_cast<int>(reader.readInt());
+        results.emplace_back(player_id, score);
+    }
+    const uint64_t seed = reader.readUint();
+    return std::make_unique<EndGameBroadcastMessage>(game_id, results, seed, message_id);
+}
+
+static std::unique_ptr<ResultResponseMessage> parseResultResponse(BinaryReader &reader, const std::string &game_id,
+                                                                  const std::string &message_id)
+{
+    std::optional<std::string> in_response_to = reader.readOptionalString();
+    const bool success = reader.readBool();
+    std::optional<std::string> additional_information = reader.readOptionalString();
+    return std::make_unique<ResultResponseMessage>(game_id, success, in_response_to, additional_information,
+                                                   message_id);
+}
+
+static std::unique_ptr<ActionOrderMessage> parseActionOrder(BinaryReader &reader, const std::string &game_id,
+                                                            const std::string &message_id)
+{
+    std::unique_ptr<ActionOrder> order = ActionOrder::fromBinary(reader);
+    std::unique_ptr<reduced::GameState> game_state = reduced::GameState::fromBinary(reader);
+    std::optional<std::string> description = reader.readOptionalString();
+    return std::make_unique<ActionOrderMessage>(game_id, std::move(order), std::move(game_state), description,
+                                                message_id);
+}
+
+static std::unique_ptr<ServerToClientMessage> parseServerToClientMessage(BinaryReader &reader)
+{
+    if ( reader.readByte() != BINARY_MAGIC ) {
+        throw exception::MalformedMessage("Missing binary magic byte");
+    }
+    const auto tag = reader.readEnum<MessageTag>();
+    std::string game_id = reader.readString();
+    std::string message_id = reader.readString();
+
+    switch ( tag ) {
+        case MessageTag::GAME_STATE:
+            return parseGameStateMessage(reader, game_id, message_id);
+        case MessageTag::CREATE_LOBBY_RESPONSE:
+            return parseCreateLobbyResponse(reader, game_id, message_id);
+        case MessageTag::JOIN_LOBBY_BROADCAST:
+            return parseJoinGameBroadcast(reader, game_id, message_id);
+        case MessageTag::START_GAME_BROADCAST:
+            return std::make_unique<StartGameBroadcastMessage>(game_id, message_id);
+        case MessageTag::END_GAME_BROADCAST:
+            return parseEndGameBroadcast(reader, game_id, message_id);
+        case MessageTag::RESULT_RESPONSE:
+            return parseResultResponse(reader, game_id, message_id);
+        case MessageTag::ACTION_ORDER:
+            return parseActionOrder(reader, game_id, message_id);
+        case MessageTag::GAME_STATE_DELTA:
+            return parseGameStateDelta(reader, game_id, message_id);
+        default:
+            throw exception::MalformedMessage("Unknown message tag " +
+                                              std::to_string(static_cast<unsigned int>(tag)));
+    }
+}
+
+/* ======= CLIENT TO SERVER MESSAGES ======= */
+
+static std::unique_ptr<StartGameRequestMessage> parseStartGameRequest(BinaryReader &reader,
+                                                                      const std::string &game_id,
+                                                                      const PlayerBase::id_t &player_id,
+                                                                      const std::string &message_id)
+{
+    std::vector<CardBase::id_t> selected_cards = reader.readCards();
+    if ( selected_cards.size() != shared::board_config::KINGDOM_CARD_COUNT ) {
+        throw exception::MalformedMessage("Expected " + std::to_string(shared::board_config::KINGDOM_CARD_COUNT) +
+                                          " selected cards, got " + std::to_string(selected_cards.size()));
+    }
+    return std::make_unique<StartGameRequestMessage>(game_id, player_id, selected_cards, message_id);
+}
+
+static std::unique_ptr<ActionDecisionMessage> parseActionDecision(BinaryReader &reader, const std::string &game_id,
+                                                                  const PlayerBase::id_t &player_id,
+                                                                  const std::string &message_id)
+{
+    std::optional<std::string> in_response_to = reader.readOptionalString();
+
+    std::unique_ptr<ActionDecision> decision;
+    const auto tag = reader.readEnum<DecisionTag>();
+    switch ( tag ) {
+        case DecisionTag::PLAY_ACTION_CARD:
+            {
+                shared::CardBase::id_t card_id = reader.readCard();
+                decision = std::make_unique<PlayActionCardDecision>(card_id, reader.readEnum<shared::CardAccess>());
+                break;
+            }
+        case DecisionTag::BUY_CARD:
+            decision = std::make_unique<BuyCardDecision>(reader.readCard());
+            break;
+        case DecisionTag::END_ACTION_PHASE:
+            decision = std::make_unique<EndActionPhaseDecision>();
+            break;
+        case DecisionTag::END_TURN:
+            decision = std::make_unique<EndTurnDecision>();
+            break;
+        case DecisionTag::DECK_CHOICE:
+            {
+                std::vector<shared::CardBase::id_t> cards = reader.readCards();
+                decision = std::make_unique<DeckChoiceDecision>(
+                        cards, reader.readEnums<shared::ChooseFromOrder::AllowedChoice>());
+                break;
+            }
+        case DecisionTag::BOARD_CHOICE:
+            decision = std::make_unique<GainFromBoardDecision>(reader.readCard());
+            break;
+        default:
+            throw exception::MalformedMessage("Unknown decision tag " +
+                                              std::to_string(static_cast<unsigned int>(tag)));
+    }
+
+    return std::make_unique<ActionDecisionMessage>(game_id, player_id, std::move(decision), in_response_to,
+                                                   message_id);
+}
+
+static std::unique_ptr<ClientToServerMessage> parseClientToServerMessage(BinaryReader &reader)
+{
+    if ( reader.readByte() != BINARY_MAGIC ) {
+        throw exception::MalformedMessage("Missing binary magic byte");
+    }
+    const auto tag = reader.readEnum<MessageTag>();
+    std::string game_id = reader.readString();
+    std::string message_id = reader.readString();
+    std::string player_id = reader.readString();
+
+    switch ( tag ) {
+        case MessageTag::GAME_STATE_REQUEST:
+            return std::make_unique<GameStateRequestMessage>(game_id, player_id, message_id);
+        case MessageTag::CREATE_LOBBY_REQUEST:
+            return std::make_unique<CreateLobbyRequestMessage>(game_id, player_id, message_id);
+        case MessageTag::JOIN_LOBBY_REQUEST:
+            return std::make_unique<JoinLobbyRequestMessage>(game_id, player_id, message_id);
+        case MessageTag::START_GAME_REQUEST:
+            return parseStartGameRequest(reader, game_id, player_id, message_id);
+        case MessageTag::ACTION_DECISION:
+            return parseActionDecision(reader, game_id, player_id, message_id);
+        default:
+            throw exception::MalformedMessage("Unknown message tag " +
+                                              std::to_string(static_cast<unsigned int>(tag)));
+    }
+}
+
+namespace shared
+{
+    /**
+     * @brief Runs the parser over the whole payload. Malformed payloads, including ones with trailing bytes, are
+     * logged and turned into nullptr like invalid JSON.
+     */
+    template <typename Result, typename Parser>
+    static std::unique_ptr<Result> parseBinary(std::string_view binary, Parser parser)
+    {
+        try {
+            BinaryReader reader(binary);
+            std::unique_ptr<Result> message = parser(reader);
+            if ( !reader.atEnd() ) {
+                throw exception::MalformedMessage(std::to_string(reader.remaining()) + " trailing bytes");
+            }
+            return message;
+        } catch ( const exception::MalformedMessage &e ) {
+            LOG(WARN) << "Malformed binary message: " << e.what();
+            return nullptr;
+        }
+    }
+
+    std::unique_ptr<ServerToClientMessage> ServerToClientMessage::fromBinary(std::string_view binary)
+    {
+        return parseBinary<ServerToClientMessage>(binary, parseServerToClientMessage);
+    }
+
+    std::unique_ptr<ServerToClientMessage> ServerToClientMessage::decode(std::string_view payload)
+    {
+        return detectWireFormat(payload) == WireFormat::BINARY ? fromBinary(payload) : fromJson(payload);
+    }
+
+    std::unique_ptr<ClientToServerMessage> ClientToServerMessage::fromBinary(std::string_view binary)
+    {
+        return parseBinary<ClientToServerMessage>(binary, parseClientToServerMessage);
+    }
+
+    std::unique_ptr<ClientToServerMessage> ClientToServerMessage::decode(std::string_view payload)
+    {
+        return detectWireFormat(payload) == WireFormat::BINARY ? fromBinary(payload) : fromJson(payload);
+    }
+
+    std::unique_ptr<ClientToServerMessage> ClientToServerMessage::decodeInSitu(std::span<char> payload,
+                                                                               InSituJsonParser &parser)
+    {
+        const std::string_view view(payload.data(), payload.size());
+        return detectWireFormat(view) == WireFormat::BINARY ? fromBinary(view)
+                                                            : fromJsonInSitu(payload.data(), parser);
+    }
+} // namespace shared
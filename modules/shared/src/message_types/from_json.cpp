@@ -32,7 +32,33 @@ static std::unique_ptr<GameStateMessage> parseGameStateMessage(const Document &j
 
     GET_OPTIONAL_STRING_MEMBER(in_response_to, json, "in_response_to");
 
-    return std::make_unique<GameStateMessage>(game_id, std::move(game_state), in_response_to, message_id);
+    auto message = std::make_unique<GameStateMessage>(game_id, std::move(game_state), in_response_to, message_id);
+    // older senders do not version their states
+    if ( json.HasMember("version") ) {
+        GET_UINT_MEMBER(message->version, json, "version");
+    }
+    return message;
+}
+
+static std::unique_ptr<GameStateDeltaMessage> parseGameStateDelta(const Document &json, const std::string &game_id,
+                                                                  const std::string &message_id)
+{
+    unsigned int base_version;
+    GET_UINT_MEMBER(base_version, json, "base_version");
+    unsigned int version;
+    GET_UINT_MEMBER(version, json, "version");
+
+    if ( !json.HasMember("delta") ) {
+        LOG(WARN) << "GameStateDeltaMessage: No delta member";
+        return nullptr;
+    }
+    std::unique_ptr<reduced::GameState::Delta> delta = reduced::GameState::Delta::fromJson(json["delta"]);
+    if ( delta == nullptr ) {
+        LOG(WARN) << "GameStateDeltaMessage: Could not parse delta";
+        return nullptr;
+    }
+
+    return std::make_unique<GameStateDeltaMessage>(game_id, base_version, version, std::move(delta), message_id);
 }
 
 static std::unique_ptr<CreateLobbyResponseMessage>
@@ -73,8 +99,12 @@ static std::unique_ptr<EndGameBroadcastMessage> parseEndGameBroadcast(const Docu
         GET_INT_MEMBER(score, result, "score");
         results.emplace_back(player_id, score);
     }
+    // seeds use all 64 bits, GET_UINT_MEMBER only reads 32
+    if ( !json.HasMember("seed") || !json["seed"].IsUint64() ) {
+        return nullptr;
+    }
 
-    return std::make_unique<EndGameBroadcastMessage>(game_id, results, message_id);
+    return std::make_unique<EndGameBroadcastMessage>(game_id, results, json["seed"].GetUint64(), message_id);
 }
 
 static std::unique_ptr<ResultResponseMessage> parseResultResponse(const Document &json, const std::string &game_id,
@@ -115,10 +145,10 @@ static std::unique_ptr<ActionOrderMessage> parseActionOrder(const Document &json
 
 namespace shared
 {
-    std::unique_ptr<ServerToClientMessage> ServerToClientMessage::fromJson(const std::string &json)
+    std::unique_ptr<ServerToClientMessage> ServerToClientMessage::fromJson(std::string_view json)
     {
         Document doc;
-        doc.Parse(json.c_str());
+        doc.Parse(json.data(), json.size());
 
         if ( doc.HasParseError() ) {
             return nullptr;
@@ -133,6 +163,8 @@ namespace shared
         GET_STRING_MEMBER(type, doc, "type");
         if ( type == "game_state" ) {
             return parseGameStateMessage(doc, game_id, message_id);
+        } else if ( type == "game_state_delta" ) {
+            return parseGameStateDelta(doc, game_id, message_id);
         } else if ( type == "initiate_game_response" ) {
             return parseCreateLobbyResponse(doc, game_id, message_id);
         } else if ( type == "join_game_broadcast" ) {
@@ -151,7 +183,7 @@ namespace shared
     }
 } // namespace shared
 
-static std::unique_ptr<GameStateRequestMessage> parseGameStateRequest(const Document & /*json*/,
+static std::unique_ptr<GameStateRequestMessage> parseGameStateRequest(const Value & /*json*/,
                                                                       const std::string &game_id,
                                                                       const PlayerBase::id_t &player_id,
                                                                       const std::string &message_id)
@@ -159,7 +191,7 @@ static std::unique_ptr<GameStateRequestMessage> parseGameStateRequest(const Docu
     return std::make_unique<GameStateRequestMessage>(game_id, player_id, message_id);
 }
 
-static std::unique_ptr<CreateLobbyRequestMessage> parseCreateLobbyRequest(const Document & /*json*/,
+static std::unique_ptr<CreateLobbyRequestMessage> parseCreateLobbyRequest(const Value & /*json*/,
                                                                           const std::string &game_id,
                                                                           const PlayerBase::id_t &player_id,
                                                                           const std::string &message_id)
@@ -167,7 +199,7 @@ static std::unique_ptr<CreateLobbyRequestMessage> parseCreateLobbyRequest(const
     return std::make_unique<CreateLobbyRequestMessage>(game_id, player_id, message_id);
 }
 
-static std::unique_ptr<JoinLobbyRequestMessage> parseJoinGameRequest(const Document & /*json*/,
+static std::unique_ptr<JoinLobbyRequestMessage> parseJoinGameRequest(const Value & /*json*/,
                                                                      const std::string &game_id,
                                                                      const PlayerBase::id_t &player_id,
                                                                      const std::string &message_id)
@@ -175,7 +207,7 @@ static std::unique_ptr<JoinLobbyRequestMessage> parseJoinGameRequest(const Docum
     return std::make_unique<JoinLobbyRequestMessage>(game_id, player_id, message_id);
 }
 
-static std::unique_ptr<StartGameRequestMessage> parseStartGameRequest(const Document &json, const std::string &game_id,
+static std::unique_ptr<StartGameRequestMessage> parseStartGameRequest(const Value &json, const std::string &game_id,
                                                                       const PlayerBase::id_t &player_id,
                                                                       const std::string &message_id)
 {
@@ -188,7 +220,7 @@ static std::unique_ptr<StartGameRequestMessage> parseStartGameRequest(const Docu
     return std::make_unique<StartGameRequestMessage>(game_id, player_id, selected_cards, message_id);
 }
 
-static std::unique_ptr<ActionDecisionMessage> parseActionDecision(const Document &json, const std::string &game_id,
+static std::unique_ptr<ActionDecisionMessage> parseActionDecision(const Value &json, const std::string &game_id,
                                                                   const PlayerBase::id_t &player_id,
                                                                   const std::string &message_id)
 {
@@ -196,7 +228,7 @@ static std::unique_ptr<ActionDecisionMessage> parseActionDecision(const Document
     GET_OPTIONAL_STRING_MEMBER(in_response_to, json, "in_response_to");
 
     ActionDecision *decision = nullptr;
-    std::string action;
+    std::string_view action;
     GET_STRING_MEMBER(action, json, "action");
     if ( action == "play_action_card" ) {
         shared::CardBase::id_t card_id;
@@ -235,15 +267,12 @@ static std::unique_ptr<ActionDecisionMessage> parseActionDecision(const Document
 
 namespace shared
 {
-    std::unique_ptr<ClientToServerMessage> ClientToServerMessage::fromJson(const std::string &json)
+    /**
+     * @brief Reads the message out of a parsed document. Only the fields the message keeps are copied, everything else
+     * is looked at in place.
+     */
+    static std::unique_ptr<ClientToServerMessage> parseClientToServerMessage(const Value &doc)
     {
-        Document doc;
-        doc.Parse(json.c_str());
-
-        if ( doc.HasParseError() ) {
-            return nullptr;
-        }
-
         std::string game_id;
         GET_STRING_MEMBER(game_id, doc, "game_id");
         std::string message_id;
@@ -251,7 +280,7 @@ namespace shared
         std::string player_id;
         GET_STRING_MEMBER(player_id, doc, "player_id");
 
-        std::string type;
+        std::string_view type;
         GET_STRING_MEMBER(type, doc, "type");
         if ( type == "game_state_request" ) {
             return parseGameStateRequest(doc, game_id, player_id, message_id);
@@ -267,4 +296,24 @@ namespace shared
             return nullptr;
         }
     }
+
+    std::unique_ptr<ClientToServerMessage> ClientToServerMessage::fromJson(std::string_view json)
+    {
+        Document doc;
+        doc.Parse(json.data(), json.size());
+
+        if ( doc.HasParseError() ) {
+            return nullptr;
+        }
+        return parseClientToServerMessage(doc);
+    }
+
+    std::unique_ptr<ClientToServerMessage> ClientToServerMessage::fromJsonInSitu(char *json, InSituJsonParser &parser)
+    {
+        const InSituJsonParser::Document *doc = parser.parse(json);
+        if ( doc == nullptr ) {
+            return nullptr;
+        }
+        return parseClientToServerMessage(*doc);
+    }
 } // namespace shared
@@ -34,7 +34,7 @@ namespace shared
     StartGameRequestMessage::StartGameRequestMessage(std::string game_id, PlayerBase::id_t player_id,
                                                      std::vector<CardBase::id_t> selected_cards,
                                                      std::string message_id) :
-        ClientToServerMessage(game_id, player_id, message_id),
+        ClientToServerMessage(TAG, game_id, player_id, message_id),
         selected_cards(selected_cards)
     {
         // Due to a bug in the assert macro we need to cast the size to int
@@ -64,9 +64,14 @@ namespace shared
 
     bool GameStateMessage::operator==(const GameStateMessage &other) const
     {
-        return ServerToClientMessage::operator==(other) && this->in_response_to == other.in_response_to /* TODO:
-                reenable && this->game_state == other.game_state */
-                ;
+        return ServerToClientMessage::operator==(other) && this->in_response_to == other.in_response_to &&
+                this->version == other.version /* TODO: reenable && this->game_state == other.game_state */;
+    }
+
+    bool GameStateDeltaMessage::operator==(const GameStateDeltaMessage &other) const
+    {
+        return ServerToClientMessage::operator==(other) && this->base_version == other.base_version &&
+                this->version == other.version && *this->delta == *other.delta;
     }
 
     bool CreateLobbyResponseMessage::operator==(const CreateLobbyResponseMessage &other) const
@@ -89,7 +94,7 @@ namespace shared
 
     bool EndGameBroadcastMessage::operator==(const EndGameBroadcastMessage &other) const
     {
-        return ServerToClientMessage::operator==(other) && this->results == other.results;
+        return ServerToClientMessage::operator==(other) && this->results == other.results && this->seed == other.seed;
     }
 
     bool ResultResponseMessage::operator==(const ResultResponseMessage &other) const
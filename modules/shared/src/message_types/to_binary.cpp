@@ -0,0 +1,158 @@
+#include <shared/message_types.h>
+#include <shared/utils/binary.h>
+
+namespace
+{
+    using namespace shared;
+
+    // enough for everything but game states, which reserve more
+    constexpr size_t SMALL_MESSAGE_SIZE = 128;
+    constexpr size_t GAME_STATE_MESSAGE_SIZE = 512;
+
+    BinaryWriter writerFromMsg(const Message &msg, size_t reserve = SMALL_MESSAGE_SIZE)
+    {
+        BinaryWriter writer(reserve);
+        writer.writeByte(BINARY_MAGIC);
+        writer.writeEnum(msg.getTag());
+        writer.writeString(msg.game_id);
+        writer.writeString(msg.message_id);
+        return writer;
+    }
+
+    BinaryWriter writerFromServerToClientMsg(const ServerToClientMessage &msg, size_t reserve = SMALL_MESSAGE_SIZE)
+    {
+        return writerFromMsg(msg, reserve);
+    }
+
+    BinaryWriter writerFromClientToServerMsg(const ClientToServerMessage &msg)
+    {
+        BinaryWriter writer = writerFromMsg(msg);
+        writer.writeString(msg.player_id);
+        return writer;
+    }
+} // namespace
+
+namespace shared
+{
+
+    // ======= SERVER TO CLIENT MESSAGES ======= //
+
+    std::string GameStateMessage::toBinary() const
+    {
+        BinaryWriter writer = writerFromServerToClientMsg(*this, GAME_STATE_MESSAGE_SIZE);
+        this->game_state->toBinary(writer);
+        writer.writeOptionalString(this->in_response_to);
+        writer.writeUint(this->version);
+        return writer.release();
+    }
+
+    std::string GameStateDeltaMessage::toBinary() const
+    {
+        BinaryWriter writer = writerFromServerToClientMsg(*this);
+        writer.writeUint(this->base_version);
+        writer.writeUint(this->version);
+        this->delta->toBinary(writer);
+        return writer.release();
+    }
+
+    std::string CreateLobbyResponseMessage::toBinary() const
+    {
+        BinaryWriter writer = writerFromServerToClientMsg(*this);
+        writer.writeOptionalString(this->in_response_to);
+        writer.writeCards(this->available_cards);
+        return writer.release();
+    }
+
+    std::string JoinLobbyBroadcastMessage::toBinary() const
+    {
+        BinaryWriter writer = writerFromServerToClientMsg(*this);
+        writer.writeStrings(this->players);
+        return writer.release();
+    }
+
+    std::string StartGameBroadcastMessage::toBinary() const
+    {
+        return writerFromServerToClientMsg(*this).release();
+    }
+
+    std::string EndGameBroadcastMessage::toBinary() const
+    {
+        BinaryWriter writer = writerFromServerToClientMsg(*this);
+        writer.writeUint(this->results.size());
+        for ( const auto &result : this->results ) {
+            writer.writeString(result.playerName());
+            writer.writeInt(result.score());
+        }
+        writer.writeUint(this->seed);
+        return writer.release();
+    }
+
+    std::string ResultResponseMessage::toBinary() const
+    {
+        BinaryWriter writer = writerFromServerToClientMsg(*this);
+        writer.writeOptionalString(this->in_response_to);
+        writer.writeBool(this->success);
+        writer.writeOptionalString(this->additional_information);
+        return writer.release();
+    }
+
+    std::string ActionOrderMessage::toBinary() const
+    {
+        BinaryWriter writer = writerFromServerToClientMsg(*this, GAME_STATE_MESSAGE_SIZE);
+        this->order->toBinary(writer);
+        this->game_state->toBinary(writer);
+        writer.writeOptionalString(this->description);
+        return writer.release();
+    }
+
+    // ======= CLIENT TO SERVER MESSAGES ======= //
+
+    std::string GameStateRequestMessage::toBinary() const
+    {
+        return writerFromClientToServerMsg(*this).release();
+    }
+
+    std::string CreateLobbyRequestMessage::toBinary() const
+    {
+        return writerFromClientToServerMsg(*this).release();
+    }
+
+    std::string JoinLobbyRequestMessage::toBinary() const
+    {
+        return writerFromClientToServerMsg(*this).release();
+    }
+
+    std::string StartGameRequestMessage::toBinary() const
+    {
+        BinaryWriter writer = writerFromClientToServerMsg(*this);
+        writer.writeCards(this->selected_cards);
+        return writer.release();
+    }
+
+    std::string ActionDecisionMessage::toBinary() const
+    {
+        BinaryWriter writer = writerFromClientToServerMsg(*this);
+        writer.writeOptionalString(this->in_response_to);
+
+        writer.writeEnum(this->decision->getTag());
+        visit(*this->decision,
+              Overloaded{[&writer](const PlayActionCardDecision &play_action_card)
+                         {
+                             writer.writeCard(play_action_card.card_id);
+                             writer.writeEnum(play_action_card.from);
+                         },
+                         [&writer](const BuyCardDecision &buy_card) { writer.writeCard(buy_card.card); },
+                         [&writer](const DeckChoiceDecision &deck_choice)
+                         {
+                             writer.writeCards(deck_choice.cards);
+                             writer.writeEnums(deck_choice.choices);
+                         },
+                         [&writer](const GainFromBoardDecision &board_choice)
+                         { writer.writeCard(board_choice.chosen_card); },
+                         // the tag is all there is to the others
+                         [](const ActionDecision &) {}});
+
+        return writer.release();
+    }
+
+} // namespace shared
@@ -1,41 +1,50 @@
 
 #include <memory>
-
-#include <rapidjson/document.h>
-#include <rapidjson/stringbuffer.h>
-#include <rapidjson/writer.h>
+#include <string_view>
 
 #include <shared/message_types.h>
-#include <shared/utils/assert.h>
 #include <shared/utils/json.h>
 #include "shared/action_order.h"
 
-using namespace rapidjson;
-
-Document documentFromMsg(const std::string &type, const shared::Message &msg)
+namespace
 {
-    Document doc;
-    doc.SetObject();
+    using namespace shared;
 
-    ADD_STRING_MEMBER(type.c_str(), type);
-    ADD_STRING_MEMBER(msg.game_id.c_str(), game_id);
-    ADD_STRING_MEMBER(msg.message_id.c_str(), message_id);
-
-    return doc;
-}
+    void writeMsgHeader(JsonWriter &writer, std::string_view type, const Message &msg)
+    {
+        WRITE_STRING_MEMBER(type, type);
+        WRITE_STRING_MEMBER(msg.game_id, game_id);
+        WRITE_STRING_MEMBER(msg.message_id, message_id);
+    }
 
-Document documentFromServerToClientMsg(const std::string &type, const shared::ServerToClientMessage &msg)
-{
-    return documentFromMsg(type, msg);
-}
+    void writeMsgHeader(JsonWriter &writer, std::string_view type, const ClientToServerMessage &msg)
+    {
+        writeMsgHeader(writer, type, static_cast<const Message &>(msg));
+        WRITE_STRING_MEMBER(msg.player_id, player_id);
+    }
 
-Document documentFromClientToServerMsg(const std::string &type, const shared::ClientToServerMessage &msg)
-{
-    Document doc = documentFromMsg(type, msg);
-    ADD_STRING_MEMBER(msg.player_id.c_str(), player_id);
-    return doc;
-}
+    /**
+     * @brief Streams the message object: the header members first, then what body writes.
+     */
+    template <typename Msg, typename Body>
+    std::string jsonFromMsg(std::string_view type, const Msg &msg, Body &&body)
+    {
+        return writeJson(
+                [&](JsonWriter &writer)
+                {
+                    writer.StartObject();
+                    writeMsgHeader(writer, type, msg);
+                    body(writer);
+                    writer.EndObject();
+                });
+    }
 
+    template <typename Msg>
+    std::string jsonFromMsg(std::string_view type, const Msg &msg)
+    {
+        return jsonFromMsg(type, msg, [](JsonWriter & /*writer*/) {});
+    }
+} // namespace
 
 namespace shared
 {
@@ -44,138 +53,135 @@ namespace shared
 
     std::string GameStateMessage::toJson() const
     {
-        Document doc = documentFromServerToClientMsg("game_state", *this);
-
-        Document game_state_doc = this->game_state->toJson();
-        Value game_state_value;
-        game_state_value.CopyFrom(game_state_doc, doc.GetAllocator());
-        doc.AddMember("game_state", game_state_value, doc.GetAllocator());
+        return jsonFromMsg("game_state", *this,
+                           [this](JsonWriter &writer)
+                           {
+                               WRITE_OBJECT_MEMBER(*this->game_state, game_state);
+                               WRITE_OPTIONAL_STRING_MEMBER(this->in_response_to, in_response_to);
+                               WRITE_UINT_MEMBER(this->version, version);
+                           });
+    }
 
-        ADD_OPTIONAL_STRING_MEMBER(this->in_response_to, in_response_to);
-        return documentToString(doc);
+    std::string GameStateDeltaMessage::toJson() const
+    {
+        return jsonFromMsg("game_state_delta", *this,
+                           [this](JsonWriter &writer)
+                           {
+                               WRITE_UINT_MEMBER(this->base_version, base_version);
+                               WRITE_UINT_MEMBER(this->version, version);
+                               WRITE_OBJECT_MEMBER(*this->delta, delta);
+                           });
     }
 
     std::string CreateLobbyResponseMessage::toJson() const
     {
-        Document doc = documentFromServerToClientMsg("initiate_game_response", *this);
-        ADD_OPTIONAL_STRING_MEMBER(this->in_response_to, in_response_to);
-        ADD_ARRAY_OF_STRINGS_MEMBER(this->available_cards, available_cards);
-        return documentToString(doc);
+        return jsonFromMsg("initiate_game_response", *this,
+                           [this](JsonWriter &writer)
+                           {
+                               WRITE_OPTIONAL_STRING_MEMBER(this->in_response_to, in_response_to);
+                               WRITE_ARRAY_OF_STRINGS_MEMBER(this->available_cards, available_cards);
+                           });
     }
 
     std::string JoinLobbyBroadcastMessage::toJson() const
     {
-        Document doc = documentFromServerToClientMsg("join_game_broadcast", *this);
-        ADD_ARRAY_OF_STRINGS_MEMBER(this->players, players);
-        return documentToString(doc);
+        return jsonFromMsg("join_game_broadcast", *this,
+                           [this](JsonWriter &writer) { WRITE_ARRAY_OF_STRINGS_MEMBER(this->players, players); });
     }
 
-    std::string StartGameBroadcastMessage::toJson() const
-    {
-        Document doc = documentFromServerToClientMsg("start_game_broadcast", *this);
-        return documentToString(doc);
-    }
+    std::string StartGameBroadcastMessage::toJson() const { return jsonFromMsg("start_game_broadcast", *this); }
 
     std::string EndGameBroadcastMessage::toJson() const
     {
-        Document doc = documentFromServerToClientMsg("end_game_broadcast", *this);
-
-        Value results(kArrayType);
-        for ( const auto &result : this->results ) {
-            Value result_json(kObjectType);
-            result_json.AddMember("player_id", Value().SetString(result.playerName().c_str(), doc.GetAllocator()),
-                                  doc.GetAllocator());
-            result_json.AddMember("score", Value().SetInt(result.score()), doc.GetAllocator());
-            results.PushBack(result_json, doc.GetAllocator());
-        }
-        doc.AddMember("results", results, doc.GetAllocator());
-
-        return documentToString(doc);
+        return jsonFromMsg("end_game_broadcast", *this,
+                           [this](JsonWriter &writer)
+                           {
+                               WRITE_KEY(results);
+                               writer.StartArray();
+                               for ( const auto &result : this->results ) {
+                                   writer.StartObject();
+                                   WRITE_STRING_MEMBER(result.playerName(), player_id);
+                                   WRITE_INT_MEMBER(result.score(), score);
+                                   writer.EndObject();
+                               }
+                               writer.EndArray();
+                               WRITE_KEY(seed);
+                               writer.Uint64(this->seed);
+                           });
     }
 
     std::string ResultResponseMessage::toJson() const
     {
-        Document doc = documentFromServerToClientMsg("result_response", *this);
-        ADD_OPTIONAL_STRING_MEMBER(this->in_response_to, in_response_to);
-        ADD_BOOL_MEMBER(this->success, success);
-        ADD_OPTIONAL_STRING_MEMBER(this->additional_information, additional_information);
-        return documentToString(doc);
+        return jsonFromMsg("result_response", *this,
+                           [this](JsonWriter &writer)
+                           {
+                               WRITE_OPTIONAL_STRING_MEMBER(this->in_response_to, in_response_to);
+                               WRITE_BOOL_MEMBER(this->success, success);
+                               WRITE_OPTIONAL_STRING_MEMBER(this->additional_information, additional_information);
+                           });
     }
 
     std::string ActionOrderMessage::toJson() const
     {
-        Document doc = documentFromServerToClientMsg("action_order", *this);
-
-        Document order_json = this->order->toJson();
-        doc.AddMember("order", order_json, doc.GetAllocator());
-
-        Document game_state_json = this->game_state->toJson();
-        doc.AddMember("game_state", game_state_json, doc.GetAllocator());
-
-        ADD_OPTIONAL_STRING_MEMBER(this->description, description);
-        return documentToString(doc);
+        return jsonFromMsg("action_order", *this,
+                           [this](JsonWriter &writer)
+                           {
+                               WRITE_OBJECT_MEMBER(*this->order, order);
+                               WRITE_OBJECT_MEMBER(*this->game_state, game_state);
+                               WRITE_OPTIONAL_STRING_MEMBER(this->description, description);
+                           });
     }
 
     // ======= CLIENT TO SERVER MESSAGES ======= //
 
-    std::string GameStateRequestMessage::toJson() const
-    {
-        Document doc = documentFromClientToServerMsg("game_state_request", *this);
-        return documentToString(doc);
-    }
+    std::string GameStateRequestMessage::toJson() const { return jsonFromMsg("game_state_request", *this); }
 
-    std::string CreateLobbyRequestMessage::toJson() const
-    {
-        Document doc = documentFromClientToServerMsg("initiate_game_request", *this);
-        return documentToString(doc);
-    }
+    std::string CreateLobbyRequestMessage::toJson() const { return jsonFromMsg("initiate_game_request", *this); }
 
-    std::string JoinLobbyRequestMessage::toJson() const
-    {
-        Document doc = documentFromClientToServerMsg("join_game_request", *this);
-        return documentToString(doc);
-    }
+    std::string JoinLobbyRequestMessage::toJson() const { return jsonFromMsg("join_game_request", *this); }
 
     std::string StartGameRequestMessage::toJson() const
     {
-        Document doc = documentFromClientToServerMsg("start_game_request", *this);
-        ADD_ARRAY_OF_STRINGS_MEMBER(this->selected_cards, selected_cards);
-        return documentToString(doc);
+        return jsonFromMsg("start_game_request", *this,
+                           [this](JsonWriter &writer)
+                           { WRITE_ARRAY_OF_STRINGS_MEMBER(this->selected_cards, selected_cards); });
     }
 
     std::string ActionDecisionMessage::toJson() const
     {
-        Document doc = documentFromClientToServerMsg("action_decision", *this);
-
-        ADD_OPTIONAL_STRING_MEMBER(this->in_response_to, in_response_to);
-
-        ActionDecision *action_decision = this->decision.get();
-        if ( PlayActionCardDecision *play_action_card = dynamic_cast<PlayActionCardDecision *>(action_decision) ) {
-            ADD_STRING_MEMBER("play_action_card", action);
-            ADD_STRING_MEMBER(play_action_card->card_id.c_str(), card_id);
-            ADD_ENUM_MEMBER(play_action_card->from, from);
-        } else if ( BuyCardDecision *buy_card = dynamic_cast<BuyCardDecision *>(action_decision) ) {
-            ADD_STRING_MEMBER("buy_card", action);
-            ADD_STRING_MEMBER(buy_card->card.c_str(), card);
-        } else if ( dynamic_cast<EndActionPhaseDecision *>(action_decision) != nullptr ) {
-            ADD_STRING_MEMBER("end_action_phase", action);
-        } else if ( dynamic_cast<EndTurnDecision *>(action_decision) != nullptr ) {
-            ADD_STRING_MEMBER("end_turn", action);
-        } else if ( DeckChoiceDecision *deck_choice = dynamic_cast<DeckChoiceDecision *>(action_decision) ) {
-            ADD_STRING_MEMBER("deck_choice", action);
-            ADD_ARRAY_OF_STRINGS_MEMBER(deck_choice->cards, cards);
-            ADD_ARRAY_OF_ENUMS_MEMBER(deck_choice->choices, choices, ChooseFromHandOrder::AllowedChoice);
-        } else if ( GainFromBoardDecision *board_choice = dynamic_cast<GainFromBoardDecision *>(action_decision) ) {
-            ADD_STRING_MEMBER("board_choice", action);
-            ADD_STRING_MEMBER(board_choice->chosen_card.c_str(), chosen_card);
-        }
-
-        else {
-            // This code should be unreachable
-            _ASSERT_TRUE(false, "Unknown decision type");
-        }
-
-        return documentToString(doc);
+        return jsonFromMsg(
+                "action_decision", *this,
+                [this](JsonWriter &writer)
+                {
+                    WRITE_OPTIONAL_STRING_MEMBER(this->in_response_to, in_response_to);
+
+                    visit(*this->decision,
+                          Overloaded{[&writer](const PlayActionCardDecision &play_action_card)
+                                     {
+                                         WRITE_STRING_MEMBER("play_action_card", action);
+                                         WRITE_STRING_MEMBER(play_action_card.card_id, card_id);
+                                         WRITE_ENUM_MEMBER(play_action_card.from, from);
+                                     },
+                                     [&writer](const BuyCardDecision &buy_card)
+                                     {
+                                         WRITE_STRING_MEMBER("buy_card", action);
+                                         WRITE_STRING_MEMBER(buy_card.card, card);
+                                     },
+                                     [&writer](const EndActionPhaseDecision &)
+                                     { WRITE_STRING_MEMBER("end_action_phase", action); },
+                                     [&writer](const EndTurnDecision &) { WRITE_STRING_MEMBER("end_turn", action); },
+                                     [&writer](const DeckChoiceDecision &deck_choice)
+                                     {
+                                         WRITE_STRING_MEMBER("deck_choice", action);
+                                         WRITE_ARRAY_OF_STRINGS_MEMBER(deck_choice.cards, cards);
+                                         WRITE_ARRAY_OF_ENUMS_MEMBER(deck_choice.choices, choices);
+                                     },
+                                     [&writer](const GainFromBoardDecision &board_choice)
+                                     {
+                                         WRITE_STRING_MEMBER("board_choice", action);
+                                         WRITE_STRING_MEMBER(board_choice.chosen_card, chosen_card);
+                                     }});
+                });
     }
 
 } // namespace shared
@@ -0,0 +1,190 @@
+#include <limits>
+
+#include <shared/game/cards/card_factory.h>
+#include <shared/utils/binary.h>
+
+namespace shared
+{
+    namespace
+    {
+        // a uint64_t needs at most 10 groups of 7 bits
+        constexpr size_t MAX_VARINT_BYTES = 10;
+        // card 0 is reserved for ids that are not registered, these are followed by the id as string
+        constexpr uint64_t UNKNOWN_CARD = 0;
+    } // namespace
+
+    WireFormat detectWireFormat(std::string_view payload)
+    {
+        return !payload.empty() && static_cast<uint8_t>(payload.front()) == BINARY_MAGIC ? WireFormat::BINARY
+                                                                                          : WireFormat::JSON;
+    }
+
+    std::ostream &operator<<(std::ostream &os, const LoggablePayload &loggable)
+    {
+        if ( detectWireFormat(loggable.payload) == WireFormat::BINARY ) {
+            return os << "<binary message, " << loggable.payload.size() << " bytes>";
+        }
+        return os << loggable.payload;
+    }
+
+    // ======= WRITER ======= //
+
+    void BinaryWriter::writeUint(uint64_t value)
+    {
+        while ( value >= 0x80 ) {
+            writeByte(static_cast<uint8_t>(value) | 0x80);
+            value >>= 7;
+        }
+        writeByte(static_cast<uint8_t>(value));
+    }
+
+    void BinaryWriter::writeInt(int64_t value)
+    {
+        // zigzag, small negative numbers stay small
+        writeUint((static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+    }
+
+    void BinaryWriter::writeString(std::string_view value)
+    {
+        writeUint(value.size());
+        buffer.append(value);
+    }
+
+    void BinaryWriter::writeOptionalString(const std::optional<std::string> &value)
+    {
+        writeBool(value.has_value());
+        if ( value.has_value() ) {
+            writeString(*value);
+        }
+    }
+
+    void BinaryWriter::writeStrings(const std::vector<std::string> &values)
+    {
+        writeUint(values.size());
+        for ( const auto &value : values ) {
+            writeString(value);
+        }
+    }
+
+    void BinaryWriter::writeCard(const CardBase::id_t &card_id)
+    {
+        const auto handle = CardFactory::findHandle(card_id);
+        if ( !handle.has_value() ) {
+            writeUint(UNKNOWN_CARD);
+            writeString(card_id);
+            return;
+        }
+        writeUint(toIndex(*handle) + 1);
+    }
+
+    void BinaryWriter::writeCards(const std::vector<CardBase::id_t> &card_ids)
+    {
+        writeUint(card_ids.size());
+        for ( const auto &card_id : card_ids ) {
+            writeCard(card_id);
+        }
+    }
+
+    // ======= READER ======= //
+
+    uint8_t BinaryReader::readByte()
+    {
+        if ( position >= input.size() ) {
+            throw exception::MalformedMessage("Unexpected end of message");
+        }
+        return static_cast<uint8_t>(input[position++]);
+    }
+
+    bool BinaryReader::readBool()
+    {
+        const uint8_t value = readByte();
+        if ( value > 1 ) {
+            throw exception::MalformedMessage("Invalid bool " + std::to_string(value));
+        }
+        return value == 1;
+    }
+
+    uint64_t BinaryReader::readUint()
+    {
+        uint64_t value = 0;
+        for ( size_t i = 0; i < MAX_VARINT_BYTES; ++i ) {
+            const uint8_t byte = readByte();
+            value |= static_cast<uint64_t>(byte & 0x7F) << (7 * i);
+            if ( (byte & 0x80) == 0 ) {
+                return value;
+            }
+        }
+        throw exception::MalformedMessage("Varint is too long");
+    }
+
+    int64_t BinaryReader::readInt()
+    {
+        const uint64_t value = readUint();
+        return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+    }
+
+    unsigned int BinaryReader::readUint32()
+    {
+        const uint64_t value = readUint();
+        if ( value > std::numeric_limits<unsigned int>::max() ) {
+            throw exception::MalformedMessage("Value " + std::to_string(value) + " is out of range");
+        }
+        return static_cast<unsigned int>(value);
+    }
+
+    size_t BinaryReader::readLength()
+    {
+        const uint64_t length = readUint();
+        // every element takes at least one byte
+        if ( length > remaining() ) {
+            throw exception::MalformedMessage("Length " + std::to_string(length) + " exceeds the message");
+        }
+        return static_cast<size_t>(length);
+    }
+
+    std::string BinaryReader::readString()
+    {
+        const size_t length = readLength();
+        std::string value(input.substr(position, length));
+        position += length;
+        return value;
+    }
+
+    std::optional<std::string> BinaryReader::readOptionalString()
+    {
+        if ( !readBool() ) {
+            return std::nullopt;
+        }
+        return readString();
+    }
+
+    std::vector<std::string> BinaryReader::readStrings()
+    {
+        std::vector<std::string> values(readLength());
+        for ( auto &value : values ) {
+            value = readString();
+        }
+        return values;
+    }
+
+    CardBase::id_t BinaryReader::readCard()
+    {
+        const uint64_t card = readUint();
+        if ( card == UNKNOWN_CARD ) {
+            return readString();
+        }
+        if ( card > CardFactory::size() ) {
+            throw exception::MalformedMessage("Unknown card handle " + std::to_string(card - 1));
+        }
+        return CardFactory::getId(static_cast<CardBase::handle_t>(card - 1));
+    }
+
+    std::vector<CardBase::id_t> BinaryReader::readCards()
+    {
+        std::vector<CardBase::id_t> card_ids(readLength());
+        for ( auto &card_id : card_ids ) {
+            card_id = readCard();
+        }
+        return card_ids;
+    }
+} // namespace shared
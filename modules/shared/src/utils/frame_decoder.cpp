@@ -0,0 +1,134 @@
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstring>
+
+#include <shared/utils/frame_decoder.h>
+#include <shared/utils/logger.h>
+
+namespace shared
+{
+    namespace
+    {
+        // longer than any length prefix that fits into a size_t
+        constexpr size_t MAX_LENGTH_DIGITS = 20;
+    } // namespace
+
+    std::string encodeFrame(std::string_view payload)
+    {
+        std::array<char, MAX_LENGTH_DIGITS> length;
+        const auto [length_end, error] = std::to_chars(length.begin(), length.end(), payload.size());
+
+        std::string frame;
+        frame.reserve((length_end - length.begin()) + 1 + payload.size());
+        frame.append(length.begin(), length_end);
+        frame.push_back(':');
+        frame.append(payload);
+        return frame;
+    }
+
+    char *FrameDecoder::prepare(size_t size)
+    {
+        restoreBorrowed();
+        if ( begin == end ) {
+            // nothing pending, start over at the front for free
+            begin = end = 0;
+        }
+
+        // one more byte than asked for, nextWritable terminates the last payload there
+        if ( buffer.size() - end <= size ) {
+            if ( begin > 0 ) {
+                // drop the consumed bytes before growing
+                std::memmove(buffer.data(), buffer.data() + begin, end - begin);
+                end -= begin;
+                begin = 0;
+            }
+            if ( buffer.size() - end <= size ) {
+                buffer.resize(std::max(buffer.size() * 2, end + size + 1));
+            }
+        }
+
+        return buffer.data() + end;
+    }
+
+    void FrameDecoder::commit(size_t size)
+    {
+        if ( !buffer.empty() ) {
+            end = std::min(end + size, buffer.size() - 1);
+        }
+    }
+
+    void FrameDecoder::feed(std::string_view data)
+    {
+        if ( data.empty() ) {
+            return;
+        }
+        std::memcpy(prepare(data.size()), data.data(), data.size());
+        commit(data.size());
+    }
+
+    std::optional<std::string_view> FrameDecoder::next()
+    {
+        const auto frame = nextWritable();
+        if ( !frame ) {
+            return std::nullopt;
+        }
+        return std::string_view(frame->data(), frame->size());
+    }
+
+    std::optional<std::span<char>> FrameDecoder::nextWritable()
+    {
+        restoreBorrowed();
+
+        const size_t available = end - begin;
+        if ( available == 0 ) {
+            return std::nullopt;
+        }
+        char *data = buffer.data() + begin;
+
+        // the separator has to come within the first few bytes, no need to scan a whole payload for it
+        auto *separator =
+                static_cast<char *>(std::memchr(data, ':', std::min(available, MAX_LENGTH_DIGITS + 1)));
+        if ( separator == nullptr ) {
+            if ( available > MAX_LENGTH_DIGITS ) {
+                LOG(ERROR) << "Malformed frame: Missing length separator ':'";
+                throw exception::MalformedFrame("Missing length separator ':'");
+            }
+            return std::nullopt;
+        }
+
+        size_t length = 0;
+        const auto [length_end, error] = std::from_chars(data, separator, length);
+        if ( error != std::errc() || length_end != separator ) {
+            LOG(ERROR) << "Malformed frame: Invalid length prefix";
+            throw exception::MalformedFrame("Invalid length prefix");
+        }
+        if ( length > max_frame_size ) {
+            LOG(ERROR) << "Malformed frame: " << length << " bytes exceed the maximum of " << max_frame_size;
+            throw exception::MalformedFrame("Frame of " + std::to_string(length) + " bytes exceeds the maximum of " +
+                                            std::to_string(max_frame_size));
+        }
+
+        const size_t header_size = separator + 1 - data;
+        if ( available - header_size < length ) {
+            // wait for the rest of the payload
+            return std::nullopt;
+        }
+
+        begin += header_size + length;
+
+        // there always is room after the buffered data, see prepare
+        borrowed = begin;
+        borrowed_byte = buffer[borrowed];
+        buffer[borrowed] = '\0';
+        return std::span<char>(separator + 1, length);
+    }
+
+    void FrameDecoder::restoreBorrowed()
+    {
+        if ( borrowed != NOTHING_BORROWED ) {
+            buffer[borrowed] = borrowed_byte;
+            borrowed = NOTHING_BORROWED;
+        }
+    }
+} // namespace shared
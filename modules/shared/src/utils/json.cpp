@@ -3,10 +3,45 @@
 #include <rapidjson/writer.h>
 #include <string>
 
+#include <shared/utils/json.h>
+
 std::string documentToString(const rapidjson::Document &doc)
 {
-    rapidjson::StringBuffer buffer;
-    rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
-    doc.Accept(writer);
-    return buffer.GetString();
+    return shared::writeJson([&doc](shared::JsonWriter &writer) { doc.Accept(writer); });
 }
+
+namespace shared
+{
+    // messages are a few KiB, a buffer that grew beyond this held a rare huge one
+    static constexpr size_t MAX_RETAINED_JSON_BUFFER = 64 * 1024;
+    // initial capacity of the parse stack, it grows inside the pool if a message nests deeper
+    static constexpr size_t PARSE_STACK_CAPACITY = 512;
+
+    InSituJsonParser::InSituJsonParser() :
+        pool(chunk, sizeof(chunk)), document(&pool, PARSE_STACK_CAPACITY, &pool)
+    {}
+
+    const InSituJsonParser::Document *InSituJsonParser::parse(char *json)
+    {
+        // values in a pool have nothing to destruct, dropping the previous document is just rewinding the pool
+        document.SetNull();
+        pool.Clear();
+
+        document.ParseInsitu(json);
+        return document.HasParseError() ? nullptr : &document;
+    }
+
+    rapidjson::StringBuffer &threadJsonBuffer()
+    {
+        thread_local rapidjson::StringBuffer buffer;
+        return buffer;
+    }
+
+    void releaseThreadJsonBuffer(rapidjson::StringBuffer &buffer)
+    {
+        if ( buffer.GetSize() > MAX_RETAINED_JSON_BUFFER ) {
+            buffer.Clear();
+            buffer.ShrinkToFit();
+        }
+    }
+} // namespace shared
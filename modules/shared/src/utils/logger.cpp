@@ -1,12 +1,17 @@
 
 #include <shared/utils/logger.h>
 
+#include <cerrno>
 #include <chrono>
+#include <cstring>
 #include <filesystem>
 #include <iomanip>
 #include <iostream>
 #include <stdexcept>
 
+#include <fcntl.h>
+#include <unistd.h>
+
 std::ostream &operator<<(std::ostream &os, const LogLevel &level)
 {
     os << shared::log_helpers::toString(level);
@@ -30,33 +35,83 @@ namespace shared
         }
     }
 
+    std::optional<LogModule> parseLogModule(const std::string &module)
+    {
+        if ( module == "general" ) {
+            return LogModule::GENERAL;
+        } else if ( module == "network" ) {
+            return LogModule::NETWORK;
+        } else if ( module == "lobby" ) {
+            return LogModule::LOBBY;
+        } else if ( module == "game" ) {
+            return LogModule::GAME;
+        } else if ( module == "behaviour" ) {
+            return LogModule::BEHAVIOUR;
+        } else {
+            return std::nullopt;
+        }
+    }
+
     // ================================
     // IMPLEMENTATION LogStream
     // ================================
     Logger::LogStream::LogStream(Logger &logger, LogLevel level, const char *file, int line) :
-        logger_(logger), level_(level)
+        logger_(logger)
     {
         ss_ << log_helpers::formatTimestamp() << " ";
         ss_ << log_helpers::formatLogLevel(level, logger_.log_to_file_) << " ";
         ss_ << log_helpers::formatFileLine(file, line) << " - ";
     }
 
-    Logger::LogStream::~LogStream() { logger_.writeLog(level_, ss_.str()); }
+    Logger::LogStream::~LogStream() { logger_.writeLog(std::move(ss_).str()); }
+
+    // ================================
+    // IMPLEMENTATION ThreadBuffer
+    // ================================
+    bool Logger::ThreadBuffer::tryPush(std::string &&line)
+    {
+        const size_t head = head_.load(std::memory_order_relaxed);
+        if ( head - tail_.load(std::memory_order_acquire) == CAPACITY ) {
+            return false;
+        }
+        slots_[head % CAPACITY] = std::move(line);
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    size_t Logger::ThreadBuffer::drainInto(std::string &batch)
+    {
+        const size_t head = head_.load(std::memory_order_acquire);
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        const size_t count = head - tail;
+        for ( ; tail != head; ++tail ) {
+            auto &slot = slots_[tail % CAPACITY];
+            batch += slot;
+            batch += '\n';
+            slot.clear();
+        }
+        tail_.store(tail, std::memory_order_release);
+        return count;
+    }
 
     // ================================
     // IMPLEMENTATION Logger
     // ================================
 
-    Logger::Logger() : min_log_level_(LogLevel::WARN), log_to_file_(false) {}
+    Logger::Logger() :
+        log_to_file_(false), output_fd_(STDERR_FILENO),
+        writer_([this]() { writerLoop(); })
+    {}
 
     Logger::~Logger()
     {
-        if ( log_file_.is_open() ) {
-            log_file_.flush();
-            if ( log_to_file_ ) {
-                log_file_ << "[INFO] - END LOG" << std::endl;
-            }
-            log_file_.close();
+        stopping_ = true;
+        wakeWriter();
+        writer_.join();
+
+        if ( output_fd_ != STDERR_FILENO ) {
+            writeOut("[INFO] - END LOG\n");
+            ::close(output_fd_);
         }
     }
 
@@ -83,56 +138,167 @@ namespace shared
 
     void Logger::writeTo(const std::string &file_path)
     {
-        std::lock_guard<std::mutex> lock(_init_mutex);
-        Logger &logger = getInstance();
+        // lines logged so far belong to the old output
+        flush();
 
-        if ( logger.log_file_.is_open() ) {
-            logger.log_file_.close();
-        }
+        Logger &logger = getInstance();
+        std::lock_guard<std::mutex> lock(_init_mutex);
 
+        int fd = STDERR_FILENO;
         if ( !file_path.empty() ) {
             std::filesystem::path log_path = file_path;
             if ( log_path.has_parent_path() ) {
                 std::filesystem::create_directories(log_path.parent_path());
             }
 
-            LOG(LogLevel::INFO) << "Logging to file: " << file_path;
-            logger.log_file_.open(file_path, std::ios::out | std::ios::app);
-            if ( !logger.log_file_ ) {
+            fd = ::open(file_path.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+            if ( fd < 0 ) {
                 throw exception::Logger("Failed to open log file: " + file_path);
             }
-            logger.log_to_file_ = true;
+        }
+
+        {
+            std::lock_guard<std::mutex> output_lock(logger.output_mutex_);
+            if ( logger.output_fd_ != STDERR_FILENO ) {
+                ::close(logger.output_fd_);
+            }
+            logger.output_fd_ = fd;
+        }
+        logger.log_to_file_ = !file_path.empty();
+
+        if ( !file_path.empty() ) {
+            LOG(LogLevel::INFO) << "Logging to file: " << file_path;
         } else {
-            logger.log_to_file_ = false;
             LOG(LogLevel::INFO) << "Logging to std::cerr.";
         }
     }
 
     void Logger::setLevel(LogLevel level)
     {
-        std::lock_guard<std::mutex> lock(_init_mutex);
-        Logger &logger = getInstance();
-        logger.min_log_level_ = level;
+        for ( auto &module_level : _module_levels ) {
+            module_level = level;
+        }
     }
 
-    LogLevel Logger::getLevel()
+    void Logger::setLevel(LogModule module, LogLevel level) { _module_levels[static_cast<size_t>(module)] = level; }
+
+    LogLevel Logger::getLevel(LogModule module) { return _module_levels[static_cast<size_t>(module)]; }
+
+    void Logger::flush()
     {
-        std::lock_guard<std::mutex> lock(_init_mutex);
         Logger &logger = getInstance();
-        return logger.min_log_level_;
+        const uint64_t target = logger.enqueued_.load();
+        logger.wakeWriter();
+
+        uint64_t written = logger.written_.load();
+        while ( written < target ) {
+            logger.written_.wait(written);
+            written = logger.written_.load();
+        }
     }
 
-    void Logger::writeLog(LogLevel level, const std::string &message)
+    uint64_t Logger::getDroppedCount() { return getInstance().dropped_.load(std::memory_order_relaxed); }
+
+    void Logger::writeLog(std::string &&message)
     {
-        if ( level < min_log_level_ ) {
-            return; // Do not log messages below the minimum log level
+        // the level was already checked by LOG
+        if ( !threadBuffer().tryPush(std::move(message)) ) {
+            // the writer will report it, blocking here would stall e.g. a network thread
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return;
         }
+        enqueued_.fetch_add(1);
+        wakeWriter();
+    }
 
-        std::lock_guard<std::mutex> lock(mutex_);
-        if ( log_to_file_ ) {
-            log_file_ << message << std::endl;
-        } else {
-            std::cerr << message << std::endl;
+    Logger::ThreadBuffer &Logger::threadBuffer()
+    {
+        struct Registration
+        {
+            std::shared_ptr<ThreadBuffer> buffer;
+            ~Registration()
+            {
+                if ( buffer ) {
+                    buffer->retired = true;
+                }
+            }
+        };
+        thread_local Registration registration;
+
+        if ( !registration.buffer ) {
+            registration.buffer = std::make_shared<ThreadBuffer>();
+            std::lock_guard<std::mutex> lock(buffers_mutex_);
+            buffers_.push_back(registration.buffer);
+        }
+        return *registration.buffer;
+    }
+
+    void Logger::wakeWriter()
+    {
+        wakeups_.fetch_add(1);
+        // a busy writer comes around anyway, so the syscall is only needed for an idle one
+        if ( writer_idle_.load() ) {
+            wakeups_.notify_one();
+        }
+    }
+
+    void Logger::writerLoop()
+    {
+        std::string batch;
+        uint64_t reported_drops = 0;
+
+        while ( true ) {
+            const uint32_t wakeups = wakeups_.load();
+            const bool stopping = stopping_.load();
+
+            size_t count = 0;
+            {
+                std::lock_guard<std::mutex> lock(buffers_mutex_);
+                for ( auto &buffer : buffers_ ) {
+                    count += buffer->drainInto(batch);
+                }
+                std::erase_if(buffers_, [](const auto &buffer) { return buffer->retired && buffer->empty(); });
+            }
+
+            if ( const uint64_t dropped = dropped_.load(std::memory_order_relaxed); dropped != reported_drops ) {
+                batch += log_helpers::formatTimestamp() + " " +
+                         log_helpers::formatLogLevel(LogLevel::WARN, log_to_file_) + " - Dropped " +
+                         std::to_string(dropped - reported_drops) + " log messages, the writer fell behind\n";
+                reported_drops = dropped;
+            }
+
+            if ( !batch.empty() ) {
+                writeOut(batch);
+                batch.clear();
+                written_.fetch_add(count);
+                written_.notify_all();
+                continue;
+            }
+            if ( stopping ) {
+                return;
+            }
+
+            writer_idle_ = true;
+            wakeups_.wait(wakeups);
+            writer_idle_ = false;
+        }
+    }
+
+    void Logger::writeOut(const std::string &batch)
+    {
+        std::lock_guard<std::mutex> lock(output_mutex_);
+        size_t offset = 0;
+        while ( offset < batch.size() ) {
+            const ssize_t res = ::write(output_fd_, batch.data() + offset, batch.size() - offset);
+            if ( res < 0 ) {
+                if ( errno == EINTR ) {
+                    continue;
+                }
+                // there is nowhere left to report this
+                std::cerr << "Failed to write log: " << std::strerror(errno) << std::endl;
+                return;
+            }
+            offset += res;
         }
     }
 
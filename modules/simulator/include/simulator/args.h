@@ -0,0 +1,42 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <shared/utils/logger.h>
+
+namespace simulator
+{
+    class SimArgs
+    {
+    public:
+        SimArgs(int argc, char *argv[]);
+        ~SimArgs() = default;
+
+        size_t getGames() const { return _games; }
+        size_t getFirstGame() const { return _first_game; }
+        size_t getThreads() const { return _threads; }
+        size_t getPlayers() const { return _players; }
+        size_t getMaxDecisions() const { return _max_decisions; }
+        uint64_t getSeed() const { return _seed; }
+        bool isBroadcast() const { return _broadcast; }
+        LogLevel getLogLevel() const { return _log_level; }
+
+        /**
+         * @brief The policy of every seat, the policies given on the command line are repeated if there are more
+         * players than policies.
+         */
+        const std::vector<std::string> &getPolicies() const { return _policies; }
+
+    private:
+        size_t _games;
+        size_t _first_game;
+        size_t _threads;
+        size_t _players;
+        size_t _max_decisions;
+        uint64_t _seed;
+        bool _broadcast;
+        LogLevel _log_level;
+        std::vector<std::string> _policies;
+    };
+} // namespace simulator
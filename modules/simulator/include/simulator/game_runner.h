@@ -0,0 +1,68 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <server/game/game_interface.h>
+#include <simulator/policy.h>
+#include <simulator/statistics.h>
+
+namespace simulator
+{
+    struct SimConfig
+    {
+        std::vector<std::string> policies;
+        size_t players;
+        size_t max_decisions;
+        // also build and serialise the game state of every player after each decision, like a lobby does
+        bool broadcast;
+    };
+
+    /**
+     * @brief Plays complete games against a GameInterface in process, without any network in between.
+     *
+     * A runner is meant to be owned by a single thread, it keeps its own random engine and records into its own
+     * Statistics. Every game is seeded from the seed of the simulation and its game number only, so a game plays out
+     * the same no matter which runner picks it up.
+     */
+    class GameRunner
+    {
+    public:
+        GameRunner(const SimConfig &config, uint64_t seed);
+
+        /**
+         * @brief The seed the kingdom, the shuffles and the decisions of a game are drawn from.
+         */
+        static uint64_t gameSeed(uint64_t seed, size_t game_number);
+
+        /**
+         * @brief Plays a single game until it is over or the decision limit is reached.
+         *
+         * @return true if the game ended regularly
+         */
+        bool run(size_t game_number);
+
+        const Statistics &getStatistics() const { return stats; }
+
+    private:
+        /**
+         * @brief Draws 10 distinct kingdom cards, God_Mode is never part of a simulated game.
+         */
+        std::vector<shared::CardBase::id_t> drawKingdom();
+
+        /**
+         * @brief Sends a decision to the game and records its latency.
+         * @throw anything GameInterface::handleMessage throws
+         */
+        server::GameInterface::response_t send(server::GameInterface &game, const std::string &game_id,
+                                               const shared::PlayerBase::id_t &player_id,
+                                               std::unique_ptr<shared::ActionDecision> decision);
+
+        const SimConfig config;
+        const uint64_t seed;
+        rng_t rng;
+        Statistics stats;
+        std::vector<Policy::ptr_t> seats;
+        size_t message_counter = 0;
+    };
+} // namespace simulator
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <memory>
+#include <random>
+#include <string>
+
+#include <shared/action_decision.h>
+#include <shared/action_order.h>
+#include <shared/game/game_state/reduced_game_state.h>
+
+namespace simulator
+{
+    using rng_t = std::mt19937_64;
+
+    /**
+     * @brief A scripted bot that answers the orders of the server.
+     *
+     * A policy only sees what a client would see: the reduced game state of its own seat and the order it received.
+     * The decisions it returns are not guaranteed to be legal, the server is the one validating them.
+     */
+    class Policy
+    {
+    public:
+        using ptr_t = std::unique_ptr<Policy>;
+
+        virtual ~Policy() = default;
+
+        /**
+         * @brief Answers an order of the server.
+         */
+        std::unique_ptr<shared::ActionDecision> decide(const reduced::GameState &state,
+                                                       const shared::ActionOrder &order, rng_t &rng);
+
+        /**
+         * @brief Creates a policy by name, currently `big_money` and `random` exist.
+         * @throw std::invalid_argument if there is no policy with this name
+         */
+        static ptr_t make(const std::string &name);
+
+    protected:
+        virtual std::unique_ptr<shared::ActionDecision> playAction(const reduced::GameState &state, rng_t &rng) = 0;
+        virtual std::unique_ptr<shared::ActionDecision> buyCard(const reduced::GameState &state, rng_t &rng) = 0;
+
+        /**
+         * @brief Picks the cards for a ChooseFromOrder, by default the first eligible cards.
+         */
+        virtual std::vector<shared::CardBase::id_t> chooseCards(const std::vector<shared::CardBase::id_t> &eligible,
+                                                                const shared::ChooseFromOrder &order, rng_t &rng);
+
+        /**
+         * @brief Picks a card for a GainFromBoardOrder, by default the most expensive one.
+         */
+        virtual shared::CardBase::id_t gainCard(const std::vector<shared::CardBase::id_t> &available, rng_t &rng);
+    };
+
+    /**
+     * @brief Plays every action card it gets, buys Province, Gold or Silver, and Duchies once the game gets close.
+     */
+    class BigMoneyPolicy : public Policy
+    {
+    protected:
+        std::unique_ptr<shared::ActionDecision> playAction(const reduced::GameState &state, rng_t &rng) override;
+        std::unique_ptr<shared::ActionDecision> buyCard(const reduced::GameState &state, rng_t &rng) override;
+    };
+
+    /**
+     * @brief Makes random (but mostly valid) choices, this exercises far more card behaviours than BigMoneyPolicy.
+     */
+    class RandomPolicy : public Policy
+    {
+    protected:
+        std::unique_ptr<shared::ActionDecision> playAction(const reduced::GameState &state, rng_t &rng) override;
+        std::unique_ptr<shared::ActionDecision> buyCard(const reduced::GameState &state, rng_t &rng) override;
+        std::vector<shared::CardBase::id_t> chooseCards(const std::vector<shared::CardBase::id_t> &eligible,
+                                                        const shared::ChooseFromOrder &order, rng_t &rng) override;
+        shared::CardBase::id_t gainCard(const std::vector<shared::CardBase::id_t> &available, rng_t &rng) override;
+    };
+} // namespace simulator
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace simulator
+{
+    /**
+     * @brief Counters and latency samples of a batch of simulated games.
+     *
+     * Every worker thread records into its own instance, the instances are merged once all games are done. This keeps
+     * the hot path free of any synchronisation.
+     */
+    class Statistics
+    {
+    public:
+        using duration_t = std::chrono::nanoseconds;
+
+        void recordDecision(const std::string &decision_type, duration_t latency);
+        void recordError() { ++errors; }
+        void recordGame(bool finished);
+
+        void merge(const Statistics &other);
+
+        size_t getGames() const { return games; }
+        size_t getDecisions() const { return decisions; }
+
+        /**
+         * @brief Prints the throughput and the latency percentiles per decision type.
+         *
+         * @param elapsed wall clock time it took to simulate all games
+         */
+        void report(std::ostream &os, duration_t elapsed) const;
+
+    private:
+        size_t games = 0;
+        size_t finished_games = 0;
+        size_t decisions = 0;
+        size_t errors = 0;
+
+        // latencies in nanoseconds, the map keeps the report ordered
+        std::map<std::string, std::vector<int64_t>> latencies;
+    };
+} // namespace simulator
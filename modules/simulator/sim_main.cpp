@@ -0,0 +1,69 @@
+#include <atomic>
+#include <iostream>
+#include <thread>
+
+#include <shared/utils/logger.h>
+#include <simulator/args.h>
+#include <simulator/game_runner.h>
+
+/**
+ * @brief Plays bot games against the game engine in process and reports the throughput and decision latencies.
+ *
+ * Example: `./dominion_sim --games 10000 --players 3 --policy big_money,random`
+ */
+int main(int argc, char *argv[])
+{
+    simulator::SimArgs args(argc, argv);
+
+    shared::Logger::initialize();
+    shared::Logger::setLevel(args.getLogLevel());
+
+    simulator::SimConfig config{args.getPolicies(), args.getPlayers(), args.getMaxDecisions(), args.isBroadcast()};
+    try {
+        for ( const auto &policy : config.policies ) {
+            simulator::Policy::make(policy);
+        }
+    } catch ( const std::invalid_argument &e ) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    std::cout << "simulating " << args.getGames() << " games with " << args.getPlayers() << " players on "
+              << args.getThreads() << " threads, seed " << args.getSeed() << std::endl;
+    // games only depend on the seed and their number, `--seed S --first-game N --games 1` replays game sim_N
+    if ( args.getFirstGame() != 0 ) {
+        std::cout << "starting at game sim_" << args.getFirstGame() << " (seed "
+                  << simulator::GameRunner::gameSeed(args.getSeed(), args.getFirstGame()) << ")" << std::endl;
+    }
+
+    std::atomic<size_t> next_game{args.getFirstGame()};
+    std::vector<std::unique_ptr<simulator::GameRunner>> runners;
+    runners.reserve(args.getThreads());
+    for ( size_t i = 0; i < args.getThreads(); ++i ) {
+        runners.push_back(std::make_unique<simulator::GameRunner>(config, args.getSeed()));
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> workers;
+    for ( auto &runner : runners ) {
+        workers.emplace_back(
+                [runner = runner.get(), &next_game, games = args.getFirstGame() + args.getGames()]()
+                {
+                    for ( size_t game = next_game++; game < games; game = next_game++ ) {
+                        runner->run(game);
+                    }
+                });
+    }
+    for ( auto &worker : workers ) {
+        worker.join();
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+
+    simulator::Statistics total;
+    for ( const auto &runner : runners ) {
+        total.merge(runner->getStatistics());
+    }
+    total.report(std::cout, std::chrono::duration_cast<simulator::Statistics::duration_t>(elapsed));
+
+    return 0;
+}
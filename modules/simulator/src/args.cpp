@@ -0,0 +1,83 @@
+#include <iostream>
+#include <sstream>
+#include <thread>
+
+#include <quick_arg_parser.hpp>
+#include <simulator/args.h>
+
+namespace simulator
+{
+    struct ArgsImpl : MainArguments<ArgsImpl>
+    {
+        int games = option("games", 'n', "Number of games to simulate") = 1000;
+        int threads = option("threads", 't', "Worker threads, 0 uses all cores") = 0;
+        int players = option("players", 'p', "Players per game (2-4)") = 2;
+        std::string policies =
+                option("policy", 'b', "Comma separated bot policy per seat (big_money, random)") = "big_money,random";
+        int seed = option("seed", 's', "Seed of the simulation, every game derives its own from it") = 42;
+        int first_game = option("first-game", 'f', "Number of the first game, e.g. to replay a single game") = 0;
+        int max_decisions = option("max-decisions", 'm', "Abort a game after this many decisions") = 5000;
+        bool broadcast =
+                (option("broadcast", 'B', "Build and serialise every player's game state after each decision") =
+                         false);
+        std::string logLevel = option("log-level", 'l', "Log level") = "error";
+    };
+
+    static void die(const std::string &message)
+    {
+        std::cerr << "Error: " << message << std::endl;
+        std::exit(1);
+    }
+
+    SimArgs::SimArgs(int argc, char **argv)
+    {
+        try {
+            ArgsImpl impl{{argc, argv}};
+
+            if ( impl.games <= 0 ) {
+                die("The number of games has to be positive");
+            }
+            if ( impl.threads < 0 ) {
+                die("The number of threads can not be negative");
+            }
+            if ( impl.players < 2 || impl.players > 4 ) {
+                die("A game needs between 2 and 4 players");
+            }
+            if ( impl.first_game < 0 ) {
+                die("The first game can not be negative");
+            }
+            if ( impl.max_decisions <= 0 ) {
+                die("The decision limit has to be positive");
+            }
+
+            _games = impl.games;
+            _first_game = impl.first_game;
+            _threads = impl.threads != 0 ? impl.threads : std::max(1u, std::thread::hardware_concurrency());
+            _players = impl.players;
+            _max_decisions = impl.max_decisions;
+            _seed = static_cast<uint64_t>(impl.seed);
+            _broadcast = impl.broadcast;
+
+            std::optional<LogLevel> log_level = shared::parseLogLevel(impl.logLevel);
+            if ( !log_level.has_value() ) {
+                die("Invalid log level");
+            }
+            _log_level = log_level.value();
+
+            std::stringstream policies(impl.policies);
+            std::string policy;
+            while ( std::getline(policies, policy, ',') ) {
+                if ( !policy.empty() ) {
+                    _policies.push_back(policy);
+                }
+            }
+            if ( _policies.empty() ) {
+                die("At least one policy is needed");
+            }
+        } catch ( const QuickArgParserInternals::ArgumentError &e ) {
+            die(e.what());
+        } catch ( const std::invalid_argument &e ) {
+            die(std::string("Invalid number: ") + e.what());
+        }
+    }
+} // namespace simulator
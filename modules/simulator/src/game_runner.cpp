@@ -0,0 +1,165 @@
+#include <algorithm>
+#include <map>
+
+#include <shared/game/cards/card_factory.h>
+#include <shared/message_types.h>
+#include <shared/utils/logger.h>
+#include <shared/utils/random.h>
+#include <shared/utils/utils.h>
+#include <simulator/game_runner.h>
+
+namespace simulator
+{
+    namespace
+    {
+        // a policy that keeps getting rejected falls back to ending its phase after this many attempts ...
+        constexpr size_t FALLBACK_AFTER_ERRORS = 3;
+        // ... and the game is given up after this many
+        constexpr size_t ABORT_AFTER_ERRORS = 16;
+
+        std::string decisionName(const shared::ActionDecision &decision)
+        {
+            auto name = utils::demangle(typeid(decision).name());
+            const std::string prefix = "shared::";
+            if ( name.rfind(prefix, 0) == 0 ) {
+                name.erase(0, prefix.size());
+            }
+            return name;
+        }
+
+        /**
+         * @brief A decision the server accepts for phase orders no matter what the hand looks like.
+         */
+        std::unique_ptr<shared::ActionDecision> fallbackDecision(const shared::ActionOrder &order)
+        {
+            if ( dynamic_cast<const shared::ActionPhaseOrder *>(&order) != nullptr ) {
+                return std::make_unique<shared::EndActionPhaseDecision>();
+            } else if ( dynamic_cast<const shared::BuyPhaseOrder *>(&order) != nullptr ) {
+                return std::make_unique<shared::EndTurnDecision>();
+            }
+            return nullptr;
+        }
+    } // namespace
+
+    GameRunner::GameRunner(const SimConfig &config, uint64_t seed) : config(config), seed(seed), rng(seed)
+    {
+        for ( size_t i = 0; i < config.players; ++i ) {
+            seats.push_back(Policy::make(config.policies[i % config.policies.size()]));
+        }
+    }
+
+    bool GameRunner::run(size_t game_number)
+    {
+        const std::string game_id = "sim_" + std::to_string(game_number);
+        std::vector<shared::PlayerBase::id_t> player_ids;
+        for ( size_t i = 0; i < config.players; ++i ) {
+            player_ids.push_back("bot_" + std::to_string(i));
+        }
+
+        const auto game_seed = gameSeed(seed, game_number);
+        LOG(INFO) << "Game " << game_id << " uses seed " << game_seed;
+        rng.seed(game_seed);
+        auto game = server::GameInterface::make(game_id, drawKingdom(), player_ids, rng());
+
+        // the orders that still wait for an answer, a player never has more than one
+        std::map<shared::PlayerBase::id_t, std::unique_ptr<shared::ActionOrder>> pending;
+        const auto collect_orders = [&pending](server::GameInterface::response_t &response)
+        {
+            for ( auto &[player_id, order] : response ) {
+                pending[player_id] = std::move(order);
+            }
+        };
+
+        auto response = game->startGame();
+        collect_orders(response);
+
+        size_t consecutive_errors = 0;
+        for ( size_t decisions = 0; decisions < config.max_decisions; ++decisions ) {
+            if ( pending.empty() ) {
+                LOG(WARN) << "Game " << game_id << " has no pending orders but is not over";
+                break;
+            }
+
+            auto order_it = pending.begin();
+            const auto player_id = order_it->first;
+            const auto seat = std::distance(player_ids.begin(),
+                                            std::find(player_ids.begin(), player_ids.end(), player_id));
+
+            std::unique_ptr<shared::ActionDecision> decision;
+            if ( consecutive_errors >= FALLBACK_AFTER_ERRORS ) {
+                decision = fallbackDecision(*order_it->second);
+            }
+            if ( decision == nullptr ) {
+                const auto state = game->getGameState(player_id);
+                decision = seats[seat]->decide(*state, *order_it->second, rng);
+            }
+
+            try {
+                response = send(*game, game_id, player_id, std::move(decision));
+            } catch ( const std::exception &e ) {
+                LOG(DEBUG) << "Game " << game_id << ": decision of " << player_id << " was rejected: " << e.what();
+                stats.recordError();
+                if ( ++consecutive_errors >= ABORT_AFTER_ERRORS ) {
+                    LOG(WARN) << "Game " << game_id << " (seed " << game_seed << ") is stuck, giving up";
+                    break;
+                }
+                continue;
+            }
+
+            consecutive_errors = 0;
+            pending.erase(order_it);
+
+            if ( response.isGameOver() ) {
+                stats.recordGame(true);
+                return true;
+            }
+            collect_orders(response);
+
+            if ( config.broadcast ) {
+                for ( const auto &id : player_ids ) {
+                    game->getGameState(id)->toJson();
+                }
+            }
+        }
+
+        stats.recordGame(false);
+        return false;
+    }
+
+    uint64_t GameRunner::gameSeed(uint64_t seed, size_t game_number) { return utils::splitmix64(seed, game_number); }
+
+    std::vector<shared::CardBase::id_t> GameRunner::drawKingdom()
+    {
+        constexpr auto god_mode = shared::cardHandle("God_Mode");
+
+        std::vector<shared::CardBase::id_t> candidates;
+        for ( size_t i = 0; i < shared::CardFactory::size(); ++i ) {
+            const auto card = static_cast<shared::CardBase::handle_t>(i);
+            if ( card != god_mode && (shared::CardFactory::getType(card) & shared::CardType::KINGDOM) != 0 ) {
+                candidates.push_back(shared::CardFactory::getId(card));
+            }
+        }
+
+        std::vector<shared::CardBase::id_t> kingdom;
+        std::sample(candidates.begin(), candidates.end(), std::back_inserter(kingdom),
+                    shared::board_config::KINGDOM_CARD_COUNT, rng);
+        return kingdom;
+    }
+
+    server::GameInterface::response_t GameRunner::send(server::GameInterface &game, const std::string &game_id,
+                                                       const shared::PlayerBase::id_t &player_id,
+                                                       std::unique_ptr<shared::ActionDecision> decision)
+    {
+        const auto decision_type = decisionName(*decision);
+
+        // the message ids only have to be unique, counting is much cheaper than generating uuids
+        std::unique_ptr<shared::ClientToServerMessage> message = std::make_unique<shared::ActionDecisionMessage>(
+                game_id, player_id, std::move(decision), std::nullopt, std::to_string(message_counter++));
+
+        const auto start = std::chrono::steady_clock::now();
+        auto response = game.handleMessage(message);
+        stats.recordDecision(decision_type, std::chrono::steady_clock::now() - start);
+
+        return response;
+    }
+} // namespace simulator
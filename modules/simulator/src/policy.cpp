@@ -0,0 +1,224 @@
+#include <algorithm>
+
+#include <shared/game/cards/card_factory.h>
+#include <shared/utils/logger.h>
+#include <shared/utils/utils.h>
+#include <simulator/policy.h>
+
+namespace simulator
+{
+    namespace
+    {
+        /**
+         * @brief All cards on the board that are not sold out, cost at most max_cost and only have types out of
+         * allowed_type.
+         */
+        std::vector<shared::CardBase::id_t>
+        availableCards(const reduced::GameState &state, unsigned int max_cost,
+                       shared::CardType allowed_type = static_cast<shared::CardType>(UINT16_MAX))
+        {
+            std::vector<shared::CardBase::id_t> available;
+            const auto add_pile = [&](const shared::Pile &pile)
+            {
+                const auto type = shared::CardFactory::getType(pile.card_id);
+                if ( pile.count > 0 && shared::CardFactory::getCost(pile.card_id) <= max_cost &&
+                     (type & allowed_type) == type ) {
+                    available.push_back(pile.card_id);
+                }
+            };
+
+            auto &board = *state.board;
+            std::for_each(board.getTreasureCards().begin(), board.getTreasureCards().end(), add_pile);
+            std::for_each(board.getVictoryCards().begin(), board.getVictoryCards().end(), add_pile);
+            std::for_each(board.getKingdomCards().begin(), board.getKingdomCards().end(), add_pile);
+            add_pile(board.getCurseCardPile());
+            return available;
+        }
+
+        size_t pileCount(const reduced::GameState &state, const shared::CardBase::id_t &card_id)
+        {
+            for ( const auto &pile : state.board->getVictoryCards() ) {
+                if ( pile.card_id == card_id ) {
+                    return pile.count;
+                }
+            }
+            for ( const auto &pile : state.board->getTreasureCards() ) {
+                if ( pile.card_id == card_id ) {
+                    return pile.count;
+                }
+            }
+            return 0;
+        }
+
+        std::vector<shared::CardBase::id_t> actionCardsInHand(const reduced::GameState &state)
+        {
+            std::vector<shared::CardBase::id_t> actions;
+            for ( const auto &card_id : state.reduced_player->getHandCards() ) {
+                if ( shared::CardFactory::isAction(card_id) ) {
+                    actions.push_back(card_id);
+                }
+            }
+            return actions;
+        }
+
+        template <typename T>
+        const T &pickRandom(const std::vector<T> &values, rng_t &rng)
+        {
+            return values[std::uniform_int_distribution<size_t>(0, values.size() - 1)(rng)];
+        }
+
+        shared::ChooseFromOrder::AllowedChoice firstChoice(shared::ChooseFromOrder::AllowedChoice choices)
+        {
+            // the lowest bit that is set
+            return static_cast<shared::ChooseFromOrder::AllowedChoice>(choices & -static_cast<int>(choices));
+        }
+    } // namespace
+
+    std::unique_ptr<shared::ActionDecision> Policy::decide(const reduced::GameState &state,
+                                                           const shared::ActionOrder &order, rng_t &rng)
+    {
+        if ( dynamic_cast<const shared::ActionPhaseOrder *>(&order) != nullptr ) {
+            return playAction(state, rng);
+        } else if ( dynamic_cast<const shared::BuyPhaseOrder *>(&order) != nullptr ) {
+            return buyCard(state, rng);
+        } else if ( dynamic_cast<const shared::EndTurnOrder *>(&order) != nullptr ) {
+            return std::make_unique<shared::EndTurnDecision>();
+        } else if ( const auto *gain_order = dynamic_cast<const shared::GainFromBoardOrder *>(&order) ) {
+            const auto available = availableCards(state, gain_order->max_cost, gain_order->allowed_type);
+            return std::make_unique<shared::GainFromBoardDecision>(available.empty() ? "" : gainCard(available, rng));
+        } else if ( const auto *staged_order = dynamic_cast<const shared::ChooseFromStagedOrder *>(&order) ) {
+            auto cards = chooseCards(staged_order->cards, *staged_order, rng);
+            std::vector<shared::ChooseFromOrder::AllowedChoice> choices(cards.size(),
+                                                                         firstChoice(staged_order->allowed_choices));
+            return std::make_unique<shared::DeckChoiceDecision>(std::move(cards), std::move(choices));
+        } else if ( const auto *hand_order = dynamic_cast<const shared::ChooseFromHandOrder *>(&order) ) {
+            std::vector<shared::CardBase::id_t> eligible;
+            for ( const auto &card_id : state.reduced_player->getHandCards() ) {
+                const auto type = shared::CardFactory::getType(card_id);
+                if ( (type & hand_order->allowed_type) == type &&
+                     (type & hand_order->required_type) == hand_order->required_type ) {
+                    eligible.push_back(card_id);
+                }
+            }
+            auto cards = chooseCards(eligible, *hand_order, rng);
+            std::vector<shared::ChooseFromOrder::AllowedChoice> choices(cards.size(),
+                                                                         firstChoice(hand_order->allowed_choices));
+            return std::make_unique<shared::DeckChoiceDecision>(std::move(cards), std::move(choices));
+        }
+
+        LOG(ERROR) << "Policy received an unknown order type: " << utils::demangle(typeid(order).name());
+        throw std::invalid_argument("Unknown order type");
+    }
+
+    std::vector<shared::CardBase::id_t> Policy::chooseCards(const std::vector<shared::CardBase::id_t> &eligible,
+                                                            const shared::ChooseFromOrder &order, rng_t & /*rng*/)
+    {
+        const size_t amount = std::min<size_t>(order.min_cards, eligible.size());
+        return {eligible.begin(), eligible.begin() + amount};
+    }
+
+    shared::CardBase::id_t Policy::gainCard(const std::vector<shared::CardBase::id_t> &available, rng_t & /*rng*/)
+    {
+        return *std::max_element(available.begin(), available.end(),
+                                 [](const auto &a, const auto &b)
+                                 { return shared::CardFactory::getCost(a) < shared::CardFactory::getCost(b); });
+    }
+
+    Policy::ptr_t Policy::make(const std::string &name)
+    {
+        if ( name == "big_money" ) {
+            return std::make_unique<BigMoneyPolicy>();
+        } else if ( name == "random" ) {
+            return std::make_unique<RandomPolicy>();
+        }
+
+        throw std::invalid_argument("Unknown policy: " + name);
+    }
+
+    std::unique_ptr<shared::ActionDecision> BigMoneyPolicy::playAction(const reduced::GameState &state,
+                                                                       rng_t & /*rng*/)
+    {
+        const auto actions = actionCardsInHand(state);
+        if ( state.reduced_player->getActions() > 0 && !actions.empty() ) {
+            return std::make_unique<shared::PlayActionCardDecision>(actions.front());
+        }
+        return std::make_unique<shared::EndActionPhaseDecision>();
+    }
+
+    std::unique_ptr<shared::ActionDecision> BigMoneyPolicy::buyCard(const reduced::GameState &state, rng_t &rng)
+    {
+        const auto treasure = state.reduced_player->getTreasure();
+        const auto provinces_left = pileCount(state, "Province");
+
+        const auto buy_if_available = [&](const shared::CardBase::id_t &card_id) -> std::unique_ptr<shared::ActionDecision>
+        {
+            if ( pileCount(state, card_id) > 0 ) {
+                return std::make_unique<shared::BuyCardDecision>(card_id);
+            }
+            return std::make_unique<shared::EndTurnDecision>();
+        };
+
+        if ( treasure >= 8 ) {
+            return buy_if_available("Province");
+        } else if ( treasure >= 6 ) {
+            return buy_if_available(provinces_left <= 4 ? "Duchy" : "Gold");
+        } else if ( treasure >= 5 && provinces_left <= 5 ) {
+            return buy_if_available("Duchy");
+        } else if ( treasure >= 4 && std::uniform_int_distribution<int>(0, 3)(rng) == 0 ) {
+            // now and then pick up an action card, otherwise the kingdom is never played
+            std::vector<shared::CardBase::id_t> actions;
+            for ( const auto &card_id : availableCards(state, treasure) ) {
+                if ( shared::CardFactory::isAction(card_id) ) {
+                    actions.push_back(card_id);
+                }
+            }
+            if ( !actions.empty() ) {
+                return std::make_unique<shared::BuyCardDecision>(pickRandom(actions, rng));
+            }
+        }
+
+        if ( treasure >= 3 ) {
+            return buy_if_available("Silver");
+        }
+        return std::make_unique<shared::EndTurnDecision>();
+    }
+
+    std::unique_ptr<shared::ActionDecision> RandomPolicy::playAction(const reduced::GameState &state, rng_t &rng)
+    {
+        const auto actions = actionCardsInHand(state);
+        if ( state.reduced_player->getActions() > 0 && !actions.empty() &&
+             std::uniform_int_distribution<int>(0, 9)(rng) != 0 ) {
+            return std::make_unique<shared::PlayActionCardDecision>(pickRandom(actions, rng));
+        }
+        return std::make_unique<shared::EndActionPhaseDecision>();
+    }
+
+    std::unique_ptr<shared::ActionDecision> RandomPolicy::buyCard(const reduced::GameState &state, rng_t &rng)
+    {
+        auto available = availableCards(state, state.reduced_player->getTreasure());
+        available.erase(std::remove(available.begin(), available.end(), "Curse"), available.end());
+
+        if ( state.reduced_player->getBuys() > 0 && !available.empty() &&
+             std::uniform_int_distribution<int>(0, 4)(rng) != 0 ) {
+            return std::make_unique<shared::BuyCardDecision>(pickRandom(available, rng));
+        }
+        return std::make_unique<shared::EndTurnDecision>();
+    }
+
+    std::vector<shared::CardBase::id_t> RandomPolicy::chooseCards(const std::vector<shared::CardBase::id_t> &eligible,
+                                                                  const shared::ChooseFromOrder &order, rng_t &rng)
+    {
+        const size_t max_amount = std::min<size_t>(order.max_cards, eligible.size());
+        const size_t min_amount = std::min<size_t>(order.min_cards, max_amount);
+        const size_t amount = std::uniform_int_distribution<size_t>(min_amount, max_amount)(rng);
+
+        std::vector<shared::CardBase::id_t> chosen;
+        std::sample(eligible.begin(), eligible.end(), std::back_inserter(chosen), amount, rng);
+        return chosen;
+    }
+
+    shared::CardBase::id_t RandomPolicy::gainCard(const std::vector<shared::CardBase::id_t> &available, rng_t &rng)
+    {
+        return pickRandom(available, rng);
+    }
+} // namespace simulator
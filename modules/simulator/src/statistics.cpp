@@ -0,0 +1,71 @@
+#include <algorithm>
+#include <iomanip>
+
+#include <simulator/statistics.h>
+
+namespace simulator
+{
+    namespace
+    {
+        /**
+         * @brief Nearest rank percentile of a sorted sample.
+         */
+        int64_t percentile(const std::vector<int64_t> &sorted, double p)
+        {
+            const auto rank = static_cast<size_t>(p * static_cast<double>(sorted.size() - 1) + 0.5);
+            return sorted[std::min(rank, sorted.size() - 1)];
+        }
+
+        double toMicroseconds(int64_t nanoseconds) { return static_cast<double>(nanoseconds) / 1000.0; }
+    } // namespace
+
+    void Statistics::recordDecision(const std::string &decision_type, duration_t latency)
+    {
+        ++decisions;
+        latencies[decision_type].push_back(latency.count());
+    }
+
+    void Statistics::recordGame(bool finished)
+    {
+        ++games;
+        if ( finished ) {
+            ++finished_games;
+        }
+    }
+
+    void Statistics::merge(const Statistics &other)
+    {
+        games += other.games;
+        finished_games += other.finished_games;
+        decisions += other.decisions;
+        errors += other.errors;
+        for ( const auto &[decision_type, samples] : other.latencies ) {
+            auto &merged = latencies[decision_type];
+            merged.insert(merged.end(), samples.begin(), samples.end());
+        }
+    }
+
+    void Statistics::report(std::ostream &os, duration_t elapsed) const
+    {
+        const double seconds = std::chrono::duration<double>(elapsed).count();
+
+        os << std::fixed << std::setprecision(2);
+        os << "games:     " << games << " (" << finished_games << " finished, " << games - finished_games
+           << " aborted) in " << seconds << " s, " << static_cast<double>(games) / seconds << " games/s\n";
+        os << "decisions: " << decisions << " (" << errors << " rejected), " << static_cast<double>(decisions) / seconds
+           << " decisions/s\n\n";
+
+        os << std::left << std::setw(26) << "decision" << std::right << std::setw(10) << "count" << std::setw(12)
+           << "p50 [us]" << std::setw(12) << "p90 [us]" << std::setw(12) << "p99 [us]" << std::setw(12) << "max [us]"
+           << "\n";
+
+        for ( const auto &[decision_type, samples] : latencies ) {
+            auto sorted = samples;
+            std::sort(sorted.begin(), sorted.end());
+            os << std::left << std::setw(26) << decision_type << std::right << std::setw(10) << sorted.size()
+               << std::setw(12) << toMicroseconds(percentile(sorted, 0.50)) << std::setw(12)
+               << toMicroseconds(percentile(sorted, 0.90)) << std::setw(12) << toMicroseconds(percentile(sorted, 0.99))
+               << std::setw(12) << toMicroseconds(sorted.back()) << "\n";
+        }
+    }
+} // namespace simulator
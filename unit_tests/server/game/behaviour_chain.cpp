@@ -0,0 +1,87 @@
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <server/game/behaviour_chain.h>
+#include <server/game/behaviour_registry.h>
+#include <server/game/game_state.h>
+#include <shared/utils/test_helpers.h>
+
+namespace
+{
+    server::GameState makeGameState()
+    {
+        return server::GameState(test_helper::getValidRandomKingdomCards(10), {"player1", "player2"});
+    }
+} // namespace
+
+TEST(BehaviourChainTest, AppliesEffectsAtOnce)
+{
+    auto game_state = makeGameState();
+    const auto &player = game_state.getCurrentPlayer();
+    const auto actions = player.getActions();
+    const auto buys = player.getBuys();
+    const auto treasure = player.getTreasure();
+
+    server::BehaviourChain chain;
+    chain.loadBehaviours(shared::cardHandle("Festival"));
+    const auto response = chain.startChain(game_state);
+
+    EXPECT_TRUE(response.empty());
+    EXPECT_TRUE(chain.empty());
+    EXPECT_EQ(player.getActions(), actions + 2);
+    EXPECT_EQ(player.getBuys(), buys + 1);
+    EXPECT_EQ(player.getTreasure(), treasure + 2);
+
+    // the chain can be reused right away
+    chain.loadBehaviours(shared::cardHandle("Copper"));
+    chain.startChain(game_state);
+    EXPECT_TRUE(chain.empty());
+    EXPECT_EQ(player.getTreasure(), treasure + 3);
+}
+
+TEST(BehaviourChainTest, InteractiveBehaviourWaitsForDecision)
+{
+    auto game_state = makeGameState();
+    const auto player_id = game_state.getCurrentPlayerId();
+    const auto hand_size = game_state.getCurrentPlayer().get<shared::HAND>().size();
+
+    server::BehaviourChain chain;
+    chain.loadBehaviours(shared::cardHandle("Chapel"));
+    auto response = chain.startChain(game_state);
+
+    ASSERT_TRUE(response.hasOrder(player_id));
+    EXPECT_FALSE(chain.empty());
+
+    const auto trashed = shared::CardFactory::getId(game_state.getCurrentPlayer().get<shared::HAND>().front());
+    std::unique_ptr<shared::ActionDecision> decision = std::make_unique<shared::DeckChoiceDecision>(
+            std::vector<shared::CardBase::id_t>{trashed},
+            std::vector<shared::ChooseFromOrder::AllowedChoice>{shared::ChooseFromOrder::AllowedChoice::TRASH});
+    response = chain.continueChain(game_state, player_id, decision);
+
+    EXPECT_TRUE(response.empty());
+    EXPECT_TRUE(chain.empty());
+    EXPECT_EQ(game_state.getCurrentPlayer().get<shared::HAND>().size(), hand_size - 1);
+}
+
+TEST(BehaviourChainTest, ConsecutiveEffectsAreFused)
+{
+    const server::BehaviourRegistry registry;
+
+    const auto festival = registry.getBehaviours(shared::cardHandle("Festival"));
+    ASSERT_EQ(festival.size(), 1);
+    EXPECT_NE(festival[0].effect, nullptr);
+
+    // effects before an interactive behaviour are fused, the behaviour stays on its own
+    const auto poacher = registry.getBehaviours(shared::cardHandle("Poacher"));
+    ASSERT_EQ(poacher.size(), 2);
+    EXPECT_NE(poacher[0].effect, nullptr);
+    EXPECT_NE(poacher[1].construct, nullptr);
+
+    const auto artisan = registry.getBehaviours(shared::cardHandle("Artisan"));
+    ASSERT_EQ(artisan.size(), 2);
+    EXPECT_NE(artisan[0].construct, nullptr);
+    EXPECT_NE(artisan[1].construct, nullptr);
+}
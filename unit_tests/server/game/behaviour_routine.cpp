@@ -0,0 +1,368 @@
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <server/game/behaviour_arena.h>
+#include <server/game/behaviour_chain.h>
+#include <server/game/game_state.h>
+
+namespace
+{
+    using Choice = shared::ChooseFromOrder::AllowedChoice;
+
+    server::GameState makeGameState(const std::vector<server::Player::id_t> &player_ids = {"player1", "player2"})
+    {
+        server::GameState game_state({"Village", "Festival", "Chapel", "Remodel", "Throne_Room", "Library", "Sentry",
+                                      "Bandit", "Moat", "Smithy"},
+                                     player_ids);
+        // behaviours only run while a card is played
+        game_state.setPhase(shared::GamePhase::PLAYING_ACTION_CARD);
+        return game_state;
+    }
+
+    std::unique_ptr<shared::ActionDecision> chooseCards(const std::vector<shared::CardBase::id_t> &cards,
+                                                        Choice choice)
+    {
+        return std::make_unique<shared::DeckChoiceDecision>(cards, std::vector<Choice>(cards.size(), choice));
+    }
+
+    std::unique_ptr<shared::ActionDecision> gainCard(const shared::CardBase::id_t &card)
+    {
+        return std::make_unique<shared::GainFromBoardDecision>(card);
+    }
+} // namespace
+
+TEST(BehaviourArenaTest, ReusesMemoryInStackOrder)
+{
+    server::BehaviourArena arena;
+
+    void *outer = arena.allocate(100);
+    void *inner = arena.allocate(10);
+    EXPECT_EQ(arena.used(), 128);
+
+    arena.deallocate(inner, 10);
+    EXPECT_EQ(arena.used(), 112);
+    EXPECT_EQ(arena.allocate(10), inner);
+
+    arena.deallocate(inner, 10);
+    arena.deallocate(outer, 100);
+    EXPECT_EQ(arena.used(), 0);
+
+    // too large for the arena, ends up on the heap
+    void *large = arena.allocate(server::BehaviourArena::CAPACITY + 1);
+    EXPECT_EQ(arena.used(), 0);
+    arena.deallocate(large, server::BehaviourArena::CAPACITY + 1);
+}
+
+TEST(BehaviourRoutineTest, InvalidDecisionsCanBeRetried)
+{
+    auto game_state = makeGameState();
+    const auto player_id = game_state.getCurrentPlayerId();
+    auto &player = game_state.getCurrentPlayer();
+    player.add<shared::HAND>(shared::cardHandle("Copper"));
+
+    server::BehaviourChain chain;
+    chain.loadBehaviours(shared::cardHandle("Remodel"));
+    auto response = chain.startChain(game_state);
+    ASSERT_TRUE(response.hasOrder(player_id));
+    EXPECT_GT(game_state.getBehaviourArena().used(), 0);
+
+    // wrong decision type and a card that is not in hand, the routine keeps waiting
+    auto decision = gainCard("Copper");
+    EXPECT_ANY_THROW(chain.continueChain(game_state, player_id, decision));
+    decision = chooseCards({"Gold"}, Choice::TRASH);
+    EXPECT_ANY_THROW(chain.continueChain(game_state, player_id, decision));
+
+    decision = chooseCards({"Copper"}, Choice::TRASH);
+    response = chain.continueChain(game_state, player_id, decision);
+    ASSERT_TRUE(response.hasOrder(player_id));
+
+    // Silver costs more than Copper + 2
+    decision = gainCard("Silver");
+    EXPECT_ANY_THROW(chain.continueChain(game_state, player_id, decision));
+
+    decision = gainCard("Estate");
+    response = chain.continueChain(game_state, player_id, decision);
+    EXPECT_TRUE(response.empty());
+    EXPECT_TRUE(chain.empty());
+    EXPECT_EQ(player.get<shared::DISCARD_PILE>().back(), shared::cardHandle("Estate"));
+    EXPECT_EQ(game_state.getBehaviourArena().used(), 0);
+}
+
+TEST(BehaviourRoutineTest, ThroneRoomPlaysACardTwice)
+{
+    auto game_state = makeGameState();
+    const auto player_id = game_state.getCurrentPlayerId();
+    auto &player = game_state.getCurrentPlayer();
+    player.add<shared::HAND>(shared::cardHandle("Festival"));
+    const auto actions = player.getActions();
+    const auto treasure = player.getTreasure();
+
+    server::BehaviourChain chain;
+    chain.loadBehaviours(shared::cardHandle("Throne_Room"));
+    auto response = chain.startChain(game_state);
+    ASSERT_TRUE(response.hasOrder(player_id));
+
+    auto decision = chooseCards({"Festival"}, Choice::PLAY);
+    response = chain.continueChain(game_state, player_id, decision);
+    EXPECT_TRUE(chain.empty());
+    EXPECT_FALSE(player.hasCard<shared::HAND>(shared::cardHandle("Festival")));
+    EXPECT_EQ(player.getActions(), actions + 4);
+    EXPECT_EQ(player.getTreasure(), treasure + 4);
+}
+
+TEST(BehaviourRoutineTest, ThroneRoomPlaysAnyActionCard)
+{
+    auto game_state = makeGameState();
+    const auto player_id = game_state.getCurrentPlayerId();
+    auto &player = game_state.getCurrentPlayer();
+    player.add<shared::HAND>(shared::cardHandle("Great_Hall"));
+    player.add<shared::HAND>(shared::cardHandle("Copper"));
+    const auto actions = player.getActions();
+    const auto hand_size = player.get<shared::HAND>().size();
+
+    server::BehaviourChain chain;
+    chain.loadBehaviours(shared::cardHandle("Throne_Room"));
+    chain.startChain(game_state);
+
+    // treasures are not action cards
+    auto decision = chooseCards({"Copper"}, Choice::PLAY);
+    EXPECT_ANY_THROW(chain.continueChain(game_state, player_id, decision));
+
+    decision = chooseCards({"Great_Hall"}, Choice::PLAY);
+    chain.continueChain(game_state, player_id, decision);
+    EXPECT_TRUE(chain.empty());
+    EXPECT_EQ(player.getActions(), actions + 2);
+    EXPECT_EQ(player.get<shared::HAND>().size(), hand_size + 1);
+}
+
+TEST(BehaviourRoutineTest, ThroneRoomForwardsDecisions)
+{
+    auto game_state = makeGameState();
+    const auto player_id = game_state.getCurrentPlayerId();
+    auto &player = game_state.getCurrentPlayer();
+    player.add<shared::HAND>(shared::cardHandle("Chapel"));
+    player.add<shared::HAND>(shared::cardHandle("Curse"));
+    player.add<shared::HAND>(shared::cardHandle("Curse"));
+
+    server::BehaviourChain chain;
+    chain.loadBehaviours(shared::cardHandle("Throne_Room"));
+    chain.startChain(game_state);
+
+    auto decision = chooseCards({"Chapel"}, Choice::PLAY);
+    auto response = chain.continueChain(game_state, player_id, decision);
+    ASSERT_TRUE(response.hasOrder(player_id));
+
+    // every play of Chapel asks on its own
+    for ( int i = 0; i < 2; ++i ) {
+        EXPECT_FALSE(chain.empty());
+        decision = chooseCards({"Curse"}, Choice::TRASH);
+        response = chain.continueChain(game_state, player_id, decision);
+    }
+
+    EXPECT_TRUE(chain.empty());
+    EXPECT_FALSE(player.hasCard<shared::HAND>(shared::cardHandle("Curse")));
+    EXPECT_EQ(game_state.getBehaviourArena().used(), 0);
+}
+
+TEST(BehaviourRoutineTest, FailingRoutineAbortsTheCard)
+{
+    auto game_state = makeGameState();
+    const auto player_id = game_state.getCurrentPlayerId();
+    auto &player = game_state.getCurrentPlayer();
+    player.add<shared::HAND>(shared::cardHandle("Throne_Room"));
+    player.add<shared::HAND>(shared::cardHandle("Festival"));
+
+    server::BehaviourChain chain;
+    chain.loadBehaviours(shared::cardHandle("Throne_Room"));
+    chain.startChain(game_state);
+
+    auto decision = chooseCards({"Throne_Room"}, Choice::PLAY);
+    auto response = chain.continueChain(game_state, player_id, decision);
+    ASSERT_TRUE(response.hasOrder(player_id));
+
+    // the inner Throne Room can no longer play the card, which throws inside both routines
+    game_state.setPhase(shared::GamePhase::ACTION_PHASE);
+    decision = chooseCards({"Festival"}, Choice::PLAY);
+    EXPECT_ANY_THROW(chain.continueChain(game_state, player_id, decision));
+    EXPECT_TRUE(chain.empty());
+    EXPECT_EQ(game_state.getBehaviourArena().used(), 0);
+
+    // the chain can be used for the next card
+    game_state.setPhase(shared::GamePhase::PLAYING_ACTION_CARD);
+    const auto actions = player.getActions();
+    chain.loadBehaviours(shared::cardHandle("Festival"));
+    chain.startChain(game_state);
+    EXPECT_TRUE(chain.empty());
+    EXPECT_EQ(player.getActions(), actions + 2);
+}
+
+TEST(BehaviourRoutineTest, LibraryDrawsUpToSevenCards)
+{
+    auto game_state = makeGameState();
+    auto &player = game_state.getCurrentPlayer();
+
+    server::BehaviourChain chain;
+    chain.loadBehaviours(shared::cardHandle("Library"));
+    // the starting deck has no action cards, so nothing is skipped
+    const auto response = chain.startChain(game_state);
+
+    EXPECT_TRUE(response.empty());
+    EXPECT_TRUE(chain.empty());
+    EXPECT_EQ(player.get<shared::HAND>().size(), 7);
+    EXPECT_TRUE(player.get<shared::STAGED_CARDS>().empty());
+}
+
+TEST(BehaviourRoutineTest, SentryTrashesAndDiscards)
+{
+    auto game_state = makeGameState();
+    const auto player_id = game_state.getCurrentPlayerId();
+    auto &player = game_state.getCurrentPlayer();
+    player.add<shared::DRAW_PILE_TOP>(shared::cardHandle("Gold"));
+    player.add<shared::DRAW_PILE_TOP>(shared::cardHandle("Curse"));
+    player.add<shared::DRAW_PILE_TOP>(shared::cardHandle("Silver"));
+    const auto draw_pile_size = player.get<shared::DRAW_PILE_TOP>().size();
+
+    server::BehaviourChain chain;
+    chain.loadBehaviours(shared::cardHandle("Sentry"));
+    auto response = chain.startChain(game_state);
+    ASSERT_TRUE(response.hasOrder(player_id));
+    EXPECT_EQ(player.get<shared::STAGED_CARDS>().size(), 2);
+
+    // a card can only be chosen once
+    auto decision = chooseCards({"Curse", "Curse"}, Choice::TRASH);
+    EXPECT_ANY_THROW(chain.continueChain(game_state, player_id, decision));
+
+    decision = chooseCards({"Curse"}, Choice::TRASH);
+    response = chain.continueChain(game_state, player_id, decision);
+    EXPECT_TRUE(chain.empty());
+    EXPECT_TRUE(player.get<shared::STAGED_CARDS>().empty());
+    EXPECT_TRUE(player.hasCard<shared::HAND>(shared::cardHandle("Silver")));
+    EXPECT_EQ(player.get<shared::DRAW_PILE_TOP>().front(), shared::cardHandle("Gold"));
+    EXPECT_EQ(player.get<shared::DRAW_PILE_TOP>().size(), draw_pile_size - 2);
+}
+
+TEST(BehaviourRoutineTest, SentryLetsThePlayerOrderTheRest)
+{
+    auto game_state = makeGameState();
+    const auto player_id = game_state.getCurrentPlayerId();
+    const auto enemy_id = game_state.getPlayerId(*game_state.getEnemySeats(game_state.getCurrentSeat()).begin());
+    auto &player = game_state.getCurrentPlayer();
+    player.add<shared::DRAW_PILE_TOP>(shared::cardHandle("Estate"));
+    player.add<shared::DRAW_PILE_TOP>(shared::cardHandle("Gold"));
+    player.add<shared::DRAW_PILE_TOP>(shared::cardHandle("Silver"));
+    const auto draw_pile_size = player.get<shared::DRAW_PILE_TOP>().size();
+
+    server::BehaviourChain chain;
+    chain.loadBehaviours(shared::cardHandle("Sentry"));
+    auto response = chain.startChain(game_state);
+    ASSERT_TRUE(response.hasOrder(player_id));
+
+    // only the player of the Sentry decides
+    auto decision = chooseCards({}, Choice::TRASH);
+    EXPECT_THROW(chain.continueChain(game_state, enemy_id, decision), exception::NotYourTurn);
+
+    // keep both, the player is asked which one goes on top
+    decision = chooseCards({}, Choice::TRASH);
+    response = chain.continueChain(game_state, player_id, decision);
+    ASSERT_TRUE(response.hasOrder(player_id));
+    EXPECT_FALSE(chain.empty());
+    EXPECT_EQ(player.get<shared::STAGED_CARDS>().size(), 2);
+
+    decision = chooseCards({"Estate"}, Choice::DRAW_PILE);
+    EXPECT_THROW(chain.continueChain(game_state, enemy_id, decision), exception::NotYourTurn);
+    decision = chooseCards({"Estate"}, Choice::TRASH);
+    EXPECT_ANY_THROW(chain.continueChain(game_state, player_id, decision));
+    decision = chooseCards({"Estate", "Gold"}, Choice::DRAW_PILE);
+    EXPECT_ANY_THROW(chain.continueChain(game_state, player_id, decision));
+
+    decision = chooseCards({"Estate"}, Choice::DRAW_PILE);
+    response = chain.continueChain(game_state, player_id, decision);
+    EXPECT_TRUE(chain.empty());
+    EXPECT_TRUE(player.get<shared::STAGED_CARDS>().empty());
+    const auto &draw_pile = player.get<shared::DRAW_PILE_TOP>();
+    ASSERT_EQ(draw_pile.size(), draw_pile_size - 1);
+    EXPECT_EQ(draw_pile[0], shared::cardHandle("Estate"));
+    EXPECT_EQ(draw_pile[1], shared::cardHandle("Gold"));
+}
+
+TEST(BehaviourRoutineTest, BanditAsksTheEnemy)
+{
+    auto game_state = makeGameState();
+    const auto player_id = game_state.getCurrentPlayerId();
+    const auto enemy_seat = *game_state.getEnemySeats(game_state.getCurrentSeat()).begin();
+    const auto enemy_id = game_state.getPlayerId(enemy_seat);
+    auto &enemy = game_state.getPlayer(enemy_seat);
+    enemy.add<shared::DRAW_PILE_TOP>(shared::cardHandle("Silver"));
+    enemy.add<shared::DRAW_PILE_TOP>(shared::cardHandle("Gold"));
+
+    server::BehaviourChain chain;
+    chain.loadBehaviours(shared::cardHandle("Bandit"));
+    auto response = chain.startChain(game_state);
+    ASSERT_TRUE(response.hasOrder(enemy_id));
+    EXPECT_EQ(game_state.getCurrentPlayer().get<shared::DISCARD_PILE>().back(), shared::cardHandle("Gold"));
+
+    auto decision = chooseCards({"Gold"}, Choice::TRASH);
+    EXPECT_THROW(chain.continueChain(game_state, player_id, decision), exception::NotYourTurn);
+
+    decision = chooseCards({"Gold"}, Choice::TRASH);
+    response = chain.continueChain(game_state, enemy_id, decision);
+    EXPECT_TRUE(chain.empty());
+    EXPECT_TRUE(enemy.get<shared::STAGED_CARDS>().empty());
+    EXPECT_EQ(enemy.get<shared::DISCARD_PILE>().back(), shared::cardHandle("Silver"));
+}
+
+TEST(BehaviourRoutineTest, BanditAsksEachEnemyInTurn)
+{
+    auto game_state = makeGameState({"player1", "player2", "player3"});
+    const auto player_id = game_state.getCurrentPlayerId();
+    std::vector<server::GameState::seat_t> enemy_seats;
+    for ( const auto enemy_seat : game_state.getEnemySeats(game_state.getCurrentSeat()) ) {
+        enemy_seats.push_back(enemy_seat);
+        auto &enemy = game_state.getPlayer(enemy_seat);
+        enemy.add<shared::DRAW_PILE_TOP>(shared::cardHandle("Silver"));
+        enemy.add<shared::DRAW_PILE_TOP>(shared::cardHandle("Gold"));
+    }
+    ASSERT_EQ(enemy_seats.size(), 2);
+    const auto first_id = game_state.getPlayerId(enemy_seats[0]);
+    const auto second_id = game_state.getPlayerId(enemy_seats[1]);
+    auto &first = game_state.getPlayer(enemy_seats[0]);
+    auto &second = game_state.getPlayer(enemy_seats[1]);
+
+    server::BehaviourChain chain;
+    chain.loadBehaviours(shared::cardHandle("Bandit"));
+    auto response = chain.startChain(game_state);
+    ASSERT_TRUE(response.hasOrder(first_id));
+    EXPECT_FALSE(response.hasOrder(second_id));
+
+    // neither the player of the Bandit nor the next enemy may answer for the first enemy
+    auto decision = chooseCards({"Silver"}, Choice::TRASH);
+    EXPECT_THROW(chain.continueChain(game_state, player_id, decision), exception::NotYourTurn);
+    decision = chooseCards({"Silver"}, Choice::TRASH);
+    EXPECT_THROW(chain.continueChain(game_state, second_id, decision), exception::NotYourTurn);
+    EXPECT_EQ(first.get<shared::STAGED_CARDS>().size(), 2);
+    EXPECT_TRUE(second.get<shared::STAGED_CARDS>().empty());
+
+    // only offered treasures can be trashed
+    decision = chooseCards({"Copper"}, Choice::TRASH);
+    EXPECT_ANY_THROW(chain.continueChain(game_state, first_id, decision));
+
+    decision = chooseCards({"Silver"}, Choice::TRASH);
+    response = chain.continueChain(game_state, first_id, decision);
+    ASSERT_TRUE(response.hasOrder(second_id));
+    EXPECT_FALSE(chain.empty());
+    EXPECT_TRUE(first.get<shared::STAGED_CARDS>().empty());
+    EXPECT_EQ(first.get<shared::DISCARD_PILE>().back(), shared::cardHandle("Gold"));
+
+    // the first enemy is done and can not answer again
+    decision = chooseCards({"Gold"}, Choice::TRASH);
+    EXPECT_THROW(chain.continueChain(game_state, first_id, decision), exception::NotYourTurn);
+
+    decision = chooseCards({"Gold"}, Choice::TRASH);
+    response = chain.continueChain(game_state, second_id, decision);
+    EXPECT_TRUE(chain.empty());
+    EXPECT_TRUE(second.get<shared::STAGED_CARDS>().empty());
+    EXPECT_EQ(second.get<shared::DISCARD_PILE>().back(), shared::cardHandle("Silver"));
+}
@@ -80,6 +80,53 @@ TEST(GameStateTest, GetPlayerById)
     EXPECT_THROW(game_state.getPlayer("nonexistent_player"), std::out_of_range);
 }
 
+TEST(GameStateTest, SameSeedSameShuffles)
+{
+    std::vector<shared::CardBase::id_t> selected_cards = test_helper::getValidRandomKingdomCards(10);
+    std::vector<server::Player::id_t> player_ids = {"player1", "player2", "player3"};
+
+    server::GameState game_state(selected_cards, player_ids, 1234);
+    server::GameState replay(selected_cards, player_ids, game_state.getSeed());
+    EXPECT_EQ(game_state.getSeed(), 1234);
+
+    for ( server::GameState::seat_t seat = 0; seat < player_ids.size(); ++seat ) {
+        auto &player = game_state.getPlayer(seat);
+        auto &replayed = replay.getPlayer(seat);
+        EXPECT_EQ(player.get<shared::HAND>(), replayed.get<shared::HAND>());
+
+        // reshuffles follow the seed as well
+        player.endTurn();
+        player.endTurn();
+        replayed.endTurn();
+        replayed.endTurn();
+        EXPECT_EQ(player.get<shared::HAND>(), replayed.get<shared::HAND>());
+        EXPECT_EQ(player.get<shared::DRAW_PILE_TOP>(), replayed.get<shared::DRAW_PILE_TOP>());
+    }
+}
+
+TEST(GameStateTest, EnemySeatsInPlayingOrder)
+{
+    std::vector<shared::CardBase::id_t> selected_cards = test_helper::getValidRandomKingdomCards(10);
+    std::vector<server::Player::id_t> player_ids = {"player1", "player2", "player3", "player4"};
+
+    server::GameState game_state(selected_cards, player_ids);
+
+    // seats follow the order the players were given in
+    for ( server::GameState::seat_t seat = 0; seat < player_ids.size(); ++seat ) {
+        EXPECT_EQ(game_state.getSeat(player_ids[seat]), seat);
+        EXPECT_EQ(game_state.getPlayerId(seat), player_ids[seat]);
+        EXPECT_EQ(&game_state.getPlayer(seat), &game_state.getPlayer(player_ids[seat]));
+    }
+    EXPECT_THROW(game_state.getSeat("nonexistent_player"), std::out_of_range);
+
+    // the enemies of player3 start with the next player and wrap around
+    std::vector<server::GameState::seat_t> enemies;
+    for ( const auto enemy : game_state.getEnemySeats(2) ) {
+        enemies.push_back(enemy);
+    }
+    EXPECT_EQ(enemies, (std::vector<server::GameState::seat_t>{3, 0, 1}));
+}
+
 TEST(GameStateTest, StartTurn)
 {
     // Since start_turn is a private method, we can't call it directly
@@ -5,13 +5,18 @@
 
 using namespace server;
 
+// the player works on card handles, so the tests have to use registered cards
+static shared::CardBase::handle_t handle(const shared::CardBase::id_t &card_id)
+{
+    return shared::CardFactory::getHandle(card_id);
+}
+
 class TestPlayer : public Player
 {
 public:
     using Player::Player;
 
-    // to make setups easier
-    using Player::getMutable;
+    using Player::getDeckCounts;
 
     // expose the functions to test
 };
@@ -61,65 +66,66 @@ TEST(PlayerTest, DrawCards)
 {
     TestPlayer player("player");
 
-    std::vector<std::string> draw_pile = {"Card1", "Card2", "Card3", "Card4", "Card5"};
-    player.getMutable<shared::CardAccess::DRAW_PILE_TOP>() = draw_pile;
+    Player::pile_t draw_pile = {handle("Copper"), handle("Silver"), handle("Gold"), handle("Estate"),
+                                handle("Duchy")};
+    player.add<shared::CardAccess::DRAW_PILE_TOP>(draw_pile);
 
     player.draw(2);
 
     ASSERT_EQ(player.get<shared::CardAccess::HAND>().size(), 2);
-    EXPECT_EQ(player.get<shared::CardAccess::HAND>()[0], "Card1");
-    EXPECT_EQ(player.get<shared::CardAccess::HAND>()[1], "Card2");
+    EXPECT_EQ(player.get<shared::CardAccess::HAND>()[0], handle("Copper"));
+    EXPECT_EQ(player.get<shared::CardAccess::HAND>()[1], handle("Silver"));
 
     ASSERT_EQ(player.get<shared::CardAccess::DRAW_PILE_TOP>().size(), 3);
-    EXPECT_EQ(player.get<shared::CardAccess::DRAW_PILE_TOP>()[0], "Card3");
-    EXPECT_EQ(player.get<shared::CardAccess::DRAW_PILE_TOP>()[1], "Card4");
-    EXPECT_EQ(player.get<shared::CardAccess::DRAW_PILE_TOP>()[2], "Card5");
+    EXPECT_EQ(player.get<shared::CardAccess::DRAW_PILE_TOP>()[0], handle("Gold"));
+    EXPECT_EQ(player.get<shared::CardAccess::DRAW_PILE_TOP>()[1], handle("Estate"));
+    EXPECT_EQ(player.get<shared::CardAccess::DRAW_PILE_TOP>()[2], handle("Duchy"));
 }
 
 TEST(PlayerTest, TrashCard)
 {
     TestPlayer player("player");
-    std::vector<std::string> hand = {"Card1", "Card2", "Card3"};
-    player.getMutable<shared::CardAccess::HAND>() = hand;
+    Player::pile_t hand = {handle("Copper"), handle("Silver"), handle("Gold")};
+    player.add<shared::CardAccess::HAND>(hand);
 
     player.move<shared::CardAccess::HAND, shared::CardAccess::TRASH>(hand[1]);
 
     ASSERT_EQ(player.get<shared::CardAccess::HAND>().size(), 2);
-    EXPECT_EQ(player.get<shared::CardAccess::HAND>()[0], "Card1");
-    EXPECT_EQ(player.get<shared::CardAccess::HAND>()[1], "Card3");
+    EXPECT_EQ(player.get<shared::CardAccess::HAND>()[0], handle("Copper"));
+    EXPECT_EQ(player.get<shared::CardAccess::HAND>()[1], handle("Gold"));
 }
 
 TEST(PlayerTest, DiscardCard)
 {
     TestPlayer player("player");
-    std::vector<std::string> hand = {"Card1", "Card2", "Card3"};
-    player.getMutable<shared::CardAccess::HAND>() = hand;
+    Player::pile_t hand = {handle("Copper"), handle("Silver"), handle("Gold")};
+    player.add<shared::CardAccess::HAND>(hand);
 
     // Discard the second card (index 1)
     player.move<shared::HAND, shared::DISCARD_PILE>(hand[1]);
 
-    // Now hand should have "Card1", "Card3"
+    // Now hand should have "Copper", "Gold"
     ASSERT_EQ(player.get<shared::CardAccess::HAND>().size(), 2);
-    EXPECT_EQ(player.get<shared::CardAccess::HAND>()[0], "Card1");
-    EXPECT_EQ(player.get<shared::CardAccess::HAND>()[1], "Card3");
+    EXPECT_EQ(player.get<shared::CardAccess::HAND>()[0], handle("Copper"));
+    EXPECT_EQ(player.get<shared::CardAccess::HAND>()[1], handle("Gold"));
 
-    // Discard pile should have "Card2"
+    // Discard pile should have "Silver"
     ASSERT_EQ(player.get<shared::CardAccess::DISCARD_PILE>().size(), 1);
-    EXPECT_EQ(player.get<shared::CardAccess::DISCARD_PILE>()[0], "Card2");
+    EXPECT_EQ(player.get<shared::CardAccess::DISCARD_PILE>()[0], handle("Silver"));
 }
 
 TEST(PlayerTest, GainCard)
 {
     TestPlayer player("player");
-    std::vector<std::string> discard_pile = {"Card1", "Card2"};
-    player.getMutable<shared::CardAccess::DISCARD_PILE>() = discard_pile;
+    Player::pile_t discard_pile = {handle("Copper"), handle("Silver")};
+    player.add<shared::CardAccess::DISCARD_PILE>(discard_pile);
 
-    // Add "Card3" to hand
-    player.gain("Card3");
+    // Add "Gold" to hand
+    player.gain(handle("Gold"));
 
-    // Now hand should have "Card1", "Card2", "Card3"
+    // Now hand should have "Copper", "Silver", "Gold"
     ASSERT_EQ(player.get<shared::CardAccess::DISCARD_PILE>().size(), 3);
-    EXPECT_EQ(player.get<shared::CardAccess::DISCARD_PILE>()[2], "Card3");
+    EXPECT_EQ(player.get<shared::CardAccess::DISCARD_PILE>()[2], handle("Gold"));
 }
 
 TEST(PlayerTest, AddToDiscardPile)
@@ -129,12 +135,12 @@ TEST(PlayerTest, AddToDiscardPile)
     // Discard pile is initially empty
     EXPECT_TRUE(player.get<shared::CardAccess::DISCARD_PILE>().empty());
 
-    // Add "Card1" to discard pile
-    player.gain("Card1");
+    // Add "Copper" to discard pile
+    player.gain(handle("Copper"));
 
-    // Now discard pile should have "Card1"
+    // Now discard pile should have "Copper"
     ASSERT_EQ(player.get<shared::CardAccess::DISCARD_PILE>().size(), 1);
-    EXPECT_EQ(player.get<shared::CardAccess::DISCARD_PILE>()[0], "Card1");
+    EXPECT_EQ(player.get<shared::CardAccess::DISCARD_PILE>()[0], handle("Copper"));
 }
 
 TEST(PlayerTest, IncreaseActions)
@@ -171,8 +177,8 @@ TEST(PlayerTest, EndTurn)
     player.addActions(2);
     player.addBuys(1);
     player.addTreasure(3);
-    player.getMutable<shared::CardAccess::HAND>() = {"Card1", "Card2"};
-    player.getMutable<shared::CardAccess::DISCARD_PILE>() = {"Card3"};
+    player.add<shared::CardAccess::HAND>(Player::pile_t{handle("Copper"), handle("Silver")});
+    player.add<shared::CardAccess::DISCARD_PILE>(Player::pile_t{handle("Gold")});
 
     // Call end_turn()
     player.endTurn();
@@ -193,21 +199,21 @@ TEST(PlayerTest, AddCardsToPile)
 {
     TestPlayer player("player");
 
-    // Set up an empty discard pile
-    player.getMutable<shared::CardAccess::DISCARD_PILE>().clear();
+    // Discard pile is initially empty
+    ASSERT_TRUE(player.get<shared::CardAccess::DISCARD_PILE>().empty());
 
     // Add cards to the discard pile
-    player.gain("Card1");
-    player.gain("Card2");
-    player.gain("Card3");
+    player.gain(handle("Copper"));
+    player.gain(handle("Silver"));
+    player.gain(handle("Gold"));
 
     // Verify the discard pile
     const auto &discard_pile = player.get<shared::CardAccess::DISCARD_PILE>();
 
     ASSERT_EQ(discard_pile.size(), 3);
-    EXPECT_EQ(discard_pile[0], "Card1");
-    EXPECT_EQ(discard_pile[1], "Card2");
-    EXPECT_EQ(discard_pile[2], "Card3");
+    EXPECT_EQ(discard_pile[0], handle("Copper"));
+    EXPECT_EQ(discard_pile[1], handle("Silver"));
+    EXPECT_EQ(discard_pile[2], handle("Gold"));
 }
 
 TEST(PlayerTest, GetPile)
@@ -215,16 +221,85 @@ TEST(PlayerTest, GetPile)
     TestPlayer player("player");
 
     // Set up piles
-    player.getMutable<shared::CardAccess::DISCARD_PILE>() = {"Card1", "Card2"};
-    player.getMutable<shared::CardAccess::DRAW_PILE_TOP>() = {"Card3", "Card4"};
-    player.getMutable<shared::CardAccess::HAND>() = {"Card5"};
+    player.add<shared::CardAccess::DISCARD_PILE>(Player::pile_t{handle("Copper"), handle("Silver")});
+    player.add<shared::CardAccess::DRAW_PILE_TOP>(Player::pile_t{handle("Gold"), handle("Estate")});
+    player.add<shared::CardAccess::HAND>(Player::pile_t{handle("Duchy")});
 
     // Access and verify each pile
-    EXPECT_EQ(player.get<shared::CardAccess::DISCARD_PILE>()[0], "Card1");
-    EXPECT_EQ(player.get<shared::CardAccess::DISCARD_PILE>()[1], "Card2");
+    EXPECT_EQ(player.get<shared::CardAccess::DISCARD_PILE>()[0], handle("Copper"));
+    EXPECT_EQ(player.get<shared::CardAccess::DISCARD_PILE>()[1], handle("Silver"));
+
+    EXPECT_EQ(player.get<shared::CardAccess::DRAW_PILE_TOP>()[0], handle("Gold"));
+    EXPECT_EQ(player.get<shared::CardAccess::DRAW_PILE_TOP>()[1], handle("Estate"));
+
+    EXPECT_EQ(player.get<shared::CardAccess::HAND>()[0], handle("Duchy"));
+}
+
+TEST(PlayerTest, CardCountsFollowPiles)
+{
+    TestPlayer player("player");
+    player.add<shared::CardAccess::DRAW_PILE_TOP>(
+            Player::pile_t{handle("Copper"), handle("Copper"), handle("Estate"), handle("Village")});
+
+    player.draw(3);
 
-    EXPECT_EQ(player.get<shared::CardAccess::DRAW_PILE_TOP>()[0], "Card3");
-    EXPECT_EQ(player.get<shared::CardAccess::DRAW_PILE_TOP>()[1], "Card4");
+    EXPECT_EQ(player.getCounts<shared::CardAccess::HAND>().count(handle("Copper")), 2);
+    EXPECT_EQ(player.getCounts<shared::CardAccess::HAND>().count(handle("Estate")), 1);
+    EXPECT_EQ(player.getCounts<shared::CardAccess::DRAW_PILE_TOP>().size(), 1);
+    EXPECT_TRUE(player.hasCard<shared::CardAccess::DRAW_PILE_TOP>(handle("Village")));
+    EXPECT_FALSE(player.hasType<shared::CardAccess::HAND>(shared::CardType::ACTION));
 
-    EXPECT_EQ(player.get<shared::CardAccess::HAND>()[0], "Card5");
+    player.move<shared::CardAccess::HAND, shared::CardAccess::TRASH>(handle("Copper"));
+    player.move<shared::CardAccess::HAND, shared::CardAccess::DISCARD_PILE>(handle("Estate"));
+
+    EXPECT_EQ(player.getCounts<shared::CardAccess::HAND>().count(handle("Copper")), 1);
+    EXPECT_FALSE(player.hasCard<shared::CardAccess::HAND>(handle("Estate")));
+    EXPECT_TRUE(player.hasCard<shared::CardAccess::DISCARD_PILE>(handle("Estate")));
+    EXPECT_EQ(player.getDeckCounts().size(), 3);
+}
+
+TEST(PlayerTest, MoveCardsBetweenPiles)
+{
+    TestPlayer player("player");
+    player.add<shared::CardAccess::DRAW_PILE_TOP>(Player::pile_t{handle("Copper"), handle("Estate")});
+    player.add<shared::CardAccess::DRAW_PILE_TOP>(handle("Gold"));
+    player.add<shared::CardAccess::DRAW_PILE_BOTTOM>(handle("Duchy"));
+    EXPECT_THAT(player.get<shared::CardAccess::DRAW_PILE_TOP>(),
+                testing::ElementsAre(handle("Gold"), handle("Copper"), handle("Estate"), handle("Duchy")));
+
+    player.draw(3);
+    EXPECT_THAT(player.get<shared::CardAccess::HAND>(),
+                testing::ElementsAre(handle("Gold"), handle("Copper"), handle("Estate")));
+
+    // the last card of the hand takes the place of the taken one
+    player.move<shared::CardAccess::HAND, shared::CardAccess::DISCARD_PILE>(handle("Gold"));
+    EXPECT_THAT(player.get<shared::CardAccess::HAND>(), testing::ElementsAre(handle("Estate"), handle("Copper")));
+
+    // either all cards are moved or none
+    EXPECT_THROW((player.move<shared::CardAccess::HAND, shared::CardAccess::TRASH>(
+                         Player::pile_t{handle("Copper"), handle("Copper")})),
+                 exception::InvalidCardAccess);
+    EXPECT_EQ(player.get<shared::CardAccess::HAND>().size(), 2);
+    EXPECT_EQ(player.getCounts<shared::CardAccess::HAND>().size(), 2);
+
+    player.move<shared::CardAccess::HAND, shared::CardAccess::DISCARD_PILE>(
+            Player::pile_t{handle("Copper"), handle("Estate")});
+    EXPECT_TRUE(player.get<shared::CardAccess::HAND>().empty());
+    EXPECT_THAT(player.get<shared::CardAccess::DISCARD_PILE>(),
+                testing::ElementsAre(handle("Gold"), handle("Copper"), handle("Estate")));
+    EXPECT_EQ(player.getCounts<shared::CardAccess::DISCARD_PILE>().size(), 3);
+}
+
+TEST(PlayerTest, VictoryPoints)
+{
+    TestPlayer player("player");
+    Player::pile_t deck(17, handle("Copper"));
+    deck.push_back(handle("Estate"));
+    deck.push_back(handle("Duchy"));
+    deck.push_back(handle("Gardens"));
+    player.add<shared::CardAccess::DRAW_PILE_TOP>(deck);
+    player.draw(5);
+
+    // 1 (Estate) + 3 (Duchy) + 2 (Gardens, 20 cards)
+    EXPECT_EQ(player.getVictoryPoints(), 6);
 }
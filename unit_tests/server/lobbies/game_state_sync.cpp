@@ -0,0 +1,70 @@
+#include <gtest/gtest.h>
+
+#include <server/lobbies/game_state_sync.h>
+#include <shared/utils/test_helpers.h>
+
+using namespace server;
+
+namespace
+{
+    const shared::PlayerBase::id_t PLAYER = "player";
+}
+
+TEST(GameStateSyncTest, KeyframeThenDeltas)
+{
+    GameStateSync sync;
+    auto state = test_helper::getReducedGameStatePtr(3);
+
+    auto first = sync.makeUpdate("lobby", PLAYER, state->clone());
+    const auto *keyframe = dynamic_cast<shared::GameStateMessage *>(first.get());
+    ASSERT_NE(keyframe, nullptr);
+    EXPECT_EQ(keyframe->version, 1);
+
+    // the client applies every delta to the state it has
+    std::unique_ptr<reduced::GameState> client_state = keyframe->game_state->clone();
+    for ( unsigned int version = 2; version <= 5; ++version ) {
+        state->board->getCurseCardPile().count -= 1;
+        state->board->getPlayedCards().push_back("Copper");
+
+        auto update = sync.makeUpdate("lobby", PLAYER, state->clone());
+        const auto *delta = dynamic_cast<shared::GameStateDeltaMessage *>(update.get());
+        ASSERT_NE(delta, nullptr);
+        EXPECT_EQ(delta->base_version, version - 1);
+        EXPECT_EQ(delta->version, version);
+
+        delta->delta->applyTo(*client_state);
+        EXPECT_EQ(*client_state, *state);
+    }
+}
+
+TEST(GameStateSyncTest, KeyframeAfterInterval)
+{
+    GameStateSync sync;
+    auto state = test_helper::getReducedGameStatePtr(2);
+
+    sync.makeUpdate("lobby", PLAYER, state->clone());
+    for ( unsigned int i = 0; i < GameStateSync::KEYFRAME_INTERVAL; ++i ) {
+        auto update = sync.makeUpdate("lobby", PLAYER, state->clone());
+        ASSERT_NE(dynamic_cast<shared::GameStateDeltaMessage *>(update.get()), nullptr);
+    }
+
+    auto update = sync.makeUpdate("lobby", PLAYER, state->clone());
+    ASSERT_NE(dynamic_cast<shared::GameStateMessage *>(update.get()), nullptr);
+}
+
+TEST(GameStateSyncTest, RequestedStateIsKeyframe)
+{
+    GameStateSync sync;
+    auto state = test_helper::getReducedGameStatePtr(2);
+
+    sync.makeUpdate("lobby", PLAYER, state->clone());
+    auto response = sync.makeUpdate("lobby", PLAYER, state->clone(), "request");
+    const auto *keyframe = dynamic_cast<shared::GameStateMessage *>(response.get());
+    ASSERT_NE(keyframe, nullptr);
+    EXPECT_EQ(keyframe->in_response_to, "request");
+    EXPECT_EQ(keyframe->version, 2);
+
+    sync.requestKeyframe(PLAYER);
+    auto update = sync.makeUpdate("lobby", PLAYER, state->clone());
+    ASSERT_NE(dynamic_cast<shared::GameStateMessage *>(update.get()), nullptr);
+}
@@ -162,6 +162,35 @@ TEST(ServerLibraryTest, StartGame)
     LOBBY_MANAGER_CALL(valid_request);
 }
 
+TEST(ServerLibraryTest, StartGameWithUnsupportedCard)
+{
+    std::shared_ptr<MockMessageInterface> message_interface = std::make_shared<MockMessageInterface>();
+    server::LobbyManager lobby_manager(message_interface);
+    shared::PlayerBase::id_t game_master = "Max";
+    shared::PlayerBase::id_t player_2 = "Peter";
+
+    auto create_lobby = std::make_unique<shared::CreateLobbyRequestMessage>("123", game_master);
+    auto join_lobby = std::make_unique<shared::JoinLobbyRequestMessage>("123", player_2);
+
+    // the client can not answer the orders of Library yet
+    std::vector<shared::CardBase::id_t> selected_cards = getValidKingdomCards();
+    selected_cards.back() = "Library";
+    auto unsupported_request = std::make_unique<shared::StartGameRequestMessage>("123", game_master, selected_cards);
+    auto valid_request = std::make_unique<shared::StartGameRequestMessage>("123", game_master, getValidKingdomCards());
+
+    LOBBY_MANAGER_CALL(create_lobby);
+    LOBBY_MANAGER_CALL(join_lobby);
+
+    {
+        InSequence s;
+        EXPECT_CALL(*message_interface, sendMessage(IsFailureMessage(), game_master)).Times(1);
+        EXPECT_CALL(*message_interface, sendMessage(_, _)).Times(4);
+    }
+
+    LOBBY_MANAGER_CALL(unsupported_request);
+    LOBBY_MANAGER_CALL(valid_request);
+}
+
 TEST(ServerLibraryTest, ReceiveAction)
 {
     std::shared_ptr<MockMessageInterface> message_interface = std::make_shared<MockMessageInterface>();
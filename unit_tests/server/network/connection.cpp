@@ -0,0 +1,126 @@
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include <sys/epoll.h>
+#include <unistd.h>
+
+#include <sockpp/tcp_acceptor.h>
+#include <sockpp/tcp_connector.h>
+
+#include <server/network/connection.h>
+#include <server/network/network_metrics.h>
+#include <shared/utils/frame_decoder.h>
+
+namespace
+{
+    /**
+     * @brief A server side connection and the client socket it talks to, over loopback.
+     */
+    struct LoopbackPair
+    {
+        LoopbackPair()
+        {
+            sockpp::initialize();
+            acceptor.open(sockpp::inet_address("127.0.0.1", 0));
+            client.connect(acceptor.address());
+            epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+            connection = std::make_shared<server::Connection>(acceptor.accept().release(), epoll_fd);
+
+            epoll_event event{};
+            event.events = EPOLLIN | EPOLLRDHUP;
+            event.data.fd = connection->getHandle();
+            epoll_ctl(epoll_fd, EPOLL_CTL_ADD, connection->getHandle(), &event);
+        }
+
+        ~LoopbackPair()
+        {
+            connection->close();
+            ::close(epoll_fd);
+        }
+
+        sockpp::tcp_acceptor acceptor;
+        sockpp::tcp_connector client;
+        int epoll_fd = -1;
+        server::Connection::ptr_t connection;
+    };
+} // namespace
+
+TEST(ConnectionTest, SendOnlyQueues)
+{
+    LoopbackPair pair;
+    const auto frame = shared::encodeFrame("hello");
+
+    EXPECT_EQ(pair.connection->send(frame), frame.size());
+    // nothing is written before the I/O thread gets to it
+    EXPECT_EQ(pair.connection->getQueuedBytes(), frame.size());
+
+    ASSERT_TRUE(pair.connection->onWritable());
+    EXPECT_EQ(pair.connection->getQueuedBytes(), 0);
+
+    std::string received(frame.size(), '\0');
+    EXPECT_EQ(pair.client.read_n(received.data(), received.size()).value(), frame.size());
+    EXPECT_EQ(received, frame);
+}
+
+TEST(ConnectionTest, BatchesQueuedFrames)
+{
+    LoopbackPair pair;
+    auto &metrics = server::NetworkMetrics::get();
+    const auto calls_before = metrics.write_calls.load();
+
+    constexpr int FRAMES = 100;
+    std::string expected;
+    for ( int i = 0; i < FRAMES; ++i ) {
+        auto frame = shared::encodeFrame("message " + std::to_string(i));
+        expected += frame;
+        pair.connection->send(std::move(frame));
+    }
+    ASSERT_TRUE(pair.connection->onWritable());
+    EXPECT_EQ(pair.connection->getQueuedBytes(), 0);
+    // 64 frames per call
+    EXPECT_LE(metrics.write_calls.load() - calls_before, 2);
+
+    std::string received(expected.size(), '\0');
+    EXPECT_EQ(pair.client.read_n(received.data(), received.size()).value(), expected.size());
+    EXPECT_EQ(received, expected);
+}
+
+TEST(ConnectionTest, EvictsSlowConsumer)
+{
+    LoopbackPair pair;
+    auto &metrics = server::NetworkMetrics::get();
+    const auto slow_before = metrics.slow_consumers.load();
+
+    // the client never reads, so the queue has to overflow eventually
+    const auto frame = shared::encodeFrame(std::string(64 * 1024, 'x'));
+    ssize_t res = 0;
+    for ( size_t i = 0; i < 2 * server::Connection::MAX_QUEUED_BYTES / frame.size() && res >= 0; ++i ) {
+        res = pair.connection->send(frame);
+        pair.connection->onWritable();
+    }
+
+    EXPECT_EQ(res, -1);
+    EXPECT_EQ(metrics.slow_consumers.load(), slow_before + 1);
+    EXPECT_EQ(pair.connection->send(frame), -1) << "an evicted connection does not accept frames anymore";
+}
+
+TEST(ConnectionTest, SharedFrameIsNotCopied)
+{
+    LoopbackPair first;
+    LoopbackPair second;
+    const auto frame = std::make_shared<const std::string>(shared::encodeFrame("broadcast"));
+
+    EXPECT_EQ(first.connection->send(frame), frame->size());
+    EXPECT_EQ(second.connection->send(frame), frame->size());
+    // both queues reference the buffer of the caller
+    EXPECT_EQ(frame.use_count(), 3);
+
+    for ( auto *pair : {&first, &second} ) {
+        ASSERT_TRUE(pair->connection->onWritable());
+        std::string received(frame->size(), '\0');
+        EXPECT_EQ(pair->client.read_n(received.data(), received.size()).value(), frame->size());
+        EXPECT_EQ(received, *frame);
+    }
+    EXPECT_EQ(frame.use_count(), 1);
+}
@@ -0,0 +1,91 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <future>
+#include <vector>
+
+#include <server/utils/mailbox.h>
+#include <server/utils/worker_pool.h>
+
+TEST(WorkerPoolTest, RunsAllTasks)
+{
+    std::atomic<int> counter{0};
+    {
+        server::WorkerPool pool(4);
+        for ( int i = 0; i < 1000; ++i ) {
+            pool.submit([&counter] { ++counter; });
+        }
+        // the destructor runs what is still queued
+    }
+    EXPECT_EQ(counter, 1000);
+}
+
+TEST(WorkerPoolTest, TasksCanOwnMoveOnlyState)
+{
+    std::promise<int> promise;
+    auto result = promise.get_future();
+    {
+        server::WorkerPool pool(1);
+        auto value = std::make_unique<int>(42);
+        pool.submit([value = std::move(value), &promise] { promise.set_value(*value); });
+    }
+    EXPECT_EQ(result.get(), 42);
+}
+
+TEST(MailboxTest, InlineWithoutPool)
+{
+    server::Mailbox mailbox;
+    std::vector<int> order;
+
+    mailbox.post(
+            [&]
+            {
+                order.push_back(1);
+                // posted while the mailbox is drained, runs after the current task
+                mailbox.post([&] { order.push_back(3); });
+                order.push_back(2);
+            });
+
+    EXPECT_EQ(order, (std::vector<int>{1, 2, 3}));
+    EXPECT_EQ(mailbox.size(), 0);
+}
+
+TEST(MailboxTest, SerialisesTasksOnPool)
+{
+    constexpr int MAILBOXES = 8;
+    constexpr int TASKS = 500;
+
+    std::vector<std::vector<int>> order(MAILBOXES);
+    std::atomic<int> running[MAILBOXES] = {};
+    std::atomic<bool> overlapped{false};
+    {
+        server::WorkerPool pool(4);
+        std::vector<std::unique_ptr<server::Mailbox>> mailboxes;
+        for ( int m = 0; m < MAILBOXES; ++m ) {
+            mailboxes.push_back(std::make_unique<server::Mailbox>(&pool));
+        }
+
+        for ( int i = 0; i < TASKS; ++i ) {
+            for ( int m = 0; m < MAILBOXES; ++m ) {
+                mailboxes[m]->post(
+                        [&, m, i]
+                        {
+                            if ( running[m]++ != 0 ) {
+                                overlapped = true;
+                            }
+                            // not synchronised on purpose, the mailbox has to do that
+                            order[m].push_back(i);
+                            --running[m];
+                        });
+            }
+        }
+    }
+
+    EXPECT_FALSE(overlapped);
+    for ( const auto &tasks : order ) {
+        ASSERT_EQ(tasks.size(), TASKS);
+        for ( int i = 0; i < TASKS; ++i ) {
+            EXPECT_EQ(tasks[i], i);
+        }
+    }
+}
@@ -0,0 +1,61 @@
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <server/utils/sharded_map.h>
+
+TEST(ShardedMapTest, BasicOperations)
+{
+    server::ShardedMap<std::string, int, 4> map;
+
+    EXPECT_FALSE(map.find("a").has_value());
+
+    EXPECT_EQ(map.tryEmplace("a", 1), std::make_pair(1, true));
+    // an existing value is not overwritten
+    EXPECT_EQ(map.tryEmplace("a", 2), std::make_pair(1, false));
+    EXPECT_EQ(map.find("a"), 1);
+    EXPECT_EQ(map.size(), 1);
+
+    EXPECT_FALSE(map.eraseIf("a", 2));
+    EXPECT_TRUE(map.eraseIf("a", 1));
+    EXPECT_FALSE(map.find("a").has_value());
+
+    map.tryEmplace("b", 3);
+    EXPECT_EQ(map.take("b"), 3);
+    EXPECT_FALSE(map.take("b").has_value());
+    EXPECT_EQ(map.size(), 0);
+}
+
+TEST(ShardedMapTest, ConcurrentWriters)
+{
+    constexpr int THREADS = 4;
+    constexpr int KEYS = 2000;
+
+    server::ShardedMap<std::string, std::shared_ptr<int>> map;
+    std::vector<std::thread> threads;
+    for ( int t = 0; t < THREADS; ++t ) {
+        threads.emplace_back(
+                [&map, t]
+                {
+                    for ( int i = 0; i < KEYS; ++i ) {
+                        const std::string key = std::to_string(i);
+                        // every thread races for the same keys, exactly one of them wins each
+                        map.tryEmplace(key, std::make_shared<int>(t));
+                        map.find(key);
+                    }
+                });
+    }
+    for ( auto &thread : threads ) {
+        thread.join();
+    }
+
+    EXPECT_EQ(map.size(), KEYS);
+    for ( int i = 0; i < KEYS; ++i ) {
+        const auto value = map.find(std::to_string(i));
+        ASSERT_TRUE(value.has_value());
+        EXPECT_TRUE(**value >= 0 && **value < THREADS);
+    }
+}
@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 #include <shared/game/cards/card_base.h>
+#include <shared/game/cards/card_factory.h>
 
 TEST(CardBaseTest, ConstructorAndGetters)
 {
@@ -181,3 +182,30 @@ TEST(CardBaseTest, CostTest)
     EXPECT_EQ(card2.getCost(), 3);
     EXPECT_EQ(card3.getCost(), 6);
 }
+
+TEST(CardFactoryTest, HandleRoundTrip)
+{
+    for ( const auto &[card_id, card] : shared::CardFactory::getAll() ) {
+        const auto handle = shared::CardFactory::getHandle(card_id);
+
+        ASSERT_LT(shared::toIndex(handle), shared::CardFactory::size());
+        EXPECT_EQ(shared::CardFactory::getId(handle), card_id);
+        EXPECT_EQ(shared::CardFactory::getCost(handle), card->getCost());
+        EXPECT_EQ(shared::CardFactory::getType(handle), card->getType());
+    }
+}
+
+TEST(CardFactoryTest, HandleOfUnknownCardThrows)
+{
+    EXPECT_THROW(shared::CardFactory::getHandle("NonExistentCard"), std::invalid_argument);
+}
+
+TEST(CardFactoryTest, CompileTimeHandles)
+{
+    constexpr auto copper = shared::cardHandle("Copper");
+    static_assert(shared::CardFactory::isTreasure(copper));
+    static_assert(shared::CardFactory::getCost(shared::cardHandle("Province")) == 8);
+
+    EXPECT_EQ(copper, shared::CardFactory::getHandle("Copper"));
+    EXPECT_EQ(shared::CardFactory::getAll().size(), shared::CardFactory::size());
+}
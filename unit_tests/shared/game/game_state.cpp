@@ -2,6 +2,7 @@
 
 #include <gtest/gtest.h>
 #include <shared/game/game_state/reduced_game_state.h>
+#include <shared/utils/exception.h>
 #include <shared/utils/test_helpers.h>
 
 TEST(ReducedGameStateTest, Json2WayConversion)
@@ -73,3 +74,94 @@ TEST(ReducedGameStateTest, ParameterizedConstructor)
     EXPECT_EQ(game_state.reduced_enemies[0]->getId(), "enemy1");
     EXPECT_EQ(game_state.reduced_enemies[1]->getId(), "enemy2");
 }
+
+namespace
+{
+    // a state a few moves after the given one
+    std::unique_ptr<reduced::GameState> advance(const reduced::GameState &from)
+    {
+        std::unique_ptr<reduced::GameState> to = from.clone();
+
+        to->board->getKingdomCards().begin()->count -= 1;
+        to->board->getCurseCardPile().count -= 1;
+        to->board->getPlayedCards().push_back("Village");
+
+        to->reduced_player->decActions();
+        std::vector<shared::CardBase::id_t> hand_cards = to->reduced_player->getHandCards();
+        hand_cards.erase(hand_cards.begin());
+        to->reduced_player = reduced::Player::make(*to->reduced_player, hand_cards);
+
+        to->reduced_enemies.back() = reduced::Enemy::make(*to->reduced_enemies.back(), 2);
+        to->active_player = to->reduced_enemies.front()->getId();
+        to->game_phase = shared::GamePhase::BUY_PHASE;
+        return to;
+    }
+} // namespace
+
+TEST(ReducedGameStateTest, CloneIsIndependent)
+{
+    auto original = test_helper::getReducedGameStatePtr(3);
+    auto copy = original->clone();
+    ASSERT_EQ(*copy, *original);
+
+    copy->board->getCurseCardPile().count -= 1;
+    EXPECT_NE(*copy, *original);
+}
+
+TEST(ReducedGameStateTest, DeltaTransformsState)
+{
+    auto from = test_helper::getReducedGameStatePtr(4);
+    auto to = advance(*from);
+
+    auto delta = reduced::GameState::Delta::make(*from, *to);
+    ASSERT_NE(delta, nullptr);
+    ASSERT_TRUE(delta->board.has_value());
+    EXPECT_EQ(delta->board->piles.size(), 2);
+    // only the enemy whose hand changed
+    EXPECT_EQ(delta->reduced_enemies.size(), 1);
+
+    delta->applyTo(*from);
+    EXPECT_EQ(*from, *to);
+    EXPECT_EQ(from->board->getPlayedCards(), to->board->getPlayedCards());
+    EXPECT_EQ(from->game_phase, to->game_phase);
+}
+
+TEST(ReducedGameStateTest, DeltaOfEqualStatesIsEmpty)
+{
+    auto state = test_helper::getReducedGameStatePtr(2);
+
+    auto delta = reduced::GameState::Delta::make(*state, *state->clone());
+    ASSERT_NE(delta, nullptr);
+    EXPECT_TRUE(delta->empty());
+}
+
+TEST(ReducedGameStateTest, DeltaTwoWayConversion)
+{
+    auto from = test_helper::getReducedGameStatePtr(3);
+    auto delta = reduced::GameState::Delta::make(*from, *advance(*from));
+    ASSERT_NE(delta, nullptr);
+
+    auto from_json = reduced::GameState::Delta::fromJson(delta->toJson());
+    ASSERT_NE(from_json, nullptr);
+    EXPECT_EQ(*from_json, *delta);
+
+    shared::BinaryWriter writer;
+    delta->toBinary(writer);
+    const std::string binary = writer.release();
+    shared::BinaryReader reader(binary);
+    auto from_binary = reduced::GameState::Delta::fromBinary(reader);
+    EXPECT_TRUE(reader.atEnd());
+    EXPECT_EQ(*from_binary, *delta);
+}
+
+TEST(ReducedGameStateTest, DeltaRequiresSamePlayers)
+{
+    auto three_players = test_helper::getReducedGameStatePtr(3);
+    auto four_players = test_helper::getReducedGameStatePtr(4);
+    EXPECT_EQ(reduced::GameState::Delta::make(*three_players, *four_players), nullptr);
+
+    // a delta that touches an enemy the state does not have
+    auto delta = reduced::GameState::Delta::make(*four_players, *advance(*four_players));
+    ASSERT_NE(delta, nullptr);
+    EXPECT_THROW(delta->applyTo(*three_players), exception::DeltaMismatch);
+}
@@ -0,0 +1,200 @@
+#include <gtest/gtest.h>
+
+#include <shared/message_types.h>
+#include <shared/player_result.h>
+#include <shared/utils/test_helpers.h>
+
+using namespace shared;
+
+namespace
+{
+    template <typename Message, typename Base>
+    std::unique_ptr<Message> roundTrip(const Message &original)
+    {
+        const std::string binary = original.toBinary();
+        EXPECT_EQ(detectWireFormat(binary), WireFormat::BINARY);
+
+        std::unique_ptr<Base> base_message = Base::fromBinary(binary);
+        return std::unique_ptr<Message>(dynamic_cast<Message *>(base_message.release()));
+    }
+
+    std::unique_ptr<ActionDecisionMessage> makeDecisionMessage(std::unique_ptr<ActionDecision> decision)
+    {
+        return std::make_unique<ActionDecisionMessage>("123", "player1", std::move(decision), "789", "456");
+    }
+} // namespace
+
+// ======= SERVER TO CLIENT MESSAGES ======= //
+
+TEST(SharedLibraryTest, GameStateMessageBinaryTwoWayConversion)
+{
+    GameStateMessage original_message("123", test_helper::getReducedGameStatePtr(3), "789", "456");
+    original_message.version = 3;
+
+    const auto parsed_message = roundTrip<GameStateMessage, ServerToClientMessage>(original_message);
+
+    ASSERT_NE(parsed_message, nullptr);
+    ASSERT_EQ(*parsed_message, original_message);
+}
+
+TEST(SharedLibraryTest, GameStateDeltaMessageBinaryTwoWayConversion)
+{
+    auto from = test_helper::getReducedGameStatePtr(3);
+    auto to = from->clone();
+    to->board->getCurseCardPile().count -= 1;
+    to->reduced_player->decBuys();
+    to->active_player = to->reduced_enemies.front()->getId();
+
+    GameStateDeltaMessage original_message("123", 7, 8, reduced::GameState::Delta::make(*from, *to), "456");
+
+    const auto parsed_message = roundTrip<GameStateDeltaMessage, ServerToClientMessage>(original_message);
+
+    ASSERT_NE(parsed_message, nullptr);
+    ASSERT_EQ(*parsed_message, original_message);
+}
+
+TEST(SharedLibraryTest, CreateLobbyResponseMessageBinaryTwoWayConversion)
+{
+    CreateLobbyResponseMessage original_message("123", "789");
+    original_message.available_cards = getValidKingdomCards();
+
+    const auto parsed_message = roundTrip<CreateLobbyResponseMessage, ServerToClientMessage>(original_message);
+
+    ASSERT_NE(parsed_message, nullptr);
+    ASSERT_EQ(*parsed_message, original_message);
+    ASSERT_EQ(parsed_message->available_cards, original_message.available_cards);
+}
+
+TEST(SharedLibraryTest, EndGameBroadcastMessageBinaryTwoWayConversion)
+{
+    std::vector<PlayerResult> results = {{"player1", 10}, {"player2", -3}, {"player3", 0}};
+    EndGameBroadcastMessage original_message("123", results, UINT64_MAX);
+
+    const auto parsed_message = roundTrip<EndGameBroadcastMessage, ServerToClientMessage>(original_message);
+
+    ASSERT_NE(parsed_message, nullptr);
+    ASSERT_EQ(*parsed_message, original_message);
+}
+
+TEST(SharedLibraryTest, ResultResponseMessageBinaryTwoWayConversion)
+{
+    ResultResponseMessage original_message("123", false, std::nullopt, "hey");
+
+    const auto parsed_message = roundTrip<ResultResponseMessage, ServerToClientMessage>(original_message);
+
+    ASSERT_NE(parsed_message, nullptr);
+    ASSERT_EQ(*parsed_message, original_message);
+}
+
+TEST(SharedLibraryTest, ActionOrderMessageBinaryTwoWayConversion)
+{
+    std::vector<std::unique_ptr<ActionOrder>> orders;
+    orders.push_back(std::make_unique<ActionPhaseOrder>());
+    orders.push_back(std::make_unique<BuyPhaseOrder>());
+    orders.push_back(std::make_unique<EndTurnOrder>());
+    orders.push_back(std::make_unique<GainFromBoardOrder>(4, CardType::TREASURE));
+    orders.push_back(std::make_unique<ChooseFromHandOrder>(0, 4, ChooseFromOrder::AllowedChoice::TRASH));
+    orders.push_back(std::make_unique<ChooseFromHandOrder>(0, 1, ChooseFromOrder::AllowedChoice::PLAY,
+                                                           CardType::ACTION, CardType::ACTION));
+    // ids that are not registered cards fall back to strings
+    orders.push_back(std::make_unique<ChooseFromStagedOrder>(1, 1, ChooseFromOrder::AllowedChoice::DISCARD,
+                                                             std::vector<CardBase::id_t>{"Gold", "a card"}));
+
+    for ( auto &order : orders ) {
+        ActionOrderMessage original_message("123", std::move(order), test_helper::getReducedGameStatePtr(4),
+                                            "description");
+
+        const auto parsed_message = roundTrip<ActionOrderMessage, ServerToClientMessage>(original_message);
+
+        ASSERT_NE(parsed_message, nullptr);
+        ASSERT_EQ(*parsed_message, original_message);
+    }
+}
+
+// ======= CLIENT TO SERVER MESSAGES ======= //
+
+TEST(SharedLibraryTest, StartGameRequestMessageBinaryTwoWayConversion)
+{
+    StartGameRequestMessage original_message("123", "player1", getValidKingdomCards());
+
+    const auto parsed_message = roundTrip<StartGameRequestMessage, ClientToServerMessage>(original_message);
+
+    ASSERT_NE(parsed_message, nullptr);
+    ASSERT_EQ(*parsed_message, original_message);
+}
+
+TEST(SharedLibraryTest, ActionDecisionMessageBinaryTwoWayConversion)
+{
+    std::vector<std::unique_ptr<ActionDecisionMessage>> messages;
+    messages.push_back(makeDecisionMessage(std::make_unique<PlayActionCardDecision>("Village", CardAccess::HAND)));
+    messages.push_back(makeDecisionMessage(std::make_unique<BuyCardDecision>("Province")));
+    messages.push_back(makeDecisionMessage(std::make_unique<EndActionPhaseDecision>()));
+    messages.push_back(makeDecisionMessage(std::make_unique<EndTurnDecision>()));
+    messages.push_back(makeDecisionMessage(std::make_unique<DeckChoiceDecision>(
+            std::vector<CardBase::id_t>{"Copper", "Estate"},
+            std::vector<ChooseFromOrder::AllowedChoice>{ChooseFromOrder::TRASH, ChooseFromOrder::DISCARD})));
+    messages.push_back(makeDecisionMessage(std::make_unique<GainFromBoardDecision>("Silver")));
+
+    for ( const auto &original_message : messages ) {
+        const auto parsed_message = roundTrip<ActionDecisionMessage, ClientToServerMessage>(*original_message);
+
+        ASSERT_NE(parsed_message, nullptr);
+        ASSERT_EQ(*parsed_message, *original_message);
+    }
+}
+
+// ======= WIRE FORMAT ======= //
+
+TEST(SharedLibraryTest, DecodeAcceptsBothWireFormats)
+{
+    const JoinLobbyRequestMessage original_message("123", "player1", "456");
+
+    for ( const auto format : {WireFormat::JSON, WireFormat::BINARY} ) {
+        const std::string payload = original_message.encode(format);
+        ASSERT_EQ(detectWireFormat(payload), format);
+
+        std::unique_ptr<ClientToServerMessage> base_message = ClientToServerMessage::decode(payload);
+        const auto *parsed_message = dynamic_cast<JoinLobbyRequestMessage *>(base_message.get());
+        ASSERT_NE(parsed_message, nullptr);
+        ASSERT_EQ(*parsed_message, original_message);
+    }
+}
+
+TEST(SharedLibraryTest, BinaryGameStateIsSmallerThanJson)
+{
+    const GameStateMessage message("123", test_helper::getReducedGameStatePtr(4), "789", "456");
+
+    EXPECT_LT(message.toBinary().size() * 3, message.toJson().size());
+}
+
+TEST(SharedLibraryTest, GameStateDeltaIsSmallerThanGameState)
+{
+    auto from = test_helper::getReducedGameStatePtr(4);
+    auto to = from->clone();
+    to->reduced_player->decActions();
+    to->game_phase = GamePhase::BUY_PHASE;
+
+    const GameStateMessage full_message("123", to->clone(), std::nullopt, "456");
+    const GameStateDeltaMessage delta_message("123", 1, 2, reduced::GameState::Delta::make(*from, *to), "456");
+
+    EXPECT_LT(delta_message.toBinary().size() * 3, full_message.toBinary().size());
+    EXPECT_LT(delta_message.toJson().size() * 4, full_message.toJson().size());
+}
+
+TEST(SharedLibraryTest, TruncatedBinaryMessageIsRejected)
+{
+    const std::string binary = GameStateMessage("123", test_helper::getReducedGameStatePtr(2), "789").toBinary();
+
+    for ( size_t size = 0; size < binary.size(); ++size ) {
+        EXPECT_EQ(ServerToClientMessage::fromBinary(std::string_view(binary).substr(0, size)), nullptr)
+                << "accepted a prefix of " << size << " bytes";
+    }
+    EXPECT_EQ(ServerToClientMessage::fromBinary(binary + '\0'), nullptr);
+}
+
+TEST(SharedLibraryTest, BinaryMessageOfOtherDirectionIsRejected)
+{
+    const std::string binary = StartGameBroadcastMessage("123").toBinary();
+    EXPECT_EQ(ClientToServerMessage::fromBinary(binary), nullptr);
+    EXPECT_NE(ServerToClientMessage::fromBinary(binary), nullptr);
+}
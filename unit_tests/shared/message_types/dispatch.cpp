@@ -0,0 +1,67 @@
+#include <gtest/gtest.h>
+
+#include <shared/action_decision.h>
+#include <shared/message_types.h>
+#include <shared/utils/tag_cast.h>
+#include <shared/utils/test_helpers.h>
+
+using namespace shared;
+
+TEST(SharedLibraryTest, MessagesCarryTheirTag)
+{
+    const JoinLobbyRequestMessage join("123", "player1");
+    const StartGameBroadcastMessage start("123");
+    const ActionDecisionMessage decision("123", "player1", std::make_unique<EndTurnDecision>());
+
+    EXPECT_EQ(join.getTag(), MessageTag::JOIN_LOBBY_REQUEST);
+    EXPECT_EQ(start.getTag(), MessageTag::START_GAME_BROADCAST);
+    EXPECT_EQ(decision.getTag(), MessageTag::ACTION_DECISION);
+    EXPECT_EQ(decision.decision->getTag(), DecisionTag::END_TURN);
+}
+
+TEST(SharedLibraryTest, TagCastChecksTheTag)
+{
+    std::unique_ptr<ClientToServerMessage> message = std::make_unique<GameStateRequestMessage>("123", "player1");
+
+    EXPECT_EQ(tagCast<JoinLobbyRequestMessage>(message.get()), nullptr);
+    EXPECT_EQ(tagCast<GameStateRequestMessage>(message.get()), message.get());
+    EXPECT_EQ(tagCast<GameStateRequestMessage>(static_cast<ClientToServerMessage *>(nullptr)), nullptr);
+
+    // ownership only moves on a match
+    EXPECT_EQ(tagCast<JoinLobbyRequestMessage>(message), nullptr);
+    ASSERT_NE(message, nullptr);
+    const auto request = tagCast<GameStateRequestMessage>(message);
+    EXPECT_NE(request, nullptr);
+    EXPECT_EQ(message, nullptr);
+}
+
+TEST(SharedLibraryTest, VisitDispatchesOnTheTag)
+{
+    std::vector<std::unique_ptr<ActionDecision>> decisions;
+    decisions.push_back(std::make_unique<PlayActionCardDecision>("Village"));
+    decisions.push_back(std::make_unique<BuyCardDecision>("Gold"));
+    decisions.push_back(std::make_unique<EndActionPhaseDecision>());
+    decisions.push_back(std::make_unique<EndTurnDecision>());
+    decisions.push_back(std::make_unique<DeckChoiceDecision>(std::vector<CardBase::id_t>{"Copper"},
+                                                             std::vector<ChooseFromOrder::AllowedChoice>{}));
+    decisions.push_back(std::make_unique<GainFromBoardDecision>("Silver"));
+
+    std::vector<std::string> visited;
+    for ( const auto &decision : decisions ) {
+        const ActionDecision &ref = *decision;
+        visited.push_back(visit(ref,
+                                Overloaded{[](const PlayActionCardDecision &play) { return play.card_id; },
+                                           [](const BuyCardDecision &buy) { return buy.card; },
+                                           [](const DeckChoiceDecision &choice) { return choice.cards.front(); },
+                                           [](const GainFromBoardDecision &gain) { return gain.chosen_card; },
+                                           [](const ActionDecision &) { return std::string("none"); }}));
+    }
+    EXPECT_EQ(visited, (std::vector<std::string>{"Village", "Gold", "none", "none", "Copper", "Silver"}));
+
+    const StartGameRequestMessage start("123", "player1", getValidKingdomCards());
+    const ClientToServerMessage &message = start;
+    EXPECT_EQ(visit(message,
+                    Overloaded{[](const StartGameRequestMessage &request) { return request.selected_cards.size(); },
+                               [](const ClientToServerMessage &) { return size_t{0}; }}),
+              getValidKingdomCards().size());
+}
@@ -3,6 +3,7 @@
 
 #include <shared/message_types.h>
 #include <shared/player_result.h>
+#include <shared/utils/json.h>
 #include <shared/utils/test_helpers.h>
 
 using namespace shared;
@@ -40,6 +41,27 @@ TEST(SharedLibraryTest, GameStateMessageTwoWayConversion)
     ASSERT_EQ(*parsed_message, original_message);
 }
 
+TEST(SharedLibraryTest, GameStateDeltaMessageTwoWayConversion)
+{
+    auto from = test_helper::getReducedGameStatePtr(2);
+    auto to = from->clone();
+    to->board->getPlayedCards().push_back("Smithy");
+    to->game_phase = GamePhase::BUY_PHASE;
+
+    GameStateDeltaMessage original_message("123", 1, 2, reduced::GameState::Delta::make(*from, *to), "456");
+
+    std::string json = original_message.toJson();
+
+    std::unique_ptr<ServerToClientMessage> base_message;
+    base_message = ServerToClientMessage::fromJson(json);
+
+    std::unique_ptr<GameStateDeltaMessage> parsed_message(
+            dynamic_cast<GameStateDeltaMessage *>(base_message.release()));
+
+    ASSERT_NE(parsed_message, nullptr);
+    ASSERT_EQ(*parsed_message, original_message);
+}
+
 TEST(SharedLibraryTest, CreateLobbyResponseMessageTwoWayConversion)
 {
     CreateLobbyResponseMessage original_message("123", std::nullopt);
@@ -93,7 +115,7 @@ TEST(SharedLibraryTest, EndGameBroadcastMessageTwoWayConversion)
 {
 
     std::vector<PlayerResult> results = {{"player1", 10}, {"player2", 20}, {"player3", 30}};
-    EndGameBroadcastMessage original_message("123", results);
+    EndGameBroadcastMessage original_message("123", results, UINT64_MAX);
 
     std::string json = original_message.toJson();
 
@@ -294,3 +316,27 @@ TEST(SharedLibraryTest, ActionDecisionMessageTwoWayConversionChooseNCardsFromHan
     ASSERT_NE(parsed_message, nullptr);
     ASSERT_EQ(*parsed_message, original_message);
 }
+
+TEST(SharedLibraryTest, ActionDecisionMessageInSituConversion)
+{
+    std::unique_ptr<ActionDecision> decision = std::make_unique<DeckChoiceDecision>(
+            std::vector<CardBase::id_t>{"Copper", "Estate"},
+            std::vector<ChooseFromOrder::AllowedChoice>{ChooseFromOrder::TRASH, ChooseFromOrder::DISCARD});
+    ActionDecisionMessage original_message("123", "player \"1\"", std::move(decision), "789");
+
+    InSituJsonParser parser;
+    // the parser is reused like on a connection, the fields must not point into the previous buffer
+    for ( int i = 0; i < 2; ++i ) {
+        std::string json = original_message.toJson();
+
+        std::unique_ptr<ClientToServerMessage> base_message =
+                ClientToServerMessage::fromJsonInSitu(json.data(), parser);
+        json.assign(json.size(), 'x');
+
+        std::unique_ptr<ActionDecisionMessage> parsed_message(
+                dynamic_cast<ActionDecisionMessage *>(base_message.release()));
+
+        ASSERT_NE(parsed_message, nullptr);
+        ASSERT_EQ(*parsed_message, original_message);
+    }
+}
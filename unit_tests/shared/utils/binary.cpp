@@ -0,0 +1,99 @@
+#include <gtest/gtest.h>
+
+#include <limits>
+
+#include <shared/utils/binary.h>
+
+using namespace shared;
+
+TEST(BinaryCodec, IntegersRoundTrip)
+{
+    const std::vector<uint64_t> unsigned_values = {0, 1, 127, 128, 300, 16383, 16384,
+                                                   std::numeric_limits<uint64_t>::max()};
+    const std::vector<int64_t> signed_values = {0, -1, 1, -64, 64, std::numeric_limits<int64_t>::min(),
+                                                std::numeric_limits<int64_t>::max()};
+
+    BinaryWriter writer;
+    for ( const auto value : unsigned_values ) {
+        writer.writeUint(value);
+    }
+    for ( const auto value : signed_values ) {
+        writer.writeInt(value);
+    }
+
+    const std::string binary = writer.release();
+    BinaryReader reader(binary);
+    for ( const auto value : unsigned_values ) {
+        EXPECT_EQ(reader.readUint(), value);
+    }
+    for ( const auto value : signed_values ) {
+        EXPECT_EQ(reader.readInt(), value);
+    }
+    EXPECT_TRUE(reader.atEnd());
+}
+
+TEST(BinaryCodec, SmallValuesTakeOneByte)
+{
+    BinaryWriter writer;
+    writer.writeUint(127);
+    writer.writeInt(-64);
+    writer.writeCard("Province");
+    EXPECT_EQ(writer.size(), 3);
+}
+
+TEST(BinaryCodec, CardsRoundTrip)
+{
+    // the empty id is used for "no card" and is not registered
+    const std::vector<CardBase::id_t> cards = {"Copper", "Village", "", "not a card"};
+
+    BinaryWriter writer;
+    writer.writeCards(cards);
+
+    const std::string binary = writer.release();
+    BinaryReader reader(binary);
+    EXPECT_EQ(reader.readCards(), cards);
+    EXPECT_TRUE(reader.atEnd());
+}
+
+TEST(BinaryCodec, StringsRoundTrip)
+{
+    BinaryWriter writer;
+    writer.writeString("");
+    writer.writeOptionalString(std::nullopt);
+    writer.writeOptionalString("in_response_to");
+    writer.writeStrings({"player1", "player2"});
+    writer.writeBool(true);
+
+    const std::string binary = writer.release();
+    BinaryReader reader(binary);
+    EXPECT_EQ(reader.readString(), "");
+    EXPECT_EQ(reader.readOptionalString(), std::nullopt);
+    EXPECT_EQ(reader.readOptionalString(), "in_response_to");
+    EXPECT_EQ(reader.readStrings(), (std::vector<std::string>{"player1", "player2"}));
+    EXPECT_TRUE(reader.readBool());
+    EXPECT_TRUE(reader.atEnd());
+}
+
+TEST(BinaryCodec, RejectsMalformedInput)
+{
+    // truncated varint
+    EXPECT_THROW(BinaryReader("\x80").readUint(), exception::MalformedMessage);
+    // varint longer than any uint64_t
+    EXPECT_THROW(BinaryReader(std::string(11, '\xFF')).readUint(), exception::MalformedMessage);
+    // length beyond the end of the input
+    EXPECT_THROW(BinaryReader("\x05"
+                              "abc")
+                         .readString(),
+                 exception::MalformedMessage);
+    EXPECT_THROW(BinaryReader("\x7F").readCards(), exception::MalformedMessage);
+    // card handle that is not registered
+    EXPECT_THROW(BinaryReader("\x7F").readCard(), exception::MalformedMessage);
+    EXPECT_THROW(BinaryReader("\x02").readBool(), exception::MalformedMessage);
+}
+
+TEST(BinaryCodec, DetectsWireFormat)
+{
+    EXPECT_EQ(detectWireFormat(""), WireFormat::JSON);
+    EXPECT_EQ(detectWireFormat("{\"type\": \"start_game_broadcast\"}"), WireFormat::JSON);
+    EXPECT_EQ(detectWireFormat(std::string(1, static_cast<char>(BINARY_MAGIC))), WireFormat::BINARY);
+}
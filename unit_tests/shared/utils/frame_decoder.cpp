@@ -0,0 +1,154 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+#include <shared/utils/frame_decoder.h>
+
+namespace
+{
+    std::vector<std::string> drain(shared::FrameDecoder &decoder)
+    {
+        std::vector<std::string> frames;
+        while ( auto frame = decoder.next() ) {
+            frames.emplace_back(*frame);
+        }
+        return frames;
+    }
+} // namespace
+
+TEST(FrameDecoderTest, EncodeFrame)
+{
+    EXPECT_EQ(shared::encodeFrame("hello"), "5:hello");
+    EXPECT_EQ(shared::encodeFrame(""), "0:");
+    EXPECT_EQ(shared::encodeFrame(std::string(1234, 'x')).substr(0, 5), "1234:");
+}
+
+TEST(FrameDecoderTest, SingleFrame)
+{
+    shared::FrameDecoder decoder;
+    decoder.feed(shared::encodeFrame("{\"type\":\"test\"}"));
+
+    const auto frames = drain(decoder);
+    ASSERT_EQ(frames.size(), 1);
+    EXPECT_EQ(frames[0], "{\"type\":\"test\"}");
+    EXPECT_EQ(decoder.buffered(), 0);
+}
+
+TEST(FrameDecoderTest, ByteByByte)
+{
+    const std::vector<std::string> payloads = {"first", "", "a:b:c", std::string(300, 'y')};
+    std::string stream;
+    for ( const auto &payload : payloads ) {
+        stream += shared::encodeFrame(payload);
+    }
+
+    shared::FrameDecoder decoder;
+    std::vector<std::string> frames;
+    for ( char c : stream ) {
+        decoder.feed(std::string_view(&c, 1));
+        for ( auto &frame : drain(decoder) ) {
+            frames.push_back(std::move(frame));
+        }
+    }
+
+    EXPECT_EQ(frames, payloads);
+    EXPECT_EQ(decoder.buffered(), 0);
+}
+
+TEST(FrameDecoderTest, MultipleFramesPerChunk)
+{
+    shared::FrameDecoder decoder;
+    decoder.feed("3:abc4:defg2:h");
+
+    EXPECT_EQ(drain(decoder), (std::vector<std::string>{"abc", "defg"}));
+    EXPECT_EQ(decoder.buffered(), 3);
+
+    decoder.feed("i");
+    EXPECT_EQ(drain(decoder), (std::vector<std::string>{"hi"}));
+}
+
+TEST(FrameDecoderTest, PrepareAndCommit)
+{
+    const std::string stream = shared::encodeFrame("hello") + shared::encodeFrame("world");
+
+    shared::FrameDecoder decoder;
+    std::vector<std::string> frames;
+    for ( size_t pos = 0; pos < stream.size(); pos += 3 ) {
+        const size_t size = std::min<size_t>(3, stream.size() - pos);
+        // only part of the prepared room is filled, like a short read
+        char *dst = decoder.prepare(16);
+        std::copy_n(stream.data() + pos, size, dst);
+        decoder.commit(size);
+        for ( auto &frame : drain(decoder) ) {
+            frames.push_back(std::move(frame));
+        }
+    }
+
+    EXPECT_EQ(frames, (std::vector<std::string>{"hello", "world"}));
+}
+
+TEST(FrameDecoderTest, OversizedFrame)
+{
+    shared::FrameDecoder decoder(8);
+    decoder.feed("8:12345678");
+    EXPECT_EQ(drain(decoder), (std::vector<std::string>{"12345678"}));
+
+    // rejected as soon as the prefix is known, before the payload is buffered
+    decoder.feed("9:");
+    EXPECT_THROW(decoder.next(), exception::MalformedFrame);
+}
+
+TEST(FrameDecoderTest, MalformedPrefix)
+{
+    shared::FrameDecoder decoder;
+    decoder.feed("abc:def");
+    EXPECT_THROW(decoder.next(), exception::MalformedFrame);
+
+    decoder.reset();
+    decoder.feed("-1:x");
+    EXPECT_THROW(decoder.next(), exception::MalformedFrame);
+
+    decoder.reset();
+    decoder.feed(std::string(64, '1'));
+    EXPECT_THROW(decoder.next(), exception::MalformedFrame);
+
+    // usable again after a reset
+    decoder.reset();
+    decoder.feed("2:ok");
+    EXPECT_EQ(drain(decoder), (std::vector<std::string>{"ok"}));
+}
+
+TEST(FrameDecoderTest, WritableFramesAreTerminated)
+{
+    shared::FrameDecoder decoder;
+    decoder.feed("3:abc2:de");
+
+    auto first = decoder.nextWritable();
+    ASSERT_TRUE(first.has_value());
+    EXPECT_EQ(std::string(first->data(), first->size()), "abc");
+    // the terminator borrows the length prefix of the next frame
+    EXPECT_EQ(first->data()[first->size()], '\0');
+    first->front() = 'x';
+
+    auto second = decoder.nextWritable();
+    ASSERT_TRUE(second.has_value());
+    EXPECT_EQ(std::string(second->data(), second->size()), "de");
+    EXPECT_EQ(second->data()[second->size()], '\0');
+
+    EXPECT_FALSE(decoder.nextWritable().has_value());
+    EXPECT_EQ(decoder.buffered(), 0);
+}
+
+TEST(FrameDecoderTest, BorrowedByteIsRestored)
+{
+    shared::FrameDecoder decoder;
+    // the second frame is incomplete, its prefix must survive the terminator of the first
+    decoder.feed("2:ab5:he");
+
+    auto first = decoder.nextWritable();
+    ASSERT_TRUE(first.has_value());
+    EXPECT_EQ(first->data()[first->size()], '\0');
+
+    decoder.feed("llo");
+    EXPECT_EQ(drain(decoder), (std::vector<std::string>{"hello"}));
+}
@@ -0,0 +1,100 @@
+#include <gtest/gtest.h>
+
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <shared/game/game_state/reduced_game_state.h>
+#include <shared/utils/json.h>
+#include <shared/utils/test_helpers.h>
+
+using namespace shared;
+
+TEST(JsonWriter, WritesMembersInOrder)
+{
+    const std::vector<std::string> cards = {"Copper", "Estate"};
+    const std::optional<std::string> missing;
+
+    const std::string json = writeJson(
+            [&](JsonWriter &writer)
+            {
+                writer.StartObject();
+                WRITE_STRING_MEMBER("a \"quoted\" id", id);
+                WRITE_UINT_MEMBER(3u, count);
+                WRITE_INT_MEMBER(-2, score);
+                WRITE_BOOL_MEMBER(true, success);
+                WRITE_OPTIONAL_STRING_MEMBER(missing, missing);
+                WRITE_ARRAY_OF_STRINGS_MEMBER(cards, cards);
+                writer.EndObject();
+            });
+
+    EXPECT_EQ(json, R"({"id":"a \"quoted\" id","count":3,"score":-2,"success":true,"cards":["Copper","Estate"]})");
+}
+
+TEST(JsonWriter, ConsecutiveWritesAreIndependent)
+{
+    const std::string first = writeJson([](JsonWriter &writer) { writer.String("first"); });
+    const std::string second = writeJson([](JsonWriter &writer) { writer.String("second"); });
+
+    EXPECT_EQ(first, "\"first\"");
+    EXPECT_EQ(second, "\"second\"");
+}
+
+TEST(JsonWriter, LargeWriteDoesNotKeepBuffer)
+{
+    const std::string large(256 * 1024, 'x');
+    const std::string json = writeJson([&large](JsonWriter &writer) { writeJsonString(writer, large); });
+
+    EXPECT_EQ(json.size(), large.size() + 2);
+    EXPECT_EQ(threadJsonBuffer().GetSize(), 0);
+}
+
+TEST(JsonWriter, StreamedGameStateMatchesDocument)
+{
+    const auto game_state = test_helper::getReducedGameStatePtr(3);
+
+    const std::string streamed = writeJson([&game_state](JsonWriter &writer) { game_state->writeJson(writer); });
+    rapidjson::Document doc;
+    doc.Parse(streamed.data(), streamed.size());
+    ASSERT_FALSE(doc.HasParseError());
+
+    EXPECT_EQ(doc, game_state->toJson());
+    EXPECT_EQ(*reduced::GameState::fromJson(doc), *game_state);
+}
+
+TEST(InSituJsonParser, ParsesInPlace)
+{
+    std::string json = R"({"id":"a \"quoted\" id","cards":["Copper","Estate"]})";
+
+    InSituJsonParser parser;
+    const auto *doc = parser.parse(json.data());
+    ASSERT_NE(doc, nullptr);
+
+    // the strings are not copied, escapes are decoded inside the input
+    const auto &id = (*doc)["id"];
+    EXPECT_EQ(jsonStringView(id), "a \"quoted\" id");
+    EXPECT_GE(id.GetString(), json.data());
+    EXPECT_LT(id.GetString(), json.data() + json.size());
+    EXPECT_EQ((*doc)["cards"].Size(), 2);
+}
+
+TEST(InSituJsonParser, IsReusable)
+{
+    InSituJsonParser parser;
+
+    // does not fit into the inline chunk
+    std::string large = "[";
+    for ( int i = 0; i < 1000; ++i ) {
+        large += "1,";
+    }
+    large += "1]";
+    ASSERT_NE(parser.parse(large.data()), nullptr);
+
+    std::string invalid = R"({"id":)";
+    EXPECT_EQ(parser.parse(invalid.data()), nullptr);
+
+    std::string small = R"({"id":"second"})";
+    const auto *doc = parser.parse(small.data());
+    ASSERT_NE(doc, nullptr);
+    EXPECT_EQ(jsonStringView((*doc)["id"]), "second");
+}
@@ -0,0 +1,155 @@
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <shared/utils/logger.h>
+
+namespace
+{
+    /**
+     * @brief Redirects the logger into a fresh file for the lifetime of the object.
+     */
+    class LogFile
+    {
+    public:
+        explicit LogFile(const std::string &name) :
+            path(std::filesystem::temp_directory_path() / name), previous_level(shared::Logger::getLevel())
+        {
+            std::filesystem::remove(path);
+            shared::Logger::writeTo(path.string());
+            shared::Logger::setLevel(LogLevel::INFO);
+        }
+
+        ~LogFile()
+        {
+            shared::Logger::setLevel(previous_level);
+            shared::Logger::writeTo();
+            std::filesystem::remove(path);
+        }
+
+        std::vector<std::string> linesContaining(const std::string &marker) const
+        {
+            std::vector<std::string> lines;
+            std::ifstream file(path);
+            for ( std::string line; std::getline(file, line); ) {
+                if ( line.find(marker) != std::string::npos ) {
+                    lines.push_back(line);
+                }
+            }
+            return lines;
+        }
+
+    private:
+        std::filesystem::path path;
+        LogLevel previous_level;
+    };
+
+    template <int N>
+    struct Named
+    {
+        std::string_view className() const { return CLASS_NAME; }
+    };
+} // namespace
+
+TEST(LoggerTest, FlushWritesEveryLine)
+{
+    LogFile log("dominion_logger_flush.log");
+
+    LOG(INFO) << "flush-marker " << 42;
+    LOG(ERROR) << "flush-marker error";
+    shared::Logger::flush();
+
+    const auto lines = log.linesContaining("flush-marker");
+    ASSERT_EQ(lines.size(), 2);
+    EXPECT_NE(lines[0].find("flush-marker 42"), std::string::npos);
+    EXPECT_NE(lines[1].find("ERROR"), std::string::npos);
+}
+
+TEST(LoggerTest, KeepsTheOrderOfEveryThread)
+{
+    LogFile log("dominion_logger_threads.log");
+
+    // each thread stays below the capacity of its buffer, so nothing may be dropped
+    constexpr int THREADS = 4;
+    constexpr int LINES = 500;
+    const auto dropped_before = shared::Logger::getDroppedCount();
+
+    std::vector<std::thread> threads;
+    for ( int t = 0; t < THREADS; ++t ) {
+        threads.emplace_back(
+                [t]()
+                {
+                    for ( int i = 0; i < LINES; ++i ) {
+                        LOG(INFO) << "thread-marker " << t << " " << i << ";";
+                    }
+                });
+    }
+    for ( auto &thread : threads ) {
+        thread.join();
+    }
+    shared::Logger::flush();
+
+    ASSERT_EQ(shared::Logger::getDroppedCount(), dropped_before);
+    const auto lines = log.linesContaining("thread-marker");
+    ASSERT_EQ(lines.size(), THREADS * LINES);
+
+    std::vector<int> next(THREADS, 0);
+    for ( const auto &line : lines ) {
+        for ( int t = 0; t < THREADS; ++t ) {
+            const std::string prefix = "thread-marker " + std::to_string(t) + " ";
+            if ( line.find(prefix) != std::string::npos ) {
+                EXPECT_NE(line.find(prefix + std::to_string(next[t]) + ";"), std::string::npos) << line;
+                ++next[t];
+            }
+        }
+    }
+}
+
+TEST(LoggerTest, DisabledStatementsAreNotEvaluated)
+{
+    const auto previous_level = shared::Logger::getLevel();
+    shared::Logger::setLevel(LogLevel::WARN);
+
+    int evaluated = 0;
+    const auto count = [&evaluated]() { return ++evaluated; };
+    LOG(INFO) << "not evaluated " << count();
+    LOG(DEBUG) << "not evaluated " << count();
+    EXPECT_EQ(evaluated, 0);
+
+    shared::Logger::setLevel(previous_level);
+}
+
+TEST(LoggerTest, ModulesHaveTheirOwnLevel)
+{
+    static_assert(shared::logModuleOf("modules/server/src/network/reactor.cpp") == shared::LogModule::NETWORK);
+    static_assert(shared::logModuleOf("modules/server/src/lobbies/lobby.cpp") == shared::LogModule::LOBBY);
+    static_assert(shared::logModuleOf("modules/server/include/server/game/behaviours_impl.hpp") ==
+                  shared::LogModule::BEHAVIOUR);
+    static_assert(shared::logModuleOf("modules/server/src/game/game_state.cpp") == shared::LogModule::GAME);
+    static_assert(shared::logModuleOf("modules/server/server_main.cpp") == shared::LogModule::GENERAL);
+
+    const auto previous_level = shared::Logger::getLevel();
+    shared::Logger::setLevel(LogLevel::WARN);
+    shared::Logger::setLevel(shared::LogModule::NETWORK, LogLevel::INFO);
+
+    EXPECT_TRUE(shared::Logger::isEnabled(LogLevel::INFO, shared::LogModule::NETWORK));
+    EXPECT_FALSE(shared::Logger::isEnabled(LogLevel::INFO, shared::LogModule::GAME));
+    EXPECT_TRUE(shared::Logger::isEnabled(LogLevel::WARN, shared::LogModule::GAME));
+    EXPECT_EQ(shared::parseLogModule("behaviour"), shared::LogModule::BEHAVIOUR);
+    EXPECT_EQ(shared::parseLogModule("frontend"), std::nullopt);
+
+    shared::Logger::setLevel(previous_level);
+}
+
+TEST(LoggerTest, NamesAreResolvedAtCompileTime)
+{
+    static_assert(utils::typeName<int>() == "int");
+    static_assert(utils::typeName<std::vector<int>>().starts_with("std::vector<int"));
+
+    EXPECT_EQ(Named<3>().className(), "{anonymous}::Named<3>");
+    EXPECT_EQ(FUNC_NAME, "TestBody");
+}
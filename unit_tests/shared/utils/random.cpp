@@ -0,0 +1,94 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <numeric>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <shared/utils/random.h>
+#include <shared/utils/uuid_generator.h>
+
+TEST(SplitMix64, MatchesTheReferenceSequence)
+{
+    // the first numbers of the reference implementation seeded with 0
+    EXPECT_EQ(utils::splitmix64(0, 0), 0xe220a8397b1dcdaf);
+    EXPECT_EQ(utils::splitmix64(0, 1), 0x6e789e6aa1b965f4);
+    EXPECT_NE(utils::splitmix64(1, 0), utils::splitmix64(0, 1));
+}
+
+TEST(Xoshiro256, SameSeedSameSequence)
+{
+    utils::Xoshiro256 first(1234);
+    utils::Xoshiro256 second(1234);
+    utils::Xoshiro256 other(1235);
+
+    std::vector<uint64_t> first_values;
+    for ( int i = 0; i < 100; ++i ) {
+        first_values.push_back(first());
+        EXPECT_EQ(first_values.back(), second());
+    }
+    EXPECT_NE(first_values.front(), other());
+
+    // reseeding starts over
+    first.seed(1234);
+    EXPECT_EQ(first(), first_values.front());
+}
+
+TEST(Xoshiro256, JumpSplitsTheSequence)
+{
+    utils::Xoshiro256 engine(42);
+    const utils::Xoshiro256 before = engine;
+    engine.jump();
+    EXPECT_NE(engine, before);
+
+    utils::Xoshiro256 copy = before;
+    copy.jump();
+    EXPECT_EQ(copy, engine);
+}
+
+TEST(Xoshiro256, ShufflesLikeAStdEngine)
+{
+    std::vector<int> cards(30);
+    std::iota(cards.begin(), cards.end(), 0);
+    auto first = cards;
+    auto second = cards;
+
+    utils::Xoshiro256 engine(7);
+    std::shuffle(first.begin(), first.end(), engine);
+    engine.seed(7);
+    std::shuffle(second.begin(), second.end(), engine);
+
+    EXPECT_EQ(first, second);
+    EXPECT_TRUE(std::is_permutation(first.begin(), first.end(), cards.begin()));
+}
+
+TEST(UuidGenerator, UniqueAcrossThreads)
+{
+    constexpr size_t per_thread = 1000;
+    std::vector<std::vector<std::string>> generated(4);
+    std::vector<std::thread> threads;
+    for ( auto &ids : generated ) {
+        threads.emplace_back(
+                [&ids]()
+                {
+                    for ( size_t i = 0; i < per_thread; ++i ) {
+                        ids.push_back(UuidGenerator::generateUuidV4());
+                    }
+                });
+    }
+    for ( auto &thread : threads ) {
+        thread.join();
+    }
+
+    std::set<std::string> unique;
+    for ( const auto &ids : generated ) {
+        for ( const auto &id : ids ) {
+            EXPECT_EQ(id.size(), 20);
+            EXPECT_EQ(id[8], '4');
+            unique.insert(id);
+        }
+    }
+    EXPECT_EQ(unique.size(), generated.size() * per_thread);
+}